@@ -0,0 +1,268 @@
+#include "AlarmHandler.h"   // Header for this module
+#include "ConfigHandler.h"  // For the shared Preferences object
+#include "ThemeConfig.h"    // For COLOR_BACKGROUND
+
+#include <TFT_eSPI.h>
+
+// --- EXTERNAL DEPENDENCIES ---
+extern TFT_eSPI tft;
+extern const int DISPLAY_WIDTH;
+extern const int DISPLAY_HEIGHT;
+extern bool backlight_state;
+extern unsigned long lastActivityTime;
+extern void toggleBacklight();
+extern void applyTheme(bool inverted);
+// -----------------------------
+
+#define ALARMS_KEY "alarms"
+
+// --- ALERT TIMING ---
+static const unsigned long ALARM_ALERT_TIMEOUT_MS = 10 * 60000UL; // Auto-dismiss an unattended alert
+static const unsigned long ALARM_BLINK_MS = 500;
+static const int ALARM_SNOOZE_ZONE_Y = 160;                       // Taps below this line snooze
+
+// --- STATE ---
+AlarmEntry alarmEntries[ALARM_MAX_ENTRIES];
+static AlarmHeap alarmHeap;
+static bool alarmHeapValid = false;   // Built once the clock is set
+// Pending snooze per slot (UTC, 0 = none). The heap is rebuilt on every boot, so
+// snoozes are kept here as well to survive deep sleep; editing the table drops them.
+RTC_DATA_ATTR static time_t snoozeFire[ALARM_MAX_ENTRIES] = {};
+
+static bool alertActive = false;
+static uint8_t alertSlot = 0;
+static unsigned long alertStartMs = 0;
+static unsigned long lastBlinkMs = 0;
+static bool blinkOn = false;
+
+
+/**
+ * @brief Loads the alarm table from NVS (all disabled if missing or resized).
+ */
+void loadAlarms() {
+    preferences.begin(PREF_NAMESPACE, true);
+    size_t bytesRead = preferences.getBytes(ALARMS_KEY, alarmEntries, sizeof(alarmEntries));
+    preferences.end();
+    if (bytesRead != sizeof(alarmEntries)) {
+        memset(alarmEntries, 0, sizeof(alarmEntries));
+        for (uint8_t i = 0; i < ALARM_MAX_ENTRIES; i++) {
+            alarmEntries[i].hour = 7;
+            alarmEntries[i].weekdays = 0x3E; // Monday to Friday
+            alarmEntries[i].snooze_min = 9;
+        }
+    }
+    alarmHeapValid = false;
+}
+
+/**
+ * @brief Writes the alarm table to NVS.
+ */
+static void persistAlarms() {
+    preferences.begin(PREF_NAMESPACE, false);
+    size_t bytesWritten = preferences.putBytes(ALARMS_KEY, alarmEntries, sizeof(alarmEntries));
+    preferences.end();
+    Serial.printf("Alarms saved to NVS. Bytes written: %u\n", bytesWritten);
+}
+
+/**
+ * @brief Saves an edited table and reschedules it.
+ */
+void saveAlarms() {
+    persistAlarms();
+    memset(snoozeFire, 0, sizeof(snoozeFire));
+    rescheduleAlarms();
+}
+
+void rescheduleAlarms() {
+    alarmHeapValid = false; // Rebuilt on the next tick with a valid clock
+}
+
+const char* alarmActionName(uint8_t action) {
+    switch (action) {
+        case ALARM_ACTION_ALERT:       return "Alert";
+        case ALARM_ACTION_THEME_LIGHT: return "Light Theme";
+        case ALARM_ACTION_THEME_DARK:  return "Dark Theme";
+        case ALARM_ACTION_DISPLAY_OFF: return "Display Off";
+        case ALARM_ACTION_DISPLAY_ON:  return "Display On";
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief Draws (or re-draws for blinking) the full-screen alert.
+ */
+static void drawAlarmAlert(bool highlight) {
+    const AlarmEntry& entry = alarmEntries[alertSlot];
+    uint16_t background = highlight ? TFT_ORANGE : COLOR_BACKGROUND;
+    uint16_t foreground = highlight ? TFT_BLACK : TFT_ORANGE;
+
+    tft.fillScreen(background);
+    tft.setFreeFont(NULL);
+    tft.setTextDatum(MC_DATUM);
+    tft.setTextColor(foreground, background);
+
+    char timeText[8]; // "255:255" if the NVS table held garbage
+    snprintf(timeText, sizeof(timeText), "%02u:%02u", entry.hour, entry.minute);
+    tft.setTextFont(7);
+    tft.drawString(timeText, DISPLAY_WIDTH / 2, 60);
+
+    tft.setTextFont(4);
+    tft.drawString(entry.label[0] ? entry.label : "Alarm", DISPLAY_WIDTH / 2, 120);
+
+    tft.setTextFont(2);
+    if (entry.snooze_min > 0) {
+        tft.drawFastHLine(0, ALARM_SNOOZE_ZONE_Y, DISPLAY_WIDTH, foreground);
+        tft.drawString("Tap above to dismiss", DISPLAY_WIDTH / 2, ALARM_SNOOZE_ZONE_Y - 15);
+        String snooze = "Tap here to snooze " + String(entry.snooze_min) + " min";
+        tft.drawString(snooze, DISPLAY_WIDTH / 2, (ALARM_SNOOZE_ZONE_Y + DISPLAY_HEIGHT) / 2);
+    } else {
+        tft.drawString("Tap to dismiss", DISPLAY_WIDTH / 2, 190);
+    }
+}
+
+/**
+ * @brief Runs the action of a fired entry.
+ */
+static void fireAlarm(uint8_t slot) {
+    const AlarmEntry& entry = alarmEntries[slot];
+    Serial.printf("Alarm %u fired: %s (%s)\n", slot, entry.label, alarmActionName(entry.action));
+
+    switch (entry.action) {
+        case ALARM_ACTION_ALERT:
+            if (!backlight_state) toggleBacklight();
+            lastActivityTime = millis(); // Keep the clock awake while the alert is up
+            alertActive = true;
+            alertSlot = slot;
+            alertStartMs = millis();
+            lastBlinkMs = millis();
+            blinkOn = true;
+            drawAlarmAlert(blinkOn);
+            break;
+        case ALARM_ACTION_THEME_LIGHT:
+            if (!alertActive) applyTheme(true);
+            break;
+        case ALARM_ACTION_THEME_DARK:
+            if (!alertActive) applyTheme(false);
+            break;
+        case ALARM_ACTION_DISPLAY_OFF:
+            if (backlight_state && !alertActive) toggleBacklight();
+            break;
+        case ALARM_ACTION_DISPLAY_ON:
+            if (!backlight_state) toggleBacklight();
+            break;
+    }
+}
+
+/**
+ * @brief Rebuilds the heap after rescheduleAlarms() (or at the first tick).
+ */
+static void ensureAlarmHeap(time_t now) {
+    if (alarmHeapValid) return;
+    alarmHeapBuild(alarmHeap, alarmEntries, ALARM_MAX_ENTRIES, now);
+    for (uint8_t i = 0; i < ALARM_MAX_ENTRIES; i++) {
+        if (snoozeFire[i] != 0) alarmHeapPush(alarmHeap, snoozeFire[i], i, true);
+    }
+    alarmHeapValid = true;
+    Serial.printf("Alarm schedule built: %u pending.\n", alarmHeap.count);
+}
+
+/**
+ * @brief Fires every heap entry that is due. Only the heap top is inspected
+ * when nothing is due, so a tick costs O(1).
+ */
+void serviceAlarms(time_t now) {
+    if (now < 1600000000) return; // Clock not set yet
+
+    ensureAlarmHeap(now);
+
+    bool tableChanged = false;
+    while (alarmHeap.count > 0 && alarmHeap.nodes[0].fire <= now) {
+        AlarmHeapNode node = alarmHeap.nodes[0];
+        alarmHeapPop(alarmHeap);
+        AlarmEntry& entry = alarmEntries[node.slot];
+        // A snooze rings even though its one-shot entry was disabled when it first fired
+        if (node.snoozed) {
+            snoozeFire[node.slot] = 0;
+        } else if (!(entry.flags & ALARM_FLAG_ENABLED)) {
+            continue;
+        }
+
+        // Missed by more than a few minutes (sleep, clock step): skip, but keep the rule going
+        if (now - node.fire < 300) {
+            fireAlarm(node.slot);
+        }
+        if (node.snoozed) continue;
+
+        if (entry.weekdays == 0) {
+            entry.flags &= ~ALARM_FLAG_ENABLED; // One-shot
+            tableChanged = true;
+        } else {
+            time_t next = alarmNextFire(entry, node.fire, true);
+            if (next != 0) alarmHeapPush(alarmHeap, next, node.slot, false);
+        }
+    }
+
+    if (tableChanged) {
+        persistAlarms(); // Heap is already up to date
+    }
+}
+
+bool alarmAlertActive() {
+    return alertActive;
+}
+
+/**
+ * @brief Blinks the alert and closes it after ALARM_ALERT_TIMEOUT_MS.
+ * @return True when the alert closed (caller redraws the clock).
+ */
+bool serviceAlarmAlert() {
+    if (!alertActive) return false;
+    if (millis() - alertStartMs > ALARM_ALERT_TIMEOUT_MS) {
+        Serial.println("Alarm alert timed out.");
+        alertActive = false;
+        return true;
+    }
+    if (millis() - lastBlinkMs >= ALARM_BLINK_MS) {
+        lastBlinkMs = millis();
+        blinkOn = !blinkOn;
+        drawAlarmAlert(blinkOn);
+    }
+    return false;
+}
+
+/**
+ * @brief Any tap closes the alert; a tap in the lower zone snoozes it.
+ * @return True when the alert closed (caller redraws the clock).
+ */
+bool alarmHandleTouch(int touchEvent, uint16_t x, uint16_t y) {
+    if (!alertActive || touchEvent == 0) return false;
+    (void)x;
+
+    const AlarmEntry& entry = alarmEntries[alertSlot];
+    if (entry.snooze_min > 0 && y >= ALARM_SNOOZE_ZONE_Y) {
+        time_t snoozeUntil = (time(nullptr) + entry.snooze_min * 60) / 60 * 60; // On a minute tick
+        if (alarmHeapPush(alarmHeap, snoozeUntil, alertSlot, true)) snoozeFire[alertSlot] = snoozeUntil;
+        Serial.printf("Alarm %u snoozed for %u min.\n", alertSlot, entry.snooze_min);
+    } else {
+        Serial.printf("Alarm %u dismissed.\n", alertSlot);
+    }
+    alertActive = false;
+    return true;
+}
+
+/**
+ * @brief Seconds until the next pending alarm (0 if none), for the deep-sleep wake timer.
+ */
+/**
+ * @brief True when the heap top is due, without firing it (the menu closes for it).
+ */
+bool alarmDue(time_t now) {
+    if (now < 1600000000) return false;
+    ensureAlarmHeap(now);
+    return alarmHeap.count > 0 && alarmHeap.nodes[0].fire <= now;
+}
+
+uint32_t alarmSecondsUntilNext(time_t now) {
+    if (!alarmHeapValid || alarmHeap.count == 0 || alarmHeap.nodes[0].fire <= now) return 0;
+    return (uint32_t)(alarmHeap.nodes[0].fire - now);
+}
@@ -0,0 +1,22 @@
+#ifndef ALARMHANDLER_H
+#define ALARMHANDLER_H
+
+#include <Arduino.h>
+#include "AlarmScheduler.h" // Entry/heap types
+
+// --- ALARM TABLE (persisted in NVS) ---
+extern AlarmEntry alarmEntries[ALARM_MAX_ENTRIES];
+
+// --- FUNCTION PROTOTYPES ---
+void loadAlarms();
+void saveAlarms();              // Persists the table and reschedules
+void rescheduleAlarms();        // Rebuild the heap (edits, time-zone or clock change)
+void serviceAlarms(time_t now); // Minute tick: fires everything due at the heap top
+bool alarmDue(time_t now);      // Something would fire now (checked while the menu is open)
+bool alarmAlertActive();
+bool serviceAlarmAlert();       // Blink / auto-timeout; true when the alert closed
+bool alarmHandleTouch(int touchEvent, uint16_t x, uint16_t y); // True when the alert closed
+uint32_t alarmSecondsUntilNext(time_t now); // For the deep-sleep wake timer (0 = none)
+const char* alarmActionName(uint8_t action);
+
+#endif // ALARMHANDLER_H
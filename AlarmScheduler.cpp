@@ -0,0 +1,82 @@
+#include "AlarmScheduler.h" // Header for this module
+
+/**
+ * @brief Next local-time occurrence of an entry strictly after 'after'.
+ * mktime() normalises month/year ends and resolves DST (times skipped by a
+ * spring-forward change move forward by the gap).
+ * @param skipAfterDay Start from the day after 'after' (rescheduling a fired
+ * alarm, so a repeated fall-back hour cannot fire it twice).
+ * @return UTC epoch seconds, or 0 if the entry is disabled.
+ */
+time_t alarmNextFire(const AlarmEntry& entry, time_t after, bool skipAfterDay) {
+    if (!(entry.flags & ALARM_FLAG_ENABLED)) return 0;
+
+    struct tm base;
+    localtime_r(&after, &base);
+    for (int day = skipAfterDay ? 1 : 0; day <= 8; day++) {
+        struct tm candidate = {};
+        candidate.tm_year = base.tm_year;
+        candidate.tm_mon = base.tm_mon;
+        candidate.tm_mday = base.tm_mday + day;
+        candidate.tm_hour = entry.hour;
+        candidate.tm_min = entry.minute;
+        candidate.tm_isdst = -1;
+        time_t t = mktime(&candidate);
+        if (t == (time_t)-1 || t <= after) continue;
+        if (entry.weekdays == 0 || (entry.weekdays & (1 << candidate.tm_wday))) return t;
+    }
+    return 0;
+}
+
+void alarmHeapClear(AlarmHeap& heap) {
+    heap.count = 0;
+}
+
+/**
+ * @brief Inserts a fire time (sift-up, O(log n)).
+ * @return False if the heap is full.
+ */
+bool alarmHeapPush(AlarmHeap& heap, time_t fire, uint8_t slot, bool snoozed) {
+    if (heap.count >= ALARM_HEAP_CAPACITY) return false;
+    uint8_t i = heap.count++;
+    while (i > 0) {
+        uint8_t parent = (i - 1) / 2;
+        if (heap.nodes[parent].fire <= fire) break;
+        heap.nodes[i] = heap.nodes[parent];
+        i = parent;
+    }
+    heap.nodes[i].fire = fire;
+    heap.nodes[i].slot = slot;
+    heap.nodes[i].snoozed = snoozed;
+    return true;
+}
+
+/**
+ * @brief Removes nodes[0] (sift-down, O(log n)).
+ */
+void alarmHeapPop(AlarmHeap& heap) {
+    if (heap.count == 0) return;
+    AlarmHeapNode last = heap.nodes[--heap.count];
+    uint8_t i = 0;
+    while (true) {
+        uint8_t child = 2 * i + 1;
+        if (child >= heap.count) break;
+        if (child + 1 < heap.count && heap.nodes[child + 1].fire < heap.nodes[child].fire) child++;
+        if (last.fire <= heap.nodes[child].fire) break;
+        heap.nodes[i] = heap.nodes[child];
+        i = child;
+    }
+    heap.nodes[i] = last;
+}
+
+/**
+ * @brief Rebuilds the heap from the entry table (after edits or a clock/time-zone change).
+ * Only entry occurrences are added: the caller re-adds pending snoozes.
+ */
+void alarmHeapBuild(AlarmHeap& heap, const AlarmEntry* entries, uint8_t count, time_t now) {
+    alarmHeapClear(heap);
+    for (uint8_t i = 0; i < count; i++) {
+        time_t fire = alarmNextFire(entries[i], now, false);
+        if (fire != 0) alarmHeapPush(heap, fire, i, false);
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef ALARMSCHEDULER_H
+#define ALARMSCHEDULER_H
+
+#include <stdint.h>
+#include <time.h>
+
+#define ALARM_MAX_ENTRIES 8
+#define ALARM_HEAP_CAPACITY (ALARM_MAX_ENTRIES * 2) // Each entry: next occurrence + at most one snooze
+
+// --- ENTRY FLAGS ---
+#define ALARM_FLAG_ENABLED 0x01
+
+typedef enum : uint8_t {
+    ALARM_ACTION_ALERT,        // Full-screen alert, dismissed by touch
+    ALARM_ACTION_THEME_LIGHT,
+    ALARM_ACTION_THEME_DARK,
+    ALARM_ACTION_DISPLAY_OFF,  // Start of a quiet window (backlight off)
+    ALARM_ACTION_DISPLAY_ON,
+    ALARM_ACTION_COUNT
+} AlarmAction;
+
+/**
+ * @brief One alarm or recurring rule, stored as-is in NVS (20 bytes).
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t flags;        // ALARM_FLAG_*
+    uint8_t weekdays;     // Bit 0 = Sunday ... bit 6 = Saturday; 0 = one-shot (disabled after firing)
+    uint8_t hour;         // Local time
+    uint8_t minute;
+    uint8_t action;       // AlarmAction
+    uint8_t snooze_min;   // 0 = no snooze button
+    char label[14];
+} AlarmEntry;
+
+static_assert(sizeof(AlarmEntry) == 20, "AlarmEntry is persisted as a raw blob; keep it packed");
+
+typedef struct {
+    time_t fire;          // UTC epoch seconds
+    uint8_t slot;         // Index into the entry table
+    bool snoozed;         // Snooze repeat (does not reschedule the entry)
+} AlarmHeapNode;
+
+/**
+ * @brief Min-heap of pending fire times: the next alarm is always nodes[0].
+ */
+typedef struct {
+    AlarmHeapNode nodes[ALARM_HEAP_CAPACITY];
+    uint8_t count;
+} AlarmHeap;
+
+// --- FUNCTION PROTOTYPES ---
+time_t alarmNextFire(const AlarmEntry& entry, time_t after, bool skipAfterDay);
+void alarmHeapClear(AlarmHeap& heap);
+bool alarmHeapPush(AlarmHeap& heap, time_t fire, uint8_t slot, bool snoozed);
+void alarmHeapPop(AlarmHeap& heap);
+void alarmHeapBuild(AlarmHeap& heap, const AlarmEntry* entries, uint8_t count, time_t now);
+
+#endif // ALARMSCHEDULER_H
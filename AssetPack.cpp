@@ -0,0 +1,336 @@
+#include "AssetPack.h"     // Header for this module
+#include "ScreenCapture.h" // Display lock: fonts are only swapped while loop() is not drawing
+#include "ThemeHandler.h"  // themeLoad() when the pack goes away
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+
+// --- EXTERNAL DEPENDENCIES ---
+extern TFT_eSPI tft;
+// -----------------------------
+
+// Fonts are used in place: the pack must have been built for this GFXglyph layout
+static_assert(sizeof(AssetPackHeader) == 16, "AssetPackHeader layout");
+static_assert(sizeof(AssetTocEntry) == 28, "AssetTocEntry layout");
+static_assert(sizeof(AssetFontHeader) == 20, "AssetFontHeader layout");
+
+// --- CONSTANTS ---
+static const size_t FLASH_SECTOR_SIZE = 4096;
+static const uint8_t FONT_CACHE_SIZE = 6;
+static const uint32_t UPLOAD_LOCK_TIMEOUT_MS = 2000;
+
+/**
+ * @brief A font resolved by name: a GFXfont descriptor in RAM whose glyph table
+ * and bitmap pointers lead into the mapped partition. Misses are cached too.
+ */
+typedef struct {
+    char name[ASSET_NAME_LEN + 1];
+    bool found;
+    GFXfont font;
+} FontSlot;
+
+/**
+ * @brief One pack upload in flight. Chunks go through the CRC and straight to
+ * flash; the header is written last, so a partial upload never mounts.
+ */
+typedef struct {
+    AsyncWebServerRequest* owner;
+    bool active;
+    bool failed;
+    bool complete;
+    char error[64];
+    AssetPackHeader header;
+    uint32_t crc;
+    size_t bytes;
+    size_t erased;       // Partition bytes erased so far (whole sectors)
+    unsigned long startMs;
+} AssetUpload;
+
+// --- STATE ---
+static const esp_partition_t* partition = nullptr;
+static spi_flash_mmap_handle_t mapHandle = 0;
+static const uint8_t* pack = nullptr;          // Mapped pack, nullptr = not mounted
+static const AssetTocEntry* toc = nullptr;
+static FontSlot fontCache[FONT_CACHE_SIZE];
+static uint8_t fontCacheUsed = 0;
+static AssetPackInfo info = {};
+static AssetUpload upload = {};
+static volatile bool remountPending = false;
+
+
+static const esp_partition_t* findPartition() {
+    if (partition == nullptr) {
+        partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)ASSET_PARTITION_SUBTYPE,
+                                             ASSET_PARTITION_LABEL);
+    }
+    return partition;
+}
+
+static bool headerValid(const AssetPackHeader& header, size_t capacity) {
+    return header.magic == ASSET_PACK_MAGIC && header.version == ASSET_PACK_VERSION &&
+           header.total_size >= sizeof(AssetPackHeader) + (size_t)header.count * sizeof(AssetTocEntry) &&
+           header.total_size <= capacity;
+}
+
+/**
+ * @brief Maps the pack and checks its CRC and table of contents.
+ * Call with the display lock held (fonts in use may change).
+ */
+bool assetPackMount() {
+    assetPackUnmount();
+    unsigned long start = micros();
+    if (findPartition() == nullptr) {
+        Serial.println("Assets: no 'assets' partition, using compiled-in fonts.");
+        return false;
+    }
+    AssetPackHeader header;
+    if (esp_partition_read(partition, 0, &header, sizeof(header)) != ESP_OK || !headerValid(header, partition->size)) {
+        Serial.println("Assets: partition holds no valid pack, using compiled-in fonts.");
+        return false;
+    }
+    const void* mapped = nullptr;
+    esp_err_t err = esp_partition_mmap(partition, 0, header.total_size, ESP_PARTITION_MMAP_DATA, &mapped, &mapHandle);
+    if (err != ESP_OK) {
+        Serial.printf("Assets: mmap failed (%s).\n", esp_err_to_name(err));
+        return false;
+    }
+    const uint8_t* base = (const uint8_t*)mapped;
+    size_t bodySize = header.total_size - sizeof(header);
+    if (esp_rom_crc32_le(0, base + sizeof(header), bodySize) != header.crc32) {
+        Serial.println("Assets: CRC mismatch, pack ignored.");
+        spi_flash_munmap(mapHandle);
+        return false;
+    }
+    const AssetTocEntry* entries = (const AssetTocEntry*)(base + sizeof(header));
+    size_t dataStart = sizeof(header) + (size_t)header.count * sizeof(AssetTocEntry);
+    for (uint16_t i = 0; i < header.count; i++) {
+        const AssetTocEntry& entry = entries[i];
+        if (entry.offset % 4 != 0 || entry.offset < dataStart || entry.size > header.total_size - entry.offset) {
+            Serial.printf("Assets: entry %u out of bounds, pack ignored.\n", i);
+            spi_flash_munmap(mapHandle);
+            return false;
+        }
+    }
+
+    pack = base;
+    toc = entries;
+    memset(&info, 0, sizeof(info));
+    info.mounted = true;
+    info.count = header.count;
+    info.size = header.total_size;
+    info.mount_us = micros() - start;
+    Serial.printf("Assets: %u entries, %lu bytes mapped in %lu us (CRC included).\n", header.count,
+                  (unsigned long)header.total_size, (unsigned long)info.mount_us);
+    return true;
+}
+
+/**
+ * @brief Drops the mapping and every font that points into it.
+ * Call with the display lock held.
+ */
+void assetPackUnmount() {
+    if (pack == nullptr) return;
+    if (info.fonts_loaded > 0) tft.setTextFont(1); // TFT_eSPI may still hold a pointer into the pack
+    pack = nullptr;
+    toc = nullptr;
+    fontCacheUsed = 0;
+    info.mounted = false;
+    info.fonts_loaded = 0;
+    info.font_bytes = 0;
+    spi_flash_munmap(mapHandle);
+}
+
+const AssetTocEntry* assetFind(const char* name, uint8_t type) {
+    if (pack == nullptr) return nullptr;
+    for (uint16_t i = 0; i < info.count; i++) {
+        if (toc[i].type == type && strncmp(toc[i].name, name, ASSET_NAME_LEN) == 0) return &toc[i];
+    }
+    return nullptr;
+}
+
+const AssetTocEntry* assetAt(uint16_t index) {
+    return (pack != nullptr && index < info.count) ? &toc[index] : nullptr;
+}
+
+const uint8_t* assetData(const AssetTocEntry& entry) {
+    return pack + entry.offset;
+}
+
+/**
+ * @brief Fills a GFXfont descriptor pointing at the glyph table and bitmap inside
+ * a font blob, after checking that both lie within it.
+ */
+static bool buildFont(const AssetTocEntry& entry, GFXfont& font) {
+    if (entry.size < sizeof(AssetFontHeader)) return false;
+    const uint8_t* blob = assetData(entry);
+    const AssetFontHeader* header = (const AssetFontHeader*)blob;
+    if (header->glyph_size != sizeof(GFXglyph) || header->first > header->last || header->glyph_offset % 4 != 0) {
+        return false;
+    }
+    size_t glyphBytes = (size_t)(header->last - header->first + 1) * sizeof(GFXglyph);
+    if (header->glyph_offset > entry.size || glyphBytes > entry.size - header->glyph_offset ||
+        header->bitmap_offset > entry.size || header->bitmap_size > entry.size - header->bitmap_offset) {
+        return false;
+    }
+    font.bitmap = (uint8_t*)(blob + header->bitmap_offset);
+    font.glyph = (GFXglyph*)(blob + header->glyph_offset);
+    font.first = header->first;
+    font.last = header->last;
+    font.yAdvance = header->y_advance;
+    info.font_bytes += glyphBytes + header->bitmap_size;
+    return true;
+}
+
+const GFXfont* assetFont(const char* name, const GFXfont* fallback) {
+    if (pack == nullptr) return fallback;
+    for (uint8_t i = 0; i < fontCacheUsed; i++) {
+        if (strcmp(fontCache[i].name, name) == 0) return fontCache[i].found ? &fontCache[i].font : fallback;
+    }
+    if (fontCacheUsed == FONT_CACHE_SIZE) return fallback;
+
+    unsigned long start = micros();
+    FontSlot& slot = fontCache[fontCacheUsed++];
+    strncpy(slot.name, name, ASSET_NAME_LEN);
+    slot.name[ASSET_NAME_LEN] = '\0';
+    const AssetTocEntry* entry = assetFind(name, ASSET_TYPE_FONT);
+    slot.found = entry != nullptr && buildFont(*entry, slot.font);
+    uint32_t elapsed = micros() - start;
+    info.lookups++;
+    info.lookup_us_total += elapsed;
+    if (slot.found) {
+        info.fonts_loaded++;
+        Serial.printf("Assets: font '%s' from pack (%u glyphs, lookup %lu us, %u bytes of RAM for the descriptor).\n",
+                      name, slot.font.last - slot.font.first + 1, (unsigned long)elapsed, (unsigned)sizeof(GFXfont));
+    } else if (entry != nullptr) {
+        Serial.printf("Assets: font '%s' is malformed or built for another GFXglyph layout.\n", name);
+    }
+    return slot.found ? &slot.font : fallback;
+}
+
+const AssetPackInfo& assetPackInfo() {
+    return info;
+}
+
+
+// --- UPLOAD (POST /assets) ---
+
+static void uploadFail(const char* message) {
+    if (upload.failed) return;
+    upload.failed = true;
+    strncpy(upload.error, message, sizeof(upload.error) - 1);
+    upload.error[sizeof(upload.error) - 1] = '\0';
+    Serial.printf("Assets: upload failed: %s\n", message);
+}
+
+/**
+ * @brief Erases whole sectors ahead of the write position, then writes.
+ */
+static bool writeAt(size_t offset, const uint8_t* data, size_t len) {
+    size_t end = offset + len;
+    if (end > upload.erased) {
+        size_t to = (end + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE * FLASH_SECTOR_SIZE;
+        if (esp_partition_erase_range(partition, upload.erased, to - upload.erased) != ESP_OK) return false;
+        upload.erased = to;
+    }
+    return esp_partition_write(partition, offset, data, len) == ESP_OK;
+}
+
+/**
+ * @brief Upload chunk handler (AsyncTCP task). Once the header is in and valid, the
+ * current pack is unmounted under the display lock, so loop() is not mid-draw with one of its fonts.
+ */
+static void handleAssetsUpload(AsyncWebServerRequest* request, const String& filename, size_t index,
+                               uint8_t* data, size_t len, bool final) {
+    if (index == 0) {
+        if (upload.active) {
+            return; // Another upload owns the partition; handleAssetsDone() answers 409
+        }
+        memset(&upload, 0, sizeof(upload));
+        upload.owner = request;
+        upload.active = true;
+        upload.startMs = millis();
+        request->onDisconnect([]() { upload.active = false; });
+        if (findPartition() == nullptr) {
+            uploadFail("no assets partition (flash with partitions.csv)");
+            return;
+        }
+    }
+    if (!upload.active || upload.owner != request || upload.failed) return;
+
+    // The header is collected (it may straddle chunks) and held back until the rest is in flash and verified
+    size_t skip = 0;
+    if (upload.bytes < sizeof(AssetPackHeader)) {
+        skip = min(len, sizeof(AssetPackHeader) - upload.bytes);
+        memcpy((uint8_t*)&upload.header + upload.bytes, data, skip);
+        upload.bytes += skip;
+        if (upload.bytes < sizeof(AssetPackHeader)) return;
+        if (!headerValid(upload.header, partition->size)) {
+            uploadFail("not an asset pack, wrong version or too large");
+            return;
+        }
+        if (!displayLockTakeFor(UPLOAD_LOCK_TIMEOUT_MS)) {
+            uploadFail("display busy, try again");
+            return;
+        }
+        assetPackUnmount();
+        themeLoad(); // The compiled themes held fonts (and maybe records) from the old pack
+        displayLockGive();
+        Serial.printf("Assets: receiving %s (%lu bytes).\n", filename.c_str(), (unsigned long)upload.header.total_size);
+    }
+    data += skip;
+    len -= skip;
+    if (len > upload.header.total_size - upload.bytes) {
+        uploadFail("upload larger than the pack header says");
+        return;
+    }
+    if (len > 0) {
+        upload.crc = esp_rom_crc32_le(upload.crc, data, len);
+        if (!writeAt(upload.bytes, data, len)) {
+            uploadFail("flash write failed");
+            return;
+        }
+    }
+    upload.bytes += len;
+
+    if (final) {
+        if (upload.bytes != upload.header.total_size) {
+            uploadFail("upload shorter than the pack header says");
+        } else if (upload.crc != upload.header.crc32) {
+            uploadFail("CRC mismatch");
+        } else if (!writeAt(0, (const uint8_t*)&upload.header, sizeof(upload.header))) {
+            uploadFail("flash write failed");
+        } else {
+            upload.complete = true;
+            remountPending = true;
+            Serial.printf("Assets: %u bytes written in %lu ms.\n", (unsigned)upload.bytes, millis() - upload.startMs);
+        }
+    }
+}
+
+static void handleAssetsDone(AsyncWebServerRequest* request) {
+    if (!upload.active || upload.owner != request) {
+        request->send(409, "text/plain", "Another asset upload is in progress");
+        return;
+    }
+    upload.active = false;
+    if (!upload.complete) {
+        if (!upload.failed) uploadFail("upload ended early");
+        request->send(400, "text/plain", String("Asset upload failed: ") + upload.error);
+        return;
+    }
+    request->send(200, "text/plain", "Asset pack installed: " + String(upload.header.count) + " entries, " +
+                                     String(upload.bytes) + " bytes. The display redraws with it now.");
+}
+
+void assetPackAttach(AsyncWebServer& server) {
+    server.on("/assets", HTTP_POST, handleAssetsDone, handleAssetsUpload);
+}
+
+bool serviceAssetPack() {
+    if (!remountPending) return false;
+    remountPending = false;
+    assetPackMount();
+    return true;
+}
@@ -0,0 +1,81 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <TFT_eSPI.h> // For GFXfont / GFXglyph
+
+class AsyncWebServer;
+
+// --- PACK FORMAT (built by tools/pack_assets.py, all fields little-endian) ---
+// [AssetPackHeader][AssetTocEntry x count][blobs, each 4-byte aligned]
+// The pack lives at the start of the "assets" data partition and is read in
+// place through esp_partition_mmap(): fonts point straight into flash.
+
+#define ASSET_PACK_MAGIC   0x50414346UL // "FCAP"
+#define ASSET_PACK_VERSION 1
+#define ASSET_NAME_LEN     16
+#define ASSET_PARTITION_LABEL   "assets"
+#define ASSET_PARTITION_SUBTYPE 0x40    // Custom data subtype (partitions.csv)
+
+enum : uint8_t {
+    ASSET_TYPE_RAW = 0,
+    ASSET_TYPE_FONT = 1,  // AssetFontHeader + GFXglyph table + bitmap (TFT_eSPI layout)
+    ASSET_TYPE_THEME = 2  // JSON theme record (ThemeHandler.h)
+};
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;        // Table of contents entries
+    uint32_t total_size;   // Header + table + blobs
+    uint32_t crc32;        // Of everything after the header
+} AssetPackHeader;
+
+typedef struct {
+    char name[ASSET_NAME_LEN]; // NUL-padded
+    uint8_t type;              // ASSET_TYPE_*
+    uint8_t reserved[3];
+    uint32_t offset;           // From the start of the pack
+    uint32_t size;
+} AssetTocEntry;
+
+typedef struct {
+    uint16_t first;        // Character range
+    uint16_t last;
+    uint8_t y_advance;
+    uint8_t glyph_size;    // sizeof(GFXglyph) the pack was built for
+    uint16_t reserved;
+    uint32_t glyph_offset; // From the start of the font blob
+    uint32_t bitmap_offset;
+    uint32_t bitmap_size;
+} AssetFontHeader;
+
+/**
+ * @brief Mount state for /status.
+ */
+typedef struct {
+    bool mounted;
+    uint16_t count;
+    uint32_t size;           // Bytes mapped
+    uint32_t mount_us;       // Header check, CRC and mapping
+    uint8_t fonts_loaded;    // Fonts currently served from the pack
+    uint32_t font_bytes;     // Their glyph tables and bitmaps (flash, not RAM)
+    uint32_t lookups;
+    uint32_t lookup_us_total;
+} AssetPackInfo;
+
+// --- FUNCTION PROTOTYPES ---
+bool assetPackMount();     // setup(): validates and maps the pack; false = compiled-in assets only
+void assetPackUnmount();   // Fonts fall back to the compiled-in ones
+const AssetTocEntry* assetFind(const char* name, uint8_t type);
+const AssetTocEntry* assetAt(uint16_t index); // nullptr past the end or when no pack is mounted
+const uint8_t* assetData(const AssetTocEntry& entry);
+// Font by name from the pack, or 'fallback' (also when no pack is mounted). Cached after the first call.
+const GFXfont* assetFont(const char* name, const GFXfont* fallback);
+const AssetPackInfo& assetPackInfo();
+
+void assetPackAttach(AsyncWebServer& server); // Registers POST /assets (pack upload)
+bool serviceAssetPack();                      // loop(): remounts after an upload; true = redraw needed
+
+#endif // ASSETPACK_H
@@ -9,17 +9,6 @@
 #include <WiFiClientSecure.h> 
 // #include <Preferences.h>      // REMOVED - Now included in ConfigHandler.h
 
-// CRITICAL: FS.h must be included before WebServer.h to prevent compiler errors
-#include <FS.h>
-using namespace fs;
-// ------------------------------------------------------------------------------------
-
-// --- WIFI MANAGER INCLUDES ---
-#include <DNSServer.h>
-#include <WebServer.h>
-#include <WiFiManager.h> 
-// -----------------------------
-
 #include "config.h"      
 #include "TouchHandler.h"
 #include "SleepHandler.h"
@@ -31,6 +20,19 @@ using namespace fs;
 #include "WeatherHandler.h"  
 #include "ConfigHandler.h"   
 #include "PortalHandler.h"   
+#include "ForecastHandler.h" 
+#include "SolarCalculator.h" 
+#include "TimezoneHandler.h" 
+#include "TimeSync.h" 
+#include "AlarmHandler.h" 
+#include "PowerProfile.h" 
+#include "StatusStream.h" 
+#include "Metrics.h" 
+#include "ScreenCapture.h" 
+#include "OtaUpdate.h" 
+#include "AssetPack.h" 
+#include "ThemeHandler.h" 
+#include "WifiConnect.h" 
 
 // --- EXTERN DECLARATIONS FOR TOUCH OBJECTS ---
 extern SPIClass touchSPI;
@@ -62,13 +64,9 @@ bool backlight_state = true;
 // ------------------------------------------------
 
 // --- DYNAMIC COLOR STATE ---
-static bool inverted_mode = false;
-// Tracks the current color theme (Normal/Inverted)
-uint16_t current_digit_color = COLOR_DARK_TEXT;
-uint16_t current_card_color = COLOR_CARD_NORMAL;
-uint16_t current_colon_color = COLOR_COLON_NORMAL;
-uint16_t current_icon_color = COLOR_ICON_NORMAL;
-uint16_t current_weather_text_color = COLOR_WEATHER_TEXT_NORMAL;
+bool inverted_mode = false; // Also read by the menu (theme button)
+// Tracks the current color theme (Normal = dark slot, Inverted = light slot);
+// the colors themselves are in currentTheme (ThemeHandler.h)
 // ------------------------------------------------
 
 // --- DIMENSIONS & WEATHER VARIABLES ---
@@ -80,7 +78,6 @@ const int COLON_X_ADJUSTMENT = -3;
 // Fine-tuning for colon horizontal position
 const int MAIN_TIME_WIDTH = (4 * DIGIT_WIDTH) + COLON_WIDTH + (3 * DIGIT_GAP);
 const int DIGIT_HEIGHT = 100;
-const int CARD_RADIUS = 10;
 const int DATE_HEIGHT = 40;
 const int DATE_VERTICAL_GAP = 7;
 const int DATE_FONT_BUILTIN = 4;
@@ -90,9 +87,16 @@ const int TOTAL_BLOCK_HEIGHT = DIGIT_HEIGHT + DATE_VERTICAL_GAP + DATE_HEIGHT;
 const int Y_OFFSET = ((DISPLAY_HEIGHT - TOTAL_BLOCK_HEIGHT) / 2) - 10;
 // Main Y-offset for the clock/date block, adjusted 10px up
 const int DATE_Y_OFFSET = Y_OFFSET + DIGIT_HEIGHT + DATE_VERTICAL_GAP;
+const int WEATHER_AREA_Y = DATE_Y_OFFSET + DATE_HEIGHT + 5;
+// Top of the weather block (current conditions or forecast strip)
+const int WEATHER_AREA_HEIGHT = DISPLAY_HEIGHT - WEATHER_AREA_Y;
+const int SETUP_BADGE_HEIGHT = 24;
+// Strip above the clock block (Y_OFFSET) used by the setup-mode badge
 float temperature = 0.0;
 float humidityPercent = 0.0;
 String weatherStatus = "Fetching...";
+uint16_t weatherConditionId = 0; // OWM condition code, resolved to icon/color via lookup table
+bool weatherIsDay = true;
 unsigned long lastWeatherUpdate = 0;
 bool weatherDataUpdated = false; // Flag to trigger a redraw of the weather
 String temperatureUnit = " ";
@@ -111,10 +115,14 @@ WeatherState current_weather_state = WEATHER_DISABLED;
 void setupTime();
 void drawSegment(const char* text, int xPos, int yPos, int width, uint16_t color, bool isCard);
 void drawStaticElements();
+void drawSetupBadge();    // "Setup mode" strip above the clock while the portal runs
 void updateTimeDisplay();
 void updateDateDisplay();
 void drawWeather();     
 void setModeColors(bool inverted);
+void applyTheme(bool inverted);  // setModeColors() + full redraw
+void serviceSolarEvents();       // Day/night icon and automatic theme at sunrise/sunset
+void applyConfigChanges(uint32_t changes); // Live apply of web/API settings changes
 void clearWeatherArea(); 
 void toggleBacklight();   // Toggles LED_PIN high/low
 void performFullReset();
@@ -126,70 +134,45 @@ void performFullReset();
 // ------------------------------------
 
 /**
- * @brief Sets all global color variables based on the inverted mode.
- * @param inverted True for light-on-dark, False for dark-on-light.
+ * @brief Selects the compiled light or dark theme (see ThemeHandler.h).
+ * @param inverted True for the light theme slot, False for the dark one.
  */
 void setModeColors(bool inverted) {
     inverted_mode = inverted;
-    if (inverted_mode) {
-        current_digit_color = COLOR_LIGHT_TEXT;
-        current_card_color = COLOR_CARD_INVERTED;
-        current_colon_color = COLOR_COLON_INVERTED;
-        current_icon_color = COLOR_ICON_INVERTED;
-        current_weather_text_color = COLOR_WEATHER_TEXT_INVERTED;
-    } else {
-        current_digit_color = COLOR_DARK_TEXT;
-        current_card_color = COLOR_CARD_NORMAL;
-        current_colon_color = COLOR_COLON_NORMAL;
-        current_icon_color = COLOR_ICON_NORMAL;
-        current_weather_text_color = COLOR_WEATHER_TEXT_NORMAL;
-    }
+    themeSelect(inverted);
 }
 
 /**
  * @brief Connects to WiFi and synchronizes time with NTP server.
- * Launches config portal if no WiFi is saved or connection fails.
+ * Opens the setup portal in the background if no WiFi is saved or connection fails.
  */
 void setupTime() {
-    const long gmtOffset_sec = userConfig.gmt_offset_hr * 3600;
-    const int daylightOffset_sec = DST_ACTIVE ?
-    3600 : 0;
-    
     // If no Wi-Fi config is saved, start the portal immediately.
     if (userConfig.ssid[0] == '\0') {
-        Serial.println("No Wi-Fi config saved. Starting Configuration Portal immediately.");
-        startConfigPortal(); 
-        setupTime(); // Recursive call to retry time setup
+        Serial.println("No Wi-Fi config saved. Starting setup portal.");
+        portalBegin(); // Returns at once; loop() runs it and syncs time once connected
         return;
     }
     
-    Serial.print("Attempting Wi-Fi connection...");
+    Serial.println("Attempting Wi-Fi connection...");
     tft.fillRect(0, 0, DISPLAY_WIDTH, 25, TFT_DARKGREY);
     tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
     tft.setTextDatum(TL_DATUM);
     tft.drawString("Connecting...", 5, 5, 2);
 
-    WiFi.begin(userConfig.ssid, userConfig.password);
-    
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-        delay(500);
-        Serial.print(".");
-        attempts++;
-    }
-
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println("\nWiFi connected.");
+    // Cached BSSID/channel (and lease) first, then known networks by RSSI; logs attempts and time
+    if (wifiConnect()) {
+        Serial.println("WiFi connected.");
         Serial.print("Local IP Address: ");
         Serial.println(WiFi.localIP()); 
         tft.fillRect(0, 0, DISPLAY_WIDTH, 25, TFT_DARKGREEN);
         tft.drawString("WiFi OK.", 5, 5, 2);
-        configTime(gmtOffset_sec, daylightOffset_sec, ntpServer);
-        Serial.println("Time synchronized with NTP.");
+        applyTimezone(); // Zone rule from the embedded table, or the manual GMT offset
+        timeSyncBegin(); // SNTP with server fallback; sync is confirmed asynchronously
+
     } else {
-        Serial.println("\nWiFi failed. Starting Configuration Portal.");
-        startConfigPortal(); 
-        setupTime(); // Recursive call to retry time setup
+        Serial.println("WiFi failed. Starting setup portal.");
+        portalBegin(); // Keeps retrying the saved network while nobody is configuring
         return;
     }
     
@@ -209,21 +192,22 @@ void drawSegment(const char* text, int xPos, int yPos, int width, uint16_t color
     
     if (isCard) {
         // Draw the rounded rectangle "card"
-        tft.fillRoundRect(xPos, yPos, width, DIGIT_HEIGHT, CARD_RADIUS, current_card_color);
+        tft.fillRoundRect(xPos, yPos, width, DIGIT_HEIGHT, currentTheme->card_radius, currentTheme->card);
     } else {
         // Erase the background (for the colon)
-        tft.fillRect(xPos, yPos, width, DIGIT_HEIGHT, COLOR_BACKGROUND);
+        tft.fillRect(xPos, yPos, width, DIGIT_HEIGHT, currentTheme->background);
     }
+    metricsNoteRedraw((uint32_t)width * DIGIT_HEIGHT);
 
     if (text[0] != '\0') {
         // Set text color and background (transparent if not a card)
         uint16_t textBgColor = isCard ?
-        current_card_color : COLOR_BACKGROUND;
+        currentTheme->card : currentTheme->background;
         tft.setTextColor(color, textBgColor); 
         tft.setTextDatum(MC_DATUM); // Middle-Center datum
         
-        if (CLOCK_FONT != NULL) {
-            tft.setFreeFont(CLOCK_FONT);
+        if (currentTheme->clock_font != NULL) {
+            tft.setFreeFont(currentTheme->clock_font);
         } else {
             tft.setTextFont(7);
             // Fallback to a large built-in font
@@ -249,7 +233,26 @@ void drawStaticElements() {
     if (x_start < 0) x_start = 0; 
     
     int colon_x = x_start + (2 * DIGIT_WIDTH) + (2 * DIGIT_GAP);
-    drawSegment(":", colon_x, Y_OFFSET, COLON_WIDTH, current_colon_color, false);
+    drawSegment(":", colon_x, Y_OFFSET, COLON_WIDTH, currentTheme->colon, false);
+    if (portalActive()) {
+        drawSetupBadge();
+    }
+}
+
+/**
+ * @brief Draws the "setup mode" badge above the clock while the portal runs,
+ * or clears its strip once provisioning is over.
+ */
+void drawSetupBadge() {
+    tft.fillRect(0, 0, DISPLAY_WIDTH, SETUP_BADGE_HEIGHT, currentTheme->background);
+    if (!portalActive()) return;
+    tft.setFreeFont(NULL);
+    tft.setTextDatum(ML_DATUM);
+    tft.fillRoundRect(4, 3, 46, SETUP_BADGE_HEIGHT - 6, 4, TFT_ORANGE);
+    tft.setTextColor(TFT_BLACK, TFT_ORANGE);
+    tft.drawString("SETUP", 8, SETUP_BADGE_HEIGHT / 2, 2);
+    tft.setTextColor(currentTheme->weather_text, currentTheme->background);
+    tft.drawString(portalBadgeText(), 56, SETUP_BADGE_HEIGHT / 2, 2);
 }
 
 /**
@@ -271,7 +274,7 @@ void updateTimeDisplay() {
         if (!isColon) {
              if (hasChanged || timeStringPrevious == "XX:XX") { // "XX:XX" forces full redraw
                 String digitStr = String(timeStringCurrent[i]);
-                drawSegment(digitStr.c_str(), x, Y_OFFSET, segmentWidth, current_digit_color, true);
+                drawSegment(digitStr.c_str(), x, Y_OFFSET, segmentWidth, currentTheme->digit, true);
              } 
         }
         
@@ -294,13 +297,14 @@ void updateDateDisplay() {
         int cardX = (DISPLAY_WIDTH - cardWidth) / 2;
         if (cardX < 0) cardX = 0;
         // Draw the date "card"
-        tft.fillRoundRect(cardX, DATE_Y_OFFSET, cardWidth, DATE_HEIGHT, CARD_RADIUS, current_card_color);
+        tft.fillRoundRect(cardX, DATE_Y_OFFSET, cardWidth, DATE_HEIGHT, currentTheme->card_radius, currentTheme->card);
+        metricsNoteRedraw((uint32_t)cardWidth * DATE_HEIGHT);
         
-        tft.setTextColor(current_digit_color, current_card_color);
+        tft.setTextColor(currentTheme->digit, currentTheme->card);
         tft.setTextDatum(MC_DATUM);
         
-        if (DATE_FONT_CUSTOM != NULL) {
-            tft.setFreeFont(DATE_FONT_CUSTOM);
+        if (currentTheme->date_font != NULL) {
+            tft.setFreeFont(currentTheme->date_font);
         } else {
             tft.setTextFont(DATE_FONT_BUILTIN);
             // Fallback
@@ -321,20 +325,48 @@ void updateDateDisplay() {
 void drawWeather() {
     // Only proceed if weather data is valid (i.e., not an error state)
     if (current_weather_state != WEATHER_OK) return;
-    char icon = getWeatherIcon(weatherStatus);
+
+    // Forecast views replace the current-conditions line once forecast data is available
+    if (userConfig.weather_view != WEATHER_VIEW_CURRENT && forecastCount() > 0) {
+        clearWeatherArea();
+        drawForecastStrip(WEATHER_AREA_Y, WEATHER_AREA_HEIGHT, true);
+        return;
+    }
+
+    // Primary location uses the globals (which keep stale data on errors); others use their record
+    uint16_t conditionId = weatherConditionId;
+    bool isDay = weatherIsDay;
+    float shownTemperature = temperature;
+    String shownStatus = weatherStatus;
+    if (weatherDisplayIndex > 0 && weatherRecordValid[weatherDisplayIndex]) {
+        const WeatherRecord& record = weatherRecords[weatherDisplayIndex];
+        conditionId = record.condition_id;
+        isDay = record.is_day;
+        shownTemperature = record.temperature;
+        shownStatus = record.description;
+    }
+
+    char icon = getWeatherIcon(conditionId, isDay);
     
     // 'temperature' is already in the correct unit (C or F) from fetchWeatherData
-    String tempDisplay = String((int)round(temperature));
+    String tempDisplay = String((int)round(shownTemperature));
     tempDisplay += temperatureUnit;
     
-    String statusTitleCase = toTitleCase(weatherStatus);
+    String statusTitleCase = toTitleCase(shownStatus);
     String combinedWeather = statusTitleCase;
-    // Truncate long weather descriptions
+    // Long weather descriptions fall back to the short label for the condition
     if (combinedWeather.length() > 18) {
-        combinedWeather = combinedWeather.substring(0, 17) + "...";
+        combinedWeather = getWeatherLabel(conditionId);
     }
     combinedWeather += " - " + tempDisplay;
 
+    // Several locations: prefix a short place name so the rotation is readable
+    if (weatherLocationCount > 1) {
+        String place = weatherRecords[weatherDisplayIndex].name;
+        if (place.length() > 10) place = place.substring(0, 10);
+        combinedWeather = place + ": " + combinedWeather;
+    }
+
     const int TEXT_VERTICAL_ADJUSTMENT = -7;
     const int ICON_TEXT_GAP = 20;            
     
@@ -348,7 +380,7 @@ void drawWeather() {
     tft.setTextFont(2);
     int textWidth = tft.textWidth(combinedWeather);
     
-    tft.setFreeFont(WEATHER_ICON_FONT);
+    tft.setFreeFont(currentTheme->icon_font);
     int iconWidth = tft.textWidth(String(icon));
     
     int totalWidth = iconWidth + ICON_TEXT_GAP + textWidth;
@@ -357,16 +389,16 @@ void drawWeather() {
 
     // 1. Draw Icon
     int iconXCenter = blockXStart + (iconWidth / 2);
-    tft.setFreeFont(WEATHER_ICON_FONT);
+    tft.setFreeFont(currentTheme->icon_font);
     
-    // === NEW LOGIC: Select color based on userConfig toggle ===
+    // === NEW LOGIC: Select color based on the theme's icon style ===
     uint16_t iconColor;
-    if (userConfig.use_multi_color_icons) { // <-- CHANGED
-        iconColor = getWeatherColor(weatherStatus); // Get specific color
+    if (currentTheme->multi_color_icons) {
+        iconColor = getWeatherColor(conditionId, isDay); // Get specific color
     } else {
-        iconColor = current_icon_color; // Get single fallback color
+        iconColor = currentTheme->icon; // Get single fallback color
     }
-    tft.setTextColor(iconColor, COLOR_BACKGROUND); 
+    tft.setTextColor(iconColor, currentTheme->background); 
     // ==========================================================
     
     tft.setTextDatum(MC_DATUM);
@@ -376,7 +408,7 @@ void drawWeather() {
     int textXCenter = iconXCenter + (iconWidth / 2) + ICON_TEXT_GAP + (textWidth / 2);
     tft.setFreeFont(NULL);
     tft.setTextFont(2);
-    tft.setTextColor(current_weather_text_color, COLOR_BACKGROUND);
+    tft.setTextColor(currentTheme->weather_text, currentTheme->background);
     tft.setTextDatum(MC_DATUM);
     tft.drawString(combinedWeather, textXCenter, weatherYCenter + TEXT_VERTICAL_ADJUSTMENT);
     
@@ -391,23 +423,111 @@ void drawWeather() {
  * @brief Clears the weather display area (bottom part of the screen).
  */
 void clearWeatherArea() {
-    int clearYStart = DATE_Y_OFFSET + DATE_HEIGHT + 5;
-    tft.fillRect(0, clearYStart, DISPLAY_WIDTH, 70, COLOR_BACKGROUND);
+    tft.fillRect(0, WEATHER_AREA_Y, DISPLAY_WIDTH, 70, currentTheme->background);
+    metricsNoteRedraw((uint32_t)DISPLAY_WIDTH * 70);
     Serial.println("Weather area cleared.");
 }
 
+/**
+ * @brief Switches the colour theme and redraws the whole screen.
+ * @param inverted True for the light theme, False for the dark theme.
+ */
+void applyTheme(bool inverted) {
+    unsigned long switchStartUs = micros();
+    setModeColors(inverted);
+    // Force full redraw
+    tft.fillScreen(currentTheme->background);
+    metricsNoteRedraw((uint32_t)DISPLAY_WIDTH * DISPLAY_HEIGHT);
+    drawStaticElements();
+    timeStringPrevious = "XX:XX";
+    dateStringPrevious = "XX XXX XXXX";
+    updateTimeDisplay();
+    updateDateDisplay();
+    
+    // Redraw weather conditionally
+    if (current_weather_state == WEATHER_OK) {
+        drawWeather();
+    } else {
+        clearWeatherArea();
+    }
+    themeNoteSwitch(micros() - switchStartUs);
+    Serial.printf("Theme '%s' drawn in %lu us.\n", currentTheme->name, (unsigned long)themeStats().switch_us);
+}
+
+/**
+ * @brief Follows sunrise/sunset at the configured coordinates (checked once a minute).
+ * Flips the day/night weather icon and, if enabled, the theme. A manual tap
+ * overrides the theme until the next sunrise or sunset.
+ */
+void serviceSolarEvents() {
+    static unsigned long lastSolarCheck = 0;
+    static int8_t lastDaytime = -1; // -1 = not known yet
+    
+    if (lastSolarCheck != 0 && millis() - lastSolarCheck < 60000UL) return;
+    lastSolarCheck = millis();
+    if (!solarClockValid()) return;
+    
+    bool daytime = solarIsDaytime(weatherIsDay);
+    if (daytime == lastDaytime) return;
+    bool firstCheck = (lastDaytime < 0);
+    lastDaytime = daytime;
+    
+    if (weatherIsDay != daytime) {
+        weatherIsDay = daytime;
+        weatherDataUpdated = true; // Sun/moon glyph and colour change
+    }
+    
+    if (userConfig.auto_theme && inverted_mode != daytime) {
+        Serial.printf("Solar event: %s, switching to %s theme.\n", firstCheck ? "startup" : (daytime ? "sunrise" : "sunset"),
+                      daytime ? "light" : "dark");
+        applyTheme(daytime); // Light (inverted) theme by day
+    }
+}
+
+/**
+ * @brief Applies settings changed from the web API without a restart.
+ * @param changes CONFIG_CHANGE_* flags from configSetField().
+ */
+void applyConfigChanges(uint32_t changes) {
+    Serial.printf("Applying settings live (changes 0x%02lx).\n", (unsigned long)changes);
+    if (changes & CONFIG_CHANGE_TIMEZONE) {
+        applyTimezone();    // setenv("TZ") + tzset()
+        rescheduleAlarms(); // Local fire times moved
+    }
+    if (changes & CONFIG_CHANGE_WEATHER) {
+        resetWeatherSchedule(); // Refetched on the next loop pass
+    }
+    if (changes & CONFIG_CHANGE_FORECAST) {
+        resetForecast();
+    }
+    if (changes & (CONFIG_CHANGE_REDRAW | CONFIG_CHANGE_THEME | CONFIG_CHANGE_TIMEZONE)) {
+        themeLoad(); // Selection or icon style may have changed; recompiled here, never while drawing
+        bool inverted = inverted_mode;
+        if (userConfig.auto_theme && solarClockValid()) {
+            inverted = solarIsDaytime(weatherIsDay); // Light theme by day
+        }
+        if (backlight_state) {
+            applyTheme(inverted);
+        } else {
+            setModeColors(inverted); // Drawn when the backlight comes back on
+        }
+    }
+}
+
 /**
  * @brief Toggles the display backlight ON/OFF.
  * If turning ON, forces a full screen redraw.
  */
 void toggleBacklight() {
+    powerRestoreBacklight(); // Leave PWM dimming so digitalWrite() drives the pin
     backlight_state = !backlight_state;
     if (backlight_state) {
         // --- Turn ON ---
         digitalWrite(LED_PIN, HIGH);
         // Treat turning on as activity to prevent immediate sleep
         lastActivityTime = millis();
-        tft.fillScreen(COLOR_BACKGROUND); 
+        tft.fillScreen(currentTheme->background); 
+        metricsNoteRedraw((uint32_t)DISPLAY_WIDTH * DISPLAY_HEIGHT);
         
         // Force a full redraw of time and date by resetting previous values
         timeStringPrevious = "XX:XX";
@@ -449,10 +569,10 @@ void performFullReset() {
     tft.drawString("WIPING ALL SETTINGS", DISPLAY_WIDTH / 2, 100);
     tft.setTextFont(2); 
     tft.drawString("Rebooting to start Configuration Portal...", DISPLAY_WIDTH / 2, 140);
-    // 2. Wipe WiFiManager's stored credentials
-    WiFiManager wm;
-    wm.resetSettings();
-    Serial.println("WiFiManager Settings Wiped.");
+    // 2. Wipe the Wi-Fi credentials the radio keeps in its own NVS, and the connect cache
+    WiFi.disconnect(true, true);
+    wifiCacheClear();
+    Serial.println("Wi-Fi Settings Wiped.");
     // 3. Delete ALL saved settings in our custom namespace
     preferences.begin(PREF_NAMESPACE, false);
     preferences.clear();
@@ -468,8 +588,12 @@ void performFullReset() {
 
 void setup() {
     Serial.begin(115200);
+    displayLockInit();
+    displayLockTake(); // Released at the end of setup(); loop() re-takes it each pass
     if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_EXT1) {
         Serial.println("Woke up from deep sleep (Touch Event)");
+    } else if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER) {
+        Serial.println("Woke up from deep sleep (Timer: alarm or end of quiet hours)");
     } else {
         Serial.println("Power-on or Reset");
     }
@@ -483,28 +607,36 @@ void setup() {
     
     loadConfig(); 
     // CRITICAL: Load configuration immediately
+    
+    loadAlarms();
+    applyTimezone();      // Local time is valid straight after deep sleep
+    powerNoteWake();      // Book the time spent in deep sleep
+    timeSyncApplyDrift(); // Correct the RTC for the drift accumulated while asleep
 
     tft.init();
     tft.setRotation(1); 
     tft.fillScreen(COLOR_BACKGROUND);
+    assetPackMount(); // Fonts from the asset partition, if one was uploaded
+    themeLoad();      // Validates and compiles the selected dark/light themes
     // Initialize Touchscreen
     touchSPI.begin(TS_CLK, TS_MISO, TS_MOSI, -1);
     ts.begin(touchSPI);
     
+    metricsBegin(); // Before the first connection, so reconnects are counted from here on
     setupTime();
     // Connect to WiFi and get NTP time
 
-    // Start Web Server for Direct IP Configuration (if connected)
-    if (WiFi.status() == WL_CONNECTED) {
-        startConfigServer();
-    }
+    // Start Web Server for Direct IP Configuration (on the network, or on the setup AP)
+    startConfigServer();
+    otaConfirmBoot(); // Boot after an update: display/NVS self-test, roll back on failure
 
     setModeColors(false); // Set initial theme to normal
 
-    tft.fillScreen(COLOR_BACKGROUND); 
+    tft.fillScreen(currentTheme->background); 
     
     drawStaticElements();
     // Draw the colon
+    resetWeatherSchedule(); // millis() restarted, so the RTC-kept schedule must fetch now
     fetchWeatherData(); // Initial fetch sets current_weather_state
 
     if (current_weather_state == WEATHER_OK) {
@@ -519,38 +651,119 @@ void setup() {
     timeStringCurrent = "";
     dateStringPrevious = "XX XXX XXXX";
     dateStringCurrent = "";
+    displayLockGive();
 }
 
 void loop() {
+    unsigned long loopStartUs = micros();
+    displayLockTake(); // The panel is ours until the idle delay (see ScreenCapture.h)
+    serviceOtaVerdict(); // New image on trial: keep it once Wi-Fi is up, or boot the old one (never draws)
+    bool alarmClosedMenu = false;
+
+    if (menuActive()) {
+        // The menu owns the screen and the touch panel. Anything that could draw
+        // (web actions, weather) waits until it closes, as it always has; settings
+        // saves, the portal and time sync keep running, and a due alarm closes the
+        // menu so the clock pass below rings it.
+        serviceConfigStore();
+        servicePortal(); // Its badge is part of the clock face, redrawn when the menu closes
+        if (WiFi.status() == WL_CONNECTED) {
+            timeSyncService();
+            wifiCacheService();
+        }
+        if (alarmDue(time(nullptr))) {
+            menuDismiss();
+            alarmClosedMenu = true; // Rung below even within the minute already ticked
+        } else {
+            checkTouch(&touchEvent); // Tracks the press; the menu reads isTouched/touchX/touchY
+            if (touchEvent != 0) metricsNoteTouch(touchEvent);
+            touchEvent = 0;
+            serviceMenu(isTouched, touchX, touchY);
+            if (!menuActive()) {
+                // Widgets act on release; the tap that closed the menu must not also count as a clock tap
+                pressCount = 0;
+                lastPressTime = 0;
+            }
+            metricsNoteLoop(micros() - loopStartUs); // Menu passes are loop passes too (diagnostics percentiles)
+            displayLockGive();
+            delay(MENU_POLL_MS);
+            return;
+        }
+    }
     
-    // Handle any incoming web requests (like the /config URL)
+    // Web requests are served asynchronously; run what they asked of the main task
+    serviceWebActions();
+    serviceConfigStore(); // Writes coalesced settings saves once they settle
+    if (serviceAssetPack()) {
+        applyConfigChanges(CONFIG_CHANGE_REDRAW); // A new pack was uploaded: redraw with its fonts
+    }
+    if (servicePortal() && backlight_state) {
+        drawSetupBadge(); // Provisioning moved on (connecting, joined, closed)
+    }
+    if (portalActive()) {
+        // Whoever is provisioning talks to the AP, not the touch screen: keep the clock
+        // awake so neither the sleep timeout nor a deep-sleep quiet-hours window drops it
+        lastActivityTime = millis();
+    } else {
+        wifiRoamService(); // Weak signal: stronger access point; lost: the other known networks
+    }
     if (WiFi.status() == WL_CONNECTED) {
-        server.handleClient();
+        timeSyncService(); // Offset/drift bookkeeping and NTP server fallback
+        wifiCacheService(); // Dates a lease obtained before the first sync, renews a reused one when due
     }
     
     struct tm timeinfo;
-    if(!getLocalTime(&timeinfo)){
+    // While the portal runs, never wait for the time: the clock keeps drawing either way
+    bool timeValid = getLocalTime(&timeinfo, portalActive() ? 0 : 5000);
+    if (!timeValid && !portalActive()) {
         Serial.println("Failed to obtain time. Retrying WiFi/NTP setup.");
         delay(1000);
         setupTime();
         // Attempt to re-establish connection and time
-        tft.fillScreen(COLOR_BACKGROUND);
+        tft.fillScreen(currentTheme->background);
         // Clear screen for redraw
+        displayLockGive();
         return;
         // Skip this loop iteration
     }
     
-    // Format the current time string
-    char timeBuffer[6];
-    const char *timeFormat = userConfig.time_format_24h ? "%R" : "%I:%M"; // %R = HH:MM (24h), %I:%M = hh:MM (12h)
-    strftime(timeBuffer, 6, timeFormat, &timeinfo);
-    timeStringCurrent = String(timeBuffer);
+    if (timeValid) {
+        // Format the current time string
+        char timeBuffer[6];
+        const char *timeFormat = userConfig.time_format_24h ? "%R" : "%I:%M"; // %R = HH:MM (24h), %I:%M = hh:MM (12h)
+        strftime(timeBuffer, 6, timeFormat, &timeinfo);
+        timeStringCurrent = String(timeBuffer);
+        
+        // Format the current date string
+        char dateBuffer[20];
+        const char *dateFormat = "%a, %b %d, %Y"; // e.g., "Mon, Sep 30, 2024"
+        strftime(dateBuffer, 20, dateFormat, &timeinfo);
+        dateStringCurrent = String(dateBuffer);
+    } else {
+        // Never synced (first boot in setup mode): placeholders until the portal gets us online
+        timeStringCurrent = "--:--";
+        dateStringCurrent = "Setup mode";
+    }
     
-    // Format the current date string
-    char dateBuffer[20];
-    const char *dateFormat = "%a, %b %d, %Y"; // e.g., "Mon, Sep 30, 2024"
-    strftime(dateBuffer, 20, dateFormat, &timeinfo);
-    dateStringCurrent = String(dateBuffer);
+    // --- Alarms: evaluated on the minute tick (and at once when one closed the menu) ---
+    static int lastAlarmMinute = -1;
+    if (timeValid && (timeinfo.tm_min != lastAlarmMinute || alarmClosedMenu)) {
+        lastAlarmMinute = timeinfo.tm_min;
+        serviceAlarms(time(nullptr));
+    }
+    if (alarmAlertActive()) {
+        // The alert owns the screen and the touch panel until it is dismissed or snoozed
+        checkTouch(&touchEvent);
+        if (touchEvent != 0) lastActivityTime = millis();
+        bool closed = alarmHandleTouch(touchEvent, touchX, touchY) || serviceAlarmAlert();
+        touchEvent = 0;
+        if (closed) {
+            applyTheme(inverted_mode); // Full clock redraw
+        }
+        displayLockGive();
+        delay(50);
+        return;
+    }
     
     // Update display elements (only redraws if changed)
     updateTimeDisplay();
@@ -570,11 +783,29 @@ void loop() {
         // Reset flag
     }
 
+    // Sunrise/sunset: day/night icon and optional automatic theme
+    serviceSolarEvents();
+
+    // Multi-location: rotate the current-conditions block on a timer
+    static unsigned long lastWeatherRotate = 0;
+    if (weatherLocationCount > 1 && userConfig.weather_view == WEATHER_VIEW_CURRENT &&
+        millis() - lastWeatherRotate >= WEATHER_ROTATE_INTERVAL_MS) {
+        lastWeatherRotate = millis();
+        advanceWeatherLocation(1); // Sets weatherDataUpdated; drawn on the next pass
+    }
+
+    // Forecast strip: fetch, scroll and redraw changed cells (no-op in current-conditions view)
+    if (current_weather_state == WEATHER_OK && backlight_state) {
+        serviceForecastStrip(WEATHER_AREA_Y, WEATHER_AREA_HEIGHT);
+    }
+
     // --- Handle Touch Events ---
     checkTouch(&touchEvent);
     if (touchEvent != 0) {
         lastActivityTime = millis();
         // Any touch resets the sleep timer
+        statusStreamNoteTouch(touchEvent);
+        metricsNoteTouch(touchEvent);
     }
 
     if (touchEvent == 1) {
@@ -582,21 +813,7 @@ void loop() {
         
         // Only toggle colors if the backlight is ON
         if (backlight_state) { 
-            setModeColors(!inverted_mode);
-            // Force full redraw
-            tft.fillScreen(COLOR_BACKGROUND);
-            drawStaticElements();
-            timeStringPrevious = "XX:XX";
-            dateStringPrevious = "XX XXX XXXX";
-            updateTimeDisplay();
-            updateDateDisplay();
-            
-            // Redraw weather conditionally
-            if (current_weather_state == WEATHER_OK) {
-                drawWeather();
-            } else {
-                clearWeatherArea();
-            }
+            applyTheme(!inverted_mode);
             
             Serial.print("Main Loop Action: Single Press - Color mode toggled to ");
             Serial.println(inverted_mode ? "INVERTED" : "NORMAL");
@@ -615,9 +832,9 @@ void loop() {
             toggleBacklight(); // Wake up screen first
         }
         
-        showMenu(); // Show the main settings menu
+        showMenu(); // Draws the menu; loop() runs it from the next pass
         
-        // Menu function handles redrawing the screen on exit
+        // serviceMenu() redraws the clock when it closes
         touchEvent = 0;
         
     } else if (touchEvent == 3) { 
@@ -627,6 +844,23 @@ void loop() {
         toggleBacklight(); // Toggles screen on or off
         
         touchEvent = 0;
+
+    } else if (touchEvent == 4) {
+        // === Swipe: Next / Previous Weather Location ===
+        
+        if (backlight_state) {
+            Serial.printf("Main Loop Action: Swipe - Weather location %+d.\n", swipeDirection);
+            advanceWeatherLocation(swipeDirection);
+        } else {
+            toggleBacklight();
+        }
+        
+        touchEvent = 0;
+    }
+
+    // --- Quiet Hours: dim / backlight off / timed deep sleep ---
+    if (timeValid) {
+        servicePowerProfile(timeinfo);
     }
 
     // --- Check for Deep Sleep ---
@@ -638,5 +872,10 @@ void loop() {
     // --- End of loop housekeeping ---
     timeStringPrevious = timeStringCurrent;
     dateStringPrevious = dateStringCurrent;
+    uint32_t loopBusyUs = micros() - loopStartUs;
+    statusStreamNoteLoop(loopBusyUs);
+    metricsNoteLoop(loopBusyUs);      // Latency histogram for /metrics
+    serviceStatusStream(); // Live frames for /events subscribers (no-op without clients)
+    displayLockGive();     // Screenshots read the panel during the delay
     delay(100); // Small delay to prevent spamming
 }
\ No newline at end of file
@@ -1,56 +1,238 @@
 #include "ConfigHandler.h"
 #include "UserConfig.h" // For userConfig_t and PREF_NAMESPACE
 #include "config.h"     // For default values like TIME_FORMAT_24H, USE_FAHRENHEIT
+#include "ForecastHandler.h" // For WEATHER_VIEW_CURRENT
+#include "WeatherProvider.h" // For WEATHER_PROVIDER_OPENWEATHER
+#include "PowerProfile.h"    // For POWER_MODE_BACKLIGHT_OFF
+#include "TimezoneHandler.h" // For findTimezone()
+#include "ConfigStore.h"     // Per-field NVS storage behind loadConfig()/saveConfig()
+#include "ThemeHandler.h"    // For themeExists()
 
 #include <Arduino.h>    // For Serial.println/printf and strncpy
+#include <IPAddress.h>  // For validating static IP fields
 
 // --- INSTANTIATION OF GLOBALS ---
 // These variables are defined here (ConfigHandler.cpp)
 userConfig_t userConfig;
 Preferences preferences;
-#define CONFIG_KEY "userConfig"
 
 
 /**
- * @brief Loads the configuration struct from NVS.
+ * @brief Loads the configuration (per-field NVS keys, see ConfigStore.h).
  */
 void loadConfig() {
-    preferences.begin(PREF_NAMESPACE, true); // Read-only mode 
-    size_t bytesRead = preferences.getBytes(CONFIG_KEY, &userConfig, sizeof(userConfig));
-    preferences.end();
-    
-    if (bytesRead == 0 || bytesRead != sizeof(userConfig)) {
-        Serial.println("No saved config found or size mismatch. Setting fresh install defaults.");
-        // Set all critical defaults here
-        userConfig.gmt_offset_hr = -5; // Default to New York time zone
-        userConfig.sleep_timeout_min = 5; // Default sleep timeout to 5 minutes
-        
-        userConfig.time_format_24h = TIME_FORMAT_24H;
-        userConfig.use_fahrenheit = USE_FAHRENHEIT;
-        
-        userConfig.use_multi_color_icons = true; // <-- ADDED DEFAULT
+    configStoreLoad();
+}
+
+/**
+ * @brief Saves the configuration. Writes are coalesced and only changed keys
+ * are written; call configStoreFlush() before a restart or deep sleep.
+ */
+void saveConfig() {
+    configStoreRequestSave();
+}
+
 
-        userConfig.use_city_id_mode = false;
-        // Set default location: New York, US
-        strncpy(userConfig.weather_city, "New York", sizeof(userConfig.weather_city) - 1);
-        strncpy(userConfig.weather_country_code, "US", sizeof(userConfig.weather_country_code) - 1);
+// --- FIELD VALIDATION ---
+
+/**
+ * @brief Parses a whole decimal integer ("-5", "300"); rejects empty or trailing text.
+ */
+static bool parseLong(const String& text, long& out) {
+    char* end = nullptr;
+    out = strtol(text.c_str(), &end, 10);
+    return text.length() > 0 && end != nullptr && *end == '\0';
+}
+
+template <typename T>
+static bool setNumber(T& field, const String& text, long minValue, long maxValue, uint32_t flags, uint32_t& changes) {
+    long value;
+    if (!parseLong(text, value) || value < minValue || value > maxValue) return false;
+    if (field != (T)value) {
+        field = (T)value;
+        changes |= flags;
+    }
+    return true;
+}
 
-        // Ensure API key and Wi-Fi credentials are empty to trigger the config portal
-        userConfig.weather_api_key[0] = '\0';
-        userConfig.ssid[0] = '\0';
-        userConfig.password[0] = '\0';
+static bool setFloat(float& field, const String& text, float minValue, float maxValue, uint32_t flags, uint32_t& changes) {
+    char* end = nullptr;
+    float value = strtof(text.c_str(), &end);
+    if (text.length() == 0 || *end != '\0' || value < minValue || value > maxValue) return false;
+    if (field != value) {
+        field = value;
+        changes |= flags;
+    }
+    return true;
+}
 
-    } else {
-        Serial.printf("Config loaded successfully (%u bytes).\n", bytesRead);
+static bool setText(char* field, size_t size, const String& text, uint32_t flags, uint32_t& changes) {
+    String trimmed = text;
+    trimmed.trim();
+    if (trimmed.length() >= size) return false;
+    if (strcmp(field, trimmed.c_str()) != 0) {
+        memset(field, 0, size);
+        strncpy(field, trimmed.c_str(), size - 1);
+        changes |= flags;
     }
+    return true;
 }
 
 /**
- * @brief Saves the configuration struct to NVS.
+ * @brief Dotted IPv4 address, empty = unset.
  */
-void saveConfig() {
-    preferences.begin(PREF_NAMESPACE, false); // Read/Write mode
-    size_t bytesWritten = preferences.putBytes(CONFIG_KEY, &userConfig, sizeof(userConfig));
-    preferences.end();
-    Serial.printf("Configuration saved to NVS. Bytes written: %u\n", bytesWritten);
-}
\ No newline at end of file
+static bool setAddress(char* field, size_t size, const String& text, uint32_t flags, uint32_t& changes) {
+    String trimmed = text;
+    trimmed.trim();
+    IPAddress address;
+    if (trimmed.length() > 0 && !address.fromString(trimmed)) return false;
+    return setText(field, size, trimmed, flags, changes);
+}
+
+/**
+ * @brief "HH:MM" into hour/minute fields.
+ */
+static bool setClockTime(uint8_t& hour, uint8_t& minute, const String& text, uint32_t flags, uint32_t& changes) {
+    long h, m;
+    if (text.length() != 5 || text[2] != ':' || !parseLong(text.substring(0, 2), h) || !parseLong(text.substring(3, 5), m) ||
+        h < 0 || h > 23 || m < 0 || m > 59) {
+        return false;
+    }
+    if (hour != h || minute != m) {
+        hour = h;
+        minute = m;
+        changes |= flags;
+    }
+    return true;
+}
+
+/**
+ * @brief Extra location: all digits = City ID, otherwise "City,CC", empty = unused.
+ */
+static bool setExtraLocation(weatherLocation_t& loc, const String& text, uint32_t flags, uint32_t& changes) {
+    weatherLocation_t parsed;
+    memset(&parsed, 0, sizeof(parsed));
+    String value = text;
+    value.trim();
+
+    bool allDigits = value.length() > 0;
+    for (unsigned int c = 0; c < value.length(); c++) {
+        if (!isDigit(value[c])) { allDigits = false; break; }
+    }
+    if (allDigits) {
+        if (value.length() >= sizeof(parsed.city_id)) return false;
+        strncpy(parsed.city_id, value.c_str(), sizeof(parsed.city_id) - 1);
+    } else if (value.length() > 0) {
+        int comma = value.indexOf(',');
+        String city = (comma >= 0) ? value.substring(0, comma) : value;
+        String country = (comma >= 0) ? value.substring(comma + 1) : String("");
+        city.trim();
+        country.trim();
+        if (city.length() >= sizeof(parsed.city) || country.length() >= sizeof(parsed.country_code)) return false;
+        strncpy(parsed.city, city.c_str(), sizeof(parsed.city) - 1);
+        strncpy(parsed.country_code, country.c_str(), sizeof(parsed.country_code) - 1);
+    }
+    if (memcmp(&loc, &parsed, sizeof(loc)) != 0) {
+        loc = parsed;
+        changes |= flags;
+    }
+    return true;
+}
+
+/**
+ * @brief Extra Wi-Fi networks "wssid<i>" / "wpass<i>" (i = 1..WIFI_EXTRA_NETWORKS).
+ * An empty password leaves the stored one (it is never sent back); an empty ssid frees the slot.
+ */
+static bool setNetworkField(userConfig_t& config, const char* key, const String& value, uint32_t& changes) {
+    bool isSsid = strncmp(key, "wssid", 5) == 0;
+    const char* number = key + 5; // Both prefixes are five characters
+    if (number[0] < '1' || number[0] >= '1' + WIFI_EXTRA_NETWORKS || number[1] != '\0') return false;
+    wifiCredential_t& network = config.extra_networks[number[0] - '1'];
+    if (!isSsid) {
+        if (value.length() == 0) return true;
+        if (value.length() >= sizeof(network.password)) return false;
+        if (strcmp(network.password, value.c_str()) != 0) {
+            memset(network.password, 0, sizeof(network.password));
+            strncpy(network.password, value.c_str(), sizeof(network.password) - 1);
+            changes |= CONFIG_CHANGE_STORED;
+        }
+        return true;
+    }
+    if (!setText(network.ssid, sizeof(network.ssid), value, CONFIG_CHANGE_STORED, changes)) return false;
+    if (network.ssid[0] == '\0' && network.password[0] != '\0') {
+        memset(network.password, 0, sizeof(network.password));
+        changes |= CONFIG_CHANGE_STORED;
+    }
+    return true;
+}
+
+/**
+ * @brief Quiet-hours fields "p<i>s", "p<i>e", "p<i>days", "p<i>m", "p<i>dim", "p<i>wf".
+ */
+static bool setProfileField(userConfig_t& config, const char* key, const String& value, uint32_t& changes) {
+    int index = key[1] - '0';
+    if (index < 0 || index >= POWER_PROFILE_COUNT) return false;
+    powerProfile_t& profile = config.power_profiles[index];
+    const char* field = key + 2;
+
+    if (strcmp(field, "s") == 0)    return setClockTime(profile.start_hour, profile.start_minute, value, CONFIG_CHANGE_STORED, changes);
+    if (strcmp(field, "e") == 0)    return setClockTime(profile.end_hour, profile.end_minute, value, CONFIG_CHANGE_STORED, changes);
+    if (strcmp(field, "days") == 0) return setNumber(profile.weekdays, value, 0, 0x7F, CONFIG_CHANGE_STORED, changes);
+    if (strcmp(field, "m") == 0)    return setNumber(profile.mode, value, 0, POWER_MODE_COUNT - 1, CONFIG_CHANGE_STORED, changes);
+    if (strcmp(field, "dim") == 0)  return setNumber(profile.dim_percent, value, 1, 100, CONFIG_CHANGE_STORED, changes);
+    if (strcmp(field, "wf") == 0)   return setNumber(profile.weather_factor, value, 1, 10, CONFIG_CHANGE_STORED, changes);
+    return false;
+}
+
+bool configSetField(userConfig_t& config, const char* key, const String& value, uint32_t& changes) {
+    const uint32_t WEATHER = CONFIG_CHANGE_WEATHER | CONFIG_CHANGE_FORECAST;
+
+    if (strcmp(key, "apikey") == 0)    return setText(config.weather_api_key, sizeof(config.weather_api_key), value, WEATHER, changes);
+    if (strcmp(key, "city") == 0)      return setText(config.weather_city, sizeof(config.weather_city), value, WEATHER, changes);
+    if (strcmp(key, "country") == 0)   return setText(config.weather_country_code, sizeof(config.weather_country_code), value, WEATHER, changes);
+    if (strcmp(key, "city_id") == 0) {
+        if (!setText(config.weather_city_id, sizeof(config.weather_city_id), value, WEATHER, changes)) return false;
+        config.use_city_id_mode = config.weather_city_id[0] != '\0';
+        return true;
+    }
+    if (strcmp(key, "provider") == 0)  return setNumber(config.weather_provider, value, 0, 2, WEATHER, changes);
+    if (strcmp(key, "lat") == 0)       return setFloat(config.latitude, value, -90.0f, 90.0f, WEATHER, changes);
+    if (strcmp(key, "lon") == 0)       return setFloat(config.longitude, value, -180.0f, 180.0f, WEATHER, changes);
+    if (strcmp(key, "quota") == 0)     return setNumber(config.weather_daily_quota, value, 0, 65535, CONFIG_CHANGE_STORED, changes);
+    if (strncmp(key, "loc", 3) == 0 && key[3] >= '1' && key[3] < '1' + WEATHER_EXTRA_LOCATIONS && key[4] == '\0') {
+        return setExtraLocation(config.extra_locations[key[3] - '1'], value, CONFIG_CHANGE_WEATHER, changes);
+    }
+    if (strcmp(key, "tempunit") == 0)  return setNumber(config.use_fahrenheit, value, 0, 1, WEATHER | CONFIG_CHANGE_REDRAW, changes);
+    if (strcmp(key, "iconcolor") == 0) return setNumber(config.use_multi_color_icons, value, 0, 1, CONFIG_CHANGE_REDRAW, changes);
+    if (strcmp(key, "autotheme") == 0) return setNumber(config.auto_theme, value, 0, 1, CONFIG_CHANGE_THEME, changes);
+    if (strcmp(key, "themedark") == 0 || strcmp(key, "themelight") == 0) {
+        String name = value;
+        name.trim();
+        if (!themeExists(name.c_str())) return false;
+        char* slot = (key[5] == 'd') ? config.theme_dark : config.theme_light;
+        return setText(slot, sizeof(config.theme_dark), name, CONFIG_CHANGE_THEME, changes);
+    }
+    if (strcmp(key, "wview") == 0)     return setNumber(config.weather_view, value, 0, 2, CONFIG_CHANGE_REDRAW | CONFIG_CHANGE_FORECAST, changes);
+    if (strcmp(key, "timefmt") == 0)   return setNumber(config.time_format_24h, value, 0, 1, CONFIG_CHANGE_REDRAW, changes);
+    if (strcmp(key, "tz") == 0) {
+        // Only names from the embedded table (or empty = manual offset) are accepted
+        if (value.length() > 0 && findTimezone(value.c_str()) == nullptr) return false;
+        return setText(config.tz_name, sizeof(config.tz_name), value, CONFIG_CHANGE_TIMEZONE, changes);
+    }
+    if (strcmp(key, "gmt") == 0)       return setNumber(config.gmt_offset_hr, value, -12, 14, CONFIG_CHANGE_TIMEZONE, changes);
+    if (strncmp(key, "wssid", 5) == 0 || strncmp(key, "wpass", 5) == 0) return setNetworkField(config, key, value, changes);
+    // Static IP: used from the next connection on
+    if (strcmp(key, "sip") == 0)       return setAddress(config.static_ip, sizeof(config.static_ip), value, CONFIG_CHANGE_STORED, changes);
+    if (strcmp(key, "sgw") == 0)       return setAddress(config.static_gateway, sizeof(config.static_gateway), value, CONFIG_CHANGE_STORED, changes);
+    if (strcmp(key, "smask") == 0)     return setAddress(config.static_subnet, sizeof(config.static_subnet), value, CONFIG_CHANGE_STORED, changes);
+    if (strcmp(key, "sdns") == 0)      return setAddress(config.static_dns, sizeof(config.static_dns), value, CONFIG_CHANGE_STORED, changes);
+    if (strcmp(key, "sleeptmo") == 0)  return setNumber(config.sleep_timeout_min, value, 0, 1440, CONFIG_CHANGE_STORED, changes);
+    if (strcmp(key, "otapw") == 0) {
+        // Write-only like the Wi-Fi passwords: empty keeps the stored one
+        if (value.length() == 0) return true;
+        if (value.length() < 8) return false;
+        return setText(config.update_password, sizeof(config.update_password), value, CONFIG_CHANGE_STORED, changes);
+    }
+    if (key[0] == 'p' && key[1] != '\0') return setProfileField(config, key, value, changes);
+    return false;
+}
@@ -10,8 +10,19 @@ extern userConfig_t userConfig;
 // The NVS preferences object (defined in .cpp)
 extern Preferences preferences;
 
+// --- LIVE-APPLY CHANGE FLAGS (accumulated by configSetField) ---
+#define CONFIG_CHANGE_STORED   0x01  // Read where it is used (sleep timeout, quota, quiet hours): persist only
+#define CONFIG_CHANGE_REDRAW   0x02  // Units, icon style, time format, weather view: full redraw
+#define CONFIG_CHANGE_WEATHER  0x04  // Key, location, provider, units: refetch current conditions
+#define CONFIG_CHANGE_FORECAST 0x08  // Forecast data or view changed: drop and refetch the strip
+#define CONFIG_CHANGE_TIMEZONE 0x10  // Zone or GMT offset: re-apply TZ and reschedule alarms
+#define CONFIG_CHANGE_THEME    0x20  // Automatic theme switched on/off, or another theme selected
+
 // --- FUNCTION PROTOTYPES ---
 void loadConfig();
-void saveConfig();
+void saveConfig(); // Coalesced (ConfigStore.h): configStoreFlush() before restarting
+// Validates and stores one setting by its web/API name (the config form's field names).
+// Returns false for unknown names or invalid values; ORs CONFIG_CHANGE_* into 'changes' if it differs.
+bool configSetField(userConfig_t& config, const char* key, const String& value, uint32_t& changes);
 
-#endif // CONFIGHANDLER_H
\ No newline at end of file
+#endif // CONFIGHANDLER_H
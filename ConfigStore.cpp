@@ -0,0 +1,351 @@
+#include "ConfigStore.h"     // Header for this module
+#include "ConfigHandler.h"   // For userConfig and the shared Preferences object
+#include "config.h"          // For CONFIG_SAVE_COALESCE_MS and default values
+#include "ForecastHandler.h" // For WEATHER_VIEW_CURRENT
+#include "WeatherProvider.h" // For WEATHER_PROVIDER_OPENWEATHER
+#include "PowerProfile.h"    // For POWER_MODE_BACKLIGHT_OFF
+#include "ThemeConfig.h"     // For THEME_DEFAULT_DARK / THEME_DEFAULT_LIGHT
+
+#include <Arduino.h>
+#include <stddef.h>
+
+#define LEGACY_BLOB_KEY "userConfig"
+#define SCHEMA_KEY "schema"
+
+// --- FIELD REGISTRY ---
+// Key names are part of the stored format: never rename one, add a migration instead.
+#define CONFIG_FIELD(key, member, type) \
+    { key, (uint16_t)offsetof(userConfig_t, member), (uint16_t)sizeof(((userConfig_t*)0)->member), type }
+
+static const ConfigField CONFIG_FIELDS[] = {
+    CONFIG_FIELD("ssid", ssid, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("pass", password, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("apikey", weather_api_key, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("gmt", gmt_offset_hr, CONFIG_FIELD_INT),
+    CONFIG_FIELD("sleeptmo", sleep_timeout_min, CONFIG_FIELD_INT),
+    CONFIG_FIELD("timefmt", time_format_24h, CONFIG_FIELD_BOOL),
+    CONFIG_FIELD("fahrenheit", use_fahrenheit, CONFIG_FIELD_BOOL),
+    CONFIG_FIELD("cityidmode", use_city_id_mode, CONFIG_FIELD_BOOL),
+    CONFIG_FIELD("city", weather_city, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("country", weather_country_code, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("cityid", weather_city_id, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("iconcolor", use_multi_color_icons, CONFIG_FIELD_BOOL),
+    CONFIG_FIELD("wview", weather_view, CONFIG_FIELD_U8),
+    CONFIG_FIELD("provider", weather_provider, CONFIG_FIELD_U8),
+    CONFIG_FIELD("lat", latitude, CONFIG_FIELD_FLOAT),
+    CONFIG_FIELD("lon", longitude, CONFIG_FIELD_FLOAT),
+    CONFIG_FIELD("quota", weather_daily_quota, CONFIG_FIELD_U16),
+    CONFIG_FIELD("loc0", extra_locations[0], CONFIG_FIELD_BYTES),
+    CONFIG_FIELD("loc1", extra_locations[1], CONFIG_FIELD_BYTES),
+    CONFIG_FIELD("loc2", extra_locations[2], CONFIG_FIELD_BYTES),
+    CONFIG_FIELD("autotheme", auto_theme, CONFIG_FIELD_BOOL),
+    CONFIG_FIELD("tz", tz_name, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("power0", power_profiles[0], CONFIG_FIELD_BYTES),
+    CONFIG_FIELD("power1", power_profiles[1], CONFIG_FIELD_BYTES),
+    CONFIG_FIELD("power2", power_profiles[2], CONFIG_FIELD_BYTES),
+    CONFIG_FIELD("otapw", update_password, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("themedark", theme_dark, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("themelight", theme_light, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("sip", static_ip, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("sgw", static_gateway, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("smask", static_subnet, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("sdns", static_dns, CONFIG_FIELD_TEXT),
+    CONFIG_FIELD("net0", extra_networks[0], CONFIG_FIELD_BYTES),
+    CONFIG_FIELD("net1", extra_networks[1], CONFIG_FIELD_BYTES),
+    CONFIG_FIELD("net2", extra_networks[2], CONFIG_FIELD_BYTES),
+};
+static const uint8_t CONFIG_FIELD_COUNT = sizeof(CONFIG_FIELDS) / sizeof(CONFIG_FIELDS[0]);
+
+// --- LEGACY BLOB LAYOUTS ---
+// Every release appended fields to userConfig_t, so each old blob is a prefix of
+// today's struct: each entry is where the first field that release did not
+// have begins. The blob itself was padded to the struct alignment. Two layouts can pad
+// to the same size (adding auto_theme did not grow the blob); the newer one wins,
+// and the padding byte it then reads as auto_theme was zero.
+static const size_t LEGACY_LAYOUTS[] = {
+    offsetof(userConfig_t, weather_view),        // Original release
+    offsetof(userConfig_t, weather_provider),    // + weather view
+    offsetof(userConfig_t, weather_daily_quota), // + provider and coordinates
+    offsetof(userConfig_t, extra_locations),     // + daily quota
+    offsetof(userConfig_t, auto_theme),          // + extra locations
+    offsetof(userConfig_t, tz_name),             // + automatic theme
+    offsetof(userConfig_t, power_profiles),      // + time zone name
+    offsetof(userConfig_t, update_password),     // + quiet hours
+    offsetof(userConfig_t, theme_dark),          // + update password (last blob release)
+};
+static const uint8_t LEGACY_LAYOUT_COUNT = sizeof(LEGACY_LAYOUTS) / sizeof(LEGACY_LAYOUTS[0]);
+
+// --- MIGRATIONS ---
+// MIGRATIONS[N] upgrades a store at schema N; each runs with the namespace open
+// read/write and userConfig/stored holding what has been read so far.
+typedef bool (*ConfigMigration)();
+static bool migrateFromBlob();
+
+static const ConfigMigration MIGRATIONS[] = {
+    migrateFromBlob,   // 0 -> 1
+};
+static const uint8_t CONFIG_SCHEMA_VERSION = sizeof(MIGRATIONS) / sizeof(MIGRATIONS[0]);
+
+// --- STATE ---
+static userConfig_t stored;             // What NVS holds: fields that differ from it are dirty
+static bool saveRequested = false;
+static unsigned long firstRequestMs = 0;
+static unsigned long lastRequestMs = 0;
+static uint16_t requestsCoalesced = 0;
+static uint32_t totalBytesWritten = 0;
+
+
+/**
+ * @brief Fresh-install settings.
+ */
+void configSetDefaults(userConfig_t& config) {
+    memset(&config, 0, sizeof(config));
+    config.gmt_offset_hr = -5; // Default to New York time zone
+    strncpy(config.tz_name, "America/New_York", sizeof(config.tz_name) - 1);
+    config.sleep_timeout_min = 5; // Default sleep timeout to 5 minutes
+
+    config.time_format_24h = TIME_FORMAT_24H;
+    config.use_fahrenheit = USE_FAHRENHEIT;
+
+    config.use_multi_color_icons = true;
+    config.weather_view = WEATHER_VIEW_CURRENT;
+    config.auto_theme = false;
+    strncpy(config.theme_dark, THEME_DEFAULT_DARK, sizeof(config.theme_dark) - 1);
+    strncpy(config.theme_light, THEME_DEFAULT_LIGHT, sizeof(config.theme_light) - 1);
+
+    config.use_city_id_mode = false;
+    // Set default location: New York, US
+    strncpy(config.weather_city, "New York", sizeof(config.weather_city) - 1);
+    strncpy(config.weather_country_code, "US", sizeof(config.weather_country_code) - 1);
+    config.weather_provider = WEATHER_PROVIDER_OPENWEATHER;
+    config.latitude = 40.7128f;
+    config.longitude = -74.0060f;
+    config.weather_daily_quota = WEATHER_DEFAULT_DAILY_QUOTA;
+    // Quiet hours: all profiles off, pre-filled with a 23:00-06:00 display-off window
+    for (int i = 0; i < POWER_PROFILE_COUNT; i++) {
+        config.power_profiles[i] = { 0, 23, 0, 6, 0, POWER_MODE_BACKLIGHT_OFF, 20, 3 };
+    }
+    // API key and Wi-Fi credentials stay empty to trigger the config portal;
+    // no update password keeps network firmware updates off
+}
+
+/**
+ * @brief Puts imported data in canonical form: strings terminated and zero-padded,
+ * bools 0 or 1.
+ */
+void configSanitize(userConfig_t& config) {
+    uint8_t* base = (uint8_t*)&config;
+    for (uint8_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        const ConfigField& field = CONFIG_FIELDS[i];
+        if (field.type == CONFIG_FIELD_TEXT) {
+            // Zero everything after the terminator so equal strings compare equal byte-wise
+            char* text = (char*)base + field.offset;
+            size_t length = strnlen(text, field.size - 1);
+            memset(text + length, 0, field.size - length);
+        } else if (field.type == CONFIG_FIELD_BOOL) {
+            base[field.offset] = base[field.offset] ? 1 : 0;
+        }
+    }
+}
+
+bool configImportBlob(const uint8_t* blob, size_t size, userConfig_t& config) {
+    const size_t align = alignof(userConfig_t);
+    for (int8_t i = LEGACY_LAYOUT_COUNT - 1; i >= 0; i--) {
+        size_t valid = LEGACY_LAYOUTS[i];
+        if ((valid + align - 1) / align * align != size) continue;
+        configSetDefaults(config);
+        memcpy(&config, blob, valid);
+        // Releases without a zone name ran on the manual GMT offset: an empty name
+        // keeps it in charge instead of the default zone's rules
+        if (valid <= offsetof(userConfig_t, tz_name)) config.tz_name[0] = '\0';
+        configSanitize(config);
+        return true;
+    }
+    return false;
+}
+
+uint8_t configFieldCount() {
+    return CONFIG_FIELD_COUNT;
+}
+
+const ConfigField& configFieldAt(uint8_t index) {
+    return CONFIG_FIELDS[index];
+}
+
+bool configFieldDiffers(const ConfigField& field, const userConfig_t& a, const userConfig_t& b) {
+    return memcmp((const uint8_t*)&a + field.offset, (const uint8_t*)&b + field.offset, field.size) != 0;
+}
+
+
+// --- NVS ACCESS (namespace already open) ---
+
+/**
+ * @brief Reads one field if its key exists with the expected size; otherwise the
+ * current (default) value stays.
+ */
+static void readField(const ConfigField& field, userConfig_t& config) {
+    if (!preferences.isKey(field.key)) return;
+    uint8_t* value = (uint8_t*)&config + field.offset;
+    switch (field.type) {
+        case CONFIG_FIELD_TEXT: {
+            size_t length = preferences.getBytesLength(field.key);
+            if (length == 0 || length > field.size) break;
+            memset(value, 0, field.size);
+            preferences.getBytes(field.key, value, length);
+            break;
+        }
+        case CONFIG_FIELD_BOOL:  *(bool*)value = preferences.getBool(field.key, *(bool*)value); break;
+        case CONFIG_FIELD_U8:    *value = preferences.getUChar(field.key, *value); break;
+        case CONFIG_FIELD_U16:   *(uint16_t*)value = preferences.getUShort(field.key, *(uint16_t*)value); break;
+        case CONFIG_FIELD_INT:   *(int32_t*)value = preferences.getInt(field.key, *(int32_t*)value); break;
+        case CONFIG_FIELD_FLOAT: *(float*)value = preferences.getFloat(field.key, *(float*)value); break;
+        case CONFIG_FIELD_BYTES:
+            if (preferences.getBytesLength(field.key) == field.size) {
+                preferences.getBytes(field.key, value, field.size);
+            } else {
+                Serial.printf("Config: key '%s' has an old size, keeping the default.\n", field.key);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Writes one field. Text goes in as bytes with its terminator, so an empty
+ * string still reports a non-zero length (putString() returns 0 for it).
+ * @return Bytes written, 0 on failure.
+ */
+static size_t writeField(const ConfigField& field, const userConfig_t& config) {
+    const uint8_t* value = (const uint8_t*)&config + field.offset;
+    switch (field.type) {
+        case CONFIG_FIELD_TEXT:  return preferences.putBytes(field.key, value, strnlen((const char*)value, field.size - 1) + 1);
+        case CONFIG_FIELD_BOOL:  return preferences.putBool(field.key, *(const bool*)value);
+        case CONFIG_FIELD_U8:    return preferences.putUChar(field.key, *value);
+        case CONFIG_FIELD_U16:   return preferences.putUShort(field.key, *(const uint16_t*)value);
+        case CONFIG_FIELD_INT:   return preferences.putInt(field.key, *(const int32_t*)value);
+        case CONFIG_FIELD_FLOAT: return preferences.putFloat(field.key, *(const float*)value);
+        case CONFIG_FIELD_BYTES: return preferences.putBytes(field.key, value, field.size);
+    }
+    return 0;
+}
+
+/**
+ * @brief Writes the fields of userConfig that differ from what NVS holds.
+ * A field whose write fails stays dirty for the next save.
+ */
+static void writeDirtyFields(const char* reason) {
+    uint8_t keys = 0;
+    uint8_t failed = 0;
+    size_t bytes = 0;
+    for (uint8_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        const ConfigField& field = CONFIG_FIELDS[i];
+        if (!configFieldDiffers(field, userConfig, stored)) continue;
+        size_t written = writeField(field, userConfig);
+        if (written == 0) {
+            failed++;
+            continue;
+        }
+        memcpy((uint8_t*)&stored + field.offset, (const uint8_t*)&userConfig + field.offset, field.size);
+        bytes += written;
+        keys++;
+    }
+    totalBytesWritten += bytes;
+    Serial.printf("Config %s: %u of %u keys changed, %u bytes written to NVS%s.\n", reason, keys,
+                  CONFIG_FIELD_COUNT, (unsigned)bytes, failed ? " (some writes failed, will retry)" : "");
+}
+
+
+// --- MIGRATIONS ---
+
+/**
+ * @brief Schema 0 -> 1: splits the old putBytes blob into per-field keys.
+ */
+static bool migrateFromBlob() {
+    size_t size = preferences.isKey(LEGACY_BLOB_KEY) ? preferences.getBytesLength(LEGACY_BLOB_KEY) : 0;
+    if (size == 0) return true; // Fresh install: nothing to carry over
+
+    static uint8_t blob[sizeof(userConfig_t)];
+    if (size > sizeof(blob) || preferences.getBytes(LEGACY_BLOB_KEY, blob, size) != size ||
+        !configImportBlob(blob, size, userConfig)) {
+        Serial.printf("Config: unrecognised %u-byte settings blob, starting from defaults.\n", (unsigned)size);
+        preferences.remove(LEGACY_BLOB_KEY);
+        return true;
+    }
+    Serial.printf("Config: migrating %u-byte settings blob to per-field keys.\n", (unsigned)size);
+    writeDirtyFields("migration");
+    for (uint8_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        if (configFieldDiffers(CONFIG_FIELDS[i], userConfig, stored)) return false; // A write failed: keep the blob
+    }
+    preferences.remove(LEGACY_BLOB_KEY);
+    return true;
+}
+
+/**
+ * @brief Loads the settings: defaults, then every stored key, then any pending
+ * migrations. Keys that are missing (fields added by a later release) keep their
+ * defaults instead of resetting everything.
+ */
+void configStoreLoad() {
+    configSetDefaults(userConfig);
+    stored = userConfig;
+
+    preferences.begin(PREF_NAMESPACE, false); // Read/write: migrations may run
+    uint8_t schema = preferences.getUChar(SCHEMA_KEY, 0);
+    for (uint8_t i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        readField(CONFIG_FIELDS[i], userConfig);
+    }
+    configSanitize(userConfig);
+    stored = userConfig;
+
+    if (schema > CONFIG_SCHEMA_VERSION) {
+        Serial.printf("Config: schema %u is newer than this firmware (%u); unknown keys are ignored.\n",
+                      schema, CONFIG_SCHEMA_VERSION);
+    }
+    // Each step is recorded as soon as it succeeds; a failed one is retried next boot
+    while (schema < CONFIG_SCHEMA_VERSION) {
+        if (!MIGRATIONS[schema]() || preferences.putUChar(SCHEMA_KEY, schema + 1) == 0) {
+            Serial.printf("Config: migration from schema %u failed; will retry next boot.\n", schema);
+            break;
+        }
+        schema++;
+    }
+    preferences.end();
+
+    Serial.printf("Config loaded (schema %u, %u fields).\n", schema, CONFIG_FIELD_COUNT);
+}
+
+/**
+ * @brief Asks for userConfig to be written. Requests arriving within
+ * CONFIG_SAVE_COALESCE_MS of each other share one write.
+ */
+void configStoreRequestSave() {
+    unsigned long now = millis();
+    if (!saveRequested) {
+        saveRequested = true;
+        firstRequestMs = now;
+        requestsCoalesced = 0;
+    }
+    lastRequestMs = now;
+    requestsCoalesced++;
+}
+
+void configStoreFlush() {
+    if (!saveRequested) return;
+    saveRequested = false;
+    preferences.begin(PREF_NAMESPACE, false);
+    char reason[32];
+    snprintf(reason, sizeof(reason), "save (%u request%s)", requestsCoalesced, requestsCoalesced == 1 ? "" : "s");
+    writeDirtyFields(reason);
+    preferences.end();
+}
+
+void serviceConfigStore() {
+    if (!saveRequested) return;
+    unsigned long now = millis();
+    if (now - lastRequestMs >= CONFIG_SAVE_COALESCE_MS || now - firstRequestMs >= CONFIG_SAVE_MAX_DELAY_MS) {
+        configStoreFlush();
+    }
+}
+
+uint32_t configStoreBytesWritten() {
+    return totalBytesWritten;
+}
@@ -0,0 +1,47 @@
+#ifndef CONFIGSTORE_H
+#define CONFIGSTORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "UserConfig.h" // Defines userConfig_t
+
+// --- SCHEMA ---
+// Settings live in NVS as one key per field, so adding a field no longer
+// invalidates the others. The stored "schema" key counts the migrations that
+// have run: migration N upgrades a store at schema N to N + 1. Schema 0 is the
+// old single-blob layout ("userConfig" key written with putBytes).
+
+typedef enum : uint8_t {
+    CONFIG_FIELD_TEXT,   // char[]: stored as bytes including the terminator
+    CONFIG_FIELD_BOOL,
+    CONFIG_FIELD_U8,
+    CONFIG_FIELD_U16,
+    CONFIG_FIELD_INT,
+    CONFIG_FIELD_FLOAT,
+    CONFIG_FIELD_BYTES   // Fixed-size struct (extra location, quiet-hours profile)
+} ConfigFieldType;
+
+typedef struct {
+    const char* key;     // NVS key (15 characters max)
+    uint16_t offset;     // Position in userConfig_t
+    uint16_t size;
+    ConfigFieldType type;
+} ConfigField;
+
+// --- PURE (no NVS access) ---
+void configSetDefaults(userConfig_t& config);
+void configSanitize(userConfig_t& config);   // Terminates strings, normalizes bools
+// Restores any historical blob layout over the defaults; false if the size matches none
+bool configImportBlob(const uint8_t* blob, size_t size, userConfig_t& config);
+uint8_t configFieldCount();
+const ConfigField& configFieldAt(uint8_t index);
+bool configFieldDiffers(const ConfigField& field, const userConfig_t& a, const userConfig_t& b);
+
+// --- DEVICE ---
+void configStoreLoad();             // Fills userConfig; runs pending migrations
+void configStoreRequestSave();      // Written once no request came for CONFIG_SAVE_COALESCE_MS
+void configStoreFlush();            // Writes changed fields now (before a restart or deep sleep)
+void serviceConfigStore();          // loop(): flushes a coalesced save when due
+uint32_t configStoreBytesWritten(); // NVS payload bytes written since boot
+
+#endif // CONFIGSTORE_H
@@ -0,0 +1,58 @@
+#include "ForecastBuffer.h" // Header for this module
+
+#include <math.h>
+
+/**
+ * @brief Packs one parsed forecast slot.
+ * @param temperature In the configured unit; stored in tenths, clamped to the int16 range.
+ * @param pop Probability of precipitation as OWM sends it (0.0-1.0).
+ * @param pod OWM "sys.pod" ("d" or "n"), may be null.
+ */
+ForecastEntry forecastPack(uint32_t time, float temperature, uint16_t conditionId, float pop, const char* pod) {
+    long tempX10 = lroundf(temperature * 10.0f);
+    long popPercent = lroundf(pop * 100.0f);
+
+    ForecastEntry entry;
+    entry.time = time;
+    entry.temp_x10 = (int16_t)(tempX10 < INT16_MIN ? INT16_MIN : (tempX10 > INT16_MAX ? INT16_MAX : tempX10));
+    entry.condition_id = conditionId;
+    entry.pop = (uint8_t)(popPercent < 0 ? 0 : (popPercent > 100 ? 100 : popPercent));
+    entry.flags = (pod != nullptr && pod[0] == 'n') ? FORECAST_FLAG_NIGHT : 0;
+    return entry;
+}
+
+void forecastRingClear(ForecastRing& ring) {
+    ring.head = 0;
+    ring.size = 0;
+}
+
+/**
+ * @brief Appends an entry, overwriting the oldest one when the ring is full.
+ */
+void forecastRingPush(ForecastRing& ring, const ForecastEntry& entry) {
+    uint8_t tail = (ring.head + ring.size) % FORECAST_CAPACITY;
+    ring.entries[tail] = entry;
+    if (ring.size < FORECAST_CAPACITY) {
+        ring.size++;
+    } else {
+        ring.head = (ring.head + 1) % FORECAST_CAPACITY;
+    }
+}
+
+/**
+ * @brief Drops entries whose 3-hour slot has already ended.
+ * The slot in progress (the last one starting at or before now) is kept.
+ */
+void forecastRingDropPast(ForecastRing& ring, uint32_t now) {
+    while (ring.size > 1) {
+        const ForecastEntry& next = ring.entries[(ring.head + 1) % FORECAST_CAPACITY];
+        if (next.time > now) break;
+        ring.head = (ring.head + 1) % FORECAST_CAPACITY;
+        ring.size--;
+    }
+}
+
+const ForecastEntry* forecastRingAt(const ForecastRing& ring, uint8_t index) {
+    if (index >= ring.size) return nullptr;
+    return &ring.entries[(ring.head + index) % FORECAST_CAPACITY];
+}
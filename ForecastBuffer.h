@@ -0,0 +1,40 @@
+#ifndef FORECASTBUFFER_H
+#define FORECASTBUFFER_H
+
+#include <stdint.h>
+
+// --- FORECAST RING BUFFER SIZING ---
+// The free OWM 2.5 forecast endpoint returns 5 days in 3-hour steps (40 entries).
+#define FORECAST_CAPACITY 40
+
+// Entry flags
+#define FORECAST_FLAG_NIGHT 0x01 // OWM "sys.pod" == "n"
+
+/**
+ * @brief One packed forecast slot (10 bytes of data, 12 with alignment).
+ */
+typedef struct {
+    uint32_t time;          // UTC epoch seconds (OWM "dt")
+    int16_t temp_x10;       // Temperature in tenths of the configured unit
+    uint16_t condition_id;  // OWM weather[0].id
+    uint8_t pop;            // Probability of precipitation, 0-100 %
+    uint8_t flags;          // FORECAST_FLAG_*
+} ForecastEntry;
+
+/**
+ * @brief Fixed-size ring of forecast slots, oldest first. Full rings overwrite the oldest slot.
+ */
+typedef struct {
+    ForecastEntry entries[FORECAST_CAPACITY];
+    uint8_t head;   // Index of the oldest entry
+    uint8_t size;   // Number of valid entries
+} ForecastRing;
+
+// --- FUNCTION PROTOTYPES ---
+ForecastEntry forecastPack(uint32_t time, float temperature, uint16_t conditionId, float pop, const char* pod);
+void forecastRingClear(ForecastRing& ring);
+void forecastRingPush(ForecastRing& ring, const ForecastEntry& entry);
+void forecastRingDropPast(ForecastRing& ring, uint32_t now);
+const ForecastEntry* forecastRingAt(const ForecastRing& ring, uint8_t index); // 0 = oldest
+
+#endif // FORECASTBUFFER_H
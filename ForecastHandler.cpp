@@ -0,0 +1,300 @@
+#include "ForecastHandler.h"  // Header for this module
+#include "WeatherHandler.h"   // For temperatureUnit and WeatherProvider.h
+#include "config.h"           // For OPENWEATHER_FORECAST_URL_BASE and intervals
+#include "UserConfig.h"       // For the userConfig struct
+#include "ThemeHandler.h"     // For icon font and icon colors
+#include "WeatherUtilities.h" // For condition-ID icon/color lookup
+#include "Metrics.h"          // Redraw pixel counter
+
+#include <TFT_eSPI.h>
+#include <WiFiClientSecure.h>
+#include <esp_random.h>
+#include <time.h>
+
+// --- EXTERN GLOBALS (from .ino) ---
+extern TFT_eSPI tft;
+extern const int DISPLAY_WIDTH;
+extern userConfig_t userConfig;
+
+// --- RING BUFFER STORAGE ---
+static ForecastRing forecastRing = {};
+static ForecastRing forecastIncoming = {}; // Parse target: replaces forecastRing only after a clean parse
+
+bool forecastDataUpdated = false;
+// Failed fetches retry with the current-conditions backoff; good ones wait FORECAST_UPDATE_INTERVAL_MS
+static WeatherSchedule forecastSchedule = {};
+
+// --- STRIP STATE ---
+// Shadow copy of what each cell currently shows, so only changed cells are redrawn
+typedef struct {
+    uint32_t time;
+    int16_t temp_x10;
+    uint16_t condition_id;
+    uint8_t flags;
+    bool valid;
+} ForecastCell;
+
+static ForecastCell drawnCells[FORECAST_STRIP_CELLS];
+static uint8_t stripScroll = 0;
+static unsigned long lastStripScroll = 0;
+
+
+uint8_t forecastCount() {
+    return forecastRing.size;
+}
+
+const ForecastEntry* forecastAt(uint8_t index) {
+    return forecastRingAt(forecastRing, index);
+}
+
+
+/**
+ * @brief Sends the forecast request and streams the body into forecastIncoming
+ * (OpenWeatherProvider::parseForecast()).
+ * @return WEATHER_RESULT_OK only if every element parsed.
+ */
+static WeatherResult requestForecast() {
+    String url = OPENWEATHER_FORECAST_URL_BASE;
+    appendOpenWeatherQuery(url, primaryWeatherLocation());
+
+    // Forecast calls count against the same daily quota as current conditions
+    if (!weatherQuotaTake()) {
+        Serial.println("Forecast fetch skipped: daily quota reached.");
+        return WEATHER_RESULT_QUOTA;
+    }
+
+    Serial.println("--- Attempting to fetch forecast data ---");
+
+    WiFiClientSecure client;
+    client.setInsecure();
+    HTTPClient http;
+    http.useHTTP10(true); // Disable chunked transfer so the body can be parsed straight off the socket
+
+    http.begin(client, url);
+    int httpResponseCode = http.GET();
+    if (httpResponseCode != 200) {
+        Serial.printf("Forecast GET Failed, Code: %d. Error: %s\n", httpResponseCode, http.errorToString(httpResponseCode).c_str());
+        http.end();
+        return activeWeatherProvider().classifyError(httpResponseCode);
+    }
+
+    OpenWeatherProvider owm;
+    unsigned long parseStart = micros();
+    WeatherResult result = owm.parseForecast(http.getStream(), forecastIncoming);
+    unsigned long parseUs = micros() - parseStart;
+    http.end();
+
+    Serial.printf("Forecast parsed: %u entries in %lu us (%u bytes/entry, %u bytes total).\n",
+                  forecastIncoming.size, parseUs, (unsigned)sizeof(ForecastEntry), (unsigned)sizeof(forecastRing.entries));
+    return result;
+}
+
+/**
+ * @brief Fetches the 5-day/3-hour forecast when due. The buffer is only
+ * replaced after a complete parse; failures keep the old slots and retry
+ * with the same backoff as current conditions.
+ */
+void fetchForecastData() {
+
+    // Throttle updates (delay chosen after the last attempt)
+    if (!scheduleIsDue(forecastSchedule, millis())) {
+        return;
+    }
+    // The forecast endpoint is OWM-only
+    if (userConfig.weather_view == WEATHER_VIEW_CURRENT || userConfig.weather_provider != WEATHER_PROVIDER_OPENWEATHER ||
+        userConfig.weather_api_key[0] == '\0') {
+        return;
+    }
+    if (WiFi.status() != WL_CONNECTED) {
+        return;
+    }
+
+    WeatherResult result = requestForecast();
+    if (result == WEATHER_RESULT_OK) {
+        forecastRing = forecastIncoming;
+        forecastDataUpdated = true;
+    }
+
+    // Schedule the next attempt
+    WeatherScheduleContext context = {};
+    context.backlight_on = true;
+    context.power_factor = 1;
+    scheduleRecord(forecastSchedule, millis(), weatherScheduleOutcome(result), context, esp_random());
+    if (result == WEATHER_RESULT_OK) {
+        forecastSchedule.next_delay_ms = FORECAST_UPDATE_INTERVAL_MS;
+    } else {
+        Serial.printf("Forecast fetch failed (%s). Next attempt in %lu s (failures: %u).\n",
+                      weatherResultText(result), forecastSchedule.next_delay_ms / 1000, forecastSchedule.failures);
+    }
+}
+
+
+/**
+ * @brief Builds the cell contents for the current view and scroll position.
+ * @return Number of cells with data.
+ */
+static uint8_t buildStripCells(ForecastCell* cells) {
+    uint8_t filled = 0;
+
+    if (userConfig.weather_view == WEATHER_VIEW_DAILY) {
+        // One cell per local calendar day: the slot closest to midday, with the day's max temperature
+        int lastYday = -1;
+        int bestDistance = 0;
+        for (uint8_t i = 0; i < forecastRing.size; i++) {
+            const ForecastEntry* e = forecastAt(i);
+            time_t t = e->time;
+            struct tm local;
+            localtime_r(&t, &local);
+
+            if (local.tm_yday != lastYday) {
+                if (filled == FORECAST_STRIP_CELLS) break;
+                lastYday = local.tm_yday;
+                ForecastCell& c = cells[filled++];
+                c.time = e->time;
+                c.temp_x10 = e->temp_x10;
+                c.condition_id = e->condition_id;
+                c.flags = 0;
+                c.valid = true;
+                bestDistance = abs(local.tm_hour - 12);
+                continue;
+            }
+
+            ForecastCell& c = cells[filled - 1];
+            if (e->temp_x10 > c.temp_x10) c.temp_x10 = e->temp_x10;
+            int distance = abs(local.tm_hour - 12);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                c.condition_id = e->condition_id;
+            }
+        }
+        return filled;
+    }
+
+    // Hourly view: a window of consecutive slots starting at the scroll offset
+    for (uint8_t i = 0; i < FORECAST_STRIP_CELLS; i++) {
+        const ForecastEntry* e = forecastAt(stripScroll + i);
+        if (e == nullptr) break;
+        ForecastCell& c = cells[filled++];
+        c.time = e->time;
+        c.temp_x10 = e->temp_x10;
+        c.condition_id = e->condition_id;
+        c.flags = e->flags;
+        c.valid = true;
+    }
+    return filled;
+}
+
+/**
+ * @brief Draws a single strip cell: time label, icon and temperature.
+ */
+static void drawStripCell(const ForecastCell& cell, int x, int yTop, int width, int height) {
+    tft.fillRect(x, yTop, width, height, currentTheme->background);
+    metricsNoteRedraw((uint32_t)width * height);
+    if (!cell.valid) return;
+
+    int centerX = x + width / 2;
+
+    // 1. Time label
+    char label[8];
+    time_t t = cell.time;
+    struct tm local;
+    localtime_r(&t, &local);
+    if (userConfig.weather_view == WEATHER_VIEW_DAILY) {
+        strftime(label, sizeof(label), "%a", &local);
+    } else {
+        strftime(label, sizeof(label), userConfig.time_format_24h ? "%H:00" : "%I%p", &local);
+    }
+    tft.setFreeFont(NULL);
+    tft.setTextFont(1);
+    tft.setTextColor(currentTheme->weather_text, currentTheme->background);
+    tft.setTextDatum(MC_DATUM);
+    tft.drawString(label, centerX, yTop + 5);
+
+    // 2. Icon
+    bool isDay = !(cell.flags & FORECAST_FLAG_NIGHT);
+    char icon = getWeatherIcon(cell.condition_id, isDay);
+    uint16_t iconColor = currentTheme->multi_color_icons ? getWeatherColor(cell.condition_id, isDay) : currentTheme->icon;
+    tft.setFreeFont(currentTheme->icon_font);
+    tft.setTextColor(iconColor, currentTheme->background);
+    tft.setTextDatum(MC_DATUM);
+    tft.drawChar(icon, centerX - 10, yTop + height / 2 + 4);
+
+    // 3. Temperature
+    char temp[8];
+    snprintf(temp, sizeof(temp), "%d%s", (int)lroundf(cell.temp_x10 / 10.0f), temperatureUnit.c_str());
+    tft.setFreeFont(NULL);
+    tft.setTextFont(2);
+    tft.setTextColor(currentTheme->weather_text, currentTheme->background);
+    tft.setTextDatum(BC_DATUM);
+    tft.drawString(temp, centerX, yTop + height);
+}
+
+/**
+ * @brief Draws the forecast strip, redrawing only the cells whose contents changed.
+ * @param yTop Top of the weather area.
+ * @param height Height of the weather area.
+ * @param force True to redraw every cell (after a screen clear or theme change).
+ */
+void drawForecastStrip(int yTop, int height, bool force) {
+    ForecastCell cells[FORECAST_STRIP_CELLS] = {};
+    buildStripCells(cells);
+
+    int cellWidth = DISPLAY_WIDTH / FORECAST_STRIP_CELLS;
+    uint8_t redrawn = 0;
+
+    for (uint8_t i = 0; i < FORECAST_STRIP_CELLS; i++) {
+        const ForecastCell& cell = cells[i];
+        ForecastCell& drawn = drawnCells[i];
+        bool changed = force || cell.valid != drawn.valid || cell.time != drawn.time ||
+                       cell.temp_x10 != drawn.temp_x10 || cell.condition_id != drawn.condition_id ||
+                       cell.flags != drawn.flags;
+        if (!changed) continue;
+
+        drawStripCell(cell, i * cellWidth, yTop, cellWidth, height);
+        drawn = cell;
+        redrawn++;
+    }
+
+    if (redrawn > 0) {
+        Serial.printf("Forecast strip updated: %u of %u cells redrawn.\n", redrawn, FORECAST_STRIP_CELLS);
+    }
+}
+
+/**
+ * @brief Drops the buffered slots (units or location changed) and fetches again on the next service call.
+ */
+void resetForecast() {
+    forecastRingClear(forecastRing);
+    scheduleReset(forecastSchedule);
+    forecastDataUpdated = true;
+}
+
+/**
+ * @brief Periodic housekeeping for the strip: expires past slots, scrolls the
+ * hourly window and redraws on new data. Called every loop iteration.
+ */
+void serviceForecastStrip(int yTop, int height) {
+    fetchForecastData();
+    if (userConfig.weather_view == WEATHER_VIEW_CURRENT || forecastRing.size == 0) return;
+
+    time_t now;
+    time(&now);
+    forecastRingDropPast(forecastRing, (uint32_t)now);
+
+    bool needsDraw = forecastDataUpdated;
+    forecastDataUpdated = false;
+
+    if (userConfig.weather_view == WEATHER_VIEW_HOURLY && FORECAST_SCROLL_INTERVAL_MS > 0 &&
+        millis() - lastStripScroll >= FORECAST_SCROLL_INTERVAL_MS) {
+        lastStripScroll = millis();
+        // Scroll through the next 24 hours (8 slots), then wrap back to "now"
+        uint8_t window = min((int)forecastRing.size, 8 + FORECAST_STRIP_CELLS);
+        uint8_t maxScroll = window > FORECAST_STRIP_CELLS ? window - FORECAST_STRIP_CELLS : 0;
+        stripScroll = (stripScroll >= maxScroll) ? 0 : stripScroll + 1;
+        needsDraw = true;
+    }
+
+    if (needsDraw) {
+        drawForecastStrip(yTop, height, false);
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef FORECASTHANDLER_H
+#define FORECASTHANDLER_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "ForecastBuffer.h" // ForecastEntry and the ring buffer
+
+// Number of cells shown at once in the strip under the date card
+#define FORECAST_STRIP_CELLS 5
+
+// --- WEATHER VIEW MODES (userConfig.weather_view) ---
+#define WEATHER_VIEW_CURRENT 0
+#define WEATHER_VIEW_HOURLY  1
+#define WEATHER_VIEW_DAILY   2
+
+// --- FORECAST STATE (Defined in ForecastHandler.cpp) ---
+extern bool forecastDataUpdated; // Signal flag to tell the strip to redraw
+
+// --- FUNCTION PROTOTYPES ---
+void fetchForecastData();
+void resetForecast();           // Drop the buffer and fetch again (settings change)
+uint8_t forecastCount();
+const ForecastEntry* forecastAt(uint8_t index); // 0 = oldest entry still in the buffer
+void drawForecastStrip(int yTop, int height, bool force);
+void serviceForecastStrip(int yTop, int height);
+
+#endif // FORECASTHANDLER_H
@@ -1,29 +1,27 @@
 #include <TFT_eSPI.h>
 #include <WiFi.h>
-#include "config.h"      
-#include "ThemeConfig.h" 
+#include "config.h"
+#include "ThemeConfig.h"
 #include "MenuHandler.h"
-#include <Arduino.h> 
-
-// --- FIX FOR WEBSERVER COMPILE ERROR ---
-// WebServer.h requires FS.h to be included first,
-// and for the 'fs' namespace to be used.
-#include <FS.h>
-using namespace fs;
-#include <WebServer.h>
+#include "ConfigStore.h" // configStoreFlush() before rebooting
+#include "ConfigHandler.h" // saveConfig()/configSetField() for settings changed here
+#include "ThemeHandler.h" // Theme list
+#include "UiToolkit.h"   // Screens, widgets and partial redraw
+#include "Metrics.h"     // Menu open/close times, diagnostics history
+#include "TimeSync.h"    // NTP sync age
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h> // Stack high-water marks
 
 // --- EXTERN DECLARATIONS from main file (CYD_Flip_Clock_MK7.ino) ---
-extern WebServer server;
 extern TFT_eSPI tft;
 extern unsigned long lastActivityTime;
 extern const int DISPLAY_WIDTH;
 extern const int DISPLAY_HEIGHT;
-extern void checkTouch(int *touchEvent); // Function to check for touch events
-extern bool inverted_mode;               // For color toggle logic
+extern bool inverted_mode;               // For the theme slot on screen
 extern String timeStringPrevious;        // For redraw logic
 extern String dateStringPrevious;        // For redraw logic
 extern void setModeColors(bool inverted); // Function to toggle colors
-extern uint16_t touchX, touchY;          // Mapped touch coordinates from TouchHandler.h
 extern void enterDeepSleep();            // Function to enter deep sleep
 extern void performFullReset();          // Function to wipe NVS and reboot
 extern void drawStaticElements();        // Function to redraw the colon/layout
@@ -31,285 +29,340 @@ extern void drawWeather();               // Function to redraw the weather block
 extern void updateTimeDisplay();         // Function to redraw time digits/cards
 extern void updateDateDisplay();         // Function to redraw date card
 extern void clearWeatherArea();          // <<< NEW EXTERN
+extern void applyConfigChanges(uint32_t changes); // Refetch after a unit change
 extern userConfig_t userConfig;          // Needed to check API key
 // NOTE: current_weather_state and weatherStatus are correctly externed via MenuHandler.h
 // ------------------------------------------------------------------
 
 // --- MENU TIMEOUT CONSTANT ---
-const unsigned long MENU_TIMEOUT_MS = 60000; // 15 seconds
+const unsigned long MENU_TIMEOUT_MS = 60000; // 60 seconds without a touch
+const unsigned long DIAG_TIMEOUT_MS = 600000; // Diagnostics are watched, not touched: 10 minutes
 
 // --- BUTTON DEFINITIONS ---
 #define BTN_W 300
-#define BTN_H 30
+#define BTN_H 28
 #define BTN_X_START 10
-#define BTN_GAP 5
+#define BTN_GAP 4
+#define BTN_Y(row) (40 + (row) * (BTN_H + BTN_GAP))
+#define ROW_H 36     // Toggles and labels on the sub-screens
 
 // --- MENU BUTTON COLORS ---
-const uint16_t MENU_BTN_COLOR_1 = TFT_SKYBLUE;     // Button 1: Toggle Color Mode
-const uint16_t MENU_BTN_COLOR_2 = TFT_ORANGE; // Button 2: IP Configuration
-const uint16_t MENU_BTN_COLOR_3 = TFT_CYAN;    // Button 3: Advanced Config
-const uint16_t MENU_BTN_COLOR_4 = TFT_RED;       // Button 4: Reboot Device
-const uint16_t MENU_BTN_COLOR_5 = TFT_GREEN;    // Button 5: Exit Menu
-
-// Helper function to draw a standard menu button
-void drawMenuButton(int buttonIndex, const char* label, uint16_t color, int yStartOffset) {
-    // Button indices: 1 (top) to 5 (bottom)
-    int yStart = yStartOffset + (buttonIndex - 1) * (BTN_H + BTN_GAP);
-    
-    // Draw the button body
-    tft.fillRoundRect(BTN_X_START, yStart, BTN_W, BTN_H, 5, color);
-    // Draw a thin border
-    tft.drawRoundRect(BTN_X_START, yStart, BTN_W, BTN_H, 5, TFT_WHITE);
-
-    // Draw the label
-    tft.setTextColor(TFT_BLACK, color);
-    tft.setTextDatum(MC_DATUM); // Middle-Center datum
-    tft.setTextFont(2);
-    tft.drawString(label, BTN_X_START + BTN_W / 2, yStart + BTN_H / 2 + 1);
-}
+const uint16_t MENU_BTN_COLOR_1 = TFT_VIOLET;      // Button 1: Themes
+const uint16_t MENU_BTN_COLOR_2 = TFT_GREENYELLOW; // Button 2: Display & Time
+const uint16_t MENU_BTN_COLOR_3 = TFT_SKYBLUE;     // Button 3: IP Configuration
+const uint16_t MENU_BTN_COLOR_4 = TFT_ORANGE;      // Button 4: Restore Defaults
+const uint16_t MENU_BTN_COLOR_5 = TFT_CYAN;        // Button 5: Sleep Now
+const uint16_t MENU_BTN_COLOR_6 = TFT_RED;         // Button 6: Reboot Device
+const uint16_t MENU_BTN_COLOR_7 = TFT_LIGHTGREY;   // Button 7: Diagnostics
+const uint16_t MENU_ACCENT = TFT_GREEN;            // Toggles, sliders, list selection
+
+// --- STATE ---
+static bool menuOpen = false;
+static unsigned long lastMenuTouchMs = 0;
+static uint32_t menuChanges = 0; // CONFIG_CHANGE_* from settings changed in the menu
 
-// Helper function to check if touch coordinates are within a button's bounds
-bool isButtonPressed(int buttonIndex, uint16_t tX, uint16_t tY, int yStartOffset) {
-    int yStart = yStartOffset + (buttonIndex - 1) * (BTN_H + BTN_GAP);
-    int yEnd = yStart + BTN_H;
-    
-    return (tX >= BTN_X_START && tX <= (BTN_X_START + BTN_W) &&
-            tY >= yStart && tY <= yEnd);
+static void setMenuField(const char* key, int value) {
+    if (configSetField(userConfig, key, String(value), menuChanges)) saveConfig();
 }
 
 // -------------------------------------------------------------
-// FUNCTION TO DISPLAY IP CONFIGURATION SCREEN (UPDATED)
+// Actions (handlers run from uiService() on release)
 // -------------------------------------------------------------
 
-void showIPConfigScreen() {
-    
+static void onRestore(UiWidget&) {
+    Serial.println("[MENU] Restore to Default Settings pressed.");
+    performFullReset();
+}
+
+static void onSleep(UiWidget&) {
+    Serial.println("[MENU] Sleep Now pressed. Entering Deep Sleep...");
     tft.fillScreen(COLOR_BACKGROUND);
     tft.setTextColor(TFT_WHITE, COLOR_BACKGROUND);
-    tft.setTextDatum(MC_DATUM); 
-    
-    // Header
-    tft.setFreeFont(NULL);
+    tft.setTextDatum(MC_DATUM);
     tft.setTextFont(4);
-    tft.drawString("IP Configuration", DISPLAY_WIDTH / 2, 20);
-    
-    // Instructions
-    tft.setTextFont(2);
-    tft.drawString("Configuration URL:", DISPLAY_WIDTH / 2, 55);
-    
-    // Display IP Address + /config
-    String ipAddress = WiFi.localIP().toString();
-    String fullConfigUrl = ipAddress + "/config";
-
-    tft.setTextFont(4); 
-    tft.setTextColor(TFT_YELLOW, COLOR_BACKGROUND);
-    tft.drawString(fullConfigUrl.c_str(), DISPLAY_WIDTH / 2, 85);
-    
-    
-    // --- STATUS LINES ---
-    tft.setTextFont(2);
-    tft.setTextColor(TFT_WHITE, COLOR_BACKGROUND);
-    
-    // <<< NEW DATUM: Use Top-Right Datum for Right Alignment >>>
-    tft.setTextDatum(TR_DATUM); 
-    
-    // Define constant coordinates for alignment
-    const int STATUS_Y_START = 120;
-    const int LABEL_X = 10;
-    // This is the new, ALIGNED END point for all result values
-    const int VALUE_END_X = DISPLAY_WIDTH - 10; // 10 pixels from the right edge
-    
-    // 1. API Key Status
+    tft.drawString("Going to Sleep...", DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2);
+    delay(500);
+    enterDeepSleep();
+}
+
+static void onReboot(UiWidget&) {
+    Serial.println("[MENU] Reboot Device pressed. Rebooting...");
+    tft.fillScreen(COLOR_BACKGROUND);
+    tft.setTextColor(TFT_RED, COLOR_BACKGROUND);
+    tft.setTextDatum(MC_DATUM);
+    tft.setTextFont(4);
+    tft.drawString("REBOOTING...", DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2);
+    delay(1000);
+    configStoreFlush(); // Coalesced settings writes must land first
+    ESP.restart();
+}
+
+// -------------------------------------------------------------
+// Screens
+// -------------------------------------------------------------
+
+// --- Themes: the list edits the slot on screen (dark or light, switched by a tap on the clock) ---
+enum { THEME_SLOT_LABEL, THEME_LIST, THEME_AUTO };
+
+static void onThemeSelect(UiWidget& list);
+static void onAutoTheme(UiWidget& toggle) { setMenuField("autotheme", toggle.value); }
+
+static UiWidget themeWidgets[] = {
+    uiLabel(BTN_X_START, 40, BTN_W, 24, ""),
+    uiList(BTN_X_START, 66, BTN_W, 5 * 24, MENU_ACCENT, themeNameAt, onThemeSelect),
+    uiToggle(BTN_X_START, 192, BTN_W, ROW_H, "Light by day (sunrise/sunset)", MENU_ACCENT, onAutoTheme),
+};
+
+static char* themeSlot() {
+    return inverted_mode ? userConfig.theme_light : userConfig.theme_dark;
+}
+
+static void showThemes(UiScreen& screen) {
+    UiWidget& list = screen.widgets[THEME_LIST];
+    uiSetText(screen.widgets[THEME_SLOT_LABEL], inverted_mode ? "Light theme:" : "Dark theme:");
+    uiSetDetail(screen.widgets[THEME_SLOT_LABEL], currentTheme->name, TFT_YELLOW);
+    list.item_count = themeCount();
+    list.value = 0;
+    for (uint8_t i = 0; i < list.item_count; i++) {
+        if (strcmp(themeNameAt(i), themeSlot()) == 0) list.value = i;
+    }
+    // Keep the selection in view
+    uint8_t rows = list.h / 24;
+    if (list.value < list.first_row || list.value >= list.first_row + rows) {
+        list.first_row = list.value >= rows ? list.value - rows + 1 : 0;
+    }
+    screen.widgets[THEME_AUTO].value = userConfig.auto_theme;
+}
+
+static void onThemeSelect(UiWidget& list) {
+    char* slot = themeSlot();
+    strncpy(slot, themeNameAt(list.value), sizeof(userConfig.theme_dark) - 1);
+    Serial.printf("[MENU] Theme -> %s\n", slot);
+    saveConfig();
+    themeLoad();
+    setModeColors(inverted_mode);
+    uiSetDetail(themeWidgets[THEME_SLOT_LABEL], currentTheme->name, TFT_YELLOW);
+}
+
+static UiScreen themeScreen = { "Themes", themeWidgets, sizeof(themeWidgets) / sizeof(themeWidgets[0]), showThemes };
+
+// --- Display & Time ---
+enum { DISPLAY_24H, DISPLAY_FAHRENHEIT, DISPLAY_SLEEP };
+
+static void on24h(UiWidget& toggle)        { setMenuField("timefmt", toggle.value); }
+static void onFahrenheit(UiWidget& toggle) { setMenuField("tempunit", toggle.value); }
+static void onSleepTimeout(UiWidget& slider) { setMenuField("sleeptmo", slider.value); }
+
+static UiWidget displayWidgets[] = {
+    uiToggle(BTN_X_START, 40, BTN_W, ROW_H, "24-hour clock", MENU_ACCENT, on24h),
+    uiToggle(BTN_X_START, 40 + ROW_H, BTN_W, ROW_H, "Temperature in Fahrenheit", MENU_ACCENT, onFahrenheit),
+    uiSlider(BTN_X_START, 40 + 2 * ROW_H + 8, BTN_W, 44, "Sleep after", MENU_ACCENT, 0, 120, 5, " min", onSleepTimeout),
+};
+
+static void showDisplay(UiScreen& screen) {
+    screen.widgets[DISPLAY_24H].value = userConfig.time_format_24h;
+    screen.widgets[DISPLAY_FAHRENHEIT].value = userConfig.use_fahrenheit;
+    // Longer timeouts set on the web page show as the slider maximum until moved
+    screen.widgets[DISPLAY_SLEEP].value = constrain(userConfig.sleep_timeout_min, 0, 120);
+}
+
+static UiScreen displayScreen = { "Display & Time", displayWidgets, sizeof(displayWidgets) / sizeof(displayWidgets[0]), showDisplay };
+
+// --- IP Configuration ---
+enum { IP_URL, IP_NETWORK, IP_API_KEY, IP_LOCATION };
+
+static UiWidget ipWidgets[] = {
+    uiLabel(BTN_X_START, 44, BTN_W, 24, "Configuration URL:"),
+    uiLabel(BTN_X_START, 44 + 28, BTN_W, 24, "Wi-Fi Network:"),
+    uiLabel(BTN_X_START, 44 + 2 * 28, BTN_W, 24, "Weather API Key Present:"),
+    uiLabel(BTN_X_START, 44 + 3 * 28, BTN_W, 24, "Location Source:"),
+};
+
+static void showIpConfig(UiScreen& screen) {
+    String url = WiFi.localIP().toString() + "/config";
+    uiSetDetail(screen.widgets[IP_URL], url.c_str(), TFT_YELLOW);
+    bool connected = WiFi.status() == WL_CONNECTED;
+    uiSetDetail(screen.widgets[IP_NETWORK], connected ? WiFi.SSID().c_str() : "Not connected", connected ? TFT_GREEN : TFT_RED);
+
     bool apiKeyPresent = userConfig.weather_api_key[0] != '\0';
-    String apiKeyStatus = apiKeyPresent ? "Yes" : "No";
-    uint16_t apiKeyColor = apiKeyPresent ? TFT_GREEN : TFT_RED;
-    
-    // Switch to TL_DATUM for the labels so they start on the left
-    tft.setTextDatum(TL_DATUM); 
-    tft.drawString("Weather API Key Present:", LABEL_X, STATUS_Y_START);
-
-    // Switch back to TR_DATUM for the values so they align on the right
-    tft.setTextDatum(TR_DATUM);
-    tft.setTextColor(apiKeyColor, COLOR_BACKGROUND);
-    // Draw result ending at the VALUE_END_X coordinate
-    tft.drawString(apiKeyStatus, VALUE_END_X, STATUS_Y_START); 
-    
-    // 2. Location Source Status
-    String locationValue;
-    uint16_t locationColor;
+    uiSetDetail(screen.widgets[IP_API_KEY], apiKeyPresent ? "Yes" : "No", apiKeyPresent ? TFT_GREEN : TFT_RED);
 
+    // City ID or City/Country, whichever mode is selected
+    String locationValue;
+    uint16_t locationColor = TFT_GREEN;
     if (userConfig.use_city_id_mode) {
-        // Using City ID Mode
-        if (userConfig.weather_city_id[0] != '\0') {
-            locationValue = String(userConfig.weather_city_id);
-            locationColor = TFT_GREEN;
-        } else {
-            locationValue = "ID Not Set";
-            locationColor = TFT_RED;
-        }
+        locationValue = userConfig.weather_city_id[0] != '\0' ? String(userConfig.weather_city_id) : "ID Not Set";
+        if (userConfig.weather_city_id[0] == '\0') locationColor = TFT_RED;
+    } else if (userConfig.weather_city[0] != '\0') {
+        locationValue = String(userConfig.weather_city) + ", " + String(userConfig.weather_country_code);
     } else {
-        // Using City Name Mode
-        if (userConfig.weather_city[0] != '\0') {
-            // Using City/Country pair
-            locationValue = String(userConfig.weather_city) + ", " + String(userConfig.weather_country_code);
-            locationColor = TFT_GREEN;
-        } else {
-            locationValue = "City Not Set";
-            locationColor = TFT_RED;
-        }
+        locationValue = "City Not Set";
+        locationColor = TFT_RED;
     }
+    uiSetDetail(screen.widgets[IP_LOCATION], locationValue.c_str(), locationColor);
+}
 
-    // Switch to TL_DATUM for the label
-    tft.setTextDatum(TL_DATUM);
-    tft.setTextColor(TFT_WHITE, COLOR_BACKGROUND);
-    tft.drawString("Location Source:", LABEL_X, STATUS_Y_START + 25);
-    
-    // Switch back to TR_DATUM for the value
-    tft.setTextDatum(TR_DATUM);
-    tft.setTextColor(locationColor, COLOR_BACKGROUND);
-    
-    // Draw the location string, also ending at the VALUE_END_X coordinate
-    tft.drawString(locationValue, VALUE_END_X, STATUS_Y_START + 25); 
-    
-    
-    // --- Footer ---
-    tft.setTextColor(TFT_WHITE, COLOR_BACKGROUND);
-    tft.setTextDatum(MC_DATUM); // Back to Middle-Center for the footer
-    tft.drawString("Tap to return to menu.", DISPLAY_WIDTH / 2, DISPLAY_HEIGHT - 15);
-
-    // --- TOUCH-WAIT LOOP ---
-    int touchEvent = 0;
-    while (touchEvent == 0) {
-        
-        // --- FIX: Handle web server requests ---
-        // This allows the config page to be loaded while this screen is active.
-        // CRITICAL: Handle any incoming web requests (like the / config URL)
-        if (WiFi.status() == WL_CONNECTED) {
-            server.handleClient();
-        }
-        // --------------------------------------
+static UiScreen ipScreen = { "IP Configuration", ipWidgets, sizeof(ipWidgets) / sizeof(ipWidgets[0]), showIpConfig };
 
-        checkTouch(&touchEvent);
-        delay(10); // Reduced delay for better web server responsiveness
+// --- Diagnostics: live counters at 2 Hz. Captions are drawn once; a tick only
+// redraws the value fields whose text changed, and the sparkline after a fetch ---
+#define DIAG_TICK_MS 500
+#define DIAG_ROW(row) (40 + (row) * 20)
+#define DIAG_VALUE_X 150
+enum { DIAG_LOOP = 6, DIAG_HEAP, DIAG_STACK, DIAG_RSSI, DIAG_NTP, DIAG_FETCH, DIAG_SPARK };
+
+static int16_t fetchHistory[METRICS_RECENT_FETCHES];
+static uint32_t fetchesShown = UINT32_MAX;
+static TaskHandle_t asyncTcpTask = nullptr;
+
+static int16_t fetchSample(uint8_t index) { return fetchHistory[index]; }
+
+static UiWidget diagWidgets[] = {
+    uiLabel(BTN_X_START, DIAG_ROW(0), DIAG_VALUE_X - BTN_X_START, 20, "Loop p50/90/99:"),
+    uiLabel(BTN_X_START, DIAG_ROW(1), DIAG_VALUE_X - BTN_X_START, 20, "Heap free/largest:"),
+    uiLabel(BTN_X_START, DIAG_ROW(2), DIAG_VALUE_X - BTN_X_START, 20, "Stack free loop/tcp:"),
+    uiLabel(BTN_X_START, DIAG_ROW(3), DIAG_VALUE_X - BTN_X_START, 20, "Wi-Fi signal:"),
+    uiLabel(BTN_X_START, DIAG_ROW(4), DIAG_VALUE_X - BTN_X_START, 20, "NTP sync age:"),
+    uiLabel(BTN_X_START, DIAG_ROW(5), DIAG_VALUE_X - BTN_X_START, 20, "Weather fetches:"),
+    uiLabel(DIAG_VALUE_X, DIAG_ROW(0), BTN_X_START + BTN_W - DIAG_VALUE_X, 20, ""),
+    uiLabel(DIAG_VALUE_X, DIAG_ROW(1), BTN_X_START + BTN_W - DIAG_VALUE_X, 20, ""),
+    uiLabel(DIAG_VALUE_X, DIAG_ROW(2), BTN_X_START + BTN_W - DIAG_VALUE_X, 20, ""),
+    uiLabel(DIAG_VALUE_X, DIAG_ROW(3), BTN_X_START + BTN_W - DIAG_VALUE_X, 20, ""),
+    uiLabel(DIAG_VALUE_X, DIAG_ROW(4), BTN_X_START + BTN_W - DIAG_VALUE_X, 20, ""),
+    uiLabel(DIAG_VALUE_X, DIAG_ROW(5), BTN_X_START + BTN_W - DIAG_VALUE_X, 20, ""),
+    uiSparkline(BTN_X_START, DIAG_ROW(6) + 4, BTN_W, 232 - DIAG_ROW(6) - 4, TFT_SKYBLUE, fetchSample),
+};
+
+// Microseconds as milliseconds with one decimal
+static void formatMs(char* out, size_t size, uint32_t us) {
+    snprintf(out, size, "%lu.%lu", (unsigned long)(us / 1000), (unsigned long)(us % 1000 / 100));
+}
+
+static void refreshDiagnostics(UiScreen& screen) {
+    char text[UI_TEXT_LEN];
+    char p50[12], p90[12], p99[12];
+    uint32_t p50Us, p90Us, p99Us;
+    metricsLoopPercentiles(p50Us, p90Us, p99Us);
+    formatMs(p50, sizeof(p50), p50Us);
+    formatMs(p90, sizeof(p90), p90Us);
+    formatMs(p99, sizeof(p99), p99Us);
+    snprintf(text, sizeof(text), "%s / %s / %s ms", p50, p90, p99);
+    uiSetDetail(screen.widgets[DIAG_LOOP], text, TFT_WHITE);
+
+    snprintf(text, sizeof(text), "%lu / %lu KB", (unsigned long)(ESP.getFreeHeap() / 1024), (unsigned long)(ESP.getMaxAllocHeap() / 1024));
+    uiSetDetail(screen.widgets[DIAG_HEAP], text, TFT_WHITE);
+
+    // ESP-IDF reports the high-water mark in bytes
+    if (!asyncTcpTask) asyncTcpTask = xTaskGetHandle("async_tcp");
+    unsigned long loopFree = uxTaskGetStackHighWaterMark(NULL);
+    if (asyncTcpTask) {
+        snprintf(text, sizeof(text), "%lu / %lu B", loopFree, (unsigned long)uxTaskGetStackHighWaterMark(asyncTcpTask));
+    } else {
+        snprintf(text, sizeof(text), "%lu B / -", loopFree);
+    }
+    uiSetDetail(screen.widgets[DIAG_STACK], text, TFT_WHITE);
+
+    if (WiFi.status() == WL_CONNECTED) {
+        int rssi = WiFi.RSSI();
+        snprintf(text, sizeof(text), "%d dBm", rssi);
+        uiSetDetail(screen.widgets[DIAG_RSSI], text, rssi > -67 ? TFT_GREEN : rssi > -75 ? TFT_YELLOW : TFT_RED);
+    } else {
+        uiSetDetail(screen.widgets[DIAG_RSSI], "Not connected", TFT_RED);
     }
-    
-    lastActivityTime = millis();
+
+    uint32_t age = timeSyncAgeSeconds();
+    if (age == UINT32_MAX) {
+        uiSetDetail(screen.widgets[DIAG_NTP], "Never synced", TFT_RED);
+    } else {
+        if (age < 120) snprintf(text, sizeof(text), "%lu s", (unsigned long)age);
+        else if (age < 7200) snprintf(text, sizeof(text), "%lu min", (unsigned long)(age / 60));
+        else snprintf(text, sizeof(text), "%lu h", (unsigned long)(age / 3600));
+        uiSetDetail(screen.widgets[DIAG_NTP], text, TFT_WHITE);
+    }
+
+    // Fetch history only changes after a fetch: the sparkline is redrawn then, not every tick
+    uint32_t fetches = metricsWeatherFetches();
+    if (fetches != fetchesShown) {
+        fetchesShown = fetches;
+        UiWidget& spark = screen.widgets[DIAG_SPARK];
+        spark.item_count = metricsRecentFetches(fetchHistory, METRICS_RECENT_FETCHES);
+        spark.dirty = true;
+        if (spark.item_count == 0) {
+            uiSetDetail(screen.widgets[DIAG_FETCH], "None yet", TFT_WHITE);
+        } else {
+            int16_t last = fetchHistory[spark.item_count - 1];
+            snprintf(text, sizeof(text), "last %d ms%s", abs(last), last < 0 ? ", failed" : "");
+            uiSetDetail(screen.widgets[DIAG_FETCH], text, last < 0 ? TFT_RED : TFT_WHITE);
+        }
+    }
+}
+
+static void showDiagnostics(UiScreen& screen) {
+    fetchesShown = UINT32_MAX; // Full draw: fill everything in
+    refreshDiagnostics(screen);
 }
 
+static UiScreen diagScreen = { "Diagnostics", diagWidgets, sizeof(diagWidgets) / sizeof(diagWidgets[0]),
+                               showDiagnostics, refreshDiagnostics, DIAG_TICK_MS };
+
+// --- Main screen (header button: Close) ---
+static void onThemes(UiWidget&)   { Serial.println("[MENU] Themes."); uiPush(themeScreen); }
+static void onDisplay(UiWidget&)  { Serial.println("[MENU] Display & Time."); uiPush(displayScreen); }
+static void onIpConfig(UiWidget&) { Serial.println("[MENU] IP Configuration."); uiPush(ipScreen); }
+static void onDiagnostics(UiWidget&) { Serial.println("[MENU] Diagnostics."); uiPush(diagScreen); }
+
+static UiWidget mainWidgets[] = {
+    uiButton(BTN_X_START, BTN_Y(0), BTN_W, BTN_H, "Themes", MENU_BTN_COLOR_1, onThemes),
+    uiButton(BTN_X_START, BTN_Y(1), BTN_W, BTN_H, "Display & Time", MENU_BTN_COLOR_2, onDisplay),
+    uiButton(BTN_X_START, BTN_Y(2), BTN_W, BTN_H, "IP Configuration", MENU_BTN_COLOR_3, onIpConfig),
+    uiButton(BTN_X_START, BTN_Y(3), BTN_W, BTN_H, "Diagnostics", MENU_BTN_COLOR_7, onDiagnostics),
+    uiButton(BTN_X_START, BTN_Y(4), BTN_W, BTN_H, "Restore to Default Settings", MENU_BTN_COLOR_4, onRestore),
+    // Sleep and Reboot share the last row
+    uiButton(BTN_X_START, BTN_Y(5), BTN_W / 2 - BTN_GAP / 2, BTN_H, "Sleep Now", MENU_BTN_COLOR_5, onSleep),
+    uiButton(BTN_X_START + BTN_W / 2 + BTN_GAP / 2, BTN_Y(5), BTN_W / 2 - BTN_GAP / 2, BTN_H, "Reboot Device", MENU_BTN_COLOR_6, onReboot),
+};
+static UiScreen mainScreen = { "Settings Menu", mainWidgets, sizeof(mainWidgets) / sizeof(mainWidgets[0]), nullptr };
+
 // -------------------------------------------------------------
-// Settings Menu Function.
+// Settings Menu
 // -------------------------------------------------------------
 
 void showMenu() {
-    
-    // --- 1. SETUP ---
-    tft.fillScreen(COLOR_BACKGROUND);
-    tft.setTextColor(TFT_WHITE, COLOR_BACKGROUND);
-    tft.setTextDatum(MC_DATUM); 
-    tft.setFreeFont(NULL);
-    tft.setTextFont(4);
-    tft.drawString("Settings Menu", DISPLAY_WIDTH / 2, 20);
-
-    int yOffset = 45; // Start position for buttons
-
-    // --- 2. DRAW BUTTONS (5 buttons total) ---
-    // Colors replaced with constants defined at the top of the file
-    drawMenuButton(1, "1. IP Configuration", MENU_BTN_COLOR_1, yOffset);
-    drawMenuButton(2, "2. Restore to Default Settings", MENU_BTN_COLOR_2, yOffset); 
-    drawMenuButton(3, "3. Sleep Now", MENU_BTN_COLOR_3, yOffset);
-    drawMenuButton(4, "4. Reboot Device", MENU_BTN_COLOR_4, yOffset);
-    drawMenuButton(5, "5. Exit Menu", MENU_BTN_COLOR_5, yOffset); 
-
-// --- 3. INPUT LOOP (UPDATED WITH TIMEOUT) ---
-    bool menuActive = true;
-    int touchEvent = 0;
-    
-    // Store the time when the menu was opened
-    unsigned long menuStartTime = millis();
-
-    while (menuActive) {
-
-        // CRITICAL: Handle any incoming web requests (like the / config URL)
-        if (WiFi.status() == WL_CONNECTED) {
-            server.handleClient();
-        }
-        
-        // Check for any touch event
-        checkTouch(&touchEvent);
-        
-        // --- TIMEOUT CHECK ---
-        if (millis() - menuStartTime > MENU_TIMEOUT_MS) {
-            Serial.println("[MENU] Timeout reached. Returning to clock.");
-            menuActive = false; // Exit the loop
-            break; // Exit the loop immediately
-        }
-        // ---------------------
-        
-        if (touchEvent != 0) {
-            
-            // A touch was registered, reset the menu timer
-            menuStartTime = millis();
-            
-            // --- 1. IP Configuration ---
-            if (isButtonPressed(1, touchX, touchY, yOffset)) {
-                Serial.println("[MENU] Button 1: IP Configuration pressed.");
-                showIPConfigScreen(); 
-                showMenu(); 
-                return; 
-            }
-
-            // --- 2. Restore to Default Settings ---
-            else if (isButtonPressed(2, touchX, touchY, yOffset)) {
-                Serial.println("[MENU] Button 2: Restore to Default Settings pressed.");
-                performFullReset(); 
-                return; 
-            }
-            
-            // --- 3. Sleep Now (Immediate Deep Sleep) ---
-            else if (isButtonPressed(3, touchX, touchY, yOffset)) {
-                Serial.println("[MENU] Button 3: Sleep Now pressed. Entering Deep Sleep...");
-                tft.fillScreen(COLOR_BACKGROUND);
-                tft.setTextColor(TFT_WHITE, COLOR_BACKGROUND);
-                tft.setTextFont(4);
-                tft.drawString("Going to Sleep...", DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2);
-                delay(500);
-                enterDeepSleep(); 
-                return; 
-            }
-
-            // --- 4. Reboot Device ---
-            else if (isButtonPressed(4, touchX, touchY, yOffset)) {
-                Serial.println("[MENU] Button 4: Reboot Device pressed. Rebooting...");
-                tft.fillScreen(COLOR_BACKGROUND);
-                tft.setTextColor(TFT_RED, COLOR_BACKGROUND);
-                tft.setTextFont(4);
-                tft.drawString("REBOOTING...", DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2);
-                delay(1000);
-                ESP.restart();
-            }
-            
-            // --- 5. Exit Menu ---
-            else if (isButtonPressed(5, touchX, touchY, yOffset)) {
-                Serial.println("[MENU] Button 5: Exit Menu pressed.");
-                menuActive = false;
-            }
-            
-            // Clear the touch event
-            touchEvent = 0;
-        }
-        delay(50); 
+    unsigned long startUs = micros();
+    menuOpen = true;
+    menuChanges = 0;
+    lastMenuTouchMs = millis();
+    uiPush(mainScreen);
+    uint32_t openUs = micros() - startUs;
+    metricsNoteMenuTransition(true, openUs);
+    Serial.printf("[MENU] Opened in %lu ms.\n", (unsigned long)(openUs / 1000));
+}
+
+bool menuActive() {
+    return menuOpen;
+}
+
+/**
+ * @brief Back to the clock: settings that need more than a redraw are applied,
+ * then the clock face is drawn in full.
+ */
+static void closeMenu(unsigned long startUs) {
+    menuOpen = false;
+    if (menuChanges & (CONFIG_CHANGE_WEATHER | CONFIG_CHANGE_FORECAST)) {
+        applyConfigChanges(menuChanges & (CONFIG_CHANGE_WEATHER | CONFIG_CHANGE_FORECAST)); // Refetch in the new units
     }
-    
-    // --- 4. EXIT MENU (Common cleanup) ---
-    tft.fillScreen(COLOR_BACKGROUND);
-    
+
+    tft.fillScreen(currentTheme->background);
+    metricsNoteRedraw((uint32_t)DISPLAY_WIDTH * DISPLAY_HEIGHT);
+
     // Set previous strings to force a full redraw of dynamic elements BEFORE calling draw functions
-    timeStringPrevious = "XX:XX"; 
+    timeStringPrevious = "XX:XX";
     dateStringPrevious = "XX XXX XXXX";
-    
-    drawStaticElements(); 
-    updateTimeDisplay();  
-    updateDateDisplay();  
-    
+
+    drawStaticElements();
+    updateTimeDisplay();
+    updateDateDisplay();
+
     // Conditional draw on exit
     if (current_weather_state == WEATHER_OK) {
         drawWeather();
@@ -318,4 +371,27 @@ void showMenu() {
     }
 
     lastActivityTime = millis(); // Reset sleep timer after exiting
-}
\ No newline at end of file
+    uint32_t closeUs = micros() - startUs;
+    metricsNoteMenuTransition(false, closeUs);
+    Serial.printf("[MENU] Closed in %lu ms.\n", (unsigned long)(closeUs / 1000));
+}
+
+void serviceMenu(bool pressed, uint16_t x, uint16_t y) {
+    if (!menuOpen) return;
+    unsigned long startUs = micros();
+    if (uiService(pressed, x, y)) {
+        lastMenuTouchMs = millis();
+        lastActivityTime = lastMenuTouchMs;
+    } else if (millis() - lastMenuTouchMs > (uiTop() == &diagScreen ? DIAG_TIMEOUT_MS : MENU_TIMEOUT_MS)) {
+        Serial.println("[MENU] Timeout reached. Returning to clock.");
+        uiClear();
+    }
+    if (!uiActive()) closeMenu(startUs);
+}
+
+void menuDismiss() {
+    if (!menuOpen) return;
+    Serial.println("[MENU] Alarm due. Returning to clock.");
+    uiClear();
+    closeMenu(micros());
+}
@@ -43,11 +43,18 @@ extern String weatherStatus;
 // ------------------------------------------------------------------
 
 /**
- * @brief Handles the drawing of the main settings menu and touch interaction.
+ * @brief Opens the settings menu (double-press event).
  *
- * This function is called on a double-press event. It takes over control,
- * draws the menu, and waits for a button press before returning.
+ * Draws the main screen and returns at once: the menu is a stack of widget
+ * screens (UiToolkit.h) that loop() drives through serviceMenu() until it is
+ * closed, times out or an action (sleep, reboot, reset) ends it.
  */
 void showMenu();
+bool menuActive();
+// loop() while the menu is open: raw press state and position (touch, then
+// redraw of the widgets that changed); redraws the clock when the menu closes.
+void serviceMenu(bool pressed, uint16_t x, uint16_t y);
+// Closes the menu from outside it (an alarm is due) and redraws the clock.
+void menuDismiss();
 
 #endif // MENUHANDLER_H
\ No newline at end of file
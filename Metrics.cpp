@@ -0,0 +1,389 @@
+#include "Metrics.h"      // Header for this module
+#include "TimeSync.h"     // For timeSyncAgeSeconds()
+#include "PowerProfile.h" // Backlight-on seconds from the power state accounting
+#include "ConfigStore.h"  // Settings bytes written to NVS
+
+#include <Arduino.h>
+#include <algorithm>
+#include <stdarg.h>
+#include <WiFi.h>
+#include <esp_timer.h>
+#include <ESPAsyncWebServer.h>
+
+// --- LOOP LATENCY BUCKETS ---
+// Upper bounds in microseconds, with the Prometheus 'le' label (seconds) kept as text
+typedef struct {
+    uint32_t le_us;
+    const char* le;
+} LatencyBucket;
+
+static const LatencyBucket LOOP_BUCKETS[] = {
+    { 1000, "0.001" }, { 2500, "0.0025" }, { 5000, "0.005" }, { 10000, "0.01" },
+    { 25000, "0.025" }, { 50000, "0.05" }, { 100000, "0.1" }, { 250000, "0.25" },
+    { 500000, "0.5" }, { 1000000, "1" },
+};
+static const uint8_t LOOP_BUCKET_COUNT = sizeof(LOOP_BUCKETS) / sizeof(LOOP_BUCKETS[0]);
+
+static const char* const TOUCH_TYPES[] = { "single", "double", "long", "swipe" };
+static const char* const MENU_TRANSITIONS[] = { "open", "close" };
+
+/**
+ * @brief Every value /metrics reports. The live copy is updated by the main task;
+ * a scrape copies it once so all chunks of one response agree.
+ */
+typedef struct {
+    uint32_t uptime_s;
+    uint32_t heap_free;
+    uint32_t heap_largest;
+    uint32_t heap_min_free;
+    uint32_t loop_buckets[LOOP_BUCKET_COUNT + 1]; // Per bucket (not cumulative), last = +Inf
+    uint32_t loop_count;
+    uint64_t loop_sum_us;
+    uint32_t weather_fetches;
+    uint32_t weather_failures;
+    uint64_t weather_sum_ms;
+    int32_t weather_last_error_http;             // 0 = no failed fetch yet
+    uint32_t ntp_age_s;                          // UINT32_MAX = never synced
+    bool wifi_connected;
+    int8_t wifi_rssi;
+    uint32_t wifi_reconnects;
+    uint32_t touches[4];
+    uint32_t backlight_on_s;
+    uint64_t redraw_pixels;
+    uint32_t config_nvs_bytes;
+    uint32_t menu_interactions;
+    uint64_t menu_interaction_pixels;
+    uint64_t menu_transition_sum_us[2];          // [0] open, [1] close
+    uint32_t menu_transitions[2];
+} MetricsSnapshot;
+
+// --- STATE ---
+static MetricsSnapshot live = {};
+static MetricsSnapshot scrape = {};
+static volatile bool wifiEverConnected = false;
+
+// Scrape in flight: one at a time, each metric rendered into 'block' when its turn comes
+static volatile bool scrapeActive = false;
+static char block[1024];
+static size_t blockLength = 0;
+static size_t blockSent = 0;
+static uint8_t nextMetric = 0;
+static unsigned long scrapeStartMs = 0;
+
+// Recent samples (diagnostics screen): ring buffers, written by the main task only
+static uint32_t recentLoops[METRICS_RECENT_LOOPS];
+static int16_t recentFetches[METRICS_RECENT_FETCHES];
+
+
+/**
+ * @brief Appends to a fixed buffer and keeps track of the length. Output that does
+ * not fit is dropped (the buffer is sized for the largest metric).
+ */
+static void appendf(char* out, size_t size, size_t& length, const char* format, ...) {
+    if (length >= size) return;
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(out + length, size - length, format, args);
+    va_end(args);
+    if (n > 0) length = min(length + (size_t)n, size - 1);
+}
+
+/**
+ * @brief Microseconds as decimal seconds with integer arithmetic only
+ * (float printf may allocate in newlib).
+ */
+static void appendSeconds(char* out, size_t size, size_t& length, uint64_t us) {
+    appendf(out, size, length, "%llu.%06lu", (unsigned long long)(us / 1000000ULL), (unsigned long)(us % 1000000ULL));
+}
+
+// --- SAMPLE WRITERS ---
+// One per metric; they read the scrape snapshot and write the sample lines.
+
+static void samplesUptime(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.uptime_s);
+}
+
+static void samplesHeapFree(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.heap_free);
+}
+
+static void samplesHeapLargest(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.heap_largest);
+}
+
+static void samplesHeapMinFree(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.heap_min_free);
+}
+
+static void samplesLoopLatency(char* out, size_t size, size_t& length, const char* name) {
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < LOOP_BUCKET_COUNT; i++) {
+        cumulative += scrape.loop_buckets[i];
+        appendf(out, size, length, "%s_bucket{le=\"%s\"} %lu\n", name, LOOP_BUCKETS[i].le, (unsigned long)cumulative);
+    }
+    appendf(out, size, length, "%s_bucket{le=\"+Inf\"} %lu\n", name, (unsigned long)scrape.loop_count);
+    appendf(out, size, length, "%s_sum ", name);
+    appendSeconds(out, size, length, scrape.loop_sum_us);
+    appendf(out, size, length, "\n%s_count %lu\n", name, (unsigned long)scrape.loop_count);
+}
+
+static void samplesWeatherFetches(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.weather_fetches);
+}
+
+static void samplesWeatherFailures(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.weather_failures);
+}
+
+static void samplesWeatherDuration(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s_sum ", name);
+    appendSeconds(out, size, length, scrape.weather_sum_ms * 1000ULL);
+    appendf(out, size, length, "\n%s_count %lu\n", name, (unsigned long)scrape.weather_fetches);
+}
+
+static void samplesWeatherLastError(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %ld\n", name, (long)scrape.weather_last_error_http);
+}
+
+static void samplesNtpAge(char* out, size_t size, size_t& length, const char* name) {
+    if (scrape.ntp_age_s == UINT32_MAX) return; // No sample until the first sync
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.ntp_age_s);
+}
+
+static void samplesWifiConnected(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %d\n", name, scrape.wifi_connected ? 1 : 0);
+}
+
+static void samplesWifiRssi(char* out, size_t size, size_t& length, const char* name) {
+    if (!scrape.wifi_connected) return; // RSSI is meaningless while disconnected
+    appendf(out, size, length, "%s %d\n", name, scrape.wifi_rssi);
+}
+
+static void samplesWifiReconnects(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.wifi_reconnects);
+}
+
+static void samplesTouches(char* out, size_t size, size_t& length, const char* name) {
+    for (uint8_t i = 0; i < 4; i++) {
+        appendf(out, size, length, "%s{type=\"%s\"} %lu\n", name, TOUCH_TYPES[i], (unsigned long)scrape.touches[i]);
+    }
+}
+
+static void samplesBacklightOn(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.backlight_on_s);
+}
+
+static void samplesRedrawPixels(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %llu\n", name, (unsigned long long)scrape.redraw_pixels);
+}
+
+static void samplesConfigBytes(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.config_nvs_bytes);
+}
+
+static void samplesMenuTransitions(char* out, size_t size, size_t& length, const char* name) {
+    for (uint8_t i = 0; i < 2; i++) {
+        appendf(out, size, length, "%s_sum{action=\"%s\"} ", name, MENU_TRANSITIONS[i]);
+        appendSeconds(out, size, length, scrape.menu_transition_sum_us[i]);
+        appendf(out, size, length, "\n%s_count{action=\"%s\"} %lu\n", name, MENU_TRANSITIONS[i],
+                (unsigned long)scrape.menu_transitions[i]);
+    }
+}
+
+static void samplesMenuInteractions(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %lu\n", name, (unsigned long)scrape.menu_interactions);
+}
+
+static void samplesMenuPixels(char* out, size_t size, size_t& length, const char* name) {
+    appendf(out, size, length, "%s %llu\n", name, (unsigned long long)scrape.menu_interaction_pixels);
+}
+
+// --- REGISTRY ---
+typedef struct {
+    const char* name;
+    const char* type;
+    const char* help;
+    void (*samples)(char* out, size_t size, size_t& length, const char* name);
+} MetricDef;
+
+static const MetricDef METRICS[] = {
+    { "flipclock_uptime_seconds", "gauge", "Seconds since boot.", samplesUptime },
+    { "flipclock_heap_free_bytes", "gauge", "Free heap.", samplesHeapFree },
+    { "flipclock_heap_largest_block_bytes", "gauge", "Largest allocatable heap block.", samplesHeapLargest },
+    { "flipclock_heap_min_free_bytes", "gauge", "Lowest free heap since boot.", samplesHeapMinFree },
+    { "flipclock_loop_duration_seconds", "histogram", "Busy time of one loop() iteration (excludes the idle delay).", samplesLoopLatency },
+    { "flipclock_weather_fetches_total", "counter", "Weather fetch attempts that reached the network.", samplesWeatherFetches },
+    { "flipclock_weather_failures_total", "counter", "Weather fetches that did not return usable data.", samplesWeatherFailures },
+    { "flipclock_weather_fetch_duration_seconds", "summary", "Time spent in weather fetches (connect, request and parse).", samplesWeatherDuration },
+    { "flipclock_weather_last_error_http_code", "gauge", "HTTP status of the last failed fetch (negative = client error, 0 = none).", samplesWeatherLastError },
+    { "flipclock_ntp_sync_age_seconds", "gauge", "Seconds since the last NTP sync (absent until the first one).", samplesNtpAge },
+    { "flipclock_wifi_connected", "gauge", "1 while the station is connected.", samplesWifiConnected },
+    { "flipclock_wifi_rssi_dbm", "gauge", "Signal strength of the current access point.", samplesWifiRssi },
+    { "flipclock_wifi_reconnects_total", "counter", "Connections after the first one since boot.", samplesWifiReconnects },
+    { "flipclock_touch_events_total", "counter", "Recognized touch gestures.", samplesTouches },
+    { "flipclock_backlight_on_seconds_total", "counter", "Seconds with the backlight on, full or dimmed (since power-on).", samplesBacklightOn },
+    { "flipclock_redraw_pixels_total", "counter", "Pixels filled by redraws (cards, cleared areas, full screens).", samplesRedrawPixels },
+    { "flipclock_config_nvs_bytes_written_total", "counter", "Settings bytes written to NVS (changed keys only).", samplesConfigBytes },
+    { "flipclock_menu_transition_seconds", "summary", "Menu open (double tap to menu drawn) and close (last tap to clock redrawn).", samplesMenuTransitions },
+    { "flipclock_menu_interactions_total", "counter", "Press-to-release sequences on the menu.", samplesMenuInteractions },
+    { "flipclock_menu_interaction_pixels_total", "counter", "Pixels redrawn by menu interactions (divide by interactions for the average).", samplesMenuPixels },
+};
+static const uint8_t METRIC_COUNT = sizeof(METRICS) / sizeof(METRICS[0]);
+
+
+/**
+ * @brief Renders one metric (HELP, TYPE and its samples) into 'block'.
+ */
+static size_t renderMetric(const MetricDef& metric) {
+    size_t length = 0;
+    appendf(block, sizeof(block), length, "# HELP %s %s\n# TYPE %s %s\n",
+            metric.name, metric.help, metric.name, metric.type);
+    metric.samples(block, sizeof(block), length, metric.name);
+    return length;
+}
+
+/**
+ * @brief Response filler: walks the registry, rendering each metric into the static
+ * block buffer when the previous one has been sent. No heap is touched.
+ */
+static size_t fillMetrics(uint8_t* buffer, size_t maxLen, size_t index) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (blockSent == blockLength) {
+            if (nextMetric >= METRIC_COUNT) break;
+            blockLength = renderMetric(METRICS[nextMetric++]);
+            blockSent = 0;
+        }
+        size_t chunk = min(blockLength - blockSent, maxLen - written);
+        memcpy(buffer + written, block + blockSent, chunk);
+        blockSent += chunk;
+        written += chunk;
+    }
+    if (written == 0) {
+        Serial.printf("Metrics: %u bytes in %lu ms.\n", (unsigned)index, millis() - scrapeStartMs);
+        scrapeActive = false;
+    }
+    return written; // 0 ends the response
+}
+
+static void handleMetrics(AsyncWebServerRequest* request) {
+    if (scrapeActive) {
+        AsyncWebServerResponse* response = request->beginResponse(503, "text/plain", "Scrape in progress");
+        response->addHeader("Retry-After", "1");
+        request->send(response);
+        return;
+    }
+    scrapeActive = true;
+    scrapeStartMs = millis();
+    request->onDisconnect([]() { scrapeActive = false; });
+
+    // Counters are word-sized and only incremented by the main task; a copy is good enough
+    scrape = live;
+    scrape.uptime_s = (uint32_t)(esp_timer_get_time() / 1000000LL);
+    scrape.heap_free = ESP.getFreeHeap();
+    scrape.heap_largest = ESP.getMaxAllocHeap();
+    scrape.heap_min_free = ESP.getMinFreeHeap();
+    scrape.ntp_age_s = timeSyncAgeSeconds();
+    scrape.wifi_connected = WiFi.status() == WL_CONNECTED;
+    scrape.wifi_rssi = scrape.wifi_connected ? WiFi.RSSI() : 0;
+    scrape.backlight_on_s = powerStateSeconds(POWER_STATE_ACTIVE) + powerStateSeconds(POWER_STATE_DIMMED);
+    scrape.config_nvs_bytes = configStoreBytesWritten();
+
+    blockLength = 0;
+    blockSent = 0;
+    nextMetric = 0;
+    AsyncWebServerResponse* response = request->beginChunkedResponse("text/plain; version=0.0.4; charset=utf-8", fillMetrics);
+    response->addHeader("Cache-Control", "no-store");
+    request->send(response);
+}
+
+/**
+ * @brief Counts every station connection after the first as a reconnect.
+ * Runs on the Wi-Fi event task.
+ */
+static void onWifiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    if (event != ARDUINO_EVENT_WIFI_STA_GOT_IP) return;
+    if (wifiEverConnected) live.wifi_reconnects++;
+    wifiEverConnected = true;
+}
+
+void metricsBegin() {
+    WiFi.onEvent(onWifiEvent, ARDUINO_EVENT_WIFI_STA_GOT_IP);
+}
+
+void metricsAttach(AsyncWebServer& server) {
+    server.on("/metrics", HTTP_GET, handleMetrics);
+}
+
+void metricsNoteLoop(uint32_t busyUs) {
+    uint8_t bucket = 0;
+    while (bucket < LOOP_BUCKET_COUNT && busyUs > LOOP_BUCKETS[bucket].le_us) bucket++;
+    live.loop_buckets[bucket]++;
+    live.loop_count++;
+    live.loop_sum_us += busyUs;
+    recentLoops[live.loop_count % METRICS_RECENT_LOOPS] = busyUs;
+}
+
+void metricsNoteTouch(int touchEvent) {
+    if (touchEvent < 1 || touchEvent > 4) return;
+    live.touches[touchEvent - 1]++;
+}
+
+void metricsNoteWeatherFetch(bool ok, uint32_t durationMs, int httpCode) {
+    live.weather_fetches++;
+    live.weather_sum_ms += durationMs;
+    int16_t clipped = (int16_t)min(durationMs, (uint32_t)INT16_MAX);
+    recentFetches[live.weather_fetches % METRICS_RECENT_FETCHES] = ok ? clipped : -clipped;
+    if (!ok) {
+        live.weather_failures++;
+        live.weather_last_error_http = httpCode;
+    }
+}
+
+void metricsNoteRedraw(uint32_t pixels) {
+    live.redraw_pixels += pixels;
+}
+
+void metricsNoteUiInteraction(uint32_t pixels) {
+    live.menu_interactions++;
+    live.menu_interaction_pixels += pixels;
+}
+
+void metricsNoteMenuTransition(bool open, uint32_t us) {
+    uint8_t index = open ? 0 : 1;
+    live.menu_transitions[index]++;
+    live.menu_transition_sum_us[index] += us;
+}
+
+/**
+ * @brief Percentiles of the recent loop passes. Sorts a copy (a few hundred
+ * bytes of stack), so it is meant for a screen refreshing a few times a second.
+ */
+void metricsLoopPercentiles(uint32_t& p50Us, uint32_t& p90Us, uint32_t& p99Us) {
+    uint32_t count = min(live.loop_count, (uint32_t)METRICS_RECENT_LOOPS);
+    if (count == 0) {
+        p50Us = p90Us = p99Us = 0;
+        return;
+    }
+    uint32_t sorted[METRICS_RECENT_LOOPS];
+    memcpy(sorted, recentLoops, sizeof(sorted));
+    // Before the ring has wrapped, the filled slots are 1..count
+    uint32_t* first = count < METRICS_RECENT_LOOPS ? sorted + 1 : sorted;
+    std::sort(first, first + count);
+    p50Us = first[(count - 1) * 50 / 100];
+    p90Us = first[(count - 1) * 90 / 100];
+    p99Us = first[(count - 1) * 99 / 100];
+}
+
+uint8_t metricsRecentFetches(int16_t* durationsMs, uint8_t capacity) {
+    uint32_t total = live.weather_fetches;
+    uint8_t count = (uint8_t)min(total, (uint32_t)min((int)capacity, METRICS_RECENT_FETCHES));
+    for (uint8_t i = 0; i < count; i++) {
+        durationsMs[i] = recentFetches[(total - count + 1 + i) % METRICS_RECENT_FETCHES];
+    }
+    return count;
+}
+
+uint32_t metricsWeatherFetches() {
+    return live.weather_fetches;
+}
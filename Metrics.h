@@ -0,0 +1,27 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+
+class AsyncWebServer;
+
+// --- FUNCTION PROTOTYPES ---
+void metricsBegin();                       // setup(), before Wi-Fi: hooks the reconnect counter
+void metricsAttach(AsyncWebServer& server); // Registers /metrics (Prometheus text format)
+
+// Counters fed by the main task (plain increments, no locking or allocation)
+void metricsNoteLoop(uint32_t busyUs);     // loop(): time spent in this iteration
+void metricsNoteTouch(int touchEvent);     // loop(): 1 single, 2 double, 3 long, 4 swipe
+void metricsNoteWeatherFetch(bool ok, uint32_t durationMs, int httpCode);
+void metricsNoteRedraw(uint32_t pixels);   // Area filled by a redraw (cards, clears, full screens)
+void metricsNoteUiInteraction(uint32_t pixels); // Menu: one press-to-release and the pixels it redrew
+void metricsNoteMenuTransition(bool open, uint32_t us); // Menu drawn after a double tap / clock back after closing
+
+// Recent history for the on-device diagnostics screen (main task)
+#define METRICS_RECENT_LOOPS 128
+#define METRICS_RECENT_FETCHES 32
+void metricsLoopPercentiles(uint32_t& p50Us, uint32_t& p90Us, uint32_t& p99Us); // Last METRICS_RECENT_LOOPS passes, 0 = none yet
+uint8_t metricsRecentFetches(int16_t* durationsMs, uint8_t capacity); // Oldest first, failures negative; returns the count
+uint32_t metricsWeatherFetches();
+
+#endif // METRICS_H
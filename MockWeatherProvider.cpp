@@ -0,0 +1,91 @@
+#include "WeatherProvider.h"  // Provider interface
+#include "config.h"           // For MOCK_WEATHER_* test knobs
+
+// --- CANNED PAYLOAD (same shape as /data/2.5/weather) ---
+static const char MOCK_WEATHER_PAYLOAD[] PROGMEM = R"raw({"coord":{"lon":-74.006,"lat":40.7143},"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"base":"stations","main":{"temp":54.3,"feels_like":53.1,"temp_min":52.0,"temp_max":56.1,"pressure":1012,"humidity":87},"visibility":10000,"wind":{"speed":9.2,"deg":70},"clouds":{"all":100},"dt":1730000000,"sys":{"country":"US","sunrise":1729940000,"sunset":1729978000},"timezone":-14400,"id":5128581,"name":"New York","cod":200})raw";
+
+/**
+ * @brief Read-only stream over the canned payload, preceded by optional
+ * whitespace padding so parser cost can be measured against payload size.
+ */
+class MockPayloadStream : public Stream {
+public:
+    MockPayloadStream(const char* data, size_t length, size_t padding)
+        : _data(data), _length(length), _padding(padding), _pos(0) {}
+    int available() override { return (int)(_padding + _length - _pos); }
+    int read() override {
+        int c = peek();
+        if (c >= 0) _pos++;
+        return c;
+    }
+    int peek() override {
+        if (_pos < _padding) return ' ';
+        if (_pos < _padding + _length) return _data[_pos - _padding];
+        return -1;
+    }
+    size_t write(uint8_t) override { return 0; }
+private:
+    const char* _data;
+    size_t _length;
+    size_t _padding;
+    size_t _pos;
+};
+
+
+WeatherResult MockWeatherProvider::checkConfig(const WeatherLocation&) const {
+    return WEATHER_RESULT_OK; // No key or location needed
+}
+
+bool MockWeatherProvider::buildRequest(const WeatherLocation&, String& url) const {
+    url = MOCK_WEATHER_URL;
+    return url.length() > 0;
+}
+
+/**
+ * @brief Serves the loopback/file payload with the configured latency and error injection.
+ */
+WeatherResult MockWeatherProvider::fetch(const WeatherLocation& location, WeatherRecord& record, WeatherFetchStats& stats) const {
+    if (MOCK_WEATHER_LATENCY_MS > 0) {
+        delay(MOCK_WEATHER_LATENCY_MS);
+    }
+
+    // Remote mock server: normal HTTP path, OWM-shaped body
+    if (MOCK_WEATHER_URL[0] != '\0') {
+        WeatherResult result = WeatherProvider::fetch(location, record, stats);
+        stats.total_ms += MOCK_WEATHER_LATENCY_MS;
+        return result;
+    }
+
+    // Canned payload from flash
+    memset(&stats, 0, sizeof(stats));
+    stats.http_code = MOCK_WEATHER_HTTP_CODE;
+    stats.total_ms = MOCK_WEATHER_LATENCY_MS;
+    if (MOCK_WEATHER_HTTP_CODE != 200) {
+        return classifyError(MOCK_WEATHER_HTTP_CODE);
+    }
+
+    MockPayloadStream stream(MOCK_WEATHER_PAYLOAD, strlen(MOCK_WEATHER_PAYLOAD), MOCK_WEATHER_PAD_BYTES);
+    unsigned long parseStart = micros();
+    WeatherResult result = parse(stream, record);
+    stats.parse_us = micros() - parseStart;
+    stats.response_bytes = MOCK_WEATHER_PAD_BYTES + strlen(MOCK_WEATHER_PAYLOAD);
+    stats.total_ms += stats.parse_us / 1000;
+    return result;
+}
+
+/**
+ * @brief Serves every location from the mock, one simulated request each.
+ */
+void MockWeatherProvider::fetchBatch(const WeatherLocation* locations, uint8_t count, WeatherRecord* records,
+                                     WeatherResult* results, WeatherFetchStats& stats) const {
+    memset(&stats, 0, sizeof(stats));
+    for (uint8_t i = 0; i < count; i++) {
+        WeatherFetchStats one;
+        results[i] = fetch(locations[i], records[i], one);
+        stats.http_code = one.http_code;
+        stats.request_bytes += one.request_bytes;
+        stats.response_bytes += one.response_bytes;
+        stats.total_ms += one.total_ms;
+        stats.parse_us += one.parse_us;
+    }
+}
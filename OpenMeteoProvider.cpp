@@ -0,0 +1,101 @@
+#include "WeatherProvider.h"  // Provider interface
+#include "WeatherUtilities.h" // For getWeatherLabel()
+#include "config.h"           // For OPENMETEO_URL_BASE
+#include "UserConfig.h"       // For the userConfig struct
+
+#include <ArduinoJson.h>
+
+extern userConfig_t userConfig;
+
+
+/**
+ * @brief Maps a WMO weather interpretation code (Open-Meteo "weather_code")
+ * to the nearest OWM condition ID so icons and colours resolve the same way.
+ */
+static uint16_t wmoToOwmCondition(int code) {
+    switch (code) {
+        case 0:  return 800;                        // Clear sky
+        case 1:  return 801;                        // Mainly clear
+        case 2:  return 802;                        // Partly cloudy
+        case 3:  return 804;                        // Overcast
+        case 45: case 48: return 741;               // Fog, depositing rime fog
+        case 51: return 300;                        // Drizzle: light
+        case 53: return 301;                        //          moderate
+        case 55: return 302;                        //          dense
+        case 56: case 57: return 511;               // Freezing drizzle
+        case 61: return 500;                        // Rain: slight
+        case 63: return 501;                        //       moderate
+        case 65: return 502;                        //       heavy
+        case 66: case 67: return 511;               // Freezing rain
+        case 71: return 600;                        // Snow: slight
+        case 73: return 601;                        //       moderate
+        case 75: return 602;                        //       heavy
+        case 77: return 600;                        // Snow grains
+        case 80: return 520;                        // Rain showers: slight
+        case 81: return 521;                        //               moderate
+        case 82: return 522;                        //               violent
+        case 85: return 620;                        // Snow showers: slight
+        case 86: return 621;                        //               heavy
+        case 95: return 211;                        // Thunderstorm
+        case 96: case 99: return 201;               // Thunderstorm with hail
+    }
+    return 0; // Unknown
+}
+
+
+/**
+ * @brief Open-Meteo is keyless but needs coordinates.
+ */
+WeatherResult OpenMeteoProvider::checkConfig(const WeatherLocation&) const {
+    if (userConfig.latitude == 0.0f && userConfig.longitude == 0.0f) {
+        return WEATHER_RESULT_NO_LOCATION;
+    }
+    return WEATHER_RESULT_OK;
+}
+
+bool OpenMeteoProvider::buildRequest(const WeatherLocation&, String& url) const {
+    char query[160];
+    snprintf(query, sizeof(query),
+             "latitude=%.4f&longitude=%.4f&current=temperature_2m,weather_code,is_day&temperature_unit=%s",
+             userConfig.latitude, userConfig.longitude,
+             userConfig.use_fahrenheit ? "fahrenheit" : "celsius");
+    url = OPENMETEO_URL_BASE;
+    url += query;
+    Serial.printf("Weather Source: Coordinates (%.4f, %.4f)\n", userConfig.latitude, userConfig.longitude);
+    return true;
+}
+
+/**
+ * @brief Parses the "current" block of the /v1/forecast body.
+ */
+WeatherResult OpenMeteoProvider::parse(Stream& stream, WeatherRecord& record) const {
+    StaticJsonDocument<128> filter;
+    filter["latitude"] = true;
+    filter["longitude"] = true;
+    filter["current"]["temperature_2m"] = true;
+    filter["current"]["weather_code"] = true;
+    filter["current"]["is_day"] = true;
+
+    StaticJsonDocument<256> doc;
+    DeserializationError error = deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+    if (error) {
+        Serial.print("JSON Parsing FAILED: ");
+        Serial.println(error.f_str());
+        return WEATHER_RESULT_PARSE;
+    }
+    JsonObject current = doc["current"];
+    if (current.isNull() || current["temperature_2m"].isNull()) {
+        return WEATHER_RESULT_PARSE;
+    }
+
+    record.temperature = current["temperature_2m"];
+    record.condition_id = wmoToOwmCondition(current["weather_code"] | -1);
+    record.is_day = (current["is_day"] | 1) != 0;
+    record.latitude = doc["latitude"] | 0.0f;
+    record.longitude = doc["longitude"] | 0.0f;
+    // Open-Meteo has no free-text description; use the condition label
+    strncpy(record.description, getWeatherLabel(record.condition_id), sizeof(record.description) - 1);
+    record.description[sizeof(record.description) - 1] = '\0';
+    record.name[0] = '\0'; // Filled from the configured city by the caller
+    return WEATHER_RESULT_OK;
+}
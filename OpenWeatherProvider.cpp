@@ -0,0 +1,259 @@
+#include "WeatherProvider.h"  // Provider interface
+#include "config.h"           // For OPENWEATHER_URL_BASE
+#include "UserConfig.h"       // For the userConfig struct
+
+#include <ArduinoJson.h>
+
+extern userConfig_t userConfig;
+extern bool weatherQuotaTake(); // Counts one request against the daily quota (WeatherHandler.cpp)
+
+
+/**
+ * @brief Custom URL encoder for City Names. Required for OWM API calls.
+ * @param str The string to encode (e.g., "New York").
+ * @return The URL-encoded string (e.g., "New+York").
+ */
+static String manualUrlEncode(const String& str) {
+    String encodedString = "";
+    char c;
+    char code0;
+    char code1;
+    for (int i = 0; i < str.length(); i++) {
+        c = str.charAt(i);
+        // Standard safe characters: alphanumeric, -._~
+        if (c == ' ') {
+            encodedString += '+';
+            // Common for query strings
+        } else if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            encodedString += c;
+        } else {
+            // Hex encoding logic
+            code0 = (c & 0xf) + '0';
+            if ((c & 0xf) > 9) {
+                code0 = (c & 0xf) - 10 + 'A';
+            }
+            c = (c >> 4) & 0xf;
+            code1 = c + '0';
+            if (c > 9) {
+                code1 = c - 10 + 'A';
+            }
+            encodedString += '%';
+            encodedString += code1;
+            encodedString += code0;
+        }
+    }
+    return encodedString;
+}
+
+
+/**
+ * @brief Appends the units and API key parameters.
+ */
+static void appendOpenWeatherUnits(String& url) {
+    // Append Units based on user configuration
+    if (userConfig.use_fahrenheit) {
+        url += "&units=imperial";
+    } else {
+        url += "&units=metric";
+    }
+    
+    url += "&appid=";
+    url += userConfig.weather_api_key; 
+}
+
+/**
+ * @brief Appends the location, units and API key query parameters for OWM calls.
+ * Shared by the current-conditions and forecast requests.
+ * @param url The URL being built (already holding the endpoint base).
+ * @param location City ID, or City/Country pair when the ID is empty.
+ */
+void appendOpenWeatherQuery(String& url, const WeatherLocation& location) {
+    if (location.city_id[0] != '\0') {
+        // Mode 1: Use City ID
+        url += "id=";
+        url += location.city_id;
+        Serial.printf("Weather Source: ID (%s)\n", location.city_id); 
+    } else {
+        // Mode 2: Use City Name (URL-Encoding required)
+        url += "q=";
+        String cityUrlEncoded = manualUrlEncode(location.city);
+        
+        url += cityUrlEncoded;
+        url += ",";
+        url += location.country_code;
+        Serial.printf("Weather Source: Location (%s, %s)\n", location.city, location.country_code);
+    }
+    
+    appendOpenWeatherUnits(url);
+}
+
+/**
+ * @brief OWM needs an API key plus either a City ID or a City/Country pair.
+ */
+WeatherResult OpenWeatherProvider::checkConfig(const WeatherLocation& location) const {
+    if (userConfig.weather_api_key[0] == '\0') {
+        return WEATHER_RESULT_NO_KEY;
+    }
+    if (location.city_id[0] == '\0' && (location.city[0] == '\0' || location.country_code[0] == '\0')) {
+        return WEATHER_RESULT_NO_LOCATION;
+    }
+    return WEATHER_RESULT_OK;
+}
+
+bool OpenWeatherProvider::buildRequest(const WeatherLocation& location, String& url) const {
+    url = OPENWEATHER_URL_BASE;
+    appendOpenWeatherQuery(url, location);
+    return true;
+}
+
+/**
+ * @brief Parses the /data/2.5/weather body, keeping only the fields we use.
+ */
+WeatherResult OpenWeatherProvider::parse(Stream& stream, WeatherRecord& record) const {
+    StaticJsonDocument<192> filter;
+    filter["main"]["temp"] = true;
+    filter["weather"][0]["id"] = true;
+    filter["weather"][0]["description"] = true;
+    filter["weather"][0]["icon"] = true;
+    filter["coord"] = true;
+    filter["name"] = true;
+
+    StaticJsonDocument<512> doc;
+    DeserializationError error = deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+    if (error) {
+        Serial.print("JSON Parsing FAILED: ");
+        Serial.println(error.f_str());
+        return WEATHER_RESULT_PARSE;
+    }
+    if (doc["main"]["temp"].isNull() || doc["weather"][0]["id"].isNull()) {
+        return WEATHER_RESULT_PARSE;
+    }
+
+    const char* description = doc["weather"][0]["description"] | "";
+    const char* icon = doc["weather"][0]["icon"]; // e.g. "01d" / "01n"
+
+    record.temperature = doc["main"]["temp"];
+    record.condition_id = doc["weather"][0]["id"];
+    record.is_day = (icon == nullptr || icon[2] != 'n');
+    record.latitude = doc["coord"]["lat"] | 0.0f;
+    record.longitude = doc["coord"]["lon"] | 0.0f;
+    strncpy(record.description, description, sizeof(record.description) - 1);
+    record.description[sizeof(record.description) - 1] = '\0';
+    strncpy(record.name, doc["name"] | "", sizeof(record.name) - 1);
+    record.name[sizeof(record.name) - 1] = '\0';
+    return WEATHER_RESULT_OK;
+}
+
+/**
+ * @brief Parses the /data/2.5/forecast body into 'ring'. Each element of "list"
+ * is deserialized on its own, so memory use does not grow with the payload size.
+ * @return WEATHER_RESULT_OK only if every element parsed.
+ */
+WeatherResult OpenWeatherProvider::parseForecast(Stream& stream, ForecastRing& ring) const {
+    // Only the fields stored in a ForecastEntry are kept by the parser
+    StaticJsonDocument<128> filter;
+    filter["dt"] = true;
+    filter["main"]["temp"] = true;
+    filter["weather"][0]["id"] = true;
+    filter["pop"] = true;
+    filter["sys"]["pod"] = true;
+
+    WeatherResult result = WEATHER_RESULT_PARSE;
+    forecastRingClear(ring);
+    if (!stream.find("\"list\":[")) return result;
+    do {
+        StaticJsonDocument<256> doc;
+        DeserializationError error = deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+        if (error) {
+            Serial.print("Forecast JSON Parsing FAILED: ");
+            Serial.println(error.f_str());
+            return WEATHER_RESULT_PARSE;
+        }
+        if (doc["dt"].isNull()) {
+            return WEATHER_RESULT_PARSE;
+        }
+
+        forecastRingPush(ring, forecastPack(doc["dt"], doc["main"]["temp"].as<float>(), doc["weather"][0]["id"],
+                                            doc["pop"].as<float>(), doc["sys"]["pod"]));
+        result = WEATHER_RESULT_OK;
+    } while (stream.findUntil(",", "]"));
+    return result;
+}
+
+/**
+ * @brief Fetches all locations with one /group?id=a,b,c request when every
+ * location has a City ID; otherwise falls back to sequential requests.
+ * The group request and each fallback request are charged to the daily quota.
+ */
+void OpenWeatherProvider::fetchBatch(const WeatherLocation* locations, uint8_t count, WeatherRecord* records,
+                                     WeatherResult* results, WeatherFetchStats& stats) const {
+    bool allIds = count > 1;
+    for (uint8_t i = 0; i < count && allIds; i++) {
+        allIds = locations[i].city_id[0] != '\0';
+    }
+    if (!allIds || WiFi.status() != WL_CONNECTED) {
+        WeatherProvider::fetchBatch(locations, count, records, results, stats);
+        return;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    if (!weatherQuotaTake()) {
+        for (uint8_t i = 0; i < count; i++) results[i] = WEATHER_RESULT_QUOTA;
+        return;
+    }
+
+    String url = OPENWEATHER_GROUP_URL_BASE;
+    url += "id=";
+    for (uint8_t i = 0; i < count; i++) {
+        if (i > 0) url += ",";
+        url += locations[i].city_id;
+    }
+    appendOpenWeatherUnits(url);
+    stats.request_bytes = url.length();
+
+    unsigned long start = millis();
+    stats.connections = 1;
+    WiFiClientSecure client;
+    client.setInsecure();
+    HTTPClient http;
+    http.useHTTP10(true);
+    http.begin(client, url);
+    int httpResponseCode = http.GET();
+    stats.http_code = httpResponseCode;
+
+    if (httpResponseCode != 200) {
+        http.end();
+        WeatherResult error = classifyError(httpResponseCode);
+        if (error == WEATHER_RESULT_AUTH || error == WEATHER_RESULT_RATE_LIMITED) {
+            for (uint8_t i = 0; i < count; i++) results[i] = error;
+            stats.total_ms = millis() - start;
+            return;
+        }
+        // Group endpoint unavailable for this key: one request per location instead
+        Serial.printf("Group request failed (HTTP %d). Falling back to sequential requests.\n", httpResponseCode);
+        uint32_t groupRequestBytes = stats.request_bytes;
+        WeatherProvider::fetchBatch(locations, count, records, results, stats);
+        stats.request_bytes += groupRequestBytes;
+        stats.connections++; // The group request's own connection
+        stats.total_ms = millis() - start;
+        return;
+    }
+
+    for (uint8_t i = 0; i < count; i++) results[i] = WEATHER_RESULT_PARSE;
+
+    // The "list" array is returned in the order of the requested IDs; parse one element at a time
+    Stream& stream = http.getStream();
+    unsigned long parseStart = micros();
+    if (stream.find("\"list\":[")) {
+        uint8_t index = 0;
+        do {
+            results[index] = parse(stream, records[index]);
+            if (results[index] != WEATHER_RESULT_OK) break;
+            index++;
+        } while (index < count && stream.findUntil(",", "]"));
+    }
+    stats.parse_us = micros() - parseStart;
+
+    http.end();
+    stats.total_ms = millis() - start;
+}
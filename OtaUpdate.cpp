@@ -0,0 +1,303 @@
+#include "OtaUpdate.h"  // Header for this module
+#include "UserConfig.h" // For PREF_NAMESPACE, userConfig.update_password
+#include "WebConfig.h"  // webRequestRestart(): loop() saves pending settings first
+#include "PortalHandler.h" // No uploads over the open setup AP
+#include "config.h"     // For OTA_VERIFY_TIMEOUT_MS, OTA_TRIAL_BOOTS
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <TFT_eSPI.h>
+#include <Preferences.h>
+#include <Update.h>
+#include <ESPAsyncWebServer.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <mbedtls/sha256.h>
+
+// Trial state of a new image (own namespace, apart from the settings keys):
+// "prev" = label of the image to fall back to, "tries" = boots so far
+#define OTA_PREF_NAMESPACE "ota"
+
+// --- EXTERNAL DEPENDENCIES ---
+extern TFT_eSPI tft;
+extern userConfig_t userConfig;
+// -----------------------------
+
+/**
+ * @brief One upload in flight. The image is never buffered: each chunk the
+ * server hands us goes through the hash and straight into the OTA partition.
+ */
+typedef struct {
+    AsyncWebServerRequest* owner;  // Request streaming the image (chunks from others are ignored)
+    bool active;
+    bool failed;
+    char error[64];
+    uint8_t expected[32];        // SHA-256 supplied with the request
+    mbedtls_sha256_context sha;
+    size_t bytes;
+    unsigned long startMs;
+    uint32_t minFreeHeap;
+} OtaSession;
+
+static OtaSession ota = {};
+
+// --- TRIAL OF A NEW IMAGE ---
+static char trialPrevious[17] = "";    // Partition label to boot back into; empty = no trial running
+static unsigned long trialStartMs = 0;
+
+
+/**
+ * @brief Parses 64 hex characters into a 32-byte digest.
+ */
+static bool parseSha256(const String& hex, uint8_t* digest) {
+    if (hex.length() != 64) return false;
+    for (int i = 0; i < 32; i++) {
+        char pair[3] = { hex[i * 2], hex[i * 2 + 1], '\0' };
+        char* end = nullptr;
+        long value = strtol(pair, &end, 16);
+        if (*end != '\0') return false;
+        digest[i] = (uint8_t)value;
+    }
+    return true;
+}
+
+/**
+ * @brief Who may flash the clock: nobody while the setup portal's open AP is up
+ * or before an update password is set, then only with that password.
+ * @return 0 if the upload is allowed, otherwise the HTTP status to refuse it with.
+ */
+static int otaRefusal(AsyncWebServerRequest* request) {
+    if (portalActive() || userConfig.update_password[0] == '\0') return 403;
+    if (!request->authenticate(OTA_USERNAME, userConfig.update_password)) return 401;
+    return 0;
+}
+
+static void otaFail(const char* message) {
+    if (ota.failed) return;
+    ota.failed = true;
+    strncpy(ota.error, message, sizeof(ota.error) - 1);
+    ota.error[sizeof(ota.error) - 1] = '\0';
+    if (Update.isRunning()) Update.abort();
+    Serial.printf("OTA: failed: %s\n", message);
+}
+
+/**
+ * @brief Upload chunk handler (AsyncTCP task): hash and write each chunk as it arrives.
+ */
+static void handleUpdateUpload(AsyncWebServerRequest* request, const String& filename, size_t index,
+                               uint8_t* data, size_t len, bool final) {
+    if (index == 0) {
+        if (ota.active) {
+            return; // Another upload owns the partition; handleUpdateDone() answers 409
+        }
+        if (otaRefusal(request) != 0) {
+            return; // Body is discarded; handleUpdateDone() answers 401/403
+        }
+        memset(&ota, 0, sizeof(ota));
+        ota.owner = request;
+        ota.active = true;
+        request->onDisconnect([]() {
+            // Client went away mid-upload: free the partition for the next attempt
+            if (Update.isRunning()) Update.abort();
+            ota.active = false;
+        });
+        ota.startMs = millis();
+        ota.minFreeHeap = ESP.getFreeHeap();
+        if (!parseSha256(request->arg("sha256"), ota.expected)) {
+            otaFail("sha256 query parameter missing or not 64 hex characters");
+            return;
+        }
+        mbedtls_sha256_init(&ota.sha);
+        mbedtls_sha256_starts(&ota.sha, 0); // 0 = SHA-256 (not SHA-224)
+        if (!Update.begin(UPDATE_SIZE_UNKNOWN, U_FLASH)) {
+            otaFail(Update.errorString());
+            return;
+        }
+        Serial.printf("OTA: receiving %s into the inactive partition.\n", filename.c_str());
+    }
+    if (!ota.active || ota.owner != request || ota.failed) return;
+
+    mbedtls_sha256_update(&ota.sha, data, len);
+    if (Update.write(data, len) != len) {
+        otaFail(Update.errorString());
+        return;
+    }
+    ota.bytes += len;
+    uint32_t freeHeap = ESP.getFreeHeap();
+    if (freeHeap < ota.minFreeHeap) ota.minFreeHeap = freeHeap;
+
+    if (final) {
+        uint8_t digest[32];
+        mbedtls_sha256_finish(&ota.sha, digest);
+        mbedtls_sha256_free(&ota.sha);
+        if (memcmp(digest, ota.expected, sizeof(digest)) != 0) {
+            otaFail("SHA-256 mismatch");
+            return;
+        }
+        // Validates the image and switches the boot partition
+        if (!Update.end(true)) {
+            otaFail(Update.errorString());
+            return;
+        }
+        // The new image runs on trial: otaConfirmBoot() boots back into this one if it fails
+        Preferences trial;
+        if (trial.begin(OTA_PREF_NAMESPACE, false)) {
+            trial.putString("prev", esp_ota_get_running_partition()->label);
+            trial.putUChar("tries", 0);
+            trial.end();
+        } else {
+            Serial.println("OTA: could not record the current image; the new one will not be checked.");
+        }
+        unsigned long elapsed = max(1UL, millis() - ota.startMs);
+        Serial.printf("OTA: %u bytes in %lu ms (%.1f KB/s), lowest free heap %u.\n", (unsigned)ota.bytes, elapsed,
+                      ota.bytes / 1024.0f / (elapsed / 1000.0f), ota.minFreeHeap);
+    }
+}
+
+/**
+ * @brief Request handler, called once the whole body has been received.
+ */
+static void handleUpdateDone(AsyncWebServerRequest* request) {
+    int refusal = otaRefusal(request);
+    if (refusal == 401) {
+        request->requestAuthentication();
+        return;
+    }
+    if (refusal != 0) {
+        request->send(403, "text/plain", portalActive() ? "Firmware updates are disabled in setup mode"
+                                                        : "Set a firmware update password in the settings first");
+        return;
+    }
+    if (!ota.active || ota.owner != request) {
+        request->send(409, "text/plain", "Another update is in progress");
+        return;
+    }
+    ota.active = false;
+    if (ota.failed || Update.isRunning()) {
+        if (!ota.failed) otaFail("upload ended early");
+        request->send(400, "text/plain", String("Update failed: ") + ota.error);
+        return;
+    }
+    unsigned long elapsed = max(1UL, millis() - ota.startMs);
+    String body = "Update OK: " + String(ota.bytes) + " bytes, " + String(ota.bytes / 1024.0f / (elapsed / 1000.0f), 1) +
+                  " KB/s, lowest free heap " + String(ota.minFreeHeap) + ". Rebooting into the new image...";
+    request->send(200, "text/plain", body);
+    request->onDisconnect(webRequestRestart);
+}
+
+void otaAttach(AsyncWebServer& server) {
+    server.on("/update", HTTP_POST, handleUpdateDone, handleUpdateUpload);
+}
+
+
+// --- FIRST-BOOT SELF-TEST AND ROLLBACK ---
+// The stock Arduino bootloader has no app rollback, so the sketch does it: the
+// upload records the running partition, and a new image that fails its checks
+// points the boot partition back at it and restarts. With a rollback-enabled
+// bootloader the image is also marked valid, so that bootloader keeps it.
+
+/**
+ * @brief Tells the Arduino core not to mark a new image valid on its own
+ * (rollback-enabled bootloaders only); otaAccept() does it after the checks.
+ */
+extern "C" bool verifyRollbackLater() {
+    return true;
+}
+
+/**
+ * @brief Display: a pixel written over SPI must read back unchanged.
+ */
+static bool selfTestDisplay() {
+    uint16_t original = tft.readPixel(0, 0);
+    tft.drawPixel(0, 0, TFT_MAGENTA);
+    bool ok = tft.readPixel(0, 0) == TFT_MAGENTA;
+    tft.drawPixel(0, 0, original);
+    return ok;
+}
+
+/**
+ * @brief NVS: the settings namespace must open (what loadConfig() relies on).
+ */
+static bool selfTestNvs() {
+    Preferences prefs;
+    bool ok = prefs.begin(PREF_NAMESPACE, false); // Read/write: also creates it on a fresh device
+    prefs.end();
+    return ok;
+}
+
+/**
+ * @brief Ends the trial: forgets the previous image either way.
+ */
+static void trialEnd() {
+    Preferences prefs;
+    if (prefs.begin(OTA_PREF_NAMESPACE, false)) {
+        prefs.clear();
+        prefs.end();
+    }
+    trialPrevious[0] = '\0';
+}
+
+static void otaAccept() {
+    esp_ota_mark_app_valid_cancel_rollback();
+    trialEnd();
+    Serial.println("OTA: new image kept.");
+}
+
+/**
+ * @brief Boots the image the update replaced. Returns only if it cannot be selected.
+ */
+static void otaRollBack(const char* reason) {
+    Serial.printf("OTA: %s, booting %s again.\n", reason, trialPrevious);
+    const esp_partition_t* previous = esp_partition_find_first(ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_ANY, trialPrevious);
+    trialEnd();
+    if (previous == nullptr || esp_ota_set_boot_partition(previous) != ESP_OK) {
+        Serial.println("OTA: the previous image cannot be selected; keeping this one.");
+        return;
+    }
+    delay(100); // Let the log line out
+    ESP.restart();
+}
+
+void otaConfirmBoot() {
+    Preferences prefs;
+    if (!prefs.begin(OTA_PREF_NAMESPACE, false)) return;
+    size_t length = prefs.getString("prev", trialPrevious, sizeof(trialPrevious));
+    uint8_t tries = prefs.getUChar("tries", 0) + 1;
+    if (length > 0) prefs.putUChar("tries", tries); // Counted before the checks: a crash later still counts
+    prefs.end();
+    if (length == 0) {
+        trialPrevious[0] = '\0';
+        return; // Not on trial
+    }
+
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    if (strcmp(running->label, trialPrevious) == 0) {
+        Serial.println("OTA: the update never started; still on the previous image.");
+        trialEnd();
+        return;
+    }
+    if (tries > OTA_TRIAL_BOOTS) {
+        otaRollBack("new image restarted before passing its checks");
+        return;
+    }
+
+    bool display = selfTestDisplay();
+    bool nvs = selfTestNvs();
+    Serial.printf("OTA self-test on %s (boot %u of %u): display %s, NVS %s; network within %lu s.\n", running->label,
+                  tries, OTA_TRIAL_BOOTS, display ? "ok" : "FAIL", nvs ? "ok" : "FAIL", OTA_VERIFY_TIMEOUT_MS / 1000);
+    if (!display || !nvs) {
+        otaRollBack("self-test failed");
+        return;
+    }
+    trialStartMs = millis(); // serviceOtaVerdict() gives the network its verdict
+}
+
+void serviceOtaVerdict() {
+    if (trialPrevious[0] == '\0') return;
+    if (WiFi.status() == WL_CONNECTED) {
+        Serial.printf("OTA self-test: network ok after %lu ms.\n", millis() - trialStartMs);
+        otaAccept();
+    } else if (millis() - trialStartMs > OTA_VERIFY_TIMEOUT_MS) {
+        otaRollBack("no Wi-Fi connection within the self-test window");
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef OTAUPDATE_H
+#define OTAUPDATE_H
+
+class AsyncWebServer;
+
+// HTTP auth user name for uploads; the password is userConfig.update_password
+#define OTA_USERNAME "update"
+
+// --- FUNCTION PROTOTYPES ---
+void otaAttach(AsyncWebServer& server); // Registers POST /update (firmware upload, password required)
+void otaConfirmBoot();                  // End of setup(): self-test a freshly updated image, roll back on failure
+void serviceOtaVerdict();               // loop(): keep the new image once Wi-Fi is up, roll back after OTA_VERIFY_TIMEOUT_MS
+
+#endif // OTAUPDATE_H
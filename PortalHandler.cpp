@@ -1,138 +1,391 @@
-#include "PortalHandler.h"
-#include "ConfigHandler.h"   // For extern userConfig and saveConfig()
-#include "WebPortalHtml.h"   // For HTML strings (used in original .ino logic)
-#include "MenuHandler.h"     // For externs of tft, DISPLAY_WIDTH, DISPLAY_HEIGHT
-
-#include <Arduino.h>         // For Serial.println and strncpy
-#include <WiFi.h>            // For WiFi.SSID/psk
-#include <TFT_eSPI.h>        // For tft.fillScreen, tft.drawString, etc.
-
-// --- EXTERN GLOBALS (from .ino) ---
-// Note: We access these via MenuHandler.h's extern declarations
-extern TFT_eSPI tft;
-extern const int DISPLAY_WIDTH;
-extern const int DISPLAY_HEIGHT;
-
-// --- INSTANTIATION OF WIFI MANAGER CUSTOM PARAMETERS (Globals defined here) ---
-char api_key_param[40];
-char gmt_offset_param[6]; 
-char sleep_timeout_param[6];
-char time_format_param[2]; 
-char city_param[40];
-char country_param[4];
-char id_param[12]; 
-
-WiFiManagerParameter *custom_api_key_field = nullptr;
-WiFiManagerParameter *custom_gmt_offset_field = nullptr;
-WiFiManagerParameter *custom_sleep_timeout_field = nullptr;
-WiFiManagerParameter *custom_time_format_field = nullptr;
-WiFiManagerParameter *custom_city_field = nullptr; 
-WiFiManagerParameter *custom_country_field = nullptr; 
-WiFiManagerParameter *custom_id_field = nullptr;
+#include "PortalHandler.h"   // Header for this module
+#include "ConfigHandler.h"   // userConfig, configSetField() and saveConfig()
+#include "ConfigStore.h"     // configStoreFlush(): credentials are written right away
+#include "TimeSync.h"        // timeSyncBegin() once the network is up
+#include "WebUiAssets.h"     // Gzipped setup page (web/setup.html)
+#include "WifiConnect.h"     // Known networks and the connect cache
 
+#include <Arduino.h>
+#include <WiFi.h>
+#include <DNSServer.h>
+#include <ArduinoJson.h>
+#include <ESPAsyncWebServer.h>
+
+// --- EXTERNAL DEPENDENCIES ---
+extern void applyConfigChanges(uint32_t changes);
+// -----------------------------
+
+// --- CONSTANTS ---
+static const uint8_t DNS_PORT = 53;
+static const uint8_t PORTAL_MAX_NETWORKS = 16;
+static const uint32_t SCAN_INTERVAL_MS = 30000;    // Background rescan while waiting for a submit
+static const uint32_t CONNECT_TIMEOUT_MS = 20000;
+static const uint32_t SAVED_RETRY_MS = 120000;     // Saved network retried while nobody is on the AP
+static const uint32_t AP_LINGER_MS = 30000;        // Setup page can still show the new address
+static const char* const STATE_NAMES[] = { "off", "open", "connecting", "connected" };
+
+// URLs phones and laptops probe to detect a captive portal
+static const char* const CAPTIVE_CHECK_URLS[] = {
+    "/generate_204", "/gen_204", "/hotspot-detect.html", "/library/test/success.html",
+    "/connecttest.txt", "/ncsi.txt", "/redirect", "/canonical.html", "/success.txt"
+};
+
+typedef struct {
+    char ssid[33];
+    int8_t rssi;
+    bool open;
+} PortalNetwork;
+
+/**
+ * @brief A setup form field with fixed storage for its value. Written by the
+ * POST handler on the network task, read by servicePortal() on the main task.
+ */
+typedef struct {
+    const char* key;   // Form field name, also the configSetField() name
+    char* value;
+    size_t size;
+} PortalParam;
+
+// --- PARAMETER STORAGE (guarded by submitPending) ---
+static char ssid_param[sizeof(userConfig.ssid)];
+static char pass_param[sizeof(userConfig.password)];
+static char api_key_param[sizeof(userConfig.weather_api_key)];
+static char city_param[sizeof(userConfig.weather_city)];
+static char country_param[sizeof(userConfig.weather_country_code)];
+static char id_param[sizeof(userConfig.weather_city_id)];
+static char tz_param[sizeof(userConfig.tz_name)];
+static char time_format_param[2];
+
+// Credentials first; the rest go through configSetField() and are optional (empty = unchanged)
+static const PortalParam PORTAL_PARAMS[] = {
+    { "ssid",    ssid_param,        sizeof(ssid_param) },
+    { "pass",    pass_param,        sizeof(pass_param) },
+    { "apikey",  api_key_param,     sizeof(api_key_param) },
+    { "city",    city_param,        sizeof(city_param) },
+    { "country", country_param,     sizeof(country_param) },
+    { "city_id", id_param,          sizeof(id_param) },
+    { "tz",      tz_param,          sizeof(tz_param) },
+    { "timefmt", time_format_param, sizeof(time_format_param) },
+};
+static const uint8_t PORTAL_PARAM_COUNT = sizeof(PORTAL_PARAMS) / sizeof(PORTAL_PARAMS[0]);
+static const uint8_t PORTAL_CREDENTIAL_COUNT = 2;
+
+// --- STATE ---
+static DNSServer dnsServer;
+static volatile PortalState state = PORTAL_OFF;
+static volatile bool submitPending = false;
+static volatile unsigned long submitMs = 0;
+static volatile bool scanRequested = false;
+static bool scanRunning = false;
+static unsigned long lastScanMs = 0;
+static bool attemptSubmitted = false;  // Attempt uses the submitted credentials, not the saved ones
+static unsigned long attemptStartMs = 0;
+static unsigned long connectedMs = 0;
+static uint32_t lastConnectMs = 0;     // Submit to connected, last successful submit
+static char attemptSsid[33] = "";
+static char lastError[40] = "";
+static char badgeText[48] = "";
+
+// Scan results, double-buffered: loop() fills the back buffer, then flips
+// scanFront; /api/portal reads the front one on the network task.
+static PortalNetwork scanCache[2][PORTAL_MAX_NETWORKS];
+static uint8_t scanCounts[2] = { 0, 0 };
+static volatile uint8_t scanFront = 0;
+
+
+/**
+ * @brief Sets the state and the badge line that goes with it.
+ */
+static void setState(PortalState next) {
+    state = next;
+    switch (next) {
+        case PORTAL_OPEN:
+            snprintf(badgeText, sizeof(badgeText), "%s > %s", PORTAL_AP_SSID, WiFi.softAPIP().toString().c_str());
+            break;
+        case PORTAL_CONNECTING:
+            snprintf(badgeText, sizeof(badgeText), "Connecting to %.18s...", attemptSsid);
+            break;
+        case PORTAL_CONNECTED:
+            snprintf(badgeText, sizeof(badgeText), "Joined, IP %s", WiFi.localIP().toString().c_str());
+            break;
+        default:
+            badgeText[0] = '\0';
+            break;
+    }
+}
 
 /**
- * @brief Callback function triggered by WiFiManager when "Save" is pressed.
- * Saves settings from form fields back into the userConfig struct.
+ * @brief Keeps the strongest entry per name, strongest first; hidden networks are skipped.
  */
-void saveConfigCallback() {
-    Serial.println("WiFiManager save config callback called.");
-    
-    // 1. Copy mandatory data
-    strncpy(userConfig.weather_api_key, custom_api_key_field->getValue(), sizeof(userConfig.weather_api_key) - 1);
-    userConfig.gmt_offset_hr = atoi(custom_gmt_offset_field->getValue());
-    userConfig.sleep_timeout_min = atoi(custom_sleep_timeout_field->getValue());
-    userConfig.time_format_24h = atoi(custom_time_format_field->getValue()) == 1; 
-    
-    // 2. Copy location fields
-    strncpy(userConfig.weather_city, custom_city_field->getValue(), sizeof(userConfig.weather_city) - 1);
-    strncpy(userConfig.weather_country_code, custom_country_field->getValue(), sizeof(userConfig.weather_country_code) - 1);
-    strncpy(userConfig.weather_city_id, custom_id_field->getValue(), sizeof(userConfig.weather_city_id) - 1);
-    
-    // 3. AUTOMATIC MODE SWITCH 
-    if (strlen(userConfig.weather_city_id) > 0) {
-        userConfig.use_city_id_mode = true;
-        Serial.println("Weather Mode set to: City ID.");
+static void storeScan(int16_t found) {
+    uint8_t back = scanFront ^ 1;
+    PortalNetwork* list = scanCache[back];
+    uint8_t count = 0;
+    for (int16_t i = 0; i < found; i++) {
+        String ssid = WiFi.SSID(i);
+        if (ssid.length() == 0 || ssid.length() >= sizeof(userConfig.ssid)) continue; // Hidden, or too long to save
+        int8_t rssi = WiFi.RSSI(i);
+        uint8_t slot = 0;
+        while (slot < count && strcmp(list[slot].ssid, ssid.c_str()) != 0) slot++;
+        if (slot == count) {
+            if (count < PORTAL_MAX_NETWORKS) {
+                count++;
+            } else {
+                slot = count - 1; // List is sorted: replace the weakest if this one is stronger
+                if (rssi <= list[slot].rssi) continue;
+            }
+            strcpy(list[slot].ssid, ssid.c_str());
+            list[slot].rssi = -128;
+        }
+        if (rssi <= list[slot].rssi) continue;
+        list[slot].rssi = rssi;
+        list[slot].open = WiFi.encryptionType(i) == WIFI_AUTH_OPEN;
+        for (; slot > 0 && list[slot].rssi > list[slot - 1].rssi; slot--) {
+            PortalNetwork swap = list[slot];
+            list[slot] = list[slot - 1];
+            list[slot - 1] = swap;
+        }
+    }
+    scanCounts[back] = count;
+    scanFront = back;
+    Serial.printf("Portal: scan found %d networks, %u listed.\n", found, count);
+}
+
+/**
+ * @brief Starts a background scan when one is due and collects the results.
+ */
+static void serviceScan(unsigned long now) {
+    if (scanRunning) {
+        int16_t found = WiFi.scanComplete();
+        if (found == WIFI_SCAN_RUNNING) return;
+        scanRunning = false;
+        lastScanMs = now;
+        if (found >= 0) storeScan(found);
+        WiFi.scanDelete();
+        return;
+    }
+    // Scanning hops channels: never while joining a network or with a submit waiting
+    if (state != PORTAL_OPEN || submitPending) return;
+    if (scanRequested || now - lastScanMs >= SCAN_INTERVAL_MS) {
+        scanRequested = false;
+        lastScanMs = now;
+        scanRunning = WiFi.scanNetworks(true) == WIFI_SCAN_RUNNING;
+    }
+}
+
+static void startAttempt(const char* ssid, const char* password, bool submitted) {
+    strncpy(attemptSsid, ssid, sizeof(attemptSsid) - 1);
+    attemptSubmitted = submitted;
+    attemptStartMs = millis();
+    WiFi.begin(ssid, password);
+    setState(PORTAL_CONNECTING);
+    Serial.printf("Portal: joining '%s' (%s credentials).\n", attemptSsid, submitted ? "submitted" : "saved");
+}
+
+/**
+ * @brief Applies the optional fields of a submit and starts joining its network.
+ * Credentials are only saved once they have worked.
+ */
+static void applySubmit() {
+    userConfig_t config = userConfig;
+    uint32_t changes = 0;
+    for (uint8_t i = PORTAL_CREDENTIAL_COUNT; i < PORTAL_PARAM_COUNT; i++) {
+        const PortalParam& param = PORTAL_PARAMS[i];
+        if (param.value[0] == '\0') continue;
+        if (!configSetField(config, param.key, String(param.value), changes)) {
+            snprintf(lastError, sizeof(lastError), "invalid value for %s", param.key);
+            Serial.printf("Portal: submit rejected, %s.\n", lastError);
+            return;
+        }
+    }
+    lastError[0] = '\0';
+    if (changes != 0) {
+        userConfig = config;
+        saveConfig();
+        applyConfigChanges(changes);
+    }
+    startAttempt(ssid_param, pass_param, true);
+}
+
+static void onConnected(unsigned long now) {
+    connectedMs = now;
+    lastError[0] = '\0';
+    if (attemptSubmitted) {
+        lastConnectMs = now - submitMs;
+        wifiRememberNetwork(ssid_param, pass_param); // The previous primary stays in the known networks
+        saveConfig();
+        configStoreFlush(); // Credentials are written right away, not coalesced
+        Serial.printf("Portal: connected to '%s' %lu ms after submit (join %lu ms), IP %s.\n", attemptSsid,
+                      (unsigned long)lastConnectMs, now - attemptStartMs, WiFi.localIP().toString().c_str());
     } else {
-        userConfig.use_city_id_mode = false;
-        Serial.println("Weather Mode set to: City Name.");
+        Serial.printf("Portal: saved network '%s' is back (join %lu ms), IP %s.\n", attemptSsid,
+                      now - attemptStartMs, WiFi.localIP().toString().c_str());
     }
-    
-    saveConfig(); // Save all changes to NVS
+    setState(PORTAL_CONNECTED);
+    wifiCacheStore();
+    timeSyncBegin();
+    applyConfigChanges(CONFIG_CHANGE_WEATHER); // Fetch now instead of waiting out the offline backoff
 }
 
+static void onAttemptFailed() {
+    wl_status_t status = WiFi.status();
+    snprintf(lastError, sizeof(lastError), "'%.16s' %s", attemptSsid,
+             status == WL_NO_SSID_AVAIL ? "not found" :
+             status == WL_CONNECT_FAILED ? "refused the password" : "did not answer");
+    Serial.printf("Portal: %s after %lu ms.\n", lastError, millis() - attemptStartMs);
+    WiFi.disconnect(); // Stop background reconnects: they hop channels under the AP
+    setState(PORTAL_OPEN);
+}
+
+static void portalStop() {
+    dnsServer.stop();
+    WiFi.softAPdisconnect(true);
+    if (scanRunning) WiFi.scanDelete();
+    scanRunning = false;
+    setState(PORTAL_OFF);
+    Serial.println("Portal: setup mode closed.");
+}
+
+void portalBegin() {
+    if (state != PORTAL_OFF) return;
+    WiFi.mode(WIFI_AP_STA);
+    WiFi.disconnect(); // Saved network is retried on a timer, not continuously
+    WiFi.softAP(PORTAL_AP_SSID);
+    dnsServer.setErrorReplyCode(DNSReplyCode::NoError);
+    dnsServer.start(DNS_PORT, "*", WiFi.softAPIP()); // Every name resolves to us
+    attemptStartMs = millis(); // The saved network (if any) was just tried
+    lastScanMs = millis() - SCAN_INTERVAL_MS;
+    setState(PORTAL_OPEN);
+    Serial.printf("Portal: setup mode, AP '%s' at %s.\n", PORTAL_AP_SSID, WiFi.softAPIP().toString().c_str());
+}
+
+bool portalActive() {
+    return state != PORTAL_OFF;
+}
+
+PortalState portalState() {
+    return state;
+}
+
+const char* portalBadgeText() {
+    return badgeText;
+}
+
+bool servicePortal() {
+    if (state == PORTAL_OFF) return false;
+    PortalState before = state;
+    unsigned long now = millis();
+    dnsServer.processNextRequest();
+
+    if (submitPending && !scanRunning && state == PORTAL_OPEN) {
+        applySubmit();
+        submitPending = false;
+    }
+    serviceScan(now);
+
+    switch (state) {
+        case PORTAL_OPEN:
+            if (userConfig.ssid[0] != '\0' && !scanRunning && !submitPending &&
+                WiFi.softAPgetStationNum() == 0 && now - attemptStartMs >= SAVED_RETRY_MS) {
+                startAttempt(userConfig.ssid, userConfig.password, false);
+            }
+            break;
+        case PORTAL_CONNECTING:
+            if (WiFi.status() == WL_CONNECTED) {
+                onConnected(now);
+            } else if (now - attemptStartMs >= CONNECT_TIMEOUT_MS) {
+                onAttemptFailed();
+            }
+            break;
+        case PORTAL_CONNECTED:
+            if (now - connectedMs >= AP_LINGER_MS) portalStop();
+            break;
+        default:
+            break;
+    }
+    return state != before;
+}
+
+// --- WEB HANDLERS (network task) ---
+
+static void handleSetupPage(AsyncWebServerRequest* request) {
+    AsyncWebServerResponse* response = request->beginResponse(200, "text/html", SETUP_PAGE_GZ, SETUP_PAGE_GZ_LEN);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("Cache-Control", "no-store"); // Captive browsers cache aggressively
+    request->send(response);
+}
 
 /**
- * @brief Starts the blocking WiFiManager Configuration Portal.
- * Displays instructions on the TFT.
+ * @brief Copies a submit into the static parameter buffers for loop().
  */
-void startConfigPortal() {
-    
-    // Display portal instructions on the screen
-    tft.fillScreen(TFT_BLACK);
-    tft.setTextColor(TFT_WHITE, TFT_BLACK);
-    tft.setTextDatum(MC_DATUM); 
-    
-    tft.setFreeFont(NULL);
-    tft.setTextFont(4);
-    tft.drawString("Configuration Portal", DISPLAY_WIDTH / 2, 40);
-    tft.setTextFont(2);
-    tft.drawString("1. Connect to network:", DISPLAY_WIDTH / 2, 80);
-    tft.drawString("FlipClockSetup", DISPLAY_WIDTH / 2, 105);
-    tft.drawString("2. Go to 192.168.4.1", DISPLAY_WIDTH / 2, 130);
-    tft.drawString("3. Enter Wi-Fi/Settings", DISPLAY_WIDTH / 2, 160);
-    
-    WiFiManager wm;
-
-    wm.setSaveConfigCallback(saveConfigCallback);
-    
-    // Populate parameter buffers with current config values
-    snprintf(api_key_param, sizeof(api_key_param), "%s", userConfig.weather_api_key);
-    snprintf(gmt_offset_param, sizeof(gmt_offset_param), "%d", userConfig.gmt_offset_hr);
-    snprintf(sleep_timeout_param, sizeof(sleep_timeout_param), "%d", userConfig.sleep_timeout_min);
-    snprintf(time_format_param, sizeof(time_format_param), "%d", userConfig.time_format_24h ? 1 : 0);
-    snprintf(city_param, sizeof(city_param), "%s", userConfig.weather_city);
-    snprintf(country_param, sizeof(country_param), "%s", userConfig.weather_country_code);
-    snprintf(id_param, sizeof(id_param), "%s", userConfig.weather_city_id);
-
-    // Create parameters
-    custom_api_key_field = new WiFiManagerParameter("apikey", "OpenWeatherMap API Key", api_key_param, 40);
-    custom_gmt_offset_field = new WiFiManagerParameter("gmt", "GMT Offset (e.g., -5)", gmt_offset_param, 6);
-    custom_sleep_timeout_field = new WiFiManagerParameter("sleeptmo", "Sleep Timeout (min)", sleep_timeout_param, 6);
-    custom_time_format_field = new WiFiManagerParameter("timefmt", "Time Format (0=12h, 1=24h)", time_format_param, 2);
-    custom_city_field = new WiFiManagerParameter("city", "City (e.g. New York)", city_param, 40);
-    custom_country_field = new WiFiManagerParameter("country", "Country Code (e.g. US)", country_param, 4);
-    custom_id_field = new WiFiManagerParameter("city_id", "City ID (if using ID mode, leave city/country blank)", id_param, 12);
-    
-    // Add parameters to WiFiManager
-    wm.addParameter(custom_api_key_field);
-    wm.addParameter(custom_gmt_offset_field);
-    wm.addParameter(custom_sleep_timeout_field);
-    wm.addParameter(custom_time_format_field);
-    wm.addParameter(custom_city_field);
-    wm.addParameter(custom_country_field);
-    wm.addParameter(custom_id_field);
-    
-    // Start the portal
-    if (!wm.autoConnect("FlipClockSetup", NULL)) {
-        Serial.println("Failed to connect or configure. Resetting.");
-        delay(3000);
-        ESP.restart();
+static void handleSetupSubmit(AsyncWebServerRequest* request) {
+    if (state != PORTAL_OPEN || submitPending) {
+        request->send(409, "text/plain", "Busy: a connection attempt is running, try again shortly.");
+        return;
+    }
+    if (!request->hasParam("ssid", true) || request->getParam("ssid", true)->value().length() == 0) {
+        request->send(400, "text/plain", "Network name missing.");
+        return;
+    }
+    for (uint8_t i = 0; i < PORTAL_PARAM_COUNT; i++) {
+        const PortalParam& param = PORTAL_PARAMS[i];
+        const AsyncWebParameter* field = request->getParam(param.key, true);
+        if (field != nullptr && field->value().length() >= param.size) {
+            request->send(400, "text/plain", String(param.key) + " is too long.");
+            return;
+        }
     }
-    
-    Serial.println("Connected to Wi-Fi. Portal exited.");
-    
-    // Clean up memory (CRITICAL)
-    delete custom_api_key_field;
-    delete custom_gmt_offset_field;
-    delete custom_sleep_timeout_field;
-    delete custom_time_format_field;
-    delete custom_city_field;
-    delete custom_country_field;
-    delete custom_id_field;
-
-    // Save final Wi-Fi details (in case they changed)
-    strncpy(userConfig.ssid, WiFi.SSID().c_str(), sizeof(userConfig.ssid) - 1);
-    strncpy(userConfig.password, WiFi.psk().c_str(), sizeof(userConfig.password) - 1);
-    saveConfig();
-}
\ No newline at end of file
+    for (uint8_t i = 0; i < PORTAL_PARAM_COUNT; i++) {
+        const PortalParam& param = PORTAL_PARAMS[i];
+        const AsyncWebParameter* field = request->getParam(param.key, true);
+        memset(param.value, 0, param.size);
+        if (field != nullptr) strncpy(param.value, field->value().c_str(), param.size - 1);
+    }
+    submitMs = millis();
+    submitPending = true;
+    request->send(202, "text/plain", "Saved. Connecting...");
+}
+
+/**
+ * @brief Portal state and the cached scan, polled by the setup page. ?scan=1 asks for a fresh scan.
+ */
+static void handleApiPortal(AsyncWebServerRequest* request) {
+    if (request->hasParam("scan")) scanRequested = true;
+    DynamicJsonDocument doc(1536);
+    doc["state"] = STATE_NAMES[state];
+    doc["ssid"] = attemptSsid;
+    doc["ip"] = state == PORTAL_CONNECTED ? WiFi.localIP().toString() : String();
+    doc["error"] = lastError;
+    doc["connect_ms"] = lastConnectMs;
+    doc["scanning"] = scanRunning;
+    JsonArray networks = doc.createNestedArray("networks");
+    uint8_t front = scanFront;
+    for (uint8_t i = 0; i < scanCounts[front]; i++) {
+        JsonObject network = networks.createNestedObject();
+        network["ssid"] = scanCache[front][i].ssid;
+        network["rssi"] = scanCache[front][i].rssi;
+        network["open"] = scanCache[front][i].open;
+    }
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+}
+
+bool portalRedirect(AsyncWebServerRequest* request) {
+    if (state == PORTAL_OFF) return false;
+    String apAddress = WiFi.softAPIP().toString();
+    if (request->host() == apAddress) return false; // A genuine miss on our own address
+    request->redirect(("http://" + apAddress + "/setup").c_str());
+    return true;
+}
+
+void portalAttach(AsyncWebServer& server) {
+    server.on("/setup", HTTP_GET, handleSetupPage);
+    server.on("/setup", HTTP_POST, handleSetupSubmit);
+    server.on("/api/portal", HTTP_GET, handleApiPortal);
+    for (const char* url : CAPTIVE_CHECK_URLS) {
+        server.on(url, HTTP_GET, [](AsyncWebServerRequest* request) {
+            if (!portalRedirect(request)) request->send(404, "text/plain", "Not found");
+        });
+    }
+}
@@ -1,30 +1,32 @@
 #ifndef PORTALHANDLER_H
 #define PORTALHANDLER_H
 
-#include <WiFiManager.h>
-#include <WebServer.h>
+#include <stdint.h>
 
-// --- EXTERN DECLARATIONS FOR WIFI MANAGER VARIABLES ---
-// These char arrays are buffers used by WiFiManager
-extern char api_key_param[40];
-extern char gmt_offset_param[6]; 
-extern char sleep_timeout_param[6];
-extern char time_format_param[2]; 
-extern char city_param[40];
-extern char country_param[4];
-extern char id_param[12]; 
+class AsyncWebServer;
+class AsyncWebServerRequest;
 
-// These are pointers to the WiFiManager parameter objects
-extern WiFiManagerParameter *custom_api_key_field;
-extern WiFiManagerParameter *custom_gmt_offset_field;
-extern WiFiManagerParameter *custom_sleep_timeout_field;
-extern WiFiManagerParameter *custom_time_format_field;
-extern WiFiManagerParameter *custom_city_field; 
-extern WiFiManagerParameter *custom_country_field; 
-extern WiFiManagerParameter *custom_id_field;
+// --- PROVISIONING PORTAL ---
+// Runs in the background while the clock keeps drawing: a soft AP with a
+// captive DNS, a cached network scan and the /setup page, served by the normal
+// async web server. loop() drives it through servicePortal().
+
+#define PORTAL_AP_SSID "FlipClockSetup"
+
+typedef enum : uint8_t {
+    PORTAL_OFF,         // Not provisioning
+    PORTAL_OPEN,        // AP up, waiting for a submit; saved credentials are retried now and then
+    PORTAL_CONNECTING,  // Joining the submitted (or saved) network; the AP stays up
+    PORTAL_CONNECTED    // Joined; the AP lingers so the setup page can show the new address
+} PortalState;
 
 // --- FUNCTION PROTOTYPES ---
-void startConfigPortal();
-void saveConfigCallback();
+void portalBegin();                        // Opens the AP and captive DNS and returns at once
+bool portalActive();                       // AP up: "setup mode" badge on the clock face
+PortalState portalState();
+const char* portalBadgeText();             // One line for the badge, by state
+void portalAttach(AsyncWebServer& server); // Registers GET/POST /setup, GET /api/portal and OS captive checks
+bool portalRedirect(AsyncWebServerRequest* request); // From onNotFound: sends captive clients to /setup
+bool servicePortal();                      // loop(): DNS, scans, connect attempts; true = redraw the badge
 
-#endif // PORTALHANDLER_H
\ No newline at end of file
+#endif // PORTALHANDLER_H
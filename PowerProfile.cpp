@@ -0,0 +1,211 @@
+#include "PowerProfile.h" // Header for this module
+#include "config.h"       // For POWER_IDLE_GRACE_MS
+
+#include <Arduino.h>
+
+// --- EXTERNAL DEPENDENCIES ---
+extern userConfig_t userConfig;
+extern const int LED_PIN;
+extern bool backlight_state;
+extern unsigned long lastActivityTime;
+extern void toggleBacklight();
+extern void enterDeepSleepFor(uint32_t wakeInS);
+// -----------------------------
+
+// --- STATE ---
+static PowerWindow currentWindow = { -1, 0, 100, 1, 0 };
+static int lastEvaluatedMinute = -1;
+static bool dimmed = false;
+static bool blankedByProfile = false;   // Backlight turned off by a window (not by the user)
+
+// --- ACCOUNTING (RTC memory: totals survive deep sleep) ---
+RTC_DATA_ATTR static uint32_t stateSeconds[POWER_STATE_COUNT] = {};
+RTC_DATA_ATTR static uint32_t sleepStartEpoch = 0;
+static PowerState accountedState = POWER_STATE_ACTIVE;
+static unsigned long accountedSinceMs = 0;
+static unsigned long lastPowerLogMs = 0;
+
+
+/**
+ * @brief Finds the window in force at 'local' (first matching profile wins).
+ * A window belongs to the weekday it starts on, so an overnight Friday
+ * window still applies early on Saturday.
+ */
+PowerWindow powerEvaluate(const powerProfile_t* profiles, uint8_t count, const struct tm& local) {
+    PowerWindow window = { -1, 0, 100, 1, 0 };
+    int now = local.tm_hour * 60 + local.tm_min;
+    uint8_t today = 1 << local.tm_wday;
+    uint8_t yesterday = 1 << ((local.tm_wday + 6) % 7);
+
+    for (uint8_t i = 0; i < count; i++) {
+        const powerProfile_t& p = profiles[i];
+        if (p.weekdays == 0 || p.mode >= POWER_MODE_COUNT) continue;
+        int start = p.start_hour * 60 + p.start_minute;
+        int end = p.end_hour * 60 + p.end_minute;
+        if (start == end) continue;
+
+        int minutesLeft = -1;
+        if (start < end) {
+            if ((p.weekdays & today) && now >= start && now < end) minutesLeft = end - now;
+        } else if ((p.weekdays & today) && now >= start) {
+            minutesLeft = (1440 - now) + end;   // Runs past midnight
+        } else if ((p.weekdays & yesterday) && now < end) {
+            minutesLeft = end - now;            // Started yesterday evening
+        }
+        if (minutesLeft < 0) continue;
+
+        window.profile = i;
+        window.mode = p.mode;
+        window.dim_percent = p.dim_percent;
+        window.weather_factor = p.weather_factor > 0 ? p.weather_factor : 1;
+        window.seconds_left = (uint32_t)minutesLeft * 60 - local.tm_sec;
+        return window;
+    }
+    return window;
+}
+
+
+/**
+ * @brief Books the time spent in the previous state and switches to 'state'.
+ */
+static void powerAccount(PowerState state) {
+    unsigned long now = millis();
+    stateSeconds[accountedState] += (now - accountedSinceMs) / 1000;
+    accountedSinceMs = now - (now - accountedSinceMs) % 1000; // Keep the sub-second remainder
+    accountedState = state;
+}
+
+static void setDimmed(uint8_t percent) {
+    analogWrite(LED_PIN, (uint32_t)percent * 255 / 100);
+    dimmed = true;
+}
+
+/**
+ * @brief Back to full brightness: hands the pin back to plain GPIO so
+ * toggleBacklight()'s digitalWrite() works again.
+ */
+void powerRestoreBacklight() {
+    if (!dimmed) return;
+    ledcDetachPin(LED_PIN);
+    pinMode(LED_PIN, OUTPUT);
+    digitalWrite(LED_PIN, backlight_state ? HIGH : LOW);
+    dimmed = false;
+}
+
+const PowerWindow& powerCurrentWindow() {
+    return currentWindow;
+}
+
+/**
+ * @brief Applies the quiet-hours window once the user has been idle for
+ * POWER_IDLE_GRACE_MS. A touch restores the display until the next idle period.
+ */
+void servicePowerProfile(const struct tm& local) {
+    if (local.tm_min != lastEvaluatedMinute) {
+        lastEvaluatedMinute = local.tm_min;
+        PowerWindow previous = currentWindow;
+        currentWindow = powerEvaluate(userConfig.power_profiles, POWER_PROFILE_COUNT, local);
+        if (currentWindow.profile != previous.profile || currentWindow.mode != previous.mode) {
+            if (currentWindow.profile >= 0) {
+                Serial.printf("Power profile %d active: %s for %lu min.\n", currentWindow.profile + 1,
+                              powerModeName(currentWindow.mode), (unsigned long)(currentWindow.seconds_left / 60));
+            } else {
+                Serial.println("Power profile: none (normal operation).");
+            }
+        }
+    }
+
+    bool idle = millis() - lastActivityTime > POWER_IDLE_GRACE_MS;
+    bool inWindow = currentWindow.profile >= 0;
+
+    if (!inWindow || !idle) {
+        // Outside quiet hours or the user is interacting: normal display
+        powerRestoreBacklight();
+        if (!inWindow && blankedByProfile && !backlight_state) {
+            toggleBacklight();
+        }
+        blankedByProfile = false;
+    } else if (currentWindow.mode == POWER_MODE_DIM) {
+        if (backlight_state && !dimmed) setDimmed(currentWindow.dim_percent);
+    } else if (currentWindow.mode == POWER_MODE_BACKLIGHT_OFF) {
+        if (backlight_state) {
+            powerRestoreBacklight();
+            toggleBacklight();
+            blankedByProfile = true;
+        }
+    } else if (currentWindow.mode == POWER_MODE_DEEP_SLEEP) {
+        Serial.printf("Power profile %d: deep sleep for %lu s.\n", currentWindow.profile + 1, (unsigned long)currentWindow.seconds_left);
+        powerRestoreBacklight();
+        enterDeepSleepFor(currentWindow.seconds_left);
+    }
+
+    PowerState state = !backlight_state ? POWER_STATE_BACKLIGHT_OFF : (dimmed ? POWER_STATE_DIMMED : POWER_STATE_ACTIVE);
+    if (state != accountedState) {
+        powerAccount(state);
+    }
+
+    // Hourly audit line
+    if (millis() - lastPowerLogMs >= 3600000UL) {
+        lastPowerLogMs = millis();
+        powerAccount(accountedState);
+        Serial.printf("Power hours: active %.1f, dimmed %.1f, backlight off %.1f, deep sleep %.1f\n",
+                      stateSeconds[POWER_STATE_ACTIVE] / 3600.0f, stateSeconds[POWER_STATE_DIMMED] / 3600.0f,
+                      stateSeconds[POWER_STATE_BACKLIGHT_OFF] / 3600.0f, stateSeconds[POWER_STATE_DEEP_SLEEP] / 3600.0f);
+    }
+}
+
+/**
+ * @brief Closes the awake accounting period and stamps the sleep start.
+ */
+void powerNoteDeepSleep() {
+    powerAccount(POWER_STATE_DEEP_SLEEP);
+    time_t now = time(nullptr);
+    sleepStartEpoch = (now > 1600000000) ? (uint32_t)now : 0;
+}
+
+/**
+ * @brief Books the time spent in deep sleep (RTC clock keeps running while asleep).
+ */
+void powerNoteWake() {
+    time_t now = time(nullptr);
+    if (sleepStartEpoch != 0 && now > (time_t)sleepStartEpoch) {
+        stateSeconds[POWER_STATE_DEEP_SLEEP] += (uint32_t)(now - sleepStartEpoch);
+        Serial.printf("Slept for %lu s.\n", (unsigned long)(now - sleepStartEpoch));
+    }
+    sleepStartEpoch = 0;
+    accountedState = POWER_STATE_ACTIVE;
+    accountedSinceMs = millis();
+}
+
+const char* powerModeName(uint8_t mode) {
+    switch (mode) {
+        case POWER_MODE_BACKLIGHT_OFF: return "Display Off";
+        case POWER_MODE_DIM:           return "Dim";
+        case POWER_MODE_DEEP_SLEEP:    return "Deep Sleep";
+    }
+    return "Unknown";
+}
+
+const char* powerStateName(PowerState state) {
+    switch (state) {
+        case POWER_STATE_ACTIVE:        return "Active";
+        case POWER_STATE_DIMMED:        return "Dimmed";
+        case POWER_STATE_BACKLIGHT_OFF: return "Backlight Off";
+        case POWER_STATE_DEEP_SLEEP:    return "Deep Sleep";
+        case POWER_STATE_COUNT:         break;
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief Seconds spent in a state since power-on, including the current period.
+ */
+uint32_t powerStateSeconds(PowerState state) {
+    uint32_t total = stateSeconds[state];
+    if (state == accountedState) total += (millis() - accountedSinceMs) / 1000;
+    return total;
+}
+
+PowerState powerCurrentState() {
+    return accountedState;
+}
@@ -0,0 +1,48 @@
+#ifndef POWERPROFILE_H
+#define POWERPROFILE_H
+
+#include <stdint.h>
+#include <time.h>
+#include "UserConfig.h" // For powerProfile_t
+
+// --- PROFILE MODES (powerProfile_t.mode) ---
+#define POWER_MODE_BACKLIGHT_OFF 0
+#define POWER_MODE_DIM           1
+#define POWER_MODE_DEEP_SLEEP    2  // Timed wake at the end of the window (touch still wakes)
+#define POWER_MODE_COUNT         3
+
+// --- ACCOUNTED STATES ---
+typedef enum : uint8_t {
+    POWER_STATE_ACTIVE,        // Backlight at full brightness
+    POWER_STATE_DIMMED,
+    POWER_STATE_BACKLIGHT_OFF,
+    POWER_STATE_DEEP_SLEEP,
+    POWER_STATE_COUNT
+} PowerState;
+
+/**
+ * @brief The quiet-hours window in force at a given local time.
+ */
+typedef struct {
+    int8_t profile;          // Index into userConfig.power_profiles, -1 = none
+    uint8_t mode;            // POWER_MODE_* (valid when profile >= 0)
+    uint8_t dim_percent;
+    uint8_t weather_factor;  // 1 outside any window
+    uint32_t seconds_left;   // Until the window ends
+} PowerWindow;
+
+// --- EVALUATOR (pure) ---
+PowerWindow powerEvaluate(const powerProfile_t* profiles, uint8_t count, const struct tm& local);
+
+// --- DEVICE ---
+const PowerWindow& powerCurrentWindow();
+void servicePowerProfile(const struct tm& local); // loop(): applies the window when idle
+void powerRestoreBacklight();                      // Full brightness (touch, toggle, window end)
+void powerNoteDeepSleep();                         // Called right before esp_deep_sleep_start()
+void powerNoteWake();                              // Called in setup(): books the time spent asleep
+const char* powerModeName(uint8_t mode);
+const char* powerStateName(PowerState state);
+uint32_t powerStateSeconds(PowerState state);      // Since power-on (survives deep sleep)
+PowerState powerCurrentState();
+
+#endif // POWERPROFILE_H
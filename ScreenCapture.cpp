@@ -0,0 +1,139 @@
+#include "ScreenCapture.h" // Header for this module
+#include "config.h"        // For SCREENSHOT_BAND_ROWS
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <ESPAsyncWebServer.h>
+#include <freertos/semphr.h>
+
+// --- EXTERNAL DEPENDENCIES ---
+extern TFT_eSPI tft;
+// -----------------------------
+
+// --- CONSTANTS ---
+static const int CAPTURE_MAX_WIDTH = 320;
+static const size_t BMP_HEADER_SIZE = 14 + 40 + 12; // File header + BITMAPINFOHEADER + RGB565 masks
+
+// --- STATE ---
+static SemaphoreHandle_t displayMutex = nullptr;
+static uint16_t band[SCREENSHOT_BAND_ROWS * CAPTURE_MAX_WIDTH]; // The only pixel buffer (5 KB)
+static int bandFirstRow = -1;                                     // Panel row held in band[0], -1 = none
+static volatile bool captureActive = false;                      // One screenshot at a time
+static unsigned long captureStartMs = 0;
+
+
+void displayLockInit() {
+    if (displayMutex == nullptr) displayMutex = xSemaphoreCreateMutex();
+}
+
+void displayLockTake() {
+    xSemaphoreTake(displayMutex, portMAX_DELAY);
+}
+
+bool displayLockTakeFor(uint32_t timeoutMs) {
+    return xSemaphoreTake(displayMutex, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+void displayLockGive() {
+    xSemaphoreGive(displayMutex);
+}
+
+
+static void putLE16(uint8_t* p, uint16_t v) { p[0] = v; p[1] = v >> 8; }
+static void putLE32(uint8_t* p, uint32_t v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; }
+
+/**
+ * @brief 16-bit BI_BITFIELDS (RGB565) header. Negative height = rows stored top-down,
+ * which is the order the panel is read back in.
+ */
+static void buildBmpHeader(uint8_t* header, int width, int height) {
+    uint32_t imageSize = (uint32_t)width * height * 2;
+    memset(header, 0, BMP_HEADER_SIZE);
+    header[0] = 'B';
+    header[1] = 'M';
+    putLE32(header + 2, BMP_HEADER_SIZE + imageSize);
+    putLE32(header + 10, BMP_HEADER_SIZE);       // Pixel data offset
+    putLE32(header + 14, 40);                    // BITMAPINFOHEADER size
+    putLE32(header + 18, width);
+    putLE32(header + 22, (uint32_t)(-height));   // Top-down
+    putLE16(header + 26, 1);                     // Planes
+    putLE16(header + 28, 16);                    // Bits per pixel
+    putLE32(header + 30, 3);                     // BI_BITFIELDS
+    putLE32(header + 34, imageSize);
+    putLE32(header + 54, 0xF800);                // Red mask
+    putLE32(header + 58, 0x07E0);                // Green mask
+    putLE32(header + 62, 0x001F);                // Blue mask
+}
+
+/**
+ * @brief Response filler: header, then pixel rows read back from the panel one band
+ * at a time. Returns RESPONSE_TRY_AGAIN while loop() is drawing.
+ */
+static size_t fillScreenshot(uint8_t* buffer, size_t maxLen, size_t index) {
+    int width = tft.width();
+    int height = tft.height();
+    size_t rowBytes = (size_t)width * 2;
+    size_t total = BMP_HEADER_SIZE + rowBytes * height;
+    size_t written = 0;
+
+    if (index < BMP_HEADER_SIZE) {
+        uint8_t header[BMP_HEADER_SIZE];
+        buildBmpHeader(header, width, height);
+        written = min(BMP_HEADER_SIZE - index, maxLen);
+        memcpy(buffer, header + index, written);
+    }
+
+    while (written < maxLen && index + written < total) {
+        size_t offset = index + written - BMP_HEADER_SIZE;
+        int row = offset / rowBytes;
+        if (bandFirstRow < 0 || row < bandFirstRow || row >= bandFirstRow + SCREENSHOT_BAND_ROWS) {
+            if (xSemaphoreTake(displayMutex, 0) != pdTRUE) {
+                // Panel busy: send what we have, or ask to be called again
+                return written > 0 ? written : RESPONSE_TRY_AGAIN;
+            }
+            int rows = min(SCREENSHOT_BAND_ROWS, height - row);
+            tft.readRect(0, row, width, rows, band);
+            xSemaphoreGive(displayMutex);
+            bandFirstRow = row;
+        }
+        // Copy as much of the cached band as fits (RGB565 words are little-endian in memory, as BMP wants)
+        size_t bandOffset = offset - (size_t)bandFirstRow * rowBytes;
+        size_t bandEnd = (size_t)min(SCREENSHOT_BAND_ROWS, height - bandFirstRow) * rowBytes;
+        size_t chunk = min(bandEnd - bandOffset, maxLen - written);
+        memcpy(buffer + written, (const uint8_t*)band + bandOffset, chunk);
+        written += chunk;
+    }
+
+    if (index + written >= total) {
+        Serial.printf("Screenshot: %u bytes in %lu ms (band buffer %u bytes).\n", (unsigned)total,
+                      millis() - captureStartMs, (unsigned)sizeof(band));
+    }
+    return written;
+}
+
+static void handleScreenshot(AsyncWebServerRequest* request) {
+    if (tft.width() > CAPTURE_MAX_WIDTH) {
+        request->send(500, "text/plain", "Display wider than the capture buffer");
+        return;
+    }
+    if (captureActive) {
+        AsyncWebServerResponse* response = request->beginResponse(503, "text/plain", "Screenshot in progress");
+        response->addHeader("Retry-After", "2");
+        request->send(response);
+        return;
+    }
+    captureActive = true;
+    captureStartMs = millis();
+    bandFirstRow = -1;
+    request->onDisconnect([]() { captureActive = false; });
+
+    size_t total = BMP_HEADER_SIZE + (size_t)tft.width() * tft.height() * 2;
+    AsyncWebServerResponse* response = request->beginResponse("image/bmp", total, fillScreenshot);
+    response->addHeader("Cache-Control", "no-store");
+    response->addHeader("Content-Disposition", "inline; filename=\"screenshot.bmp\"");
+    request->send(response);
+}
+
+void screenCaptureAttach(AsyncWebServer& server) {
+    server.on("/screenshot", HTTP_GET, handleScreenshot);
+}
@@ -0,0 +1,19 @@
+#ifndef SCREENCAPTURE_H
+#define SCREENCAPTURE_H
+
+#include <stdint.h>
+
+class AsyncWebServer;
+
+// --- DISPLAY LOCK ---
+// loop() holds the panel while it draws; the screenshot reader only gets it
+// in between (during loop()'s idle delay), so SPI transactions never interleave.
+void displayLockInit();
+void displayLockTake();
+bool displayLockTakeFor(uint32_t timeoutMs); // Other tasks: false if loop() kept the panel that long
+void displayLockGive();
+
+// --- FUNCTION PROTOTYPES ---
+void screenCaptureAttach(AsyncWebServer& server); // Registers /screenshot (BMP, streamed in bands)
+
+#endif // SCREENCAPTURE_H
@@ -5,6 +5,9 @@
 #include <TFT_eSPI.h>
 #include <esp_sleep.h> 
 #include "TouchHandler.h" // Needed for TS_IRQ pin definition
+#include "AlarmHandler.h" // Wake timer for the next alarm
+#include "PowerProfile.h" // Deep-sleep time accounting
+#include "ConfigStore.h"  // Pending settings writes are flushed before sleeping
 
 // --- GLOBAL VARIABLES DECLARED EXTERNALLY IN .INO ---
 extern TFT_eSPI tft;
@@ -20,9 +23,11 @@ extern unsigned long lastActivityTime; // <--- FIX: Declared extern, defined in
 
 /**
  * @brief Prepares the ESP32 for deep sleep, setting the touch IRQ pin as the wake source.
+ * @param wakeInS Also wake after this many seconds (0 = touch/alarm only).
  */
-void enterDeepSleep() {
+void enterDeepSleepFor(uint32_t wakeInS) {
     Serial.println("Entering deep sleep...");
+    configStoreFlush(); // RAM is lost in deep sleep: write coalesced settings now
     
     // 1. Turn off the backlight and clear screen
     digitalWrite(LED_PIN, LOW);
@@ -35,8 +40,28 @@ void enterDeepSleep() {
     const uint64_t wakeUpPinMask = (1ULL << TS_IRQ);
     esp_sleep_enable_ext1_wakeup(wakeUpPinMask, ESP_EXT1_WAKEUP_ALL_LOW);
 
+    // 3b. Timed wake: end of a quiet-hours window, or in time for the next alarm
+    //     (early enough to reconnect and resync), whichever comes first
+    uint32_t alarmInS = alarmSecondsUntilNext(time(nullptr));
+    if (alarmInS > 0) {
+        uint32_t alarmWakeS = (alarmInS > 60) ? alarmInS - 60 : 1;
+        if (wakeInS == 0 || alarmWakeS < wakeInS) wakeInS = alarmWakeS;
+    }
+    if (wakeInS > 0) {
+        esp_sleep_enable_timer_wakeup((uint64_t)wakeInS * 1000000ULL);
+        Serial.printf("Wake timer set: %lu s.\n", (unsigned long)wakeInS);
+    }
+
     // 4. Enter Deep Sleep
+    powerNoteDeepSleep();
     esp_deep_sleep_start();
 }
 
+/**
+ * @brief Deep sleep until touched (or the next alarm).
+ */
+void enterDeepSleep() {
+    enterDeepSleepFor(0);
+}
+
 #endif // SLEEPHANDLER_H
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "SolarCalculator.h" // Header for this module
+#include "UserConfig.h"      // For userConfig.latitude / longitude
+
+#include <Arduino.h>
+#include <math.h>
+
+extern userConfig_t userConfig;
+
+// --- CONSTANTS ---
+static const uint32_t J2000_UNIX_DAY = 10957;        // 2000-01-01 as days since 1970-01-01
+static const uint32_t J2000_NOON_UNIX = 946728000UL; // 2000-01-01 12:00 UTC (Julian date 2451545.0)
+static const float DEG_TO_RAD_F = 0.017453292f;
+static const float SUNRISE_ALTITUDE_DEG = -0.833f;   // Refraction + solar radius
+static const float CIVIL_ALTITUDE_DEG = -6.0f;
+
+// --- CACHE ---
+// Recomputed when the solar day or the coordinates change; survives deep sleep
+RTC_DATA_ATTR static SolarTimes solarCache = {};
+
+
+/**
+ * @brief Local mean solar day containing utcNow (the UTC day shifted by longitude).
+ */
+uint32_t solarDayFor(time_t utcNow, float longitude) {
+    long shifted = (long)utcNow + (long)(longitude * 240.0f); // 86400 s / 360 deg
+    return (uint32_t)(shifted / 86400L);
+}
+
+/**
+ * @brief Hour angle (degrees) at which the sun's centre reaches the given altitude.
+ * @return -1 if the sun never rises that high, 181 if it never sets below it.
+ */
+static float hourAngleFor(float altitudeDeg, float sinLat, float cosLat, float sinDec, float cosDec) {
+    float cosOmega = (sinf(altitudeDeg * DEG_TO_RAD_F) - sinLat * sinDec) / (cosLat * cosDec);
+    if (cosOmega > 1.0f) return -1.0f;
+    if (cosOmega < -1.0f) return 181.0f;
+    return acosf(cosOmega) / DEG_TO_RAD_F;
+}
+
+/**
+ * @brief Turns an hour angle into a UTC time pair around solar noon, clamped for polar days/nights.
+ */
+static void eventsAround(uint32_t noon, float omegaDeg, uint32_t& before, uint32_t& after) {
+    if (omegaDeg < 0.0f) {
+        before = after = noon;                  // Never reaches the altitude
+    } else if (omegaDeg > 180.0f) {
+        before = noon - 43200UL;                // Stays above it all day
+        after = noon + 43200UL;
+    } else {
+        uint32_t half = (uint32_t)(omegaDeg * 240.0f + 0.5f); // Degrees to seconds
+        before = noon - half;
+        after = noon + half;
+    }
+}
+
+/**
+ * @brief Computes sunrise, sunset, solar noon and civil twilight (sunrise equation, ~1 min accuracy).
+ * The Julian date is kept as an integer day count plus a small float fraction, so
+ * single-precision arithmetic keeps second-level resolution.
+ * @param day Local mean solar day from solarDayFor().
+ * @param latitude Decimal degrees, north positive.
+ * @param longitude Decimal degrees, east positive.
+ */
+void solarCompute(uint32_t day, float latitude, float longitude, SolarTimes& times) {
+    long n = (long)day - (long)J2000_UNIX_DAY;   // Days since J2000 noon
+    float meanSolarTime = (float)n - longitude / 360.0f;
+
+    // Solar mean anomaly, equation of centre and ecliptic longitude (degrees)
+    float m = fmodf(357.5291f + 0.98560028f * meanSolarTime, 360.0f);
+    float mRad = m * DEG_TO_RAD_F;
+    float c = 1.9148f * sinf(mRad) + 0.0200f * sinf(2.0f * mRad) + 0.0003f * sinf(3.0f * mRad);
+    float lambdaRad = fmodf(m + c + 180.0f + 102.9372f, 360.0f) * DEG_TO_RAD_F;
+
+    // Solar transit as a fraction of a day relative to n
+    float transitFraction = -longitude / 360.0f + 0.0053f * sinf(mRad) - 0.0069f * sinf(2.0f * lambdaRad);
+    uint32_t noon = J2000_NOON_UNIX + (uint32_t)n * 86400UL + (int32_t)lroundf(transitFraction * 86400.0f);
+
+    // Declination
+    float sinDec = sinf(lambdaRad) * sinf(23.4397f * DEG_TO_RAD_F);
+    float cosDec = sqrtf(1.0f - sinDec * sinDec);
+    float sinLat = sinf(latitude * DEG_TO_RAD_F);
+    float cosLat = cosf(latitude * DEG_TO_RAD_F);
+
+    float omegaSun = hourAngleFor(SUNRISE_ALTITUDE_DEG, sinLat, cosLat, sinDec, cosDec);
+    float omegaCivil = hourAngleFor(CIVIL_ALTITUDE_DEG, sinLat, cosLat, sinDec, cosDec);
+
+    times.day = day;
+    times.latitude = latitude;
+    times.longitude = longitude;
+    times.noon = noon;
+    eventsAround(noon, omegaSun, times.sunrise, times.sunset);
+    eventsAround(noon, omegaCivil, times.dawn, times.dusk);
+    times.flags = 0;
+    if (omegaSun < 0.0f) times.flags |= SOLAR_FLAG_POLAR_NIGHT;
+    if (omegaSun > 180.0f) times.flags |= SOLAR_FLAG_POLAR_DAY;
+}
+
+/**
+ * @brief Day, twilight or night at utcNow for the given solar times.
+ */
+SolarPhase solarPhaseAt(const SolarTimes& times, time_t utcNow) {
+    uint32_t t = (uint32_t)utcNow;
+    if (times.flags & SOLAR_FLAG_POLAR_DAY) return SOLAR_PHASE_DAY;
+    if (t >= times.sunrise && t < times.sunset) return SOLAR_PHASE_DAY;
+    if (t >= times.dawn && t < times.dusk) return SOLAR_PHASE_TWILIGHT;
+    return SOLAR_PHASE_NIGHT;
+}
+
+
+/**
+ * @brief True once the system clock has been set by NTP.
+ */
+bool solarClockValid() {
+    return time(nullptr) > 1600000000;
+}
+
+/**
+ * @brief Solar times for today at the configured coordinates, computed at most once per day.
+ */
+const SolarTimes& solarTimesToday() {
+    time_t now = time(nullptr);
+    uint32_t day = solarDayFor(now, userConfig.longitude);
+    if (solarCache.day != day || solarCache.latitude != userConfig.latitude ||
+        solarCache.longitude != userConfig.longitude) {
+        solarCompute(day, userConfig.latitude, userConfig.longitude, solarCache);
+        Serial.printf("Solar times (UTC epoch) for %.4f, %.4f: dawn %u, sunrise %u, noon %u, sunset %u, dusk %u, flags 0x%02x\n",
+                      userConfig.latitude, userConfig.longitude, solarCache.dawn, solarCache.sunrise,
+                      solarCache.noon, solarCache.sunset, solarCache.dusk, solarCache.flags);
+    }
+    return solarCache;
+}
+
+/**
+ * @brief Whether the sun is up at the configured coordinates.
+ * @param fallback Value returned while the clock is not set (e.g. the provider's day flag).
+ */
+bool solarIsDaytime(bool fallback) {
+    if (!solarClockValid()) return fallback;
+    return solarPhaseAt(solarTimesToday(), time(nullptr)) == SOLAR_PHASE_DAY;
+}
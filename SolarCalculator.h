@@ -0,0 +1,43 @@
+#ifndef SOLARCALCULATOR_H
+#define SOLARCALCULATOR_H
+
+#include <stdint.h>
+#include <time.h>
+
+// --- SOLAR TIMES FLAGS ---
+#define SOLAR_FLAG_POLAR_DAY   0x01  // Sun never sets on this day
+#define SOLAR_FLAG_POLAR_NIGHT 0x02  // Sun never rises on this day
+
+/**
+ * @brief Sunrise/sunset and civil twilight for one local solar day.
+ * All times are UTC epoch seconds. Pure data, so it can live in RTC memory.
+ */
+typedef struct {
+    uint32_t day;          // Local mean solar day number (days since 1970-01-01), 0 = not computed
+    float latitude;        // Coordinates the times were computed for
+    float longitude;
+    uint32_t dawn;         // Civil twilight begins (sun at -6 degrees)
+    uint32_t sunrise;      // Upper limb on the horizon (-0.833 degrees, includes refraction)
+    uint32_t noon;         // Solar transit
+    uint32_t sunset;
+    uint32_t dusk;         // Civil twilight ends
+    uint8_t flags;         // SOLAR_FLAG_*
+} SolarTimes;
+
+typedef enum : uint8_t {
+    SOLAR_PHASE_NIGHT,
+    SOLAR_PHASE_TWILIGHT,  // Between dawn and sunrise, or sunset and dusk
+    SOLAR_PHASE_DAY
+} SolarPhase;
+
+// --- FUNCTION PROTOTYPES ---
+uint32_t solarDayFor(time_t utcNow, float longitude);
+void solarCompute(uint32_t day, float latitude, float longitude, SolarTimes& times);
+SolarPhase solarPhaseAt(const SolarTimes& times, time_t utcNow);
+
+// Cached wrappers using the configured coordinates (recomputed once per day)
+bool solarClockValid();
+const SolarTimes& solarTimesToday();
+bool solarIsDaytime(bool fallback); // Returns fallback until NTP has synced
+
+#endif // SOLARCALCULATOR_H
@@ -0,0 +1,115 @@
+#include "StatusStream.h"   // Header for this module
+#include "config.h"         // For STATUS_STREAM_MIN_GAP_MS / STATUS_STREAM_HEARTBEAT_MS
+#include "WeatherHandler.h" // For lastWeatherResult, temperature
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <ESPAsyncWebServer.h>
+
+// --- EXTERNAL DEPENDENCIES ---
+extern bool backlight_state;
+// -----------------------------
+
+// --- STATE ---
+static AsyncEventSource events("/events");
+static uint32_t frameId = 0;
+static unsigned long lastFrameMs = 0;
+
+// Loop timing since the last frame
+static uint32_t loopCount = 0;
+static uint64_t loopBusySumUs = 0;
+static uint32_t loopBusyMaxUs = 0;
+
+// Touch counters since boot, by event type (index 0 unused)
+static uint32_t touchCounts[5] = {};
+static uint8_t lastTouch = 0;
+
+// Cost of the previous frame, reported in the next one
+static uint32_t lastSerializeUs = 0;
+static uint32_t lastSendUs = 0;
+
+/**
+ * @brief The fields whose change triggers a frame before the heartbeat is due.
+ */
+typedef struct {
+    WeatherResult weather;
+    int16_t temp_x10;
+    bool backlight;
+    uint32_t touches;
+} StreamSnapshot;
+
+static StreamSnapshot lastSent = {};
+
+
+void statusStreamAttach(AsyncWebServer& server) {
+    events.onConnect([](AsyncEventSourceClient* client) {
+        Serial.printf("Status stream: client connected (%u total).\n", (unsigned)events.count());
+        lastFrameMs = 0; // Send a full frame right away
+    });
+    server.addHandler(&events);
+}
+
+void statusStreamNoteLoop(uint32_t busyUs) {
+    loopCount++;
+    loopBusySumUs += busyUs;
+    if (busyUs > loopBusyMaxUs) loopBusyMaxUs = busyUs;
+}
+
+void statusStreamNoteTouch(int touchEvent) {
+    if (touchEvent < 1 || touchEvent > 4) return;
+    touchCounts[touchEvent]++;
+    lastTouch = touchEvent;
+}
+
+/**
+ * @brief Sends one frame to all subscribers when something changed (at most every
+ * STATUS_STREAM_MIN_GAP_MS) or when the heartbeat is due. The frame is serialized
+ * once into a static buffer and the same bytes are fanned out to every client.
+ */
+void serviceStatusStream() {
+    if (events.count() == 0) return;
+    unsigned long now = millis();
+    if (lastFrameMs != 0 && now - lastFrameMs < STATUS_STREAM_MIN_GAP_MS) return;
+
+    StreamSnapshot current;
+    memset(&current, 0, sizeof(current)); // Padding too: snapshots are compared with memcmp
+    current.weather = lastWeatherResult;
+    current.temp_x10 = (int16_t)lroundf(temperature * 10.0f);
+    current.backlight = backlight_state;
+    current.touches = touchCounts[1] + touchCounts[2] + touchCounts[3] + touchCounts[4];
+    bool changed = memcmp(&current, &lastSent, sizeof(current)) != 0;
+    if (!changed && lastFrameMs != 0 && now - lastFrameMs < STATUS_STREAM_HEARTBEAT_MS) return;
+
+    static char frame[384];
+    unsigned long serializeStart = micros();
+    uint32_t loopAvgUs = loopCount ? (uint32_t)(loopBusySumUs / loopCount) : 0;
+    snprintf(frame, sizeof(frame),
+             "{\"t\":%lu,\"up\":%lu,\"heap\":%u,\"rssi\":%d,\"weather\":\"%s\",\"temp\":%.1f,\"bl\":%d,"
+             "\"loop_avg_us\":%lu,\"loop_max_us\":%lu,\"touch\":[%lu,%lu,%lu,%lu],\"last_touch\":%u,"
+             "\"clients\":%u,\"ser_us\":%lu,\"send_us\":%lu}",
+             (unsigned long)time(nullptr), now / 1000, ESP.getFreeHeap(), WiFi.RSSI(),
+             weatherResultText(lastWeatherResult), temperature, backlight_state ? 1 : 0,
+             (unsigned long)loopAvgUs, (unsigned long)loopBusyMaxUs,
+             (unsigned long)touchCounts[1], (unsigned long)touchCounts[2], (unsigned long)touchCounts[3],
+             (unsigned long)touchCounts[4], lastTouch, (unsigned)events.count(),
+             (unsigned long)lastSerializeUs, (unsigned long)lastSendUs);
+    lastSerializeUs = micros() - serializeStart;
+
+    unsigned long sendStart = micros();
+    events.send(frame, "status", ++frameId);
+    lastSendUs = micros() - sendStart;
+
+    static unsigned long lastCostLogMs = 0;
+    if (now - lastCostLogMs >= 60000UL) {
+        lastCostLogMs = now;
+        Serial.printf("Status stream: %u clients, %u bytes, serialize %lu us, fan-out %lu us.\n",
+                      (unsigned)events.count(), (unsigned)strlen(frame),
+                      (unsigned long)lastSerializeUs, (unsigned long)lastSendUs);
+    }
+
+    lastSent = current;
+    lastFrameMs = now;
+    loopCount = 0;
+    loopBusySumUs = 0;
+    loopBusyMaxUs = 0;
+}
@@ -0,0 +1,14 @@
+#ifndef STATUSSTREAM_H
+#define STATUSSTREAM_H
+
+#include <stdint.h>
+
+class AsyncWebServer;
+
+// --- FUNCTION PROTOTYPES ---
+void statusStreamAttach(AsyncWebServer& server); // Registers /events (Server-Sent Events)
+void statusStreamNoteLoop(uint32_t busyUs);      // loop(): time spent in this iteration
+void statusStreamNoteTouch(int touchEvent);      // loop(): 1 single, 2 double, 3 long, 4 swipe
+void serviceStatusStream();                      // loop(): sends a frame on change or heartbeat
+
+#endif // STATUSSTREAM_H
@@ -1,40 +1,14 @@
 #ifndef THEME_CONFIG_H
 #define THEME_CONFIG_H
 
-#include <TFT_eSPI.h> 
+#include <TFT_eSPI.h>
 
-// --- 1. FONT FILE INCLUSIONS ---
-#include "meteocons10pt7b.h" 
-
-// --- 2. FONT DEFINITIONS (Assigning specific font pointers) ---
-#define CLOCK_FONT  NULL 
-#define DATE_FONT_CUSTOM NULL 
-#define WEATHER_FONT_CUSTOM NULL 
-#define WEATHER_ICON_FONT &meteocons10pt7b // The selected icon font
-
-
-// --- 3. BASE COLORS ---
+// --- 1. SYSTEM SCREEN COLORS ---
+// Menu, IP screen, alarm alert and sleep screens are not themed
 const uint16_t COLOR_BACKGROUND = TFT_BLACK;
 
-// --- 4. CLOCK & CARD COLORS (Dynamic) ---
-// Dark Mode (Normal)
-const uint16_t COLOR_DARK_TEXT = TFT_WHITE;     
-const uint16_t COLOR_CARD_NORMAL = 0x2104;      // Dark Blue/Gray
-const uint16_t COLOR_COLON_NORMAL = TFT_WHITE;  // Colon/Separator color in Dark Mode
-
-// Light Mode (Inverted)
-const uint16_t COLOR_LIGHT_TEXT = 0x2104;       
-const uint16_t COLOR_CARD_INVERTED = TFT_WHITE; 
-const uint16_t COLOR_COLON_INVERTED = TFT_WHITE;   // Colon/Separator color in Light Mode
-
-// --- 5. WEATHER COLORS (Dynamic) ---
-
-// === REMOVED: Weather Icon Color Toggle ===
-// This is now controlled by 'userConfig.use_multi_color_icons'
-// static const bool USE_MULTI_COLOR_ICONS = true; // <-- THIS LINE IS REMOVED
-
-// === NEW: Multi-Color Icon Definitions ===
-// Add/change any colors you like here
+// --- 2. DEFAULT ICON PALETTE ---
+// Multi-color icons of themes whose record has no "palette" (or leaves a color out)
 static const uint16_t COLOR_ICON_SUN     = TFT_YELLOW;
 static const uint16_t COLOR_ICON_MOON    = 0x751C;     // A darker blue/cyan
 static const uint16_t COLOR_ICON_RAIN    = 0x64BD;     // Light Blue
@@ -44,12 +18,31 @@ static const uint16_t COLOR_ICON_FOG     = 0x9CD3;     // A light mist gray
 static const uint16_t COLOR_ICON_SNOW    = TFT_WHITE;
 static const uint16_t COLOR_ICON_DEFAULT = TFT_RED;      // For unknown weather
 
-// --- Single Color Fallback ---
-const uint16_t COLOR_ICON_NORMAL = TFT_LIGHTGREY;      // Icon Color for Dark Mode
-const uint16_t COLOR_ICON_INVERTED = TFT_LIGHTGREY;    // Icon Color for Light Mode
-
-// Weather Description Text Color
-const uint16_t COLOR_WEATHER_TEXT_NORMAL = TFT_LIGHTGREY; 
-const uint16_t COLOR_WEATHER_TEXT_INVERTED = TFT_DARKGREY; 
-
-#endif // THEME_CONFIG_H
\ No newline at end of file
+// --- 3. BUILT-IN THEMES ---
+// Same record format as themes uploaded in an asset pack (see ThemeHandler.h).
+// Add entries here for themes that ship with the firmware; names are at most
+// 15 characters. The defaults for the dark and light slots must stay in the list.
+#define THEME_DEFAULT_DARK  "Dark"
+#define THEME_DEFAULT_LIGHT "Light"
+
+typedef struct {
+    const char* name;
+    const char* record;
+} BuiltinTheme;
+
+static const BuiltinTheme BUILTIN_THEMES[] = {
+    // Dark Mode (Normal)
+    { "Dark", R"JSON({
+        "background": "#000000", "digit": "#FFFFFF", "card": "#212021", "colon": "#FFFFFF",
+        "icon": "#D6D3D6", "text": "#D6D3D6", "radius": 10, "icons": "setting" })JSON" },
+    // Light Mode (Inverted): white cards, dark digits
+    { "Light", R"JSON({
+        "background": "#000000", "digit": "#212021", "card": "#FFFFFF", "colon": "#FFFFFF",
+        "icon": "#D6D3D6", "text": "#7B7D7B", "radius": 10, "icons": "setting" })JSON" },
+    // Night: dim red only, easy on dark-adapted eyes
+    { "Night", R"JSON({
+        "background": "#000000", "digit": "#FF0000", "card": "#290000", "colon": "#AD0000",
+        "icon": "#840000", "text": "#840000", "radius": 6, "icons": "mono" })JSON" },
+};
+
+#endif // THEME_CONFIG_H
@@ -0,0 +1,241 @@
+#include "ThemeHandler.h"   // Header for this module
+#include "ThemeConfig.h"    // Built-in theme records and the default icon palette
+#include "UserConfig.h"     // theme_dark / theme_light and the icon style setting
+#include "AssetPack.h"      // Themes and fonts from the asset partition
+#include "meteocons10pt7b.h" // Icon font when the pack has none
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// --- EXTERNAL DEPENDENCIES ---
+extern userConfig_t userConfig;
+// -----------------------------
+
+// --- CONSTANTS ---
+static const uint8_t BUILTIN_THEME_COUNT = sizeof(BUILTIN_THEMES) / sizeof(BUILTIN_THEMES[0]);
+static const uint8_t THEME_MAX_RADIUS = 20; // Half the date card height
+
+// Record keys of the palette, in ThemeIconColor order
+static const char* const ICON_COLOR_KEYS[THEME_ICON_COLOR_COUNT] = {
+    "sun", "moon", "rain", "thunder", "clouds", "fog", "snow", "unknown"
+};
+static const uint16_t DEFAULT_ICON_COLORS[THEME_ICON_COLOR_COUNT] = {
+    COLOR_ICON_SUN, COLOR_ICON_MOON, COLOR_ICON_RAIN, COLOR_ICON_THUNDER,
+    COLOR_ICON_CLOUDS, COLOR_ICON_FOG, COLOR_ICON_SNOW, COLOR_ICON_DEFAULT
+};
+static const char* const RECORD_KEYS[] = {
+    "background", "digit", "card", "colon", "icon", "text", "radius", "icons", "palette", "fonts"
+};
+
+// --- STATE ---
+static Theme darkTheme;
+static Theme lightTheme;
+const Theme* currentTheme = &darkTheme;
+static ThemeStats stats = {};
+
+
+/**
+ * @brief Finds a pack theme entry. Names a built-in theme already uses, and names
+ * without room for the terminator, are not listed.
+ */
+static const AssetTocEntry* findPackTheme(const char* name) {
+    for (uint8_t i = 0; i < BUILTIN_THEME_COUNT; i++) {
+        if (strcmp(BUILTIN_THEMES[i].name, name) == 0) return nullptr;
+    }
+    const AssetTocEntry* entry = assetFind(name, ASSET_TYPE_THEME);
+    return (entry != nullptr && strnlen(entry->name, ASSET_NAME_LEN) < THEME_NAME_LEN) ? entry : nullptr;
+}
+
+/**
+ * @brief Parses "#RRGGBB" into RGB565. Absent values keep 'color'.
+ */
+static bool parseColor(JsonVariantConst value, uint16_t& color) {
+    if (value.isNull()) return true;
+    const char* text = value.as<const char*>();
+    if (text == nullptr || text[0] != '#' || strlen(text) != 7) return false;
+    char* end = nullptr;
+    unsigned long rgb = strtoul(text + 1, &end, 16);
+    if (*end != '\0') return false;
+    color = ((rgb >> 8) & 0xF800) | ((rgb >> 5) & 0x07E0) | ((rgb >> 3) & 0x001F);
+    return true;
+}
+
+static bool isKnownKey(const char* key, const char* const* keys, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(key, keys[i]) == 0) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Validates one record and fills 'theme'. 'error' names the first problem.
+ */
+static bool compileRecord(const char* json, size_t length, Theme& theme, const char*& error) {
+    StaticJsonDocument<1024> doc;
+    DeserializationError parseError = deserializeJson(doc, json, length);
+    if (parseError) {
+        error = parseError.c_str();
+        return false;
+    }
+    JsonObjectConst record = doc.as<JsonObjectConst>();
+    if (record.isNull()) {
+        error = "not a JSON object";
+        return false;
+    }
+    for (JsonPairConst pair : record) {
+        if (!isKnownKey(pair.key().c_str(), RECORD_KEYS, sizeof(RECORD_KEYS) / sizeof(RECORD_KEYS[0]))) {
+            error = "unknown key";
+            return false;
+        }
+    }
+    if (record["background"].isNull() || record["digit"].isNull() || record["card"].isNull()) {
+        error = "background, digit and card are required";
+        return false;
+    }
+
+    if (!parseColor(record["background"], theme.background) || !parseColor(record["digit"], theme.digit) ||
+        !parseColor(record["card"], theme.card)) {
+        error = "colors must be \"#RRGGBB\"";
+        return false;
+    }
+    theme.colon = theme.digit;
+    theme.icon = TFT_LIGHTGREY;
+    theme.weather_text = TFT_LIGHTGREY;
+    if (!parseColor(record["colon"], theme.colon) || !parseColor(record["icon"], theme.icon) ||
+        !parseColor(record["text"], theme.weather_text)) {
+        error = "colors must be \"#RRGGBB\"";
+        return false;
+    }
+
+    JsonVariantConst radius = record["radius"];
+    if (!radius.isNull() && (!radius.is<int>() || radius.as<int>() < 0 || radius.as<int>() > THEME_MAX_RADIUS)) {
+        error = "radius must be 0-20";
+        return false;
+    }
+    theme.card_radius = radius | 10;
+
+    const char* icons = record["icons"] | "setting";
+    if (strcmp(icons, "multi") == 0) {
+        theme.multi_color_icons = true;
+    } else if (strcmp(icons, "mono") == 0) {
+        theme.multi_color_icons = false;
+    } else if (strcmp(icons, "setting") == 0) {
+        theme.multi_color_icons = userConfig.use_multi_color_icons;
+    } else {
+        error = "icons must be multi, mono or setting";
+        return false;
+    }
+
+    memcpy(theme.icon_colors, DEFAULT_ICON_COLORS, sizeof(theme.icon_colors));
+    JsonObjectConst palette = record["palette"];
+    if (!record["palette"].isNull()) {
+        if (palette.isNull()) {
+            error = "palette must be an object";
+            return false;
+        }
+        for (JsonPairConst pair : palette) {
+            if (!isKnownKey(pair.key().c_str(), ICON_COLOR_KEYS, THEME_ICON_COLOR_COUNT)) {
+                error = "unknown palette color";
+                return false;
+            }
+        }
+        for (uint8_t i = 0; i < THEME_ICON_COLOR_COUNT; i++) {
+            if (!parseColor(palette[ICON_COLOR_KEYS[i]], theme.icon_colors[i])) {
+                error = "colors must be \"#RRGGBB\"";
+                return false;
+            }
+        }
+    }
+
+    JsonObjectConst fonts = record["fonts"];
+    theme.clock_font = assetFont(fonts["clock"] | "clock", NULL);
+    theme.date_font = assetFont(fonts["date"] | "date", NULL);
+    theme.icon_font = assetFont(fonts["icons"] | "icons", &meteocons10pt7b);
+    return true;
+}
+
+bool themeCompile(const char* name, Theme& theme) {
+    const char* json = nullptr;
+    size_t length = 0;
+    for (uint8_t i = 0; i < BUILTIN_THEME_COUNT && json == nullptr; i++) {
+        if (strcmp(BUILTIN_THEMES[i].name, name) == 0) {
+            json = BUILTIN_THEMES[i].record;
+            length = strlen(json);
+        }
+    }
+    if (json == nullptr) {
+        const AssetTocEntry* entry = findPackTheme(name);
+        if (entry == nullptr) {
+            Serial.printf("Theme '%s' not found.\n", name);
+            return false;
+        }
+        json = (const char*)assetData(*entry);
+        length = entry->size;
+    }
+
+    Theme compiled;
+    memset(&compiled, 0, sizeof(compiled));
+    strncpy(compiled.name, name, THEME_NAME_LEN - 1);
+    const char* error = "";
+    if (!compileRecord(json, length, compiled, error)) {
+        Serial.printf("Theme '%s' rejected: %s.\n", name, error);
+        return false;
+    }
+    theme = compiled;
+    return true;
+}
+
+void themeLoad() {
+    unsigned long start = micros();
+    if (!themeCompile(userConfig.theme_dark, darkTheme)) themeCompile(THEME_DEFAULT_DARK, darkTheme);
+    if (!themeCompile(userConfig.theme_light, lightTheme)) themeCompile(THEME_DEFAULT_LIGHT, lightTheme);
+    stats.compile_us = micros() - start;
+    Serial.printf("Themes compiled: dark '%s', light '%s' (%lu us).\n", darkTheme.name, lightTheme.name,
+                  (unsigned long)stats.compile_us);
+}
+
+void themeSelect(bool light) {
+    currentTheme = light ? &lightTheme : &darkTheme;
+}
+
+bool themeExists(const char* name) {
+    for (uint8_t i = 0; i < BUILTIN_THEME_COUNT; i++) {
+        if (strcmp(BUILTIN_THEMES[i].name, name) == 0) return true;
+    }
+    return findPackTheme(name) != nullptr;
+}
+
+uint8_t themeCount() {
+    uint8_t count = BUILTIN_THEME_COUNT;
+    while (themeNameAt(count) != nullptr) count++;
+    return count;
+}
+
+const char* themeNameAt(uint8_t index) {
+    if (index < BUILTIN_THEME_COUNT) return BUILTIN_THEMES[index].name;
+    uint8_t packIndex = index - BUILTIN_THEME_COUNT;
+    const AssetTocEntry* entry;
+    for (uint16_t i = 0; (entry = assetAt(i)) != nullptr; i++) {
+        if (entry->type != ASSET_TYPE_THEME || strnlen(entry->name, ASSET_NAME_LEN) >= THEME_NAME_LEN) continue;
+        if (findPackTheme(entry->name) != entry) continue; // Shadowed by a built-in or an earlier entry
+        if (packIndex-- == 0) return entry->name;
+    }
+    return nullptr;
+}
+
+const char* themeNext(const char* name) {
+    uint8_t count = themeCount();
+    for (uint8_t i = 0; i < count; i++) {
+        if (strcmp(themeNameAt(i), name) == 0) return themeNameAt((i + 1) % count);
+    }
+    return themeNameAt(0);
+}
+
+void themeNoteSwitch(uint32_t us) {
+    stats.switch_us = us;
+    stats.switches++;
+}
+
+const ThemeStats& themeStats() {
+    return stats;
+}
@@ -0,0 +1,75 @@
+#ifndef THEMEHANDLER_H
+#define THEMEHANDLER_H
+
+#include <stdint.h>
+#include <TFT_eSPI.h> // For GFXfont
+
+// --- THEME RECORDS ---
+// A theme is a small JSON object, built in (ThemeConfig.h) or uploaded as a
+// "theme" entry of the asset pack (tools/pack_assets.py name=file.json):
+//
+//   { "background": "#000000", "digit": "#FFFFFF", "card": "#212021",   required
+//     "colon": "#FFFFFF", "icon": "#D6D3D6", "text": "#D6D3D6",         default: digit / light grey
+//     "radius": 10,                                                      card corner radius, 0-20
+//     "icons": "setting",                                                "multi", "mono" or "setting"
+//     "palette": { "sun": "#FFFF00", "moon": ..., "rain", "thunder",     multi-colour icons,
+//                  "clouds", "fog", "snow", "unknown" },                 default: COLOR_ICON_* (ThemeConfig.h)
+//     "fonts": { "clock": "clock", "date": "date", "icons": "icons" } }  asset pack font names
+//
+// Records are validated and compiled into a Theme once, when they are selected;
+// drawing code reads only the compiled struct.
+
+#define THEME_NAME_LEN 16 // Including the terminator
+
+typedef enum : uint8_t {
+    THEME_ICON_SUN,
+    THEME_ICON_MOON,
+    THEME_ICON_RAIN,
+    THEME_ICON_THUNDER,
+    THEME_ICON_CLOUDS,
+    THEME_ICON_FOG,
+    THEME_ICON_SNOW,
+    THEME_ICON_UNKNOWN,
+    THEME_ICON_COLOR_COUNT
+} ThemeIconColor;
+
+typedef struct {
+    char name[THEME_NAME_LEN];
+    uint16_t background;
+    uint16_t digit;
+    uint16_t card;
+    uint16_t colon;
+    uint16_t icon;               // Monochrome icons
+    uint16_t weather_text;
+    uint16_t icon_colors[THEME_ICON_COLOR_COUNT]; // Multi-colour icons
+    uint8_t card_radius;
+    bool multi_color_icons;      // Resolved against the icon style setting
+    const GFXfont* clock_font;   // NULL = built-in font 7
+    const GFXfont* date_font;    // NULL = built-in font 4
+    const GFXfont* icon_font;
+} Theme;
+
+typedef struct {
+    uint32_t compile_us;   // Last themeLoad(): both themes validated and compiled
+    uint32_t switch_us;    // Last switch including the full redraw
+    uint32_t switches;
+} ThemeStats;
+
+// The compiled theme on screen (the dark or light selection)
+extern const Theme* currentTheme;
+
+// --- FUNCTION PROTOTYPES ---
+// Compiles userConfig.theme_dark/theme_light, falling back to the built-in pair if
+// one is missing or invalid. Call after loading settings, on settings changes and
+// whenever the asset pack is mounted or unmounted (fonts point into it).
+void themeLoad();
+void themeSelect(bool light);                  // Switches currentTheme between the compiled pair (no drawing)
+bool themeCompile(const char* name, Theme& theme); // false (with a log line) if unknown or invalid
+bool themeExists(const char* name);
+uint8_t themeCount();                          // Built-in themes first, then those in the asset pack
+const char* themeNameAt(uint8_t index);
+const char* themeNext(const char* name);       // Cycling order for the menu
+void themeNoteSwitch(uint32_t us);
+const ThemeStats& themeStats();
+
+#endif // THEMEHANDLER_H
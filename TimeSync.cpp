@@ -0,0 +1,186 @@
+#include "TimeSync.h" // Header for this module
+#include "config.h"   // For NTP_SERVERS and TIME_SYNC_* constants
+
+#include <Arduino.h>
+#include <esp_sntp.h>
+#include <sys/time.h>
+#include <math.h>
+
+// --- STATE ---
+// RTC memory: the drift estimate and server rotation survive deep sleep
+RTC_DATA_ATTR TimeSyncState timeSyncState = {};
+
+// Written by the SNTP task in sntp_sync_time(), consumed by timeSyncService() in loop()
+static volatile bool syncPending = false;
+static volatile uint32_t pendingEpoch = 0;
+static volatile int32_t pendingOffsetMs = 0;
+
+static unsigned long syncStartMs = 0;    // millis() when SNTP was (re)started
+static bool syncedSinceStart = false;
+static uint32_t activeIntervalS = 0;     // Interval currently programmed into SNTP
+
+
+// ----------------------------------------------------------------
+// ESTIMATOR
+// ----------------------------------------------------------------
+
+/**
+ * @brief Folds one sync into the state.
+ * @param syncEpoch UTC seconds reported by the server.
+ * @param offsetMs Server time minus local time just before the clock was stepped.
+ */
+void timeSyncRecord(TimeSyncState& state, uint32_t syncEpoch, int32_t offsetMs) {
+    bool plausible = offsetMs <= TIME_SYNC_MAX_SAMPLE_OFFSET_MS && offsetMs >= -TIME_SYNC_MAX_SAMPLE_OFFSET_MS;
+    if (state.last_sync_epoch != 0 && plausible && syncEpoch >= state.last_sync_epoch + TIME_SYNC_MIN_SAMPLE_S) {
+        uint32_t intervalS = syncEpoch - state.last_sync_epoch;
+        // Total error over the interval, including the drift corrections already applied
+        float samplePpm = (float)(offsetMs + state.correction_ms) * 1000.0f / (float)intervalS;
+        // Running mean for the first samples, then an exponential average that follows temperature changes
+        float weight = (state.drift_samples < 4) ? 1.0f / (state.drift_samples + 1) : 0.25f;
+        state.drift_ppm += weight * (samplePpm - state.drift_ppm);
+        if (state.drift_samples < 255) state.drift_samples++;
+    }
+    state.last_offset_ms = offsetMs;
+    state.last_sync_epoch = syncEpoch;
+    state.last_correction_epoch = syncEpoch;
+    state.correction_ms = 0;
+    if (state.sync_count < 65535) state.sync_count++;
+}
+
+/**
+ * @brief Sync interval that keeps the expected error under TIME_SYNC_TARGET_ERROR_MS.
+ * @return Seconds, clamped to TIME_SYNC_MIN/MAX_INTERVAL_S.
+ */
+uint32_t timeSyncIntervalFor(const TimeSyncState& state) {
+    if (state.drift_samples < 2) return TIME_SYNC_DEFAULT_INTERVAL_S;
+    float ppm = fabsf(state.drift_ppm);
+    if (ppm < 0.1f) ppm = 0.1f;
+    float intervalS = TIME_SYNC_TARGET_ERROR_MS * 1000.0f / ppm; // ppm = ms of error per 1000 s
+    if (intervalS < TIME_SYNC_MIN_INTERVAL_S) return TIME_SYNC_MIN_INTERVAL_S;
+    if (intervalS > TIME_SYNC_MAX_INTERVAL_S) return TIME_SYNC_MAX_INTERVAL_S;
+    return (uint32_t)intervalS;
+}
+
+/**
+ * @brief Milliseconds to add to the clock for the drift since the last correction.
+ */
+int32_t timeSyncCorrectionFor(const TimeSyncState& state, uint32_t nowEpoch) {
+    if (state.drift_samples == 0 || state.last_correction_epoch == 0 || nowEpoch <= state.last_correction_epoch) {
+        return 0;
+    }
+    return (int32_t)lroundf(state.drift_ppm * (float)(nowEpoch - state.last_correction_epoch) / 1000.0f);
+}
+
+
+// ----------------------------------------------------------------
+// DEVICE
+// ----------------------------------------------------------------
+
+/**
+ * @brief Replaces the SDK's weak default so the offset can be measured before the
+ * clock is stepped. This is also where the sync notification is raised.
+ * Runs in the SNTP task: only hands the sample over to loop().
+ */
+extern "C" void sntp_sync_time(struct timeval* tv) {
+    struct timeval before;
+    gettimeofday(&before, nullptr);
+    settimeofday(tv, nullptr);
+    sntp_set_sync_status(SNTP_SYNC_STATUS_COMPLETED);
+
+    int64_t offsetMs = (int64_t)(tv->tv_sec - before.tv_sec) * 1000 + (tv->tv_usec - before.tv_usec) / 1000;
+    if (offsetMs > INT32_MAX) offsetMs = INT32_MAX;
+    if (offsetMs < INT32_MIN) offsetMs = INT32_MIN;
+    pendingEpoch = (uint32_t)tv->tv_sec;
+    pendingOffsetMs = (int32_t)offsetMs;
+    syncPending = true;
+}
+
+/**
+ * @brief Moves the clock by the estimated drift (call on wake, before Wi-Fi).
+ * The RTC keeps time through deep sleep but drifts; this pulls it back until the next sync.
+ */
+void timeSyncApplyDrift() {
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    if (now.tv_sec < 1600000000) return; // Clock never set
+
+    int32_t correctionMs = timeSyncCorrectionFor(timeSyncState, (uint32_t)now.tv_sec);
+    if (correctionMs == 0) return;
+
+    int64_t us = (int64_t)now.tv_sec * 1000000LL + now.tv_usec + (int64_t)correctionMs * 1000LL;
+    now.tv_sec = (time_t)(us / 1000000LL);
+    now.tv_usec = (suseconds_t)(us % 1000000LL);
+    settimeofday(&now, nullptr);
+
+    timeSyncState.correction_ms += correctionMs;
+    timeSyncState.last_correction_epoch = (uint32_t)now.tv_sec;
+    Serial.printf("Time sync: applied %ld ms drift correction (%.2f ppm).\n", (long)correctionMs, timeSyncState.drift_ppm);
+}
+
+/**
+ * @brief (Re)starts SNTP with the server list rotated to timeSyncState.server_index.
+ */
+void timeSyncBegin() {
+    if (sntp_enabled()) {
+        sntp_stop();
+    }
+    sntp_setoperatingmode(SNTP_OPMODE_POLL);
+    for (uint8_t i = 0; i < NTP_SERVER_COUNT; i++) {
+        sntp_setservername(i, NTP_SERVERS[(timeSyncState.server_index + i) % NTP_SERVER_COUNT]);
+    }
+    activeIntervalS = timeSyncIntervalFor(timeSyncState);
+    sntp_set_sync_interval(activeIntervalS * 1000UL);
+    sntp_init();
+
+    syncStartMs = millis();
+    syncedSinceStart = false;
+    Serial.printf("Time sync: SNTP started (primary %s, interval %lu s).\n",
+                  NTP_SERVERS[timeSyncState.server_index % NTP_SERVER_COUNT], (unsigned long)activeIntervalS);
+}
+
+/**
+ * @brief Processes sync samples, adapts the interval and rotates servers on silence.
+ */
+void timeSyncService() {
+    if (syncPending) {
+        syncPending = false;
+        timeSyncRecord(timeSyncState, pendingEpoch, pendingOffsetMs);
+        syncedSinceStart = true;
+        Serial.printf("Time sync: offset %ld ms, drift %.2f ppm (%u samples).\n",
+                      (long)timeSyncState.last_offset_ms, timeSyncState.drift_ppm, timeSyncState.drift_samples);
+
+        // Re-program the interval when the estimate has moved it by more than 25%
+        uint32_t wanted = timeSyncIntervalFor(timeSyncState);
+        if (wanted > activeIntervalS + activeIntervalS / 4 || wanted < activeIntervalS - activeIntervalS / 4) {
+            activeIntervalS = wanted;
+            sntp_set_sync_interval(activeIntervalS * 1000UL); // Takes effect after the next poll
+            Serial.printf("Time sync: interval now %lu s.\n", (unsigned long)activeIntervalS);
+        }
+        return;
+    }
+
+    // No answer since start, or the last sync is long overdue: lead with the next server
+    bool silent = !syncedSinceStart && millis() - syncStartMs > TIME_SYNC_TIMEOUT_MS;
+    bool overdue = syncedSinceStart && timeSyncAgeSeconds() > 3 * activeIntervalS + TIME_SYNC_TIMEOUT_MS / 1000;
+    if (silent || overdue) {
+        timeSyncState.server_index = (timeSyncState.server_index + 1) % NTP_SERVER_COUNT;
+        Serial.printf("Time sync: no response, falling back to %s.\n", NTP_SERVERS[timeSyncState.server_index]);
+        timeSyncBegin();
+    }
+}
+
+/**
+ * @brief Seconds since the last successful sync.
+ */
+uint32_t timeSyncAgeSeconds() {
+    time_t now = time(nullptr);
+    if (timeSyncState.last_sync_epoch == 0 || now < (time_t)timeSyncState.last_sync_epoch) return UINT32_MAX;
+    return (uint32_t)(now - timeSyncState.last_sync_epoch);
+}
+
+/**
+ * @brief Sync interval currently programmed into SNTP.
+ */
+uint32_t timeSyncActiveInterval() {
+    return activeIntervalS;
+}
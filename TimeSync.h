@@ -0,0 +1,35 @@
+#ifndef TIMESYNC_H
+#define TIMESYNC_H
+
+#include <stdint.h>
+
+/**
+ * @brief SNTP supervision state. Kept in RTC memory so the drift estimate
+ * survives deep sleep. The estimator functions below are pure: they take
+ * the clock and offsets as arguments.
+ */
+typedef struct {
+    uint32_t last_sync_epoch;        // UTC seconds of the last accepted sync, 0 = never
+    int32_t last_offset_ms;          // NTP minus local clock at the last sync
+    float drift_ppm;                 // Local clock error, positive = local clock runs slow
+    uint8_t drift_samples;           // Offsets folded into drift_ppm (saturates)
+    int32_t correction_ms;           // Drift corrections applied since the last sync
+    uint32_t last_correction_epoch;  // When drift was last applied (or the last sync)
+    uint8_t server_index;            // First server in the rotation (fallback order)
+    uint16_t sync_count;             // Syncs since power-on
+} TimeSyncState;
+
+// --- ESTIMATOR (pure) ---
+void timeSyncRecord(TimeSyncState& state, uint32_t syncEpoch, int32_t offsetMs);
+uint32_t timeSyncIntervalFor(const TimeSyncState& state);
+int32_t timeSyncCorrectionFor(const TimeSyncState& state, uint32_t nowEpoch);
+
+// --- DEVICE ---
+extern TimeSyncState timeSyncState;
+void timeSyncApplyDrift();   // After deep sleep: move the clock by the estimated drift
+void timeSyncBegin();        // Starts SNTP on the configured server list
+void timeSyncService();      // Loop: server fallback and interval adaptation
+uint32_t timeSyncAgeSeconds(); // Seconds since the last sync (UINT32_MAX = never)
+uint32_t timeSyncActiveInterval();
+
+#endif // TIMESYNC_H
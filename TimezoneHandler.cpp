@@ -0,0 +1,224 @@
+#include "TimezoneHandler.h" // Header for this module
+#include "UserConfig.h"      // For userConfig.tz_name / gmt_offset_hr
+#include "config.h"          // For DST_ACTIVE (manual offset mode)
+
+#include <Arduino.h>
+
+extern userConfig_t userConfig;
+
+// --- ZONE TABLE ---
+// IANA name -> POSIX TZ rule, sorted by name (strcmp order) for binary search.
+// Rules follow the current tzdata; update together with the tzdata release notes.
+static constexpr TimezoneEntry TIMEZONE_TABLE[] = {
+    { "Africa/Cairo",                      "EET-2EEST,M4.5.5/0,M10.5.4/24" },
+    { "Africa/Casablanca",                 "<+01>-1" }, // Ramadan offset change not expressible in POSIX
+    { "Africa/Johannesburg",               "SAST-2" },
+    { "Africa/Lagos",                      "WAT-1" },
+    { "Africa/Nairobi",                    "EAT-3" },
+    { "America/Anchorage",                 "AKST9AKDT,M3.2.0,M11.1.0" },
+    { "America/Argentina/Buenos_Aires",    "<-03>3" },
+    { "America/Bogota",                    "<-05>5" },
+    { "America/Caracas",                   "<-04>4" },
+    { "America/Chicago",                   "CST6CDT,M3.2.0,M11.1.0" },
+    { "America/Denver",                    "MST7MDT,M3.2.0,M11.1.0" },
+    { "America/Edmonton",                  "MST7MDT,M3.2.0,M11.1.0" },
+    { "America/Halifax",                   "AST4ADT,M3.2.0,M11.1.0" },
+    { "America/Havana",                    "CST5CDT,M3.2.0/0,M11.1.0/1" },
+    { "America/Lima",                      "<-05>5" },
+    { "America/Los_Angeles",               "PST8PDT,M3.2.0,M11.1.0" },
+    { "America/Mexico_City",               "CST6" },
+    { "America/New_York",                  "EST5EDT,M3.2.0,M11.1.0" },
+    { "America/Phoenix",                   "MST7" },
+    { "America/Puerto_Rico",               "AST4" },
+    { "America/Regina",                    "CST6" },
+    { "America/Santiago",                  "<-04>4<-03>,M9.1.6/24,M4.1.6/24" },
+    { "America/Sao_Paulo",                 "<-03>3" },
+    { "America/St_Johns",                  "NST3:30NDT,M3.2.0,M11.1.0" },
+    { "America/Toronto",                   "EST5EDT,M3.2.0,M11.1.0" },
+    { "America/Vancouver",                 "PST8PDT,M3.2.0,M11.1.0" },
+    { "America/Winnipeg",                  "CST6CDT,M3.2.0,M11.1.0" },
+    { "Asia/Bangkok",                      "<+07>-7" },
+    { "Asia/Dhaka",                        "<+06>-6" },
+    { "Asia/Dubai",                        "<+04>-4" },
+    { "Asia/Hong_Kong",                    "HKT-8" },
+    { "Asia/Jakarta",                      "WIB-7" },
+    { "Asia/Jerusalem",                    "IST-2IDT,M3.4.4/26,M10.5.0" },
+    { "Asia/Kabul",                        "<+0430>-4:30" },
+    { "Asia/Karachi",                      "PKT-5" },
+    { "Asia/Kathmandu",                    "<+0545>-5:45" },
+    { "Asia/Kolkata",                      "IST-5:30" },
+    { "Asia/Manila",                       "PST-8" },
+    { "Asia/Riyadh",                       "<+03>-3" },
+    { "Asia/Seoul",                        "KST-9" },
+    { "Asia/Shanghai",                     "CST-8" },
+    { "Asia/Singapore",                    "<+08>-8" },
+    { "Asia/Taipei",                       "CST-8" },
+    { "Asia/Tashkent",                     "<+05>-5" },
+    { "Asia/Tehran",                       "<+0330>-3:30" },
+    { "Asia/Tokyo",                        "JST-9" },
+    { "Asia/Yangon",                       "<+0630>-6:30" },
+    { "Atlantic/Azores",                   "<-01>1<+00>,M3.5.0/0,M10.5.0/1" },
+    { "Atlantic/Reykjavik",                "GMT0" },
+    { "Australia/Adelaide",                "ACST-9:30ACDT,M10.1.0,M4.1.0/3" },
+    { "Australia/Brisbane",                "AEST-10" },
+    { "Australia/Darwin",                  "ACST-9:30" },
+    { "Australia/Hobart",                  "AEST-10AEDT,M10.1.0,M4.1.0/3" },
+    { "Australia/Lord_Howe",               "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0" },
+    { "Australia/Melbourne",               "AEST-10AEDT,M10.1.0,M4.1.0/3" },
+    { "Australia/Perth",                   "AWST-8" },
+    { "Australia/Sydney",                  "AEST-10AEDT,M10.1.0,M4.1.0/3" },
+    { "Europe/Amsterdam",                  "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Athens",                     "EET-2EEST,M3.5.0/3,M10.5.0/4" },
+    { "Europe/Berlin",                     "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Brussels",                   "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Dublin",                     "IST-1GMT0,M10.5.0,M3.5.0/1" },
+    { "Europe/Helsinki",                   "EET-2EEST,M3.5.0/3,M10.5.0/4" },
+    { "Europe/Istanbul",                   "<+03>-3" },
+    { "Europe/Kyiv",                       "EET-2EEST,M3.5.0/3,M10.5.0/4" },
+    { "Europe/Lisbon",                     "WET0WEST,M3.5.0/1,M10.5.0" },
+    { "Europe/London",                     "GMT0BST,M3.5.0/1,M10.5.0" },
+    { "Europe/Madrid",                     "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Moscow",                     "MSK-3" },
+    { "Europe/Oslo",                       "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Paris",                      "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Prague",                     "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Rome",                       "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Stockholm",                  "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Vienna",                     "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Warsaw",                     "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Europe/Zurich",                     "CET-1CEST,M3.5.0,M10.5.0/3" },
+    { "Pacific/Auckland",                  "NZST-12NZDT,M9.5.0,M4.1.0/3" },
+    { "Pacific/Chatham",                   "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45" },
+    { "Pacific/Fiji",                      "<+12>-12" },
+    { "Pacific/Guam",                      "ChST-10" },
+    { "Pacific/Honolulu",                  "HST10" },
+    { "Pacific/Kiritimati",                "<+14>-14" },
+    { "Pacific/Pago_Pago",                 "SST11" },
+    { "Pacific/Tongatapu",                 "<+13>-13" },
+    { "UTC",                               "UTC0" },
+};
+static constexpr size_t TIMEZONE_COUNT = sizeof(TIMEZONE_TABLE) / sizeof(TIMEZONE_TABLE[0]);
+
+// Compile-time check that the table stays sorted when zones are added
+static constexpr int tzCompare(const char* a, const char* b) {
+    return (*a != *b || *a == '\0') ? (*a - *b) : tzCompare(a + 1, b + 1);
+}
+static constexpr bool tzTableSorted(size_t i) {
+    return i + 1 >= TIMEZONE_COUNT ||
+           (tzCompare(TIMEZONE_TABLE[i].name, TIMEZONE_TABLE[i + 1].name) < 0 && tzTableSorted(i + 1));
+}
+static_assert(tzTableSorted(0), "TIMEZONE_TABLE must be sorted by name");
+
+// --- DST TRANSITION CACHE ---
+static TimezoneTransitions cachedTransitions = {};
+
+
+size_t timezoneCount() {
+    return TIMEZONE_COUNT;
+}
+
+const TimezoneEntry& timezoneAt(size_t index) {
+    return TIMEZONE_TABLE[index];
+}
+
+/**
+ * @brief Looks up an IANA zone name (binary search, case-sensitive).
+ * @return The table entry, or nullptr if the name is empty or unknown.
+ */
+const TimezoneEntry* findTimezone(const char* name) {
+    if (name == nullptr || name[0] == '\0') return nullptr;
+    size_t low = 0, high = TIMEZONE_COUNT;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        int cmp = strcmp(name, TIMEZONE_TABLE[mid].name);
+        if (cmp == 0) return &TIMEZONE_TABLE[mid];
+        if (cmp < 0) high = mid;
+        else low = mid + 1;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Sets the local time rules (setenv("TZ") + tzset()).
+ * Uses the POSIX rule of userConfig.tz_name, or the manual GMT offset
+ * (plus DST_ACTIVE) when no zone is selected.
+ */
+void applyTimezone() {
+    const TimezoneEntry* zone = findTimezone(userConfig.tz_name);
+    char manualRule[20]; // "UTC" + any int + "DST"
+    const char* rule;
+    if (zone != nullptr) {
+        rule = zone->posix;
+        Serial.printf("Time zone: %s (%s)\n", zone->name, rule);
+    } else {
+        // Same rule configTime() builds: POSIX offsets are west-positive
+        snprintf(manualRule, sizeof(manualRule), "UTC%d%s", -userConfig.gmt_offset_hr, DST_ACTIVE ? "DST" : "");
+        rule = manualRule;
+        Serial.printf("Time zone: manual GMT offset %d h (%s)\n", userConfig.gmt_offset_hr, rule);
+    }
+    setenv("TZ", rule, 1);
+    tzset();
+    cachedTransitions.year = 0; // Rules changed: recompute on next use
+}
+
+/**
+ * @brief Narrows a tm_isdst change in (low, high] down to the exact second.
+ */
+static time_t bisectTransition(time_t low, time_t high) {
+    struct tm probe;
+    localtime_r(&low, &probe);
+    int lowDst = probe.tm_isdst;
+    while (high - low > 1) {
+        time_t mid = low + (high - low) / 2;
+        localtime_r(&mid, &probe);
+        if (probe.tm_isdst == lowDst) low = mid;
+        else high = mid;
+    }
+    return high;
+}
+
+/**
+ * @brief DST start/end for the current year under the active rules.
+ * Computed once per year (and after applyTimezone()) by scanning the year a day
+ * at a time and bisecting each change, so callers only compare timestamps.
+ * @return Entry with year 0 while the clock is not set.
+ */
+const TimezoneTransitions& timezoneTransitions() {
+    time_t now = time(nullptr);
+    if (now < 1600000000) {
+        static const TimezoneTransitions none = {};
+        return none;
+    }
+    struct tm local;
+    localtime_r(&now, &local);
+    int year = local.tm_year + 1900;
+    if (cachedTransitions.year == year) return cachedTransitions;
+
+    // Local midnight on 1 January
+    struct tm jan1 = {};
+    jan1.tm_year = local.tm_year;
+    jan1.tm_mday = 1;
+    jan1.tm_isdst = -1;
+    time_t start = mktime(&jan1);
+
+    cachedTransitions.year = year;
+    cachedTransitions.dst_start = 0;
+    cachedTransitions.dst_end = 0;
+
+    struct tm probe;
+    localtime_r(&start, &probe);
+    int previousDst = probe.tm_isdst;
+    for (int day = 1; day <= 366; day++) {
+        time_t t = start + (time_t)day * 86400;
+        localtime_r(&t, &probe);
+        if (probe.tm_isdst != previousDst) {
+            time_t change = bisectTransition(t - 86400, t);
+            if (probe.tm_isdst > 0) cachedTransitions.dst_start = change;
+            else cachedTransitions.dst_end = change;
+            previousDst = probe.tm_isdst;
+        }
+    }
+    Serial.printf("DST transitions %d: start %ld, end %ld (UTC epoch, 0 = none)\n",
+                  year, (long)cachedTransitions.dst_start, (long)cachedTransitions.dst_end);
+    return cachedTransitions;
+}
@@ -0,0 +1,32 @@
+#ifndef TIMEZONEHANDLER_H
+#define TIMEZONEHANDLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief One embedded zone: IANA name and the POSIX TZ rule it maps to.
+ */
+typedef struct {
+    const char* name;   // e.g. "Europe/London"
+    const char* posix;  // e.g. "GMT0BST,M3.5.0/1,M10.5.0"
+} TimezoneEntry;
+
+/**
+ * @brief DST changes for one calendar year under the active rules (UTC epoch seconds).
+ */
+typedef struct {
+    int16_t year;       // 0 = not computed
+    time_t dst_start;   // 0 if the zone has no DST
+    time_t dst_end;
+} TimezoneTransitions;
+
+// --- FUNCTION PROTOTYPES ---
+size_t timezoneCount();
+const TimezoneEntry& timezoneAt(size_t index);
+const TimezoneEntry* findTimezone(const char* name);
+void applyTimezone();                              // TZ rule (or manual offset)
+const TimezoneTransitions& timezoneTransitions();  // Current year, cached
+
+#endif // TIMEZONEHANDLER_H
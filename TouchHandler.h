@@ -26,16 +26,20 @@ const uint16_t Y_MAX_RAW = 4800;
 const long DEBOUNCE_DELAY_MS = 45;     
 const long DOUBLE_CLICK_TIME_MS = 600; 
 const long LONG_PRESS_TIME_MS = 2000;  // 2 seconds for long press
+const int SWIPE_MIN_DISTANCE_PX = 60;  // Horizontal travel that counts as a swipe
 
 uint16_t touchX = 0, touchY = 0;       
 bool isTouched = false;                
 unsigned long lastPressTime = 0;       
 unsigned long touchStartTime = 0;      // To track press duration
 int pressCount = 0;                    
+uint16_t touchStartX = 0;              // X where the current press began
+bool touchStartCaptured = false;       
+int swipeDirection = 0;                // Set with touchEvent 4: +1 = swipe left (next), -1 = swipe right (previous)
 
 /**
  * @brief Checks for touch events, handling debouncing and click counting.
- * @param touchEvent A pointer to the global touchEvent integer (1=single, 2=double, 3=long press).
+ * @param touchEvent A pointer to the global touchEvent integer (1=single, 2=double, 3=long press, 4=swipe).
  */
 void checkTouch(int *touchEvent) {
 
@@ -75,10 +79,27 @@ void checkTouch(int *touchEvent) {
         if (touchY > DISPLAY_HEIGHT) touchY = DISPLAY_HEIGHT;
         if (touchX < 0) touchX = 0;
         if (touchY < 0) touchY = 0;
+
+        if (!touchStartCaptured) {
+            touchStartX = touchX; // First sample of this press
+            touchStartCaptured = true;
+        }
     } else {
         if (isTouched) { 
             isTouched = false;
+            touchStartCaptured = false;
             unsigned long currentTime = millis();
+
+            // <<< SWIPE DETECTION >>>
+            int travel = (int)touchX - (int)touchStartX;
+            if (abs(travel) >= SWIPE_MIN_DISTANCE_PX) {
+                *touchEvent = 4;
+                swipeDirection = (travel < 0) ? 1 : -1;
+                pressCount = 0;
+                lastPressTime = 0;
+                return;
+            }
+            // <<< END SWIPE DETECTION >>>
             
             // <<< LONG PRESS DETECTION >>>
             if (currentTime - touchStartTime >= LONG_PRESS_TIME_MS) {
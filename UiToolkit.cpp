@@ -0,0 +1,487 @@
+#include "UiToolkit.h"    // Header for this module
+#include "ThemeConfig.h"  // COLOR_BACKGROUND (system screens are not themed)
+#include "Metrics.h"      // Redrawn pixels
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+// --- EXTERNAL DEPENDENCIES ---
+extern TFT_eSPI tft;
+extern const int DISPLAY_WIDTH;
+extern const int DISPLAY_HEIGHT;
+// -----------------------------
+
+// --- LAYOUT ---
+static const int16_t HEADER_BTN_W = 64;
+static const int16_t HEADER_BTN_H = 28;
+static const int16_t HEADER_BTN_MARGIN = 6;
+static const int16_t LIST_ROW_H = 24;
+static const int16_t SLIDER_PAD = 12;   // Track inset from the widget edges
+static const int16_t SLIDER_KNOB_R = 8;
+static const int16_t TOGGLE_W = 44;
+static const int16_t TOGGLE_H = 22;
+static const int16_t HIT_SLOP = 2;      // Resistive panel: accept touches just outside a widget
+static const int16_t SPARK_BAR_W = 3;   // Bar plus a one pixel gap
+
+typedef struct {
+    int16_t x0, y0, x1, y1;
+    UiWidget* widget;
+} UiHit;
+
+// --- STATE ---
+static UiScreen* stack[UI_STACK_DEPTH];
+static uint8_t depth = 0;
+static UiWidget header = {};             // "Close" / "Back", shared by every screen
+static UiHit hits[UI_MAX_WIDGETS + 1];   // Touchable widgets of the screen on top, header last
+static uint8_t hitCount = 0;
+static UiStats stats = {};
+static uint32_t drawnPixels = 0;         // Running total; an interaction is the difference
+
+// Press in progress
+static bool wasPressed = false;
+static UiWidget* active = nullptr;       // Widget the press started on
+static int16_t dragStartY = 0;
+static uint8_t dragStartRow = 0;
+static bool dragged = false;
+static uint32_t pressPixels = 0;
+static unsigned long pressStartUs = 0;
+static unsigned long lastTickMs = 0;
+
+
+static void notePixels(int16_t w, int16_t h) {
+    uint32_t pixels = (uint32_t)w * h;
+    drawnPixels += pixels;
+    metricsNoteRedraw(pixels);
+}
+
+static bool contains(const UiWidget& widget, int16_t x, int16_t y, int16_t slop) {
+    return x >= widget.x - slop && x < widget.x + widget.w + slop &&
+           y >= widget.y - slop && y < widget.y + widget.h + slop;
+}
+
+static uint8_t listRows(const UiWidget& widget) {
+    return widget.h / LIST_ROW_H;
+}
+
+// --- WIDGET DRAWING ---
+// Each draws its whole rectangle (and nothing outside it), so a dirty widget
+// can be redrawn on its own.
+
+static void drawButton(const UiWidget& widget) {
+    uint16_t body = widget.pressed ? TFT_WHITE : widget.color;
+    tft.fillRect(widget.x, widget.y, widget.w, widget.h, COLOR_BACKGROUND);
+    tft.fillRoundRect(widget.x, widget.y, widget.w, widget.h, 5, body);
+    tft.drawRoundRect(widget.x, widget.y, widget.w, widget.h, 5, TFT_WHITE);
+    tft.setTextColor(TFT_BLACK, body);
+    tft.setTextDatum(MC_DATUM);
+    tft.setTextFont(2);
+    tft.drawString(widget.text, widget.x + widget.w / 2, widget.y + widget.h / 2 + 1);
+}
+
+static void drawLabel(const UiWidget& widget) {
+    tft.fillRect(widget.x, widget.y, widget.w, widget.h, COLOR_BACKGROUND);
+    tft.setTextFont(2);
+    tft.setTextDatum(ML_DATUM);
+    tft.setTextColor(TFT_WHITE, COLOR_BACKGROUND);
+    tft.drawString(widget.text, widget.x, widget.y + widget.h / 2);
+    if (widget.detail[0] != '\0') {
+        tft.setTextDatum(MR_DATUM);
+        tft.setTextColor(widget.color, COLOR_BACKGROUND);
+        tft.drawString(widget.detail, widget.x + widget.w, widget.y + widget.h / 2);
+    }
+}
+
+static void drawToggle(const UiWidget& widget) {
+    tft.fillRect(widget.x, widget.y, widget.w, widget.h, COLOR_BACKGROUND);
+    if (widget.pressed) tft.drawRoundRect(widget.x, widget.y, widget.w, widget.h, 5, TFT_DARKGREY);
+    tft.setTextFont(2);
+    tft.setTextDatum(ML_DATUM);
+    tft.setTextColor(TFT_WHITE, COLOR_BACKGROUND);
+    tft.drawString(widget.text, widget.x + 6, widget.y + widget.h / 2);
+
+    int16_t trackX = widget.x + widget.w - TOGGLE_W - 6;
+    int16_t trackY = widget.y + (widget.h - TOGGLE_H) / 2;
+    int16_t radius = TOGGLE_H / 2;
+    tft.fillRoundRect(trackX, trackY, TOGGLE_W, TOGGLE_H, radius, widget.value ? widget.color : TFT_DARKGREY);
+    int16_t knobX = widget.value ? trackX + TOGGLE_W - radius : trackX + radius;
+    tft.fillCircle(knobX, trackY + radius, radius - 3, TFT_WHITE);
+}
+
+static int16_t sliderKnobX(const UiWidget& widget) {
+    int16_t x0 = widget.x + SLIDER_PAD;
+    int16_t span = widget.w - 2 * SLIDER_PAD;
+    if (widget.maximum <= widget.minimum) return x0;
+    return x0 + (int32_t)(widget.value - widget.minimum) * span / (widget.maximum - widget.minimum);
+}
+
+static void drawSlider(const UiWidget& widget) {
+    tft.fillRect(widget.x, widget.y, widget.w, widget.h, COLOR_BACKGROUND);
+    char value[24];
+    if (widget.value == 0 && widget.minimum == 0) {
+        strcpy(value, "Off");
+    } else {
+        snprintf(value, sizeof(value), "%d%s", widget.value, widget.detail);
+    }
+    tft.setTextFont(2);
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextColor(TFT_WHITE, COLOR_BACKGROUND);
+    tft.drawString(widget.text, widget.x + 6, widget.y + 2);
+    tft.setTextDatum(TR_DATUM);
+    tft.setTextColor(widget.pressed ? TFT_WHITE : widget.color, COLOR_BACKGROUND);
+    tft.drawString(value, widget.x + widget.w - 6, widget.y + 2);
+
+    int16_t trackY = widget.y + widget.h - SLIDER_KNOB_R - 4;
+    int16_t x0 = widget.x + SLIDER_PAD;
+    int16_t x1 = widget.x + widget.w - SLIDER_PAD;
+    int16_t knobX = sliderKnobX(widget);
+    tft.fillRect(x0, trackY - 2, knobX - x0, 5, widget.color);
+    tft.fillRect(knobX, trackY - 2, x1 - knobX, 5, TFT_DARKGREY);
+    tft.fillCircle(knobX, trackY, SLIDER_KNOB_R, widget.pressed ? widget.color : TFT_WHITE);
+}
+
+static void drawList(const UiWidget& widget) {
+    tft.fillRect(widget.x, widget.y, widget.w, widget.h, COLOR_BACKGROUND);
+    tft.drawRect(widget.x, widget.y, widget.w, widget.h, TFT_DARKGREY);
+    tft.setTextFont(2);
+    tft.setTextDatum(ML_DATUM);
+    uint8_t rows = listRows(widget);
+    for (uint8_t row = 0; row < rows && widget.first_row + row < widget.item_count; row++) {
+        uint8_t item = widget.first_row + row;
+        int16_t rowY = widget.y + row * LIST_ROW_H;
+        bool selected = item == widget.value;
+        if (selected) tft.fillRect(widget.x + 1, rowY + 1, widget.w - 2, LIST_ROW_H - 2, widget.color);
+        tft.setTextColor(selected ? TFT_BLACK : TFT_WHITE, selected ? widget.color : COLOR_BACKGROUND);
+        tft.drawString(widget.items(item), widget.x + 8, rowY + LIST_ROW_H / 2 + 1);
+    }
+    if (widget.item_count > rows) {
+        // Scroll bar: thumb size and position by the visible share of the rows
+        int16_t thumbH = max(8, (int)widget.h * rows / widget.item_count);
+        int16_t thumbY = widget.y + (widget.h - thumbH) * widget.first_row / (widget.item_count - rows);
+        tft.fillRect(widget.x + widget.w - 4, thumbY, 3, thumbH, TFT_LIGHTGREY);
+    }
+}
+
+static void drawSparkline(const UiWidget& widget) {
+    tft.fillRect(widget.x, widget.y, widget.w, widget.h, COLOR_BACKGROUND);
+    tft.drawFastHLine(widget.x, widget.y + widget.h - 1, widget.w, TFT_DARKGREY);
+    // Newest samples on the right; older ones that do not fit are left out
+    uint8_t fit = widget.w / (SPARK_BAR_W + 1);
+    uint8_t first = widget.item_count > fit ? widget.item_count - fit : 0;
+    int16_t peak = 1;
+    for (uint8_t i = first; i < widget.item_count; i++) peak = max(peak, (int16_t)abs(widget.sample(i)));
+    int16_t x = widget.x + widget.w - (widget.item_count - first) * (SPARK_BAR_W + 1);
+    for (uint8_t i = first; i < widget.item_count; i++, x += SPARK_BAR_W + 1) {
+        int16_t value = widget.sample(i);
+        int16_t barH = max(1, (int)(widget.h - 2) * abs(value) / peak);
+        tft.fillRect(x, widget.y + widget.h - 1 - barH, SPARK_BAR_W, barH, value < 0 ? TFT_RED : widget.color);
+    }
+}
+
+static void drawWidget(UiWidget& widget) {
+    switch (widget.type) {
+        case UI_LABEL:  drawLabel(widget); break;
+        case UI_BUTTON: drawButton(widget); break;
+        case UI_TOGGLE: drawToggle(widget); break;
+        case UI_SLIDER: drawSlider(widget); break;
+        case UI_LIST:   drawList(widget); break;
+        case UI_SPARKLINE: drawSparkline(widget); break;
+    }
+    widget.dirty = false;
+}
+
+// --- SCREENS ---
+
+static void onHeader(UiWidget& widget) {
+    (void)widget;
+    uiPop();
+}
+
+/**
+ * @brief Hit-test table for the screen on top: touchable widgets only, checked
+ * in table order, so a touch costs a short scan instead of a walk of every widget.
+ */
+static void buildHits(UiScreen& screen) {
+    hitCount = 0;
+    for (uint8_t i = 0; i < screen.count && hitCount < UI_MAX_WIDGETS; i++) {
+        UiWidget& widget = screen.widgets[i];
+        if (widget.type == UI_LABEL || widget.type == UI_SPARKLINE) continue;
+        hits[hitCount++] = { (int16_t)(widget.x - HIT_SLOP), (int16_t)(widget.y - HIT_SLOP),
+                             (int16_t)(widget.x + widget.w + HIT_SLOP), (int16_t)(widget.y + widget.h + HIT_SLOP), &widget };
+    }
+    hits[hitCount++] = { header.x, header.y, (int16_t)(header.x + header.w), (int16_t)(header.y + header.h), &header };
+}
+
+static UiWidget* hitTest(int16_t x, int16_t y) {
+    for (uint8_t i = 0; i < hitCount; i++) {
+        const UiHit& hit = hits[i];
+        if (x >= hit.x0 && x < hit.x1 && y >= hit.y0 && y < hit.y1) return hit.widget;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Full draw of the screen on top: background, title, header button and
+ * every widget. Only used when the stack changes.
+ */
+static void drawScreen() {
+    UiScreen& screen = *stack[depth - 1];
+    if (screen.on_show) screen.on_show(screen);
+    active = nullptr;
+    lastTickMs = millis();
+
+    tft.fillScreen(COLOR_BACKGROUND);
+    notePixels(DISPLAY_WIDTH, DISPLAY_HEIGHT); // Widgets are drawn inside it: not counted again
+    tft.setFreeFont(NULL);
+    tft.setTextFont(4);
+    tft.setTextDatum(ML_DATUM);
+    tft.setTextColor(TFT_WHITE, COLOR_BACKGROUND);
+    tft.drawString(screen.title, 10, HEADER_BTN_MARGIN + HEADER_BTN_H / 2);
+
+    header.type = UI_BUTTON;
+    header.x = DISPLAY_WIDTH - HEADER_BTN_W - HEADER_BTN_MARGIN;
+    header.y = HEADER_BTN_MARGIN;
+    header.w = HEADER_BTN_W;
+    header.h = HEADER_BTN_H;
+    header.color = TFT_GREEN;
+    header.pressed = false;
+    header.on_change = onHeader;
+    strncpy(header.text, depth == 1 ? "Close" : "Back", sizeof(header.text) - 1);
+    drawWidget(header);
+    for (uint8_t i = 0; i < screen.count; i++) drawWidget(screen.widgets[i]);
+    buildHits(screen);
+}
+
+void uiPush(UiScreen& screen) {
+    if (depth == UI_STACK_DEPTH) {
+        Serial.printf("UI: screen stack full, '%s' not shown.\n", screen.title);
+        return;
+    }
+    stack[depth++] = &screen;
+    drawScreen();
+}
+
+void uiPop() {
+    if (depth == 0) return;
+    depth--;
+    active = nullptr;
+    if (depth > 0) drawScreen();
+}
+
+void uiClear() {
+    depth = 0;
+    active = nullptr;
+    wasPressed = false;
+}
+
+bool uiActive() {
+    return depth > 0;
+}
+
+const UiScreen* uiTop() {
+    return depth > 0 ? stack[depth - 1] : nullptr;
+}
+
+// --- INPUT ---
+
+static void setSliderFromX(UiWidget& widget, int16_t x) {
+    int16_t x0 = widget.x + SLIDER_PAD;
+    int16_t span = widget.w - 2 * SLIDER_PAD;
+    int32_t offset = constrain(x - x0, 0, span);
+    int32_t range = widget.maximum - widget.minimum;
+    int32_t steps = (offset * range + span / 2) / span;
+    if (widget.step > 1) steps = (steps + widget.step / 2) / widget.step * widget.step;
+    uiSetValue(widget, constrain(widget.minimum + steps, widget.minimum, widget.maximum));
+}
+
+/**
+ * @brief Release: acts on the widget the press started on. Handlers may push or
+ * pop screens, so nothing touches the widget after calling one.
+ */
+static void release(UiWidget& widget, int16_t x, int16_t y) {
+    widget.pressed = false;
+    widget.dirty = true;
+    bool inside = contains(widget, x, y, HIT_SLOP);
+    switch (widget.type) {
+        case UI_BUTTON:
+            if (!inside) return;
+            break;
+        case UI_TOGGLE:
+            if (!inside) return;
+            widget.value = !widget.value;
+            break;
+        case UI_SLIDER:
+            break; // Reported wherever the finger left it
+        case UI_LIST: {
+            if (dragged || !inside) return;
+            uint8_t item = widget.first_row + (y - widget.y) / LIST_ROW_H;
+            if (item >= widget.item_count) return;
+            widget.value = item;
+            break;
+        }
+        case UI_LABEL:
+        case UI_SPARKLINE:
+            return;
+    }
+    if (widget.on_change) widget.on_change(widget);
+}
+
+/**
+ * @brief Redraws only the widgets marked dirty on the screen on top.
+ */
+static void redrawDirty() {
+    if (depth == 0) return;
+    UiScreen& screen = *stack[depth - 1];
+    if (header.dirty) {
+        drawWidget(header);
+        notePixels(header.w, header.h);
+    }
+    for (uint8_t i = 0; i < screen.count; i++) {
+        UiWidget& widget = screen.widgets[i];
+        if (!widget.dirty) continue;
+        drawWidget(widget);
+        notePixels(widget.w, widget.h);
+    }
+}
+
+bool uiService(bool pressed, uint16_t x, uint16_t y) {
+    if (depth == 0) return false;
+    bool handled = pressed || wasPressed;
+
+    if (pressed && !wasPressed) {
+        pressStartUs = micros();
+        pressPixels = drawnPixels;
+        active = hitTest(x, y);
+        if (active) {
+            active->pressed = true;
+            active->dirty = true;
+            if (active->type == UI_SLIDER) setSliderFromX(*active, x);
+            dragStartY = y;
+            dragStartRow = active->first_row;
+            dragged = false;
+        }
+    } else if (pressed && active) {
+        if (active->type == UI_SLIDER) {
+            setSliderFromX(*active, x);
+        } else if (active->type == UI_LIST) {
+            // Dragging up scrolls down, one row per row height travelled
+            int rows = listRows(*active);
+            int maxFirst = max(0, (int)active->item_count - rows);
+            int first = constrain(dragStartRow + (dragStartY - (int)y) / LIST_ROW_H, 0, maxFirst);
+            if (first != active->first_row) {
+                active->first_row = first;
+                active->dirty = true;
+                dragged = true;
+            }
+        }
+    }
+
+    char touched[UI_TEXT_LEN] = "";
+    bool released = !pressed && wasPressed;
+    wasPressed = pressed;
+    if (released && active) {
+        UiWidget& widget = *active;
+        active = nullptr;
+        strncpy(touched, widget.text, sizeof(touched) - 1);
+        release(widget, x, y);
+    }
+
+    if (depth > 0) {
+        UiScreen& screen = *stack[depth - 1];
+        if (screen.on_tick && millis() - lastTickMs >= screen.tick_ms) {
+            lastTickMs = millis();
+            screen.on_tick(screen);
+        }
+    }
+    redrawDirty();
+
+    if (released) {
+        uint32_t pixels = drawnPixels - pressPixels;
+        stats.interactions++;
+        stats.interaction_pixels += pixels;
+        stats.last_pixels = pixels;
+        metricsNoteUiInteraction(pixels);
+        Serial.printf("UI: '%s' touch redrew %lu px in %lu ms.\n", touched[0] ? touched : "(nothing)",
+                      (unsigned long)pixels, (unsigned long)((micros() - pressStartUs) / 1000));
+    }
+    return handled;
+}
+
+// --- WIDGET CONSTRUCTORS ---
+
+static UiWidget makeWidget(UiWidgetType type, int16_t x, int16_t y, int16_t w, int16_t h,
+                           const char* text, uint16_t color, UiHandler handler) {
+    UiWidget widget = {};
+    widget.type = type;
+    widget.x = x;
+    widget.y = y;
+    widget.w = w;
+    widget.h = h;
+    widget.color = color;
+    strncpy(widget.text, text, sizeof(widget.text) - 1);
+    widget.on_change = handler;
+    widget.dirty = true;
+    return widget;
+}
+
+UiWidget uiLabel(int16_t x, int16_t y, int16_t w, int16_t h, const char* text) {
+    return makeWidget(UI_LABEL, x, y, w, h, text, TFT_WHITE, nullptr);
+}
+
+UiWidget uiButton(int16_t x, int16_t y, int16_t w, int16_t h, const char* text, uint16_t color, UiHandler onTap) {
+    return makeWidget(UI_BUTTON, x, y, w, h, text, color, onTap);
+}
+
+UiWidget uiToggle(int16_t x, int16_t y, int16_t w, int16_t h, const char* text, uint16_t color, UiHandler onChange) {
+    return makeWidget(UI_TOGGLE, x, y, w, h, text, color, onChange);
+}
+
+UiWidget uiSlider(int16_t x, int16_t y, int16_t w, int16_t h, const char* text, uint16_t color,
+                  int16_t minimum, int16_t maximum, int16_t step, const char* unit, UiHandler onChange) {
+    UiWidget widget = makeWidget(UI_SLIDER, x, y, w, h, text, color, onChange);
+    widget.minimum = minimum;
+    widget.maximum = maximum;
+    widget.step = step;
+    widget.value = minimum;
+    strncpy(widget.detail, unit, sizeof(widget.detail) - 1);
+    return widget;
+}
+
+UiWidget uiList(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, UiItemFn items, UiHandler onSelect) {
+    UiWidget widget = makeWidget(UI_LIST, x, y, w, h, "", color, onSelect);
+    widget.items = items;
+    return widget;
+}
+
+UiWidget uiSparkline(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, UiSampleFn sample) {
+    UiWidget widget = makeWidget(UI_SPARKLINE, x, y, w, h, "", color, nullptr);
+    widget.sample = sample;
+    return widget;
+}
+
+// --- WIDGET STATE ---
+// Setters mark a widget dirty only when something it shows changes.
+
+void uiSetText(UiWidget& widget, const char* text) {
+    if (strncmp(widget.text, text, sizeof(widget.text) - 1) == 0) return;
+    strncpy(widget.text, text, sizeof(widget.text) - 1);
+    widget.text[sizeof(widget.text) - 1] = '\0';
+    widget.dirty = true;
+}
+
+void uiSetDetail(UiWidget& widget, const char* detail, uint16_t color) {
+    if (strncmp(widget.detail, detail, sizeof(widget.detail) - 1) == 0 && widget.color == color) return;
+    strncpy(widget.detail, detail, sizeof(widget.detail) - 1);
+    widget.detail[sizeof(widget.detail) - 1] = '\0';
+    widget.color = color;
+    widget.dirty = true;
+}
+
+void uiSetValue(UiWidget& widget, int16_t value) {
+    if (widget.value == value) return;
+    widget.value = value;
+    widget.dirty = true;
+}
+
+const UiStats& uiStats() {
+    return stats;
+}
@@ -0,0 +1,85 @@
+#ifndef UITOOLKIT_H
+#define UITOOLKIT_H
+
+#include <stdint.h>
+
+// --- RETAINED-MODE TOUCH WIDGETS ---
+// Screens are static tables of widgets. The toolkit keeps a stack of them, a
+// hit-test table for the screen on top and a dirty flag per widget: a touch only
+// redraws the widgets it changed. It never blocks or owns the loop; loop() feeds
+// it the raw press state through uiService().
+
+#define UI_STACK_DEPTH 4
+#define UI_MAX_WIDGETS 16   // Touchable widgets per screen, header button not included
+#define UI_TEXT_LEN 40
+
+typedef enum : uint8_t {
+    UI_LABEL,   // Text with an optional right-aligned value (detail); not touchable
+    UI_BUTTON,  // Activates on release inside it
+    UI_TOGGLE,  // value 0/1, flips on release
+    UI_SLIDER,  // value in [minimum, maximum] by step, detail = unit (0 reads "Off"); follows the finger, reports on release
+    UI_LIST,    // Rows from items(); value = selected row, scrolls by dragging
+    UI_SPARKLINE // Bars of sample(0..item_count-1), scaled to the largest; negative = drawn as a failure
+} UiWidgetType;
+
+struct UiWidget;
+typedef void (*UiHandler)(UiWidget& widget);
+typedef const char* (*UiItemFn)(uint8_t index);
+typedef int16_t (*UiSampleFn)(uint8_t index);
+
+typedef struct UiWidget {
+    UiWidgetType type;
+    int16_t x, y;
+    int16_t w, h;
+    uint16_t color;            // Button body, toggle/slider "on" colour, label value colour
+    char text[UI_TEXT_LEN];    // Caption
+    char detail[UI_TEXT_LEN];  // Labels: value drawn right-aligned
+    int16_t value;
+    int16_t minimum, maximum, step; // Sliders
+    UiItemFn items;            // Lists
+    UiSampleFn sample;         // Sparklines
+    uint8_t item_count;        // Rows or samples
+    uint8_t first_row;         // Lists: scroll position
+    UiHandler on_change;       // Button tap, toggle flip, slider release, list selection
+    bool dirty;
+    bool pressed;
+} UiWidget;
+
+typedef struct UiScreen {
+    const char* title;
+    UiWidget* widgets;
+    uint8_t count;
+    void (*on_show)(UiScreen& screen); // Refreshes widget values before the screen is drawn (push and pop)
+    void (*on_tick)(UiScreen& screen); // Optional: called every tick_ms while on top; setters mark what changed
+    uint16_t tick_ms;
+} UiScreen;
+
+typedef struct {
+    uint32_t interactions;     // Press-to-release sequences on the menu
+    uint64_t interaction_pixels; // Pixels they redrew, full-screen transitions included
+    uint32_t last_pixels;
+} UiStats;
+
+// --- WIDGET CONSTRUCTORS ---
+// For the static screen tables; everything not given starts at zero.
+UiWidget uiLabel(int16_t x, int16_t y, int16_t w, int16_t h, const char* text);
+UiWidget uiButton(int16_t x, int16_t y, int16_t w, int16_t h, const char* text, uint16_t color, UiHandler onTap);
+UiWidget uiToggle(int16_t x, int16_t y, int16_t w, int16_t h, const char* text, uint16_t color, UiHandler onChange);
+UiWidget uiSlider(int16_t x, int16_t y, int16_t w, int16_t h, const char* text, uint16_t color,
+                  int16_t minimum, int16_t maximum, int16_t step, const char* unit, UiHandler onChange);
+UiWidget uiList(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, UiItemFn items, UiHandler onSelect);
+UiWidget uiSparkline(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color, UiSampleFn sample);
+
+// --- FUNCTION PROTOTYPES ---
+void uiPush(UiScreen& screen);   // Draws the screen in full
+void uiPop();                    // Back to the screen below (drawn in full); popping the last one closes the UI
+void uiClear();                  // Empties the stack without drawing
+bool uiActive();
+const UiScreen* uiTop();         // Screen on top, nullptr when closed
+bool uiService(bool pressed, uint16_t x, uint16_t y); // loop(): touch, then dirty widgets; true while touched or on release
+void uiSetText(UiWidget& widget, const char* text);
+void uiSetDetail(UiWidget& widget, const char* detail, uint16_t color);
+void uiSetValue(UiWidget& widget, int16_t value);
+const UiStats& uiStats();
+
+#endif // UITOOLKIT_H
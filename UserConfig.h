@@ -3,18 +3,47 @@
 
 // --- CONFIGURATION MACROS ---
 #define PREF_NAMESPACE "FlipClock" 
+#define WEATHER_EXTRA_LOCATIONS 3 // Locations shown in rotation after the primary one
+
+#define POWER_PROFILE_COUNT 3      // Quiet-hours windows
+#define WIFI_EXTRA_NETWORKS 3       // Known networks besides the primary one (ssid/password)
+
+// One quiet-hours window. Overnight windows (end before start) are allowed.
+typedef struct {
+    uint8_t weekdays;       // Days the window starts on (bit 0 = Sunday); 0 = profile off
+    uint8_t start_hour;
+    uint8_t start_minute;
+    uint8_t end_hour;
+    uint8_t end_minute;
+    uint8_t mode;           // POWER_MODE_* (PowerProfile.h)
+    uint8_t dim_percent;    // Backlight level for POWER_MODE_DIM
+    uint8_t weather_factor; // Weather refresh interval multiplier inside the window (1 = unchanged)
+} powerProfile_t;
+
+// One extra weather location. Either city_id or city/country_code is set.
+typedef struct {
+    char city[40];
+    char country_code[4];
+    char city_id[12];
+} weatherLocation_t;
+
+// One extra Wi-Fi network. An empty ssid = unused slot.
+typedef struct {
+    char ssid[32];
+    char password[64];
+} wifiCredential_t;
 
 // 2. DEFINE THE CONFIGURATION STRUCTURE
-// IMPORTANT: Changes to this struct require re-flashing the ESP32 to clear old NVS data 
-// if you experience unexpected behavior or size mismatches.
+// Stored one NVS key per field (ConfigStore.cpp): a new field needs an entry in
+// CONFIG_FIELDS there, and keeps its default on devices that have not saved it yet.
 typedef struct {
-    // WiFi Credentials (saved by WiFiManager)
+    // WiFi Credentials (saved by the setup portal once they have worked)
     char ssid[32];
     char password[64];
     
     // Core Settings
     char weather_api_key[40];
-    int gmt_offset_hr;
+    int gmt_offset_hr;           // Manual offset, used when tz_name is empty
     int sleep_timeout_min;
     
     // >>> NEW: TIME FORMAT CONFIGURATION <<<
@@ -40,6 +69,54 @@ typedef struct {
     // >>> NEW: ICON COLOR TOGGLE <<<
     // true (1) = Multi-Color Icons, false (0) = Single Color Icon
     bool use_multi_color_icons; 
+
+    // >>> NEW: WEATHER VIEW <<<
+    // 0 = Current conditions, 1 = Hourly forecast strip, 2 = Daily forecast strip
+    uint8_t weather_view;
+
+    // >>> NEW: WEATHER PROVIDER <<<
+    // 0 = OpenWeatherMap, 1 = Open-Meteo (keyless, uses coordinates), 2 = Mock
+    uint8_t weather_provider;
+    float latitude;              // Decimal degrees, north positive
+    float longitude;             // Decimal degrees, east positive
+
+    // >>> NEW: API QUOTA <<<
+    uint16_t weather_daily_quota; // Max provider calls per UTC day (0 = unlimited)
+
+    // >>> NEW: EXTRA LOCATIONS <<<
+    // Empty entries (no city and no city_id) are skipped
+    weatherLocation_t extra_locations[WEATHER_EXTRA_LOCATIONS];
+
+    // >>> NEW: AUTOMATIC THEME <<<
+    // true (1) = Light theme from sunrise to sunset, dark theme at night (uses latitude/longitude)
+    bool auto_theme;
+
+    // >>> NEW: TIME ZONE <<<
+    // IANA name from the embedded zone table (e.g. "Europe/London"), empty = manual GMT offset
+    char tz_name[40];
+
+    // >>> NEW: QUIET HOURS <<<
+    powerProfile_t power_profiles[POWER_PROFILE_COUNT];
+
+    // >>> NEW: FIRMWARE UPDATE PASSWORD <<<
+    // HTTP auth password for POST /update (user OTA_USERNAME); empty = network updates refused
+    char update_password[32];
+
+    // >>> NEW: THEMES <<<
+    // Names from ThemeConfig.h or the asset pack; tap (or the automatic theme) switches between them
+    char theme_dark[16];
+    char theme_light[16];
+
+    // >>> NEW: STATIC IP <<<
+    // Dotted IPv4 text, static_ip empty = DHCP; subnet defaults to 255.255.255.0, DNS to the gateway
+    char static_ip[16];
+    char static_gateway[16];
+    char static_subnet[16];
+    char static_dns[16];
+
+    // >>> NEW: MORE WI-FI NETWORKS <<<
+    // Tried along with ssid/password, strongest first; the setup portal moves a replaced primary here
+    wifiCredential_t extra_networks[WIFI_EXTRA_NETWORKS];
     
 } userConfig_t;
 
@@ -1,173 +1,239 @@
 #include "WeatherHandler.h"   // Header for this module
-#include "config.h"           // For constants (OPENWEATHER_URL_BASE, etc.)
+#include "config.h"           // For constants (WEATHER_UPDATE_INTERVAL_MS, etc.)
 #include "UserConfig.h"       // For the userConfig struct
 #include "MenuHandler.h"      // For WeatherState enum and externs
+#include "WeatherScheduler.h" // Adaptive refresh / backoff / quota
+#include "WeatherUtilities.h" // For weatherIdIsPrecipitation()
+#include "SolarCalculator.h"  // Day/night from the configured coordinates
+#include "PowerProfile.h"     // Quiet-hours refresh factor
+#include "Metrics.h"          // Fetch counters for /metrics
 
-// Include libraries needed for implementation
-#include <WiFiClientSecure.h>
+#include <esp_random.h>
 
 // Note: HTTPClient.h, ArduinoJson.h, WiFi.h, Arduino.h
 // are already included via WeatherHandler.h
 
 
+// --- LAST FETCH DIAGNOSTICS ---
+WeatherResult lastWeatherResult = WEATHER_RESULT_OK;
+WeatherFetchStats lastWeatherFetchStats = {};
+
+// --- MULTI-LOCATION STATE ---
+WeatherRecord weatherRecords[WEATHER_MAX_LOCATIONS];
+bool weatherRecordValid[WEATHER_MAX_LOCATIONS] = {};
+uint8_t weatherLocationCount = 1;
+uint8_t weatherDisplayIndex = 0;
+
+// --- REFRESH SCHEDULE ---
+// Kept in RTC memory so the daily call counter survives deep sleep
+RTC_DATA_ATTR WeatherSchedule weatherSchedule = {};
+static unsigned long lastWeatherSuccessMs = 0; // For keeping stale data on transient errors
+
+
 /**
- * @brief Custom URL encoder for City Names. Required for OWM API calls.
- * @param str The string to encode (e.g., "New York").
- * @return The URL-encoded string (e.g., "New+York").
+ * @brief Resets the refresh timer (boot, wake or settings change). Quota counters are kept.
  */
-String manualUrlEncode(const String& str) {
-    String encodedString = "";
-    char c;
-    char code0;
-    char code1;
-    for (int i = 0; i < str.length(); i++) {
-        c = str.charAt(i);
-        // Standard safe characters: alphanumeric, -._~
-        if (c == ' ') {
-            encodedString += '+';
-            // Common for query strings
-        } else if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
-            encodedString += c;
-        } else {
-            // Hex encoding logic
-            code0 = (c & 0xf) + '0';
-            if ((c & 0xf) > 9) {
-                code0 = (c & 0xf) - 10 + 'A';
-            }
-            c = (c >> 4) & 0xf;
-            code1 = c + '0';
-            if (c > 9) {
-                code1 = c - 10 + 'A';
-            }
-            encodedString += '%';
-            encodedString += code1;
-            encodedString += code0;
-        }
+void resetWeatherSchedule() {
+    scheduleReset(weatherSchedule);
+}
+
+/**
+ * @brief Day number the quota counter belongs to.
+ */
+static uint32_t weatherQuotaDay() {
+    time_t now = time(nullptr);
+    return (now > 1600000000) ? (uint32_t)(now / 86400) : 0; // 0 until NTP has synced
+}
+
+/**
+ * @brief Counts one provider request against userConfig.weather_daily_quota.
+ * Called by the providers for every HTTP request they send.
+ * @return False if the quota for the current UTC day is used up.
+ */
+bool weatherQuotaTake() {
+    return scheduleTakeQuota(weatherSchedule, weatherQuotaDay(), userConfig.weather_daily_quota);
+}
+
+/**
+ * @brief True if at least one more request fits in today's quota. Counts nothing.
+ */
+bool weatherQuotaAvailable() {
+    return scheduleQuotaAvailable(weatherSchedule, weatherQuotaDay(), userConfig.weather_daily_quota);
+}
+
+/**
+ * @brief Location from the main config fields (City ID when in ID mode).
+ */
+WeatherLocation primaryWeatherLocation() {
+    WeatherLocation location;
+    location.city = userConfig.weather_city;
+    location.country_code = userConfig.weather_country_code;
+    location.city_id = userConfig.use_city_id_mode ? userConfig.weather_city_id : "";
+    return location;
+}
+
+/**
+ * @brief Builds the fetch list: primary first, then non-empty extra locations.
+ * @return Number of entries written to locations.
+ */
+static uint8_t collectWeatherLocations(WeatherLocation* locations) {
+    uint8_t count = 0;
+    locations[count++] = primaryWeatherLocation();
+    for (int i = 0; i < WEATHER_EXTRA_LOCATIONS; i++) {
+        const weatherLocation_t& extra = userConfig.extra_locations[i];
+        if (extra.city_id[0] == '\0' && extra.city[0] == '\0') continue;
+        locations[count].city = extra.city;
+        locations[count].country_code = extra.country_code;
+        locations[count].city_id = extra.city_id;
+        count++;
     }
-    return encodedString;
+    return count;
 }
 
+/**
+ * @brief Moves the display to the next/previous location that has data.
+ */
+void advanceWeatherLocation(int step) {
+    if (weatherLocationCount <= 1) return;
+    uint8_t index = weatherDisplayIndex;
+    for (uint8_t tries = 0; tries < weatherLocationCount; tries++) {
+        index = (index + weatherLocationCount + step) % weatherLocationCount;
+        if (weatherRecordValid[index]) break;
+    }
+    if (index != weatherDisplayIndex) {
+        weatherDisplayIndex = index;
+        weatherDataUpdated = true;
+    }
+}
 
 /**
- * @brief Fetches weather data using the configured method (City Name or City ID).
+ * @brief Maps a fetch result to the scheduler's retry classes.
+ */
+ScheduleOutcome weatherScheduleOutcome(WeatherResult result) {
+    switch (result) {
+        case WEATHER_RESULT_OK:
+            return SCHEDULE_SUCCESS;
+        case WEATHER_RESULT_RATE_LIMITED:
+        case WEATHER_RESULT_QUOTA:
+            return SCHEDULE_RATE_LIMITED;
+        case WEATHER_RESULT_NO_KEY:
+        case WEATHER_RESULT_NO_LOCATION:
+        case WEATHER_RESULT_AUTH:
+        case WEATHER_RESULT_NOT_FOUND:
+            return SCHEDULE_CONFIG_FAILURE;
+        default:
+            return SCHEDULE_TRANSIENT_FAILURE;
+    }
+}
+
+
+/**
+ * @brief Fetches weather data from the configured provider.
  * Updates global weather variables and sets the current_weather_state.
  */
 void fetchWeatherData() {
     
-    // Throttle updates
-    if (lastWeatherUpdate != 0 && (millis() - lastWeatherUpdate < WEATHER_UPDATE_INTERVAL_MS)) {
+    // Throttle updates (delay chosen by the scheduler after the last attempt)
+    if (!scheduleIsDue(weatherSchedule, millis())) {
         return;
     }
     
-    // Sanity checks: Do not attempt fetch if config is missing.
-    if (userConfig.weather_api_key[0] == '\0') {
-        Serial.println("FATAL ERROR: OpenWeatherMap API Key is empty. Skipping weather fetch.");
-        weatherStatus = "No API Key";
-        current_weather_state = WEATHER_NO_KEY;
-        lastWeatherUpdate = millis();
-        return;
-    }
-    if (!userConfig.use_city_id_mode && (userConfig.weather_city[0] == '\0' || userConfig.weather_country_code[0] == '\0')) {
-        Serial.println("FATAL ERROR: Using City Name mode, but City or Country code is empty. Skipping.");
-        weatherStatus = "No City Config";
-        current_weather_state = WEATHER_ERROR;
-        lastWeatherUpdate = millis();
-        return;
-    }
-    if (userConfig.use_city_id_mode && userConfig.weather_city_id[0] == '\0') {
-        Serial.println("FATAL ERROR: Using City ID mode, but City ID is empty. Skipping.");
-        weatherStatus = "No ID Config";
-        current_weather_state = WEATHER_ERROR;
-        lastWeatherUpdate = millis();
-        return;
-    }
+    const WeatherProvider& provider = activeWeatherProvider();
     
     String oldWeatherStatus = weatherStatus;
+    uint16_t oldConditionId = weatherConditionId;
+    bool oldIsDay = weatherIsDay;
     float oldTemperature = temperature;
     String oldTemperatureUnit = temperatureUnit;
-    Serial.println("--- Attempting to fetch weather data ---");
     
-    if (WiFi.status() == WL_CONNECTED) {
-        
-        WiFiClientSecure client;
-        client.setInsecure(); // Allow HTTPS connections without a root CA certificate
-        HTTPClient http;
-        String url = OPENWEATHER_URL_BASE;
-        
-        if (userConfig.use_city_id_mode) {
-            // Mode 1: Use City ID
-            url += "id=";
-            url += userConfig.weather_city_id;
-            Serial.printf("Weather Source: ID (%s)\n", userConfig.weather_city_id); 
-        } else {
-            // Mode 2: Use City Name (URL-Encoding required)
-            url += "q=";
-            String cityUrlEncoded = manualUrlEncode(userConfig.weather_city);
-            
-            url += cityUrlEncoded;
-            url += ",";
-            url += userConfig.weather_country_code;
-            Serial.printf("Weather Source: Location (%s, %s)\n", userConfig.weather_city, userConfig.weather_country_code);
-        }
-        
-        // Append Units based on user configuration
-        if (userConfig.use_fahrenheit) {
-            url += "&units=imperial";
-            temperatureUnit = "F"; 
+    WeatherLocation locations[WEATHER_MAX_LOCATIONS];
+    uint8_t count = provider.supportsLocations() ? collectWeatherLocations(locations) : 1;
+    if (count == 1) locations[0] = primaryWeatherLocation();
+    
+    // Sanity checks: Do not attempt fetch if config is missing.
+    WeatherResult result = provider.checkConfig(locations[0]);
+    if (result != WEATHER_RESULT_OK) {
+        Serial.printf("FATAL ERROR: %s provider not configured (%s). Skipping weather fetch.\n", provider.name(), weatherResultText(result));
+        memset(&lastWeatherFetchStats, 0, sizeof(lastWeatherFetchStats));
+    } else if (!weatherQuotaAvailable()) {
+        result = WEATHER_RESULT_QUOTA;
+        Serial.printf("Weather fetch skipped: daily quota of %u calls reached.\n", userConfig.weather_daily_quota);
+    } else {
+        Serial.printf("--- Attempting to fetch weather data (%s, %u location%s) ---\n", provider.name(), count, count > 1 ? "s" : "");
+        WeatherResult results[WEATHER_MAX_LOCATIONS];
+        if (count > 1) {
+            provider.fetchBatch(locations, count, weatherRecords, results, lastWeatherFetchStats);
         } else {
-            url += "&units=metric";
-            temperatureUnit = "C"; 
+            results[0] = provider.fetch(locations[0], weatherRecords[0], lastWeatherFetchStats);
         }
         
-        url += "&appid=";
-        url += userConfig.weather_api_key; 
-
-        //Serial.print("Final URL: "); // Useful for debugging
-        //Serial.println(url); 
-
-        http.begin(client, url);
-        int httpResponseCode = http.GET();
-        
-        if (httpResponseCode == 200) {
-            String payload = http.getString();
-            StaticJsonDocument<3000> doc;
-            DeserializationError error = deserializeJson(doc, payload);
-
-            if (!error) {
-                float temp = doc["main"]["temp"];
-                const char* description = doc["weather"][0]["description"];
-                
-                temperature = temp;
-                weatherStatus = String(description); 
-                current_weather_state = WEATHER_OK;
-                Serial.println("Weather data received successfully.");
-            } else {
-                Serial.print("JSON Parsing FAILED: ");
-                Serial.println(error.f_str());
-                weatherStatus = "JSON Error";
-                current_weather_state = WEATHER_ERROR;
-            }
-            
-        } else {
-            Serial.printf("HTTP GET Failed, Code: %d. Error: %s\n", httpResponseCode, http.errorToString(httpResponseCode).c_str());
-            if (httpResponseCode == 404) {
-                 weatherStatus = "Location Not Found";
-            } else if (httpResponseCode == 401) {
-                 weatherStatus = "Invalid API Key";
-            } else {
-                 weatherStatus = "HTTP Error";
+        // Extra locations keep their last good record on failure; only the primary drives the status
+        for (uint8_t i = 0; i < count; i++) {
+            if (results[i] == WEATHER_RESULT_OK) {
+                weatherRecordValid[i] = true;
+                if (weatherRecords[i].name[0] == '\0') {
+                    const char* label = locations[i].city[0] ? locations[i].city : locations[i].city_id;
+                    strncpy(weatherRecords[i].name, label, sizeof(weatherRecords[i].name) - 1);
+                    weatherRecords[i].name[sizeof(weatherRecords[i].name) - 1] = '\0';
+                }
+            } else if (i > 0) {
+                Serial.printf("Weather location %u failed (%s).\n", i, weatherResultText(results[i]));
             }
-            current_weather_state = WEATHER_ERROR;
         }
+        for (uint8_t i = count; i < WEATHER_MAX_LOCATIONS; i++) {
+            weatherRecordValid[i] = false;
+        }
+        weatherLocationCount = count;
+        if (weatherDisplayIndex >= count) weatherDisplayIndex = 0;
         
-        http.end();
+        result = results[0];
+        metricsNoteWeatherFetch(result == WEATHER_RESULT_OK, lastWeatherFetchStats.total_ms, lastWeatherFetchStats.http_code);
+        if (result == WEATHER_RESULT_OK) {
+            const WeatherRecord& record = weatherRecords[0];
+            temperature = record.temperature;
+            temperatureUnit = userConfig.use_fahrenheit ? "F" : "C";
+            weatherStatus = String(record.description); 
+            // Resolved once per fetch; drawWeather() only does table lookups
+            weatherConditionId = record.condition_id;
+            weatherIsDay = solarIsDaytime(record.is_day); // Provider flag only until NTP has synced
+            Serial.println("Weather data received successfully.");
+        }
+        Serial.printf("Weather fetch [%s]: %u location(s), HTTP %d, %u request bytes, %u response bytes, %u ms total over %u connection(s), %u us parse\n",
+                      provider.name(), count, lastWeatherFetchStats.http_code, lastWeatherFetchStats.request_bytes,
+                      lastWeatherFetchStats.response_bytes, lastWeatherFetchStats.total_ms, lastWeatherFetchStats.connections,
+                      lastWeatherFetchStats.parse_us);
+    }
+    
+    lastWeatherResult = result;
+    ScheduleOutcome outcome = weatherScheduleOutcome(result);
+    
+    // Transient errors keep the last good data on screen for a while instead of blanking it
+    bool keepStale = (outcome == SCHEDULE_TRANSIENT_FAILURE || outcome == SCHEDULE_RATE_LIMITED) &&
+                     current_weather_state == WEATHER_OK && millis() - lastWeatherSuccessMs < WEATHER_STALE_MAX_MS;
+    
+    if (result == WEATHER_RESULT_OK) {
+        current_weather_state = WEATHER_OK;
+        lastWeatherSuccessMs = millis();
+    } else if (keepStale) {
+        Serial.printf("Weather fetch failed (%s). Keeping last data.\n", weatherResultText(result));
     } else {
-        weatherStatus = "WiFi Offline";
-        current_weather_state = WEATHER_ERROR;
+        weatherStatus = weatherResultText(result);
+        current_weather_state = (result == WEATHER_RESULT_NO_KEY) ? WEATHER_NO_KEY : WEATHER_ERROR;
     }
+    
+    // Schedule the next attempt
+    WeatherScheduleContext context;
+    context.precipitation = current_weather_state == WEATHER_OK && weatherIdIsPrecipitation(weatherConditionId);
+    context.backlight_on = backlight_state;
+    context.idle = millis() - lastActivityTime > WEATHER_IDLE_THRESHOLD_MS;
+    context.power_factor = powerCurrentWindow().weather_factor;
+    scheduleRecord(weatherSchedule, millis(), outcome, context, esp_random());
+    Serial.printf("Next weather fetch in %lu s (failures: %u, calls today: %u/%u).\n",
+                  weatherSchedule.next_delay_ms / 1000, weatherSchedule.failures,
+                  weatherSchedule.calls_today, userConfig.weather_daily_quota);
 
     // Flag for redraw only if data has actually changed
-    if (weatherStatus != oldWeatherStatus || abs(temperature - oldTemperature) > 0.1 || temperatureUnit != oldTemperatureUnit) {
+    if (weatherStatus != oldWeatherStatus || weatherConditionId != oldConditionId || weatherIsDay != oldIsDay || abs(temperature - oldTemperature) > 0.1 || temperatureUnit != oldTemperatureUnit) {
         weatherDataUpdated = true;
     }
     
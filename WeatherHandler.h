@@ -5,6 +5,8 @@
 #include <WiFi.h>
 #include <HTTPClient.h>  
 #include <ArduinoJson.h> 
+#include "WeatherProvider.h" // For WeatherResult / WeatherFetchStats
+#include "WeatherScheduler.h" // For ScheduleOutcome
 
 // --- WEATHER STATE VARIABLES (Declared here, Defined in .ino) ---
 // These variables are shared across the project.
@@ -14,9 +16,26 @@ extern float temperature;       // <-- FIXED (was temperatureC)
 extern float humidityPercent;
 extern bool weatherDataUpdated; // Signal flag to tell the display to redraw
 extern String temperatureUnit;  // <-- ADDED
+extern uint16_t weatherConditionId; // OWM weather[0].id of the last successful fetch
+extern bool weatherIsDay;           // Day/night flag from the OWM icon code
+extern WeatherResult lastWeatherResult;          // Classified outcome of the last fetch
+extern WeatherFetchStats lastWeatherFetchStats;  // Request bytes / timing of the last fetch
+
+// --- MULTI-LOCATION STATE ---
+// Index 0 is the primary location (also mirrored into the globals above)
+extern WeatherRecord weatherRecords[WEATHER_MAX_LOCATIONS];
+extern bool weatherRecordValid[WEATHER_MAX_LOCATIONS];
+extern uint8_t weatherLocationCount;  // Locations fetched in the last cycle
+extern uint8_t weatherDisplayIndex;   // Location currently shown
 
 // --- FUNCTION PROTOTYPES ---
 void fetchWeatherData(); 
+void resetWeatherSchedule();  // Fetch on the next call (boot, wake, settings change)
+bool weatherQuotaTake();      // Counts one provider request against the daily quota
+bool weatherQuotaAvailable(); // True if today's quota has room for another request
+ScheduleOutcome weatherScheduleOutcome(WeatherResult result); // Retry class of a fetch result
+WeatherLocation primaryWeatherLocation(); // Location from the main config fields
+void advanceWeatherLocation(int step);    // Rotate the displayed location (+1 / -1)
 void updateWeatherDisplay(); // This prototype was already here
 
 #endif // WEATHERHANDLER_H
\ No newline at end of file
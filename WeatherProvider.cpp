@@ -0,0 +1,209 @@
+#include "WeatherProvider.h"  // Header for this module
+#include "UserConfig.h"       // For userConfig.weather_provider
+
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <WiFiClientSecure.h>
+
+extern userConfig_t userConfig;
+extern bool weatherQuotaTake(); // Counts one request against the daily quota (WeatherHandler.cpp)
+
+/**
+ * @brief Stream wrapper that counts the bytes the parser consumes.
+ */
+class CountingStream : public Stream {
+public:
+    explicit CountingStream(Stream& inner) : _inner(inner), _count(0) {}
+    int available() override { return _inner.available(); }
+    int read() override {
+        int c = _inner.read();
+        if (c >= 0) _count++;
+        return c;
+    }
+    int peek() override { return _inner.peek(); }
+    size_t write(uint8_t) override { return 0; }
+    uint32_t count() const { return _count; }
+private:
+    Stream& _inner;
+    uint32_t _count;
+};
+
+/**
+ * @brief Stream over a response body already read into memory.
+ */
+class BodyStream : public Stream {
+public:
+    explicit BodyStream(const String& body) : _body(body), _position(0) {}
+    int available() override { return _body.length() - _position; }
+    int read() override { return _position < _body.length() ? (uint8_t)_body[_position++] : -1; }
+    int peek() override { return _position < _body.length() ? (uint8_t)_body[_position] : -1; }
+    size_t write(uint8_t) override { return 0; }
+private:
+    const String& _body;
+    unsigned int _position;
+};
+
+
+/**
+ * @brief Default HTTP status classification shared by all providers.
+ */
+WeatherResult WeatherProvider::classifyError(int httpCode) const {
+    if (httpCode < 0) return WEATHER_RESULT_NETWORK;
+    if (httpCode == 401) return WEATHER_RESULT_AUTH;
+    if (httpCode == 404) return WEATHER_RESULT_NOT_FOUND;
+    if (httpCode == 429) return WEATHER_RESULT_RATE_LIMITED;
+    return WEATHER_RESULT_HTTP;
+}
+
+/**
+ * @brief Sends one GET on an already configured HTTPClient and stream-parses the body.
+ * Adds its bytes and time to stats, so it can be used for single requests and batches.
+ * Every request sent is charged to the daily quota.
+ * @return WEATHER_RESULT_QUOTA (nothing sent) once the quota is used up.
+ */
+WeatherResult WeatherProvider::requestOne(HTTPClient& http, WiFiClient& client, const String& url,
+                                          WeatherRecord& record, WeatherFetchStats& stats, bool keepAlive) const {
+    if (!weatherQuotaTake()) {
+        Serial.println("Weather request skipped: daily quota reached.");
+        return WEATHER_RESULT_QUOTA;
+    }
+
+    unsigned long start = millis();
+    stats.request_bytes += url.length();
+    if (!client.connected()) stats.connections++; // Otherwise HTTPClient reuses the kept-alive connection
+    http.begin(client, url);
+
+    int httpResponseCode = http.GET();
+    stats.http_code = httpResponseCode;
+
+    WeatherResult result;
+    if (httpResponseCode == 200 && keepAlive) {
+        // An HTTP/1.1 body may be chunked: getString() reads it to the end with the
+        // framing removed, which also leaves the connection clean for the next GET
+        String body = http.getString();
+        BodyStream bodyStream(body);
+        unsigned long parseStart = micros();
+        result = parse(bodyStream, record);
+        stats.parse_us += micros() - parseStart;
+        stats.response_bytes += body.length();
+    } else if (httpResponseCode == 200) {
+        CountingStream counted(http.getStream());
+        unsigned long parseStart = micros();
+        result = parse(counted, record);
+        stats.parse_us += micros() - parseStart;
+        stats.response_bytes += counted.count();
+    } else {
+        Serial.printf("HTTP GET Failed, Code: %d. Error: %s\n", httpResponseCode, http.errorToString(httpResponseCode).c_str());
+        result = classifyError(httpResponseCode);
+        if (keepAlive && httpResponseCode > 0) http.getString(); // Drain the error body before the next request
+    }
+
+    http.end();
+    stats.total_ms += millis() - start;
+    return result;
+}
+
+/**
+ * @brief Runs one request: build URL, GET, stream-parse the body.
+ * @param record Filled on WEATHER_RESULT_OK.
+ * @param stats Filled on every call.
+ */
+WeatherResult WeatherProvider::fetch(const WeatherLocation& location, WeatherRecord& record, WeatherFetchStats& stats) const {
+    memset(&stats, 0, sizeof(stats));
+
+    if (WiFi.status() != WL_CONNECTED) {
+        return WEATHER_RESULT_OFFLINE;
+    }
+
+    String url;
+    if (!buildRequest(location, url)) {
+        return WEATHER_RESULT_NO_LOCATION;
+    }
+
+    WiFiClientSecure secureClient;
+    WiFiClient plainClient;
+    HTTPClient http;
+    http.useHTTP10(true); // No chunked encoding, so the body can be parsed straight off the socket
+
+    if (url.startsWith("https")) {
+        secureClient.setInsecure(); // Allow HTTPS connections without a root CA certificate
+        return requestOne(http, secureClient, url, record, stats, false);
+    }
+    return requestOne(http, plainClient, url, record, stats, false);
+}
+
+/**
+ * @brief Fetches each location in turn. Stops at the first request the quota refuses;
+ * the remaining locations report WEATHER_RESULT_QUOTA.
+ */
+void WeatherProvider::fetchBatch(const WeatherLocation* locations, uint8_t count, WeatherRecord* records,
+                                 WeatherResult* results, WeatherFetchStats& stats) const {
+    memset(&stats, 0, sizeof(stats));
+
+    if (WiFi.status() != WL_CONNECTED) {
+        for (uint8_t i = 0; i < count; i++) results[i] = WEATHER_RESULT_OFFLINE;
+        return;
+    }
+
+    WiFiClientSecure secureClient;
+    WiFiClient plainClient;
+    HTTPClient http;
+    // HTTP/1.1 keep-alive: every location after the first skips the TCP and TLS handshake.
+    // Bodies may then be chunked, so requestOne() reads each one whole before parsing.
+    http.useHTTP10(false);
+    http.setReuse(true);
+
+    for (uint8_t i = 0; i < count; i++) {
+        String url;
+        if (!buildRequest(locations[i], url)) {
+            results[i] = WEATHER_RESULT_NO_LOCATION;
+            continue;
+        }
+        if (url.startsWith("https")) {
+            secureClient.setInsecure();
+            results[i] = requestOne(http, secureClient, url, records[i], stats, true);
+        } else {
+            results[i] = requestOne(http, plainClient, url, records[i], stats, true);
+        }
+        if (results[i] == WEATHER_RESULT_QUOTA) {
+            for (uint8_t j = i + 1; j < count; j++) results[j] = WEATHER_RESULT_QUOTA;
+            break;
+        }
+    }
+}
+
+
+/**
+ * @brief Returns the provider selected in userConfig.
+ */
+const WeatherProvider& activeWeatherProvider() {
+    static const OpenWeatherProvider openWeather;
+    static const OpenMeteoProvider openMeteo;
+    static const MockWeatherProvider mock;
+
+    switch (userConfig.weather_provider) {
+        case WEATHER_PROVIDER_OPENMETEO: return openMeteo;
+        case WEATHER_PROVIDER_MOCK:      return mock;
+        default:                         return openWeather;
+    }
+}
+
+/**
+ * @brief Short status text shown on screen for a fetch result.
+ */
+const char* weatherResultText(WeatherResult result) {
+    switch (result) {
+        case WEATHER_RESULT_OK:           return "OK";
+        case WEATHER_RESULT_NO_KEY:       return "No API Key";
+        case WEATHER_RESULT_NO_LOCATION:  return "No Location Config";
+        case WEATHER_RESULT_OFFLINE:      return "WiFi Offline";
+        case WEATHER_RESULT_NETWORK:      return "Network Error";
+        case WEATHER_RESULT_AUTH:         return "Invalid API Key";
+        case WEATHER_RESULT_NOT_FOUND:    return "Location Not Found";
+        case WEATHER_RESULT_RATE_LIMITED: return "Rate Limited";
+        case WEATHER_RESULT_HTTP:         return "HTTP Error";
+        case WEATHER_RESULT_PARSE:        return "JSON Error";
+        case WEATHER_RESULT_QUOTA:        return "Daily Quota Reached";
+    }
+    return "Unknown Error";
+}
@@ -0,0 +1,138 @@
+#ifndef WEATHERPROVIDER_H
+#define WEATHERPROVIDER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include "UserConfig.h" // For WEATHER_EXTRA_LOCATIONS
+#include "ForecastBuffer.h" // ForecastRing, filled by the OWM forecast parser
+
+// Primary location plus the extra locations from userConfig
+#define WEATHER_MAX_LOCATIONS (1 + WEATHER_EXTRA_LOCATIONS)
+
+// --- PROVIDER SELECTORS (userConfig.weather_provider) ---
+#define WEATHER_PROVIDER_OPENWEATHER 0
+#define WEATHER_PROVIDER_OPENMETEO   1
+#define WEATHER_PROVIDER_MOCK        2
+
+/**
+ * @brief Provider-independent current conditions.
+ * condition_id always uses the OWM code space so WeatherUtilities can resolve icons.
+ */
+typedef struct {
+    float temperature;      // In the configured unit (C or F)
+    uint16_t condition_id;  // OWM weather[0].id (or the nearest equivalent)
+    bool is_day;
+    float latitude;         // Coordinates reported by the provider (0 if unknown)
+    float longitude;
+    char description[48];
+    char name[24];          // Location name for the rotating display
+} WeatherRecord;
+
+/**
+ * @brief One location to fetch. Points into userConfig; either city_id or city/country is set.
+ */
+typedef struct {
+    const char* city;
+    const char* country_code;
+    const char* city_id;
+} WeatherLocation;
+
+typedef enum {
+    WEATHER_RESULT_OK,
+    WEATHER_RESULT_NO_KEY,        // Provider needs an API key and none is configured
+    WEATHER_RESULT_NO_LOCATION,   // Location fields required by the provider are empty
+    WEATHER_RESULT_OFFLINE,       // Wi-Fi not connected
+    WEATHER_RESULT_NETWORK,       // DNS / connect / timeout (HTTPClient negative codes)
+    WEATHER_RESULT_AUTH,          // 401
+    WEATHER_RESULT_NOT_FOUND,     // 404
+    WEATHER_RESULT_RATE_LIMITED,  // 429
+    WEATHER_RESULT_HTTP,          // Any other non-200 status
+    WEATHER_RESULT_PARSE,         // Body did not match the expected shape
+    WEATHER_RESULT_QUOTA          // Daily call quota used up (no request sent)
+} WeatherResult;
+
+/**
+ * @brief Per-request cost figures reported by every provider.
+ */
+typedef struct {
+    int http_code;
+    uint32_t request_bytes;   // Length of the request URL
+    uint32_t response_bytes;  // Body bytes consumed by the parser
+    uint32_t total_ms;        // Connect + request + parse
+    uint32_t parse_us;
+    uint8_t connections;      // Connections opened (a batch keeps one alive across requests)
+} WeatherFetchStats;
+
+/**
+ * @brief A weather source: builds the request, parses the body into a
+ * WeatherRecord and classifies errors.
+ */
+class WeatherProvider {
+public:
+    virtual ~WeatherProvider() {}
+    virtual const char* name() const = 0;
+
+    // Checks the configuration before any network traffic
+    virtual WeatherResult checkConfig(const WeatherLocation& location) const = 0;
+    virtual bool buildRequest(const WeatherLocation& location, String& url) const = 0;
+    virtual WeatherResult parse(Stream& stream, WeatherRecord& record) const = 0;
+    virtual WeatherResult classifyError(int httpCode) const;
+    // False if the provider ignores WeatherLocation (Open-Meteo uses the configured coordinates)
+    virtual bool supportsLocations() const { return true; }
+
+    // Runs one request over HTTP(S), charged to the daily quota. The mock provider overrides this.
+    virtual WeatherResult fetch(const WeatherLocation& location, WeatherRecord& record, WeatherFetchStats& stats) const;
+
+    // Fetches several locations. Default: one request per location, each charged to the
+    // daily quota; stops when the quota runs out. stats accumulates bytes and time over the whole cycle.
+    virtual void fetchBatch(const WeatherLocation* locations, uint8_t count, WeatherRecord* records,
+                            WeatherResult* results, WeatherFetchStats& stats) const;
+
+protected:
+    // keepAlive: HTTP/1.1 on a reused connection, body read whole (it may be chunked);
+    // otherwise HTTP/1.0 with the body parsed straight off the socket
+    WeatherResult requestOne(HTTPClient& http, WiFiClient& client, const String& url,
+                             WeatherRecord& record, WeatherFetchStats& stats, bool keepAlive) const;
+};
+
+class OpenWeatherProvider : public WeatherProvider {
+public:
+    const char* name() const override { return "OpenWeatherMap"; }
+    WeatherResult checkConfig(const WeatherLocation& location) const override;
+    bool buildRequest(const WeatherLocation& location, String& url) const override;
+    WeatherResult parse(Stream& stream, WeatherRecord& record) const override;
+    // /data/2.5/forecast body, one "list" element at a time (the forecast strip is OWM-only)
+    WeatherResult parseForecast(Stream& stream, ForecastRing& ring) const;
+    // Uses the group-by-IDs endpoint when every location has a City ID
+    void fetchBatch(const WeatherLocation* locations, uint8_t count, WeatherRecord* records,
+                    WeatherResult* results, WeatherFetchStats& stats) const override;
+};
+
+class OpenMeteoProvider : public WeatherProvider {
+public:
+    const char* name() const override { return "Open-Meteo"; }
+    WeatherResult checkConfig(const WeatherLocation& location) const override;
+    bool buildRequest(const WeatherLocation& location, String& url) const override;
+    WeatherResult parse(Stream& stream, WeatherRecord& record) const override;
+    bool supportsLocations() const override { return false; }
+};
+
+// Serves OWM-shaped payloads from MOCK_WEATHER_URL (e.g. a Linux box on the LAN)
+// or from a canned payload in flash, with injectable latency, errors and size.
+class MockWeatherProvider : public OpenWeatherProvider {
+public:
+    const char* name() const override { return "Mock"; }
+    WeatherResult checkConfig(const WeatherLocation& location) const override;
+    bool buildRequest(const WeatherLocation& location, String& url) const override;
+    WeatherResult fetch(const WeatherLocation& location, WeatherRecord& record, WeatherFetchStats& stats) const override;
+    void fetchBatch(const WeatherLocation* locations, uint8_t count, WeatherRecord* records,
+                    WeatherResult* results, WeatherFetchStats& stats) const override;
+};
+
+// --- FUNCTION PROTOTYPES ---
+const WeatherProvider& activeWeatherProvider();
+const char* weatherResultText(WeatherResult result);
+void appendOpenWeatherQuery(String& url, const WeatherLocation& location); // Location/units/appid query, shared with the forecast fetch
+
+#endif // WEATHERPROVIDER_H
@@ -0,0 +1,107 @@
+#include "WeatherScheduler.h" // Header for this module
+#include "config.h"           // For WEATHER_* timing constants
+
+/**
+ * @brief Clears the schedule so the next check fetches immediately.
+ * The quota counter is kept: it only resets when the UTC day changes.
+ */
+void scheduleReset(WeatherSchedule& schedule) {
+    schedule.last_attempt_ms = 0;
+    schedule.next_delay_ms = 0;
+    schedule.failures = 0;
+    schedule.started = false;
+}
+
+/**
+ * @brief True when the delay chosen after the last attempt has elapsed.
+ */
+bool scheduleIsDue(const WeatherSchedule& schedule, unsigned long nowMs) {
+    if (!schedule.started) return true;
+    return nowMs - schedule.last_attempt_ms >= schedule.next_delay_ms;
+}
+
+/**
+ * @brief Counts one API call against the daily quota.
+ * @param utcDay Days since the epoch (0 if the clock is not set yet).
+ * @param dailyQuota Maximum calls per UTC day, 0 = unlimited.
+ * @return False (and nothing counted) if the quota is used up.
+ */
+bool scheduleTakeQuota(WeatherSchedule& schedule, uint32_t utcDay, uint16_t dailyQuota) {
+    if (utcDay != schedule.quota_day) {
+        schedule.quota_day = utcDay;
+        schedule.calls_today = 0;
+    }
+    if (dailyQuota > 0 && schedule.calls_today >= dailyQuota) {
+        return false;
+    }
+    schedule.calls_today++;
+    return true;
+}
+
+/**
+ * @brief True if scheduleTakeQuota() would allow another call. Counts nothing.
+ */
+bool scheduleQuotaAvailable(const WeatherSchedule& schedule, uint32_t utcDay, uint16_t dailyQuota) {
+    if (dailyQuota == 0 || utcDay != schedule.quota_day) return true;
+    return schedule.calls_today < dailyQuota;
+}
+
+/**
+ * @brief Chooses the delay until the next attempt.
+ * @param failures Consecutive transient failures including this one.
+ * @param outcome Classified result of the attempt.
+ * @param context Precipitation / backlight / idle state.
+ * @param randomValue Any 32-bit random value (esp_random() on device).
+ */
+unsigned long scheduleComputeDelay(uint8_t failures, ScheduleOutcome outcome,
+                                   const WeatherScheduleContext& context, uint32_t randomValue) {
+    unsigned long delayMs;
+
+    if (outcome == SCHEDULE_TRANSIENT_FAILURE) {
+        // Exponential backoff: base, 2x base, 4x base ... capped at the normal interval
+        delayMs = WEATHER_BACKOFF_BASE_MS;
+        for (uint8_t i = 1; i < failures && delayMs < WEATHER_UPDATE_INTERVAL_MS; i++) {
+            delayMs *= 2;
+        }
+        if (delayMs > WEATHER_UPDATE_INTERVAL_MS) delayMs = WEATHER_UPDATE_INTERVAL_MS;
+    } else if (outcome == SCHEDULE_RATE_LIMITED) {
+        delayMs = WEATHER_UPDATE_INTERVAL_MS;
+    } else if (outcome == SCHEDULE_SUCCESS && context.precipitation) {
+        delayMs = WEATHER_FAST_INTERVAL_MS;
+    } else {
+        delayMs = WEATHER_UPDATE_INTERVAL_MS;
+    }
+
+    // Nobody is looking: stretch non-retry delays
+    if (outcome != SCHEDULE_TRANSIENT_FAILURE && (!context.backlight_on || context.idle)) {
+        delayMs *= WEATHER_SLOW_FACTOR;
+    }
+
+    // Quiet hours: the active power profile stretches non-retry delays further
+    if (outcome != SCHEDULE_TRANSIENT_FAILURE && context.power_factor > 1) {
+        delayMs *= context.power_factor;
+    }
+
+    // Jitter of +/- WEATHER_JITTER_PERCENT so a fleet does not refresh in lockstep
+    long span = (long)(delayMs / 100) * WEATHER_JITTER_PERCENT;
+    if (span > 0) {
+        long offset = (long)(randomValue % (uint32_t)(2 * span + 1)) - span;
+        delayMs = (unsigned long)((long)delayMs + offset);
+    }
+    return delayMs;
+}
+
+/**
+ * @brief Records an attempt and schedules the next one.
+ */
+void scheduleRecord(WeatherSchedule& schedule, unsigned long nowMs, ScheduleOutcome outcome,
+                    const WeatherScheduleContext& context, uint32_t randomValue) {
+    if (outcome == SCHEDULE_TRANSIENT_FAILURE) {
+        if (schedule.failures < 255) schedule.failures++;
+    } else {
+        schedule.failures = 0;
+    }
+    schedule.started = true;
+    schedule.last_attempt_ms = nowMs;
+    schedule.next_delay_ms = scheduleComputeDelay(schedule.failures, outcome, context, randomValue);
+}
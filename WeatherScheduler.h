@@ -0,0 +1,46 @@
+#ifndef WEATHERSCHEDULER_H
+#define WEATHERSCHEDULER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Device/weather conditions that shape the next refresh delay.
+ */
+typedef struct {
+    bool precipitation;     // Last good data shows falling precipitation
+    bool backlight_on;
+    bool idle;              // No touch for WEATHER_IDLE_THRESHOLD_MS
+    uint8_t power_factor;   // Quiet-hours interval multiplier (1 = none)
+} WeatherScheduleContext;
+
+/**
+ * @brief Refresh scheduler state. Pure data: every decision takes the clock
+ * and the random value as arguments, so it can be driven by a simulated clock.
+ */
+typedef struct {
+    unsigned long last_attempt_ms;  // millis() of the last attempt
+    unsigned long next_delay_ms;    // Delay after last_attempt_ms before the next attempt
+    uint8_t failures;               // Consecutive transient failures
+    bool started;                   // False until the first attempt
+    uint32_t quota_day;             // UTC day number the call counter belongs to
+    uint16_t calls_today;           // API calls made on quota_day
+} WeatherSchedule;
+
+typedef enum {
+    SCHEDULE_SUCCESS,
+    SCHEDULE_TRANSIENT_FAILURE,  // DNS/HTTP/parse/offline: retry with backoff
+    SCHEDULE_RATE_LIMITED,       // 429: back off to the maximum
+    SCHEDULE_CONFIG_FAILURE      // Missing key/location, 401, 404: retrying sooner will not help
+} ScheduleOutcome;
+
+// --- FUNCTION PROTOTYPES ---
+void scheduleReset(WeatherSchedule& schedule);
+bool scheduleIsDue(const WeatherSchedule& schedule, unsigned long nowMs);
+bool scheduleTakeQuota(WeatherSchedule& schedule, uint32_t utcDay, uint16_t dailyQuota);
+bool scheduleQuotaAvailable(const WeatherSchedule& schedule, uint32_t utcDay, uint16_t dailyQuota);
+unsigned long scheduleComputeDelay(uint8_t failures, ScheduleOutcome outcome,
+                                   const WeatherScheduleContext& context, uint32_t randomValue);
+void scheduleRecord(WeatherSchedule& schedule, unsigned long nowMs, ScheduleOutcome outcome,
+                    const WeatherScheduleContext& context, uint32_t randomValue);
+
+#endif // WEATHERSCHEDULER_H
@@ -1,6 +1,5 @@
 #include "WeatherUtilities.h"
-#include <time.h> // Needed for getLocalTime() for day/night icon check
-#include "ThemeConfig.h" // Gives access to the new color constants
+#include "ThemeHandler.h" // Icon colors come from the current theme's palette
 
 // Helper function to convert a string to Title Case
 String toTitleCase(String str) {
@@ -19,78 +18,63 @@ String toTitleCase(String str) {
 }
 
 
-// Function to map OpenWeatherMap status to Meteocons character
-char getWeatherIcon(String status) {
-    status.toLowerCase();
+// --- CONDITION CLASS TABLE (indexed by WeatherClass) ---
+static constexpr WeatherClassInfo WEATHER_CLASS_TABLE[WX_CLASS_COUNT] = {
+    // day  night  color_day           color_night         label
+    { 'P', 'P', THEME_ICON_THUNDER, THEME_ICON_THUNDER, "Thunderstorm"  }, // WX_CLASS_THUNDER
+    { 'Q', 'Q', THEME_ICON_RAIN,    THEME_ICON_RAIN,    "Drizzle"       }, // WX_CLASS_DRIZZLE
+    { 'R', 'R', THEME_ICON_RAIN,    THEME_ICON_RAIN,    "Rain"          }, // WX_CLASS_RAIN
+    { 'X', 'X', THEME_ICON_SNOW,    THEME_ICON_SNOW,    "Sleet"         }, // WX_CLASS_SLEET
+    { 'W', 'W', THEME_ICON_SNOW,    THEME_ICON_SNOW,    "Snow"          }, // WX_CLASS_SNOW
+    { 'M', 'M', THEME_ICON_FOG,     THEME_ICON_FOG,     "Fog"           }, // WX_CLASS_ATMOSPHERE
+    { 'B', 'C', THEME_ICON_SUN,     THEME_ICON_MOON,    "Clear"         }, // WX_CLASS_CLEAR
+    { 'H', 'I', THEME_ICON_CLOUDS,  THEME_ICON_CLOUDS,  "Partly Cloudy" }, // WX_CLASS_FEW_CLOUDS
+    { 'Y', 'Y', THEME_ICON_CLOUDS,  THEME_ICON_CLOUDS,  "Cloudy"        }, // WX_CLASS_BROKEN_CLOUDS
+    { 'N', 'N', THEME_ICON_CLOUDS,  THEME_ICON_CLOUDS,  "Overcast"      }, // WX_CLASS_OVERCAST
+    { ')', ')', THEME_ICON_UNKNOWN, THEME_ICON_UNKNOWN, "Unknown"       }, // WX_CLASS_UNKNOWN
+};
 
-    // Need to get current time for day/night icon check
-    struct tm timeinfo;
-    getLocalTime(&timeinfo); 
+static_assert(weatherClassForId(202) == WX_CLASS_THUNDER, "2xx must map to thunder");
+static_assert(weatherClassForId(511) == WX_CLASS_SLEET, "511 freezing rain must map to sleet");
+static_assert(weatherClassForId(531) == WX_CLASS_RAIN, "531 shower rain must map to rain");
+static_assert(weatherClassForId(616) == WX_CLASS_SLEET, "616 rain and snow must map to sleet");
+static_assert(weatherClassForId(622) == WX_CLASS_SNOW, "622 shower snow must map to snow");
+static_assert(weatherClassForId(781) == WX_CLASS_ATMOSPHERE, "7xx must map to atmosphere");
+static_assert(weatherClassForId(802) == WX_CLASS_FEW_CLOUDS, "802 must map to few clouds");
+static_assert(weatherClassForId(0) == WX_CLASS_UNKNOWN, "0 (no data) must map to unknown");
 
-    if (status.indexOf("thunderstorm") != -1) return 'r'; // Thunder
-    if (status.indexOf("drizzle") != -1) return 'Q';      // Drizzle
-    if (status.indexOf("rain") != -1) return 'R';         // Rain
-    if (status.indexOf("snow") != -1) return 'W';         // Snow
-    // --- UPDATED: Added || status.indexOf("haze") != -1 ---
-    if (status.indexOf("mist") != -1 || status.indexOf("fog") != -1 || status.indexOf("haze") != -1) return 'M'; // Mist/Fog/Haze
-    
-    // Check for clear/sun
-    if (status.indexOf("clear sky") != -1) {
-        // Simple check for day/night (assumes 6am-8pm is day)
-        if (timeinfo.tm_hour >= 6 && timeinfo.tm_hour < 20) {
-            return 'B'; // Sun (Day)
-        } else {
-            return 'C'; // Moon (Night)
-        }
-    }
-    
-    // Check for clouds
-    if (status.indexOf("broken clouds") != -1) return 'Y'; // Broken Clouds
-    if (status.indexOf("scattered clouds") != -1) return 'H'; // Scattered Clouds
-    if (status.indexOf("few clouds") != -1) return 'H'; // Few Clouds
-    if (status.indexOf("overcast clouds") != -1) return 'N'; // Overcast Clouds
-    if (status.indexOf("cloudy") != -1) return 'N'; // General Cloudy
 
-    // Default icon (question mark)
-    return ')'; 
+/**
+ * @brief Returns the table row for an OWM condition code.
+ */
+const WeatherClassInfo& getWeatherClassInfo(uint16_t conditionId) {
+    return WEATHER_CLASS_TABLE[weatherClassForId(conditionId)];
 }
 
-
 /**
- * @brief Maps OpenWeatherMap status to a specific icon color.
- * @param status The weather description string.
- * @return The 16-bit color (uint16_t) for the icon.
+ * @brief Maps an OWM condition code to a Meteocons character.
+ * @param conditionId OWM weather[0].id.
+ * @param isDay Day/night flag from the OWM icon code ("01d"/"01n").
  */
-uint16_t getWeatherColor(String status) {
-    status.toLowerCase();
+char getWeatherIcon(uint16_t conditionId, bool isDay) {
+    const WeatherClassInfo& info = getWeatherClassInfo(conditionId);
+    return isDay ? info.glyph_day : info.glyph_night;
+}
 
-    // Need to get current time for day/night icon check
-    struct tm timeinfo;
-    if (!getLocalTime(&timeinfo)) {
-        // Use a default (daytime) if time isn't available
-        timeinfo.tm_hour = 12; 
-    }
+/**
+ * @brief Maps an OWM condition code to a specific icon color.
+ * @param conditionId OWM weather[0].id.
+ * @param isDay Day/night flag from the OWM icon code.
+ * @return The 16-bit color (uint16_t) for the icon, from the current theme's palette.
+ */
+uint16_t getWeatherColor(uint16_t conditionId, bool isDay) {
+    const WeatherClassInfo& info = getWeatherClassInfo(conditionId);
+    return currentTheme->icon_colors[isDay ? info.color_day : info.color_night];
+}
 
-    if (status.indexOf("thunderstorm") != -1) return COLOR_ICON_THUNDER;
-    if (status.indexOf("drizzle") != -1) return COLOR_ICON_RAIN;
-    if (status.indexOf("rain") != -1) return COLOR_ICON_RAIN;
-    if (status.indexOf("snow") != -1) return COLOR_ICON_SNOW;
-    // --- UPDATED: Added || status.indexOf("haze") != -1 ---
-    if (status.indexOf("mist") != -1 || status.indexOf("fog") != -1 || status.indexOf("haze") != -1) return COLOR_ICON_FOG;
-    
-    // Check for clear/sun
-    if (status.indexOf("clear sky") != -1) {
-        // Simple check for day/night (assumes 6am-8pm is day)
-        if (timeinfo.tm_hour >= 6 && timeinfo.tm_hour < 20) {
-            return COLOR_ICON_SUN; // Sun (Day)
-        } else {
-            return COLOR_ICON_MOON; // Moon (Night)
-        }
-    }
-    
-    // Check for clouds (all types)
-    if (status.indexOf("clouds") != -1) return COLOR_ICON_CLOUDS;
-    
-    // Return a default error color if nothing matches
-    return COLOR_ICON_DEFAULT; 
-}
\ No newline at end of file
+/**
+ * @brief Short human-readable label for an OWM condition code.
+ */
+const char* getWeatherLabel(uint16_t conditionId) {
+    return getWeatherClassInfo(conditionId).label;
+}
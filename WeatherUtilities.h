@@ -4,8 +4,59 @@
 #include <Arduino.h>
 #include <stdint.h> // Include for uint16_t
 
-char getWeatherIcon(String status);
+// --- OWM CONDITION CLASSES ---
+// Every documented OpenWeatherMap condition code (weather[0].id) maps to one class.
+// The class selects the glyph, the icon colour and a short label.
+typedef enum : uint8_t {
+    WX_CLASS_THUNDER,
+    WX_CLASS_DRIZZLE,
+    WX_CLASS_RAIN,
+    WX_CLASS_SLEET,       // Freezing rain, sleet, rain and snow
+    WX_CLASS_SNOW,
+    WX_CLASS_ATMOSPHERE,  // Mist, smoke, haze, dust, fog, sand, ash, squalls, tornado
+    WX_CLASS_CLEAR,
+    WX_CLASS_FEW_CLOUDS,  // Few and scattered clouds
+    WX_CLASS_BROKEN_CLOUDS,
+    WX_CLASS_OVERCAST,
+    WX_CLASS_UNKNOWN,
+    WX_CLASS_COUNT
+} WeatherClass;
+
+typedef struct {
+    char glyph_day;       // Meteocons character for daytime
+    char glyph_night;     // Meteocons character for nighttime
+    uint8_t color_day;    // Multi-color icon palette entry for daytime (ThemeIconColor)
+    uint8_t color_night;  // Multi-color icon palette entry for nighttime
+    const char* label;    // Short label (used when the description does not fit)
+} WeatherClassInfo;
+
+/**
+ * @brief Maps an OWM condition code to its class with range checks only (O(1), no allocation).
+ */
+constexpr WeatherClass weatherClassForId(uint16_t id) {
+    return (id >= 200 && id < 300) ? WX_CLASS_THUNDER :
+           (id >= 300 && id < 400) ? WX_CLASS_DRIZZLE :
+           (id == 511)             ? WX_CLASS_SLEET :
+           (id >= 500 && id < 600) ? WX_CLASS_RAIN :
+           (id >= 611 && id <= 616) ? WX_CLASS_SLEET :
+           (id >= 600 && id < 700) ? WX_CLASS_SNOW :
+           (id >= 700 && id < 800) ? WX_CLASS_ATMOSPHERE :
+           (id == 800)             ? WX_CLASS_CLEAR :
+           (id == 801 || id == 802) ? WX_CLASS_FEW_CLOUDS :
+           (id == 803)             ? WX_CLASS_BROKEN_CLOUDS :
+           (id == 804)             ? WX_CLASS_OVERCAST :
+                                     WX_CLASS_UNKNOWN;
+}
+
+// Condition IDs that indicate falling precipitation (thunder, drizzle, rain, sleet, snow)
+constexpr bool weatherIdIsPrecipitation(uint16_t id) {
+    return weatherClassForId(id) <= WX_CLASS_SNOW;
+}
+
+const WeatherClassInfo& getWeatherClassInfo(uint16_t conditionId);
+char getWeatherIcon(uint16_t conditionId, bool isDay);
+uint16_t getWeatherColor(uint16_t conditionId, bool isDay);
+const char* getWeatherLabel(uint16_t conditionId);
 String toTitleCase(String str);
-uint16_t getWeatherColor(String status); // <-- ADDED THIS LINE
 
-#endif // WEATHER_UTILITIES_H
\ No newline at end of file
+#endif // WEATHER_UTILITIES_H
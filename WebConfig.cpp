@@ -0,0 +1,602 @@
+#include "WebConfig.h"         // Header for this module
+#include "UserConfig.h" 
+#include "config.h"             // For PREF_NAMESPACE and external settings
+#include "WebPortalHtml.h"      // HTML_HEAD for the alarms page
+#include "WebUiAssets.h"        // Gzipped pages (generated by tools/embed_web.py)
+#include "TimezoneHandler.h"    // Zone table for the time zone select
+#include "TimeSync.h"           // Sync age / offset / drift for /status
+#include "AlarmHandler.h"       // Alarm table for /alarms
+#include "PowerProfile.h"       // Quiet-hours profiles and state hours for /status
+#include "ConfigHandler.h"      // configSetField() and CONFIG_CHANGE_* for PATCH /api/config
+#include "WeatherHandler.h"     // Weather state for /api/status
+#include "StatusStream.h"       // /events live status stream
+#include "ScreenCapture.h"      // /screenshot
+#include "OtaUpdate.h"          // /update
+#include "Metrics.h"            // /metrics
+#include "ConfigStore.h"        // configStoreFlush() before a restart, configSetDefaults() for PATCH checks
+#include "AssetPack.h"          // /assets upload and pack state for /status
+#include "ThemeHandler.h"       // /api/themes and theme timings for /status
+#include "PortalHandler.h"      // /setup and captive redirects while provisioning
+#include "WifiConnect.h"        // Connect path and time for /status
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <ArduinoJson.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>  // Kept out of the .ino: modules attach their routes here
+#include <AsyncJson.h>          // AsyncCallbackJsonWebHandler
+
+// --- EXTERNAL DEPENDENCIES ---
+extern userConfig_t userConfig; 
+extern void saveConfig();       
+extern void applyConfigChanges(uint32_t changes);
+extern void enterDeepSleep();   
+extern void toggleBacklight();   
+extern bool backlight_state;     
+// ----------------------------
+
+// --- SERVER INSTANTIATION ---
+static AsyncWebServer server(80); 
+// ----------------------------
+
+// --- DEFERRED ACTIONS ---
+// Handlers run on the AsyncTCP task; display and loop()-owned state are
+// only touched from serviceWebActions() on the main task.
+static volatile bool backlightTogglePending = false;
+static volatile bool sleepPending = false;
+static volatile bool restartPending = false;
+static volatile bool alarmsPending = false;
+static AlarmEntry pendingAlarms[ALARM_MAX_ENTRIES];       // Guarded by alarmsPending
+static volatile bool configPending = false;
+static String pendingPatch;                                // Validated PATCH fields (JSON), guarded by configPending
+static userConfig_t patchScratch;                          // AsyncTCP task only: what PATCH validates against
+
+
+/**
+ * @brief Sends a precompressed asset, or 304 when the browser already has this version.
+ */
+static void sendGzipAsset(AsyncWebServerRequest* request, const char* type, const uint8_t* data, size_t len, const char* etag) {
+    if (request->hasHeader("If-None-Match") && request->getHeader("If-None-Match")->value() == etag) {
+        request->send(304);
+        Serial.printf("Web: %s 304 (cached)\n", request->url().c_str());
+        return;
+    }
+    AsyncWebServerResponse* response = request->beginResponse(200, type, data, len);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", "no-cache"); // Revalidate: the ETag changes with the firmware
+    request->send(response);
+    Serial.printf("Web: %s 200, %u bytes gzip, free heap %u\n", request->url().c_str(), (unsigned)len, ESP.getFreeHeap());
+}
+
+/**
+ * @brief Sends the settings page: static and gzipped in flash, it fills itself
+ * in from /api/config and saves with PATCH /api/config.
+ */
+static void handleConfig(AsyncWebServerRequest* request) {
+    sendGzipAsset(request, "text/html", CONFIG_PAGE_GZ, CONFIG_PAGE_GZ_LEN, CONFIG_PAGE_ETAG);
+}
+
+/**
+ * @brief Current settings as JSON, keyed by the config form's field names.
+ */
+static void handleApiConfig(AsyncWebServerRequest* request) {
+    DynamicJsonDocument doc(2048);
+    doc["ssid"] = WiFi.SSID();
+    doc["apikey"] = userConfig.weather_api_key;
+    doc["city"] = userConfig.weather_city;
+    doc["country"] = userConfig.weather_country_code;
+    doc["city_id"] = userConfig.weather_city_id;
+    doc["provider"] = userConfig.weather_provider;
+    doc["lat"] = userConfig.latitude;
+    doc["lon"] = userConfig.longitude;
+    doc["quota"] = userConfig.weather_daily_quota;
+    for (int i = 0; i < WEATHER_EXTRA_LOCATIONS; i++) {
+        const weatherLocation_t& loc = userConfig.extra_locations[i];
+        String value = loc.city_id[0] ? String(loc.city_id)
+                     : loc.city[0]    ? String(loc.city) + (loc.country_code[0] ? "," + String(loc.country_code) : "")
+                                      : String("");
+        doc["loc" + String(i + 1)] = value;
+    }
+    doc["tempunit"] = userConfig.use_fahrenheit ? 1 : 0;
+    doc["iconcolor"] = userConfig.use_multi_color_icons ? 1 : 0;
+    doc["autotheme"] = userConfig.auto_theme ? 1 : 0;
+    doc["themedark"] = userConfig.theme_dark;
+    doc["themelight"] = userConfig.theme_light;
+    doc["wview"] = userConfig.weather_view;
+    for (int i = 0; i < POWER_PROFILE_COUNT; i++) {
+        const powerProfile_t& profile = userConfig.power_profiles[i];
+        String prefix = "p" + String(i);
+        char timeText[6];
+        snprintf(timeText, sizeof(timeText), "%02u:%02u", profile.start_hour, profile.start_minute);
+        doc[prefix + "s"] = timeText;
+        snprintf(timeText, sizeof(timeText), "%02u:%02u", profile.end_hour, profile.end_minute);
+        doc[prefix + "e"] = timeText;
+        doc[prefix + "days"] = profile.weekdays;
+        doc[prefix + "m"] = profile.mode;
+        doc[prefix + "dim"] = profile.dim_percent;
+        doc[prefix + "wf"] = profile.weather_factor;
+    }
+    doc["timefmt"] = userConfig.time_format_24h ? 1 : 0;
+    doc["tz"] = userConfig.tz_name;
+    doc["gmt"] = userConfig.gmt_offset_hr;
+    doc["sleeptmo"] = userConfig.sleep_timeout_min;
+    for (int i = 0; i < WIFI_EXTRA_NETWORKS; i++) {
+        doc["wssid" + String(i + 1)] = userConfig.extra_networks[i].ssid; // Passwords are never sent back
+    }
+    doc["sip"] = userConfig.static_ip;
+    doc["sgw"] = userConfig.static_gateway;
+    doc["smask"] = userConfig.static_subnet;
+    doc["sdns"] = userConfig.static_dns;
+    doc["otapw_set"] = userConfig.update_password[0] != '\0'; // The password itself is never sent back
+
+    // This year's DST dates for the selected zone (shown next to the time zone select)
+    const TimezoneTransitions& dst = timezoneTransitions();
+    if (dst.year != 0 && dst.dst_start != 0) {
+        char when[40];
+        struct tm startTm, endTm;
+        localtime_r(&dst.dst_start, &startTm);
+        localtime_r(&dst.dst_end, &endTm);
+        size_t used = strftime(when, sizeof(when), "%b %d %H:%M", &startTm);
+        strftime(when + used, sizeof(when) - used, " - %b %d %H:%M", &endTm);
+        doc["dst"] = when;
+    }
+
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+    size_t bytes = serializeJson(doc, *response);
+    request->send(response);
+    Serial.printf("Web: /api/config 200, %u bytes, free heap %u\n", (unsigned)bytes, ESP.getFreeHeap());
+}
+
+/**
+ * @brief A PATCH value as configSetField() takes it: strings pass through,
+ * numbers and booleans use their JSON text ("3", "-5.5", true -> "1").
+ */
+static String patchFieldText(JsonVariantConst value) {
+    if (value.is<const char*>()) return value.as<const char*>();
+    if (value.is<bool>()) return value.as<bool>() ? "1" : "0";
+    char text[24];
+    serializeJson(value, text, sizeof(text));
+    return text;
+}
+
+/**
+ * @brief Validates a JSON object of settings (same names as GET /api/config) and
+ * queues the fields for loop(), which sets only those on the live config.
+ * All-or-nothing: one bad field rejects the whole request. userConfig itself is
+ * never copied here, so nothing loop() changed meanwhile (a menu toggle, a network
+ * the portal saved) is written back over.
+ */
+static void handleApiConfigPatch(AsyncWebServerRequest* request, JsonVariant& json) {
+    if (!json.is<JsonObject>()) {
+        request->send(400, "application/json", "{\"error\":\"expected a JSON object\"}");
+        return;
+    }
+    if (configPending) {
+        // loop() has not picked up the previous change yet (e.g. busy fetching weather)
+        AsyncWebServerResponse* response = request->beginResponse(503, "application/json", "{\"error\":\"busy\"}");
+        response->addHeader("Retry-After", "1");
+        request->send(response);
+        return;
+    }
+    // Replacing the firmware update password takes the current one (the first one can be set freely)
+    const char* newUpdatePassword = json["otapw"] | "";
+    if (newUpdatePassword[0] != '\0' && userConfig.update_password[0] != '\0' &&
+        !request->authenticate(OTA_USERNAME, userConfig.update_password)) {
+        request->requestAuthentication();
+        return;
+    }
+
+    JsonObject fields = json.as<JsonObject>();
+    DynamicJsonDocument reply(JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(fields.size()));
+    JsonArray queued = reply.createNestedArray("queued");
+    // Values are checked on a scratch copy of the defaults: no field's rules depend on the others
+    configSetDefaults(patchScratch);
+    for (JsonPair field : fields) {
+        uint32_t ignored = 0;
+        if (!configSetField(patchScratch, field.key().c_str(), patchFieldText(field.value()), ignored)) {
+            reply.clear();
+            reply["error"] = "invalid value";
+            reply["field"] = field.key().c_str();
+            String body;
+            serializeJson(reply, body);
+            request->send(400, "application/json", body);
+            return;
+        }
+        queued.add(field.key().c_str());
+    }
+
+    if (queued.size() > 0) {
+        pendingPatch = "";
+        serializeJson(fields, pendingPatch);
+        configPending = true; // Applied and persisted by serviceWebActions()
+    }
+    String body;
+    serializeJson(reply, body);
+    request->send(200, "application/json", body);
+}
+
+/**
+ * @brief Live device state as JSON (clock, network, weather, sync, power).
+ */
+static void handleApiStatus(AsyncWebServerRequest* request) {
+    StaticJsonDocument<768> doc;
+    time_t now = time(nullptr);
+    struct tm local;
+    localtime_r(&now, &local);
+    char localText[24];
+    strftime(localText, sizeof(localText), "%Y-%m-%dT%H:%M:%S", &local);
+
+    doc["time"] = (uint32_t)now;
+    doc["local_time"] = localText;
+    doc["uptime_s"] = millis() / 1000;
+    doc["free_heap"] = ESP.getFreeHeap();
+    doc["min_free_heap"] = ESP.getMinFreeHeap();
+    doc["max_alloc_heap"] = ESP.getMaxAllocHeap();
+    doc["rssi"] = WiFi.RSSI();
+    doc["ip"] = WiFi.localIP().toString();
+    doc["backlight"] = backlight_state;
+
+    JsonObject weather = doc.createNestedObject("weather");
+    weather["result"] = weatherResultText(lastWeatherResult);
+    weather["temperature"] = temperature;
+    weather["condition_id"] = weatherConditionId;
+    weather["locations"] = weatherLocationCount;
+
+    JsonObject sync = doc.createNestedObject("time_sync");
+    uint32_t age = timeSyncAgeSeconds();
+    if (age != UINT32_MAX) sync["age_s"] = age;
+    sync["offset_ms"] = timeSyncState.last_offset_ms;
+    sync["drift_ppm"] = timeSyncState.drift_ppm;
+    sync["interval_s"] = timeSyncActiveInterval();
+
+    JsonObject power = doc.createNestedObject("power");
+    power["state"] = powerStateName(powerCurrentState());
+    const PowerWindow& window = powerCurrentWindow();
+    if (window.profile >= 0) {
+        power["profile"] = window.profile + 1;
+        power["mode"] = powerModeName(window.mode);
+        power["seconds_left"] = window.seconds_left;
+    }
+    doc["next_alarm_s"] = alarmSecondsUntilNext(now);
+
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+}
+
+/**
+ * @brief Theme names for the theme selects: built-in ones, then those in the asset pack.
+ */
+static void handleApiThemes(AsyncWebServerRequest* request) {
+    String body = "[";
+    uint8_t count = themeCount();
+    for (uint8_t i = 0; i < count; i++) {
+        if (i > 0) body += ",";
+        body += "\"" + String(themeNameAt(i)) + "\"";
+    }
+    body += "]";
+    request->send(200, "application/json", body);
+}
+
+/**
+ * @brief Zone names as a JSON array, streamed straight from the table in flash.
+ * The filler is stateless: 'index' (bytes already sent) locates the resume point.
+ */
+static void handleApiTimezones(AsyncWebServerRequest* request) {
+    AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+        [](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            size_t position = 0; // Offset of the current item within the whole body
+            size_t written = 0;
+            char item[56];
+            for (size_t zone = 0; zone <= timezoneCount() && written < maxLen; zone++) {
+                size_t length = (zone == timezoneCount())
+                    ? snprintf(item, sizeof(item), "]")
+                    : snprintf(item, sizeof(item), "%s\"%s\"", zone == 0 ? "[" : ",", timezoneAt(zone).name);
+                if (position + length > index + written) {
+                    size_t skip = index + written - position;
+                    size_t chunk = min(length - skip, maxLen - written);
+                    memcpy(buffer + written, item + skip, chunk);
+                    written += chunk;
+                }
+                position += length;
+            }
+            return written; // 0 ends the response
+        });
+    response->addHeader("Cache-Control", "max-age=86400"); // Fixed per firmware build
+    request->send(response);
+}
+
+/**
+ * @brief Handle root request, redirects to config.
+ */
+static void handleRoot(AsyncWebServerRequest* request) {
+    request->redirect(portalActive() ? "/setup" : "/config");
+}
+
+/**
+ * @brief Plain-text device status (time sync health).
+ */
+static void handleStatus(AsyncWebServerRequest* request) {
+    String status = "Time Sync\n";
+    uint32_t age = timeSyncAgeSeconds();
+    if (age == UINT32_MAX) {
+        status += "  Last sync: never\n";
+    } else {
+        status += "  Last sync: " + String(age) + " s ago\n";
+    }
+    status += "  Server: " + String(NTP_SERVERS[timeSyncState.server_index % NTP_SERVER_COUNT]) + "\n";
+    status += "  Last offset: " + String(timeSyncState.last_offset_ms) + " ms\n";
+    status += "  Estimated drift: " + String(timeSyncState.drift_ppm, 2) + " ppm (" + String(timeSyncState.drift_samples) + " samples)\n";
+    status += "  Sync interval: " + String(timeSyncActiveInterval()) + " s\n";
+    status += "  Syncs since power-on: " + String(timeSyncState.sync_count) + "\n";
+
+    status += "\nPower\n";
+    const PowerWindow& window = powerCurrentWindow();
+    if (window.profile >= 0) {
+        status += "  Quiet hours: profile " + String(window.profile + 1) + " (" + powerModeName(window.mode) + "), ";
+        status += String(window.seconds_left / 60) + " min left\n";
+    } else {
+        status += "  Quiet hours: none active\n";
+    }
+    status += "  State: " + String(powerStateName(powerCurrentState())) + "\n";
+    for (int s = 0; s < POWER_STATE_COUNT; s++) {
+        PowerState state = (PowerState)s;
+        status += "  " + String(powerStateName(state)) + ": " + String(powerStateSeconds(state) / 3600.0f, 1) + " h\n";
+    }
+
+    status += "\nTheme\n";
+    const ThemeStats& themes = themeStats();
+    status += "  Dark: " + String(userConfig.theme_dark) + ", light: " + String(userConfig.theme_light) + ", showing " + String(currentTheme->name) + "\n";
+    status += "  Last compile (both themes): " + String(themes.compile_us) + " us\n";
+    status += "  Last switch incl. redraw: " + String(themes.switch_us) + " us (" + String(themes.switches) + " switches)\n";
+
+    status += "\nAssets\n";
+    const AssetPackInfo& assets = assetPackInfo();
+    if (assets.mounted) {
+        status += "  Pack: " + String(assets.count) + " entries, " + String(assets.size) + " bytes mapped in " + String(assets.mount_us) + " us\n";
+        status += "  Fonts from pack: " + String(assets.fonts_loaded) + " (" + String(assets.font_bytes) + " bytes read from flash in place)\n";
+        if (assets.lookups > 0) {
+            status += "  Font lookups: " + String(assets.lookups) + ", avg " + String(assets.lookup_us_total / assets.lookups) + " us\n";
+        }
+    } else {
+        status += "  Pack: none, compiled-in fonts\n";
+    }
+
+    status += "\nWi-Fi\n";
+    const WifiConnectStats& wifi = wifiConnectStats();
+    status += "  Network: " + String(wifi.ssid) + " (" + String(wifi.rssi) + " dBm when chosen, now " + String(WiFi.RSSI()) + " dBm)\n";
+    status += "  Last connect: " + String(wifiPathName(wifi.path)) + ", " + String(wifi.attempts) + " attempt(s), " +
+              String(wifi.connect_ms) + " ms total";
+    if (wifi.scan_ms > 0) status += " (" + String(wifi.scan_ms) + " ms scanning)";
+    status += wifi.static_ip ? ", static IP" : wifi.cached_lease ? ", cached lease" : ", DHCP";
+    if (wifi.directed_fail_ms > 0) status += ", after a failed directed attempt of " + String(wifi.directed_fail_ms) + " ms";
+    status += "\n";
+    status += "  Roams: " + String(wifi.roams);
+    if (wifi.roams > 0) status += ", last took " + String(wifi.roam_ms) + " ms";
+    status += "\n";
+    request->send(200, "text/plain", status);
+}
+
+/**
+ * @brief Escapes user text for an HTML attribute or text node.
+ */
+static String htmlEscape(const char* text) {
+    String escaped;
+    escaped.reserve(strlen(text));
+    for (const char* c = text; *c != '\0'; c++) {
+        switch (*c) {
+            case '<':  escaped += "&lt;"; break;
+            case '>':  escaped += "&gt;"; break;
+            case '&':  escaped += "&amp;"; break;
+            case '"':  escaped += "&quot;"; break;
+            case '\'': escaped += "&#39;"; break;
+            default:   escaped += *c; break;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Lists the alarm table as an editable form and saves submissions.
+ * Field names per slot i: a<i>en, a<i>t (HH:MM), a<i>d0..a<i>d6 (Sun..Sat), a<i>act, a<i>sn, a<i>lb.
+ */
+static void handleAlarms(AsyncWebServerRequest* request) {
+    static const char* const DAY_NAMES[7] = { "Su", "Mo", "Tu", "We", "Th", "Fr", "Sa" };
+
+    // --- 1. HANDLE SUBMITTED DATA ---
+    if (request->hasArg("save")) {
+        // Edit a copy: the table belongs to loop(), which picks it up in serviceWebActions()
+        memcpy(pendingAlarms, alarmEntries, sizeof(alarmEntries));
+        for (int i = 0; i < ALARM_MAX_ENTRIES; i++) {
+            AlarmEntry& entry = pendingAlarms[i];
+            String prefix = "a" + String(i);
+
+            entry.flags = request->hasArg(prefix + "en") ? ALARM_FLAG_ENABLED : 0;
+            String timeText = request->arg(prefix + "t"); // "HH:MM"
+            if (timeText.length() >= 5) {
+                entry.hour = constrain(timeText.substring(0, 2).toInt(), 0, 23);
+                entry.minute = constrain(timeText.substring(3, 5).toInt(), 0, 59);
+            }
+            entry.weekdays = 0;
+            for (int d = 0; d < 7; d++) {
+                if (request->hasArg(prefix + "d" + String(d))) entry.weekdays |= (1 << d);
+            }
+            int action = request->arg(prefix + "act").toInt();
+            entry.action = (action >= 0 && action < ALARM_ACTION_COUNT) ? action : ALARM_ACTION_ALERT;
+            entry.snooze_min = constrain(request->arg(prefix + "sn").toInt(), 0, 60);
+            String label = request->arg(prefix + "lb");
+            label.trim();
+            memset(entry.label, 0, sizeof(entry.label));
+            strncpy(entry.label, label.c_str(), sizeof(entry.label) - 1);
+        }
+        alarmsPending = true;
+        request->redirect("/alarms");
+        return;
+    }
+
+    // --- 2. GENERATE HTML RESPONSE ---
+    String html = HTML_HEAD;
+    html += "<body><h2>Alarms &amp; Schedules</h2>";
+    html += "<p>No days ticked = one-shot (fires once, then disables itself). Snooze 0 = no snooze.</p>";
+    html += "<form method='get' action='alarms'><input type='hidden' name='save' value='1'>";
+    for (int i = 0; i < ALARM_MAX_ENTRIES; i++) {
+        const AlarmEntry& entry = alarmEntries[i];
+        String prefix = "a" + String(i);
+        char timeText[6];
+        snprintf(timeText, sizeof(timeText), "%02u:%02u", entry.hour, entry.minute);
+
+        html += "<fieldset><legend><label><input type='checkbox' name='" + prefix + "en'";
+        html += (entry.flags & ALARM_FLAG_ENABLED) ? " checked" : "";
+        html += "> Slot " + String(i + 1) + "</label></legend>";
+        html += "<input type='time' name='" + prefix + "t' value='" + String(timeText) + "'> ";
+        for (int d = 0; d < 7; d++) {
+            html += "<label><input type='checkbox' name='" + prefix + "d" + String(d) + "'";
+            html += (entry.weekdays & (1 << d)) ? " checked" : "";
+            html += ">" + String(DAY_NAMES[d]) + "</label> ";
+        }
+        html += "<select name='" + prefix + "act'>";
+        for (int a = 0; a < ALARM_ACTION_COUNT; a++) {
+            html += "<option value='" + String(a) + "'" + String(entry.action == a ? " selected" : "") + ">";
+            html += alarmActionName(a);
+            html += "</option>";
+        }
+        html += "</select>";
+        html += "Snooze (min): <input type='number' name='" + prefix + "sn' value='" + String(entry.snooze_min) + "'>";
+        html += "Label: <input type='text' maxlength='13' name='" + prefix + "lb' value='" + htmlEscape(entry.label) + "'>";
+        html += "</fieldset>";
+    }
+    html += "<input type='submit' value='Save Alarms'></form>";
+    html += "<form method='get' action='config'><button style='background-color:#1e90ff;'>Back to Settings</button></form>";
+    html += "</body></html>";
+    request->send(200, "text/html", html);
+}
+
+/**
+ * @brief Handle Reboot request.
+ */
+static void handleReboot(AsyncWebServerRequest* request) {
+    request->send(200, "text/plain", "Rebooting...");
+    request->onDisconnect(webRequestRestart);
+}
+
+/**
+ * @brief Handle Deep Sleep request (entered from loop(), which owns the display).
+ */
+static void handleDeepSleep(AsyncWebServerRequest* request) {
+    request->send(200, "text/plain", "Entering deep sleep...");
+    sleepPending = true;
+}
+
+/**
+ * @brief Handle Backlight Toggle request (toggled from loop(), which owns the display).
+ */
+static void handleBacklightToggle(AsyncWebServerRequest* request) {
+    backlightTogglePending = true;
+    // FIX: Explicitly cast the string literal to a String object to enable concatenation
+    String status = String("Backlight is now ") + (!backlight_state ? "ON" : "OFF");
+    request->send(200, "text/plain", status);
+}
+
+
+/**
+ * @brief Sets up server routing and starts the asynchronous HTTP server.
+ * Requests are served by the AsyncTCP task; nothing needs to poll it.
+ */
+void startConfigServer() {
+    server.on("/", HTTP_GET, handleRoot);
+    server.on("/config", HTTP_GET, handleConfig);
+    server.on("/api/config", HTTP_GET, handleApiConfig);
+    AsyncCallbackJsonWebHandler* configPatch = new AsyncCallbackJsonWebHandler("/api/config", handleApiConfigPatch, 3072);
+    configPatch->setMethod(HTTP_PATCH);
+    server.addHandler(configPatch);
+    server.on("/api/status", HTTP_GET, handleApiStatus);
+    server.on("/api/timezones", HTTP_GET, handleApiTimezones);
+    server.on("/api/themes", HTTP_GET, handleApiThemes);
+    server.on("/status", HTTP_GET, handleStatus);
+    server.on("/alarms", HTTP_GET, handleAlarms);
+    server.on("/reboot", HTTP_GET, handleReboot);
+    server.on("/sleep", HTTP_GET, handleDeepSleep);
+    server.on("/toggle_backlight", HTTP_GET, handleBacklightToggle); 
+    server.on("/dashboard", HTTP_GET, [](AsyncWebServerRequest* request) {
+        sendGzipAsset(request, "text/html", DASHBOARD_PAGE_GZ, DASHBOARD_PAGE_GZ_LEN, DASHBOARD_PAGE_ETAG);
+    });
+    statusStreamAttach(server);
+    screenCaptureAttach(server);
+    otaAttach(server);
+    metricsAttach(server);
+    assetPackAttach(server);
+    portalAttach(server);
+    server.onNotFound([](AsyncWebServerRequest* request) {
+        if (portalRedirect(request)) return; // Captive portal: any other host lands on /setup
+        request->send(404, "text/plain", "Not found");
+    });
+    
+    server.begin();
+    Serial.println("HTTP Config Server started (async).");
+}
+
+/**
+ * @brief Sets the fields a PATCH queued on the live config, one configSetField()
+ * each, then saves and applies whatever actually changed.
+ */
+static void applyConfigPatch() {
+    DynamicJsonDocument patch(JSON_OBJECT_SIZE(64) + pendingPatch.length());
+    if (deserializeJson(patch, pendingPatch) != DeserializationError::Ok) {
+        Serial.println("Web: queued settings could not be read back, dropped.");
+        return;
+    }
+    uint32_t changes = 0;
+    String changed;
+    for (JsonPair field : patch.as<JsonObject>()) {
+        uint32_t fieldChanges = 0;
+        if (!configSetField(userConfig, field.key().c_str(), patchFieldText(field.value()), fieldChanges)) {
+            Serial.printf("Web: setting %s rejected on apply.\n", field.key().c_str());
+            continue;
+        }
+        if (fieldChanges == 0) continue;
+        changes |= fieldChanges;
+        if (changed.length() > 0) changed += ", ";
+        changed += field.key().c_str();
+    }
+    if (changes == 0) {
+        Serial.println("Web: settings unchanged.");
+        return;
+    }
+    Serial.printf("Web: settings changed: %s\n", changed.c_str());
+    saveConfig();
+    applyConfigChanges(changes);
+}
+
+/**
+ * @brief Runs the actions web requests left for the main task: anything that
+ * draws on the display or touches loop()-owned state. Called from loop().
+ */
+void serviceWebActions() {
+    if (configPending) {
+        applyConfigPatch();
+        configPending = false;
+    }
+    if (alarmsPending) {
+        alarmsPending = false;
+        memcpy(alarmEntries, pendingAlarms, sizeof(alarmEntries));
+        saveAlarms();
+        Serial.println("Web Server: Alarm table saved.");
+    }
+    if (backlightTogglePending) {
+        backlightTogglePending = false;
+        toggleBacklight();
+    }
+    if (sleepPending) {
+        sleepPending = false;
+        enterDeepSleep();
+    }
+    if (restartPending) {
+        configStoreFlush(); // Coalesced settings writes must land first
+        ESP.restart();
+    }
+}
+
+void webRequestRestart() {
+    restartPending = true;
+}
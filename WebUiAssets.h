@@ -0,0 +1,442 @@
+#ifndef WEBUIASSETS_H
+#define WEBUIASSETS_H
+
+// GENERATED by tools/embed_web.py from web/ -- do not edit by hand.
+// Gzip-compressed pages served with Content-Encoding: gzip; the ETag is a
+// hash of the compressed bytes, so it changes whenever the page does.
+
+#include <stdint.h>
+#include <stddef.h>
+
+// web/config.html: 10852 bytes, 3997 gzipped
+static const char CONFIG_PAGE_ETAG[] = "\"ae3b4f12cfb8c0fc\"";
+static const size_t CONFIG_PAGE_GZ_LEN = 3997;
+static const uint8_t CONFIG_PAGE_GZ[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x5a, 0x6b, 0x5b, 0xdb, 0x48,
+    0x96, 0xfe, 0xce, 0xaf, 0xa8, 0x30, 0xdb, 0x23, 0x69, 0x6c, 0xcb, 0x86, 0x40, 0xb6, 0xdb, 0xb7,
+    0x3c, 0x34, 0x24, 0x9d, 0xcc, 0x86, 0xc0, 0x8e, 0x99, 0xed, 0x9d, 0x65, 0x99, 0x7e, 0xca, 0x52,
+    0xc9, 0xd6, 0x20, 0xa9, 0x34, 0x52, 0x09, 0x73, 0x09, 0xff, 0x7d, 0xdf, 0x53, 0x25, 0xc9, 0x32,
+    0xb6, 0x81, 0xf4, 0x33, 0xfb, 0x01, 0x23, 0x4b, 0xa7, 0xce, 0xad, 0xde, 0x3a, 0x37, 0x79, 0xf8,
+    0xe6, 0xe4, 0xec, 0xf8, 0xe2, 0x6f, 0xe7, 0x1f, 0xd8, 0x5c, 0xc5, 0xd1, 0x78, 0x67, 0x58, 0xfd,
+    0x13, 0xdc, 0xc7, 0x3f, 0x15, 0xaa, 0x48, 0x8c, 0x8f, 0x23, 0xe9, 0x5d, 0xb3, 0x63, 0x99, 0x04,
+    0xe1, 0xac, 0xc8, 0xb8, 0x0a, 0x65, 0x32, 0xec, 0x9a, 0x47, 0x3b, 0xc3, 0x58, 0x28, 0xce, 0x12,
+    0x1e, 0x8b, 0xd1, 0xee, 0x4d, 0x28, 0x16, 0xa9, 0xcc, 0xd4, 0x2e, 0xf3, 0x64, 0xa2, 0x44, 0xa2,
+    0x46, 0xbb, 0x8b, 0xd0, 0x57, 0xf3, 0x91, 0x2f, 0x6e, 0x42, 0x4f, 0x74, 0xf4, 0x97, 0x36, 0x0b,
+    0x93, 0x50, 0x85, 0x3c, 0xea, 0xe4, 0x1e, 0x8f, 0xc4, 0x68, 0x6f, 0x17, 0x4c, 0x72, 0x75, 0x47,
+    0xcc, 0xa6, 0xd2, 0xbf, 0x7b, 0x08, 0xb0, 0xb6, 0x13, 0xf0, 0x38, 0x8c, 0xee, 0xfa, 0x47, 0x19,
+    0x08, 0xdb, 0x39, 0x4f, 0xf2, 0x4e, 0x2e, 0xb2, 0x30, 0x18, 0xc4, 0x3c, 0x9b, 0x85, 0x49, 0x7f,
+    0xbf, 0x97, 0xde, 0x0e, 0x1e, 0x77, 0xc2, 0x24, 0x2d, 0xd4, 0xa5, 0xba, 0x4b, 0xc5, 0x48, 0x89,
+    0x5b, 0x75, 0xd5, 0x6e, 0xdc, 0x48, 0x79, 0x9e, 0x2f, 0x64, 0xe6, 0xaf, 0xdc, 0x4c, 0x8a, 0x78,
+    0x2a, 0xb2, 0xab, 0x76, 0x2e, 0x22, 0xe1, 0xa9, 0x07, 0xad, 0x50, 0x7f, 0xaf, 0xd7, 0xfb, 0x61,
+    0x90, 0x72, 0xdf, 0x0f, 0x93, 0x19, 0xbe, 0x80, 0x73, 0x29, 0xe5, 0xc7, 0xf4, 0x96, 0xf5, 0x06,
+    0x53, 0x79, 0xdb, 0xc9, 0xc3, 0x7b, 0x7a, 0x38, 0x05, 0x3f, 0x91, 0x75, 0x70, 0x67, 0x55, 0x78,
+    0x5e, 0x4c, 0xe3, 0x50, 0x5d, 0x3d, 0x4c, 0xb9, 0x77, 0x3d, 0xcb, 0x64, 0x91, 0xf8, 0x1d, 0x4f,
+    0x46, 0x32, 0xeb, 0xff, 0xe1, 0xe0, 0xf8, 0xe8, 0xe3, 0x61, 0x6f, 0x60, 0xbe, 0x2d, 0xe6, 0xa1,
+    0x12, 0x4b, 0x49, 0x07, 0x60, 0xbf, 0xbf, 0x41, 0x1c, 0xc9, 0xe8, 0x27, 0x32, 0x11, 0x03, 0xaf,
+    0xc8, 0x72, 0xac, 0x4b, 0x65, 0x08, 0x77, 0x66, 0x83, 0x86, 0xba, 0x8f, 0x3b, 0xd3, 0x42, 0x29,
+    0x99, 0x6c, 0x10, 0x19, 0x1c, 0x1c, 0xbc, 0x7d, 0xfb, 0xee, 0xff, 0x43, 0xa4, 0x9b, 0x48, 0x25,
+    0xcc, 0xfe, 0xc0, 0x21, 0xa2, 0xdf, 0x73, 0x7f, 0x12, 0x71, 0x29, 0xe8, 0x0f, 0x87, 0x87, 0x87,
+    0x20, 0x19, 0x76, 0xcb, 0xad, 0x1c, 0x76, 0x4b, 0x08, 0xd1, 0x9e, 0x12, 0xa0, 0xf6, 0xc7, 0x1f,
+    0xa3, 0x30, 0x65, 0x06, 0x4b, 0x13, 0xa1, 0x14, 0x14, 0xca, 0x41, 0xb5, 0x8f, 0x87, 0xe9, 0x18,
+    0xe0, 0x4a, 0xb0, 0x23, 0xc2, 0x67, 0x4a, 0xb2, 0x5f, 0xc3, 0x8f, 0x61, 0x9f, 0x0d, 0xf3, 0x94,
+    0x27, 0x2c, 0xf4, 0x47, 0x56, 0x9e, 0x87, 0xbe, 0x35, 0x06, 0x6b, 0xdc, 0xc0, 0xbf, 0x14, 0x2b,
+    0x02, 0x99, 0xc5, 0xfa, 0x99, 0x17, 0xcc, 0x2c, 0x62, 0xff, 0x76, 0x7c, 0x96, 0x8a, 0xe4, 0x57,
+    0xc1, 0xd5, 0x5c, 0x64, 0xa7, 0x3c, 0x6d, 0x8a, 0x78, 0x0b, 0x82, 0x88, 0x4f, 0x45, 0xc4, 0xb0,
+    0x6c, 0x64, 0xf1, 0x34, 0xbc, 0x16, 0x77, 0xd6, 0xf8, 0xe8, 0xfc, 0x33, 0xfb, 0x0f, 0x71, 0xd7,
+    0x1f, 0x76, 0xf5, 0x43, 0x10, 0xe9, 0x2d, 0x65, 0x7a, 0x4b, 0x2d, 0x02, 0x94, 0xa5, 0x45, 0x94,
+    0xf4, 0x06, 0xe4, 0xf5, 0xb7, 0x98, 0xdf, 0x46, 0x22, 0x99, 0x01, 0xdd, 0xd6, 0xdb, 0x9f, 0xa0,
+    0xdd, 0x34, 0x23, 0x43, 0x98, 0x17, 0x01, 0x77, 0x23, 0x8b, 0x3c, 0x65, 0x8d, 0xff, 0xf4, 0x39,
+    0x60, 0x77, 0xb2, 0x60, 0xbe, 0x64, 0xb8, 0xc1, 0xe6, 0xfc, 0x46, 0x30, 0xd8, 0x54, 0x0a, 0x66,
+    0x37, 0x61, 0x1e, 0x2a, 0x26, 0xa1, 0xf7, 0xc2, 0xe8, 0x1d, 0xf3, 0xd4, 0x95, 0xd9, 0x8c, 0x7c,
+    0xe0, 0x65, 0xb8, 0xa5, 0xa9, 0xb9, 0xe7, 0x61, 0x7b, 0x95, 0x6b, 0x0c, 0x6f, 0xd8, 0xe1, 0x85,
+    0x0a, 0x56, 0x1c, 0xe3, 0x93, 0x7d, 0x85, 0x6a, 0xcc, 0x16, 0xee, 0xcc, 0x6d, 0xb3, 0x2f, 0x32,
+    0xf1, 0x65, 0xe2, 0xbc, 0x68, 0x96, 0x5e, 0x5e, 0x1a, 0x65, 0xae, 0x37, 0x9a, 0xd4, 0x14, 0x48,
+    0x7a, 0x64, 0x24, 0xd3, 0x5c, 0x20, 0x24, 0xf8, 0xb5, 0xd8, 0x5f, 0x7e, 0x7e, 0x85, 0xc8, 0x92,
+    0x41, 0x25, 0xb5, 0xfa, 0xda, 0x14, 0xbc, 0x49, 0x2e, 0xb4, 0xfb, 0x8d, 0x20, 0xa0, 0x6d, 0xfd,
+    0x7c, 0xc2, 0xec, 0xb3, 0x94, 0x82, 0x10, 0x8f, 0x5e, 0x67, 0x25, 0xad, 0x6d, 0x18, 0xaa, 0xbf,
+    0x36, 0x44, 0xee, 0xed, 0x3d, 0xb3, 0x7d, 0x95, 0xc8, 0x30, 0x67, 0x82, 0x4e, 0x84, 0xf0, 0xdb,
+    0x0c, 0x5b, 0x05, 0x42, 0xc2, 0xf1, 0x22, 0x8c, 0x22, 0x56, 0xe4, 0x82, 0x28, 0x62, 0x72, 0x06,
+    0x4f, 0x7c, 0x16, 0xce, 0x12, 0x99, 0x09, 0xbd, 0xb2, 0x5b, 0x79, 0x2a, 0x08, 0x45, 0xe4, 0xe7,
+    0xeb, 0x7b, 0x98, 0x66, 0xf2, 0x26, 0xc4, 0xe1, 0xb3, 0xc6, 0x25, 0x74, 0xd9, 0x79, 0x79, 0xa7,
+    0x61, 0x99, 0x89, 0x56, 0xda, 0x9c, 0x9a, 0xbe, 0xb4, 0x67, 0xb9, 0x7e, 0x67, 0x28, 0xb5, 0x53,
+    0xd8, 0x0d, 0x8f, 0x0a, 0x3c, 0xe9, 0x59, 0x4f, 0x4e, 0xc4, 0xb0, 0x6b, 0x08, 0xd6, 0x28, 0xf7,
+    0x0c, 0x65, 0xe7, 0x54, 0x28, 0x21, 0x99, 0x9d, 0x48, 0x06, 0x80, 0xb7, 0xc9, 0xac, 0x1c, 0x81,
+    0x1c, 0xb1, 0x21, 0x4c, 0x00, 0xc5, 0xdc, 0xd9, 0xca, 0x60, 0xdf, 0x1a, 0x9f, 0x92, 0x37, 0x6c,
+    0x50, 0xd1, 0x99, 0x6b, 0x52, 0x76, 0x8d, 0xf2, 0xeb, 0x9b, 0x1a, 0x71, 0x65, 0x8d, 0xbf, 0x20,
+    0x99, 0xa8, 0xc2, 0x17, 0xb5, 0xb1, 0x2b, 0xbb, 0x68, 0xa2, 0xb5, 0xc5, 0x72, 0x25, 0x52, 0x18,
+    0xe4, 0xf6, 0x7a, 0xbd, 0x3d, 0xb3, 0xab, 0xb4, 0xb8, 0xf4, 0x80, 0xe6, 0xb3, 0xce, 0x5d, 0x26,
+    0xe0, 0x2e, 0x93, 0xd9, 0xef, 0x63, 0x8f, 0xd5, 0x15, 0x7b, 0x62, 0xb4, 0xc6, 0xfe, 0x9f, 0x85,
+    0x54, 0xdc, 0x1a, 0x9f, 0x70, 0x24, 0x29, 0x7d, 0x9c, 0x8f, 0x39, 0x80, 0xf0, 0x25, 0x44, 0x16,
+    0x60, 0x76, 0x8f, 0x8d, 0x58, 0x91, 0x44, 0xf4, 0x45, 0xf8, 0xce, 0xf3, 0xb2, 0x49, 0x9a, 0x61,
+    0x56, 0xca, 0x2b, 0x39, 0x1b, 0x89, 0x7e, 0x78, 0x53, 0xea, 0xe3, 0xe5, 0x14, 0x00, 0xf1, 0xdd,
+    0xc4, 0xba, 0x0a, 0x2c, 0x7f, 0x45, 0x2a, 0xdd, 0x10, 0xe1, 0x94, 0x88, 0xd3, 0x02, 0x8f, 0xac,
+    0xf1, 0x05, 0xae, 0x04, 0x52, 0x76, 0x01, 0x40, 0x12, 0xf1, 0x66, 0x54, 0xd5, 0xf4, 0xa5, 0x12,
+    0xcb, 0xf5, 0xeb, 0x50, 0xf9, 0xc8, 0xe7, 0x99, 0x48, 0xe6, 0x22, 0x54, 0xf5, 0x2e, 0xaf, 0x23,
+    0xef, 0x58, 0x44, 0x79, 0x58, 0xe4, 0x4b, 0x8a, 0xad, 0x30, 0x08, 0x51, 0x2a, 0xe8, 0x0c, 0xb2,
+    0x3c, 0x01, 0x9f, 0x71, 0x8b, 0x4d, 0x28, 0x8d, 0x6c, 0xd6, 0x76, 0xb9, 0xa4, 0x54, 0xb7, 0xc1,
+    0x63, 0x5d, 0xdf, 0xd3, 0x22, 0x52, 0x61, 0xe7, 0x98, 0x1e, 0x3f, 0xa3, 0xf0, 0xa9, 0x4c, 0xa4,
+    0x37, 0xcf, 0x64, 0x2c, 0x5e, 0xa1, 0x33, 0xb4, 0x8c, 0x85, 0xcf, 0xb3, 0x6b, 0x42, 0x40, 0x76,
+    0xcd, 0x2e, 0xe8, 0xfb, 0x72, 0x9f, 0x9b, 0x8e, 0xad, 0x29, 0x2b, 0xcf, 0x2e, 0x97, 0xbe, 0xc0,
+    0x3f, 0x0a, 0x67, 0x73, 0x3a, 0x21, 0xf4, 0xef, 0x25, 0x09, 0x86, 0xb6, 0x29, 0xa2, 0x5c, 0xbd,
+    0x5d, 0x06, 0x2f, 0x94, 0xd4, 0x94, 0xc0, 0x08, 0xfd, 0x63, 0x93, 0x45, 0xa8, 0xbc, 0x39, 0x55,
+    0x09, 0x1b, 0x9d, 0xbe, 0xa4, 0xaf, 0xf2, 0xe0, 0x92, 0xc1, 0x06, 0x77, 0xf2, 0xa4, 0xe0, 0x11,
+    0x02, 0x02, 0x12, 0x31, 0x92, 0x99, 0x92, 0xb3, 0x59, 0x24, 0x9c, 0x6d, 0xfe, 0xc7, 0x2e, 0x1d,
+    0x81, 0x5b, 0x8c, 0x60, 0xe0, 0x31, 0x5b, 0xab, 0xce, 0xa6, 0x77, 0xcc, 0xe7, 0x88, 0x42, 0xe4,
+    0x2b, 0xc6, 0x15, 0x4b, 0xe8, 0xae, 0xf3, 0x8a, 0xcd, 0x59, 0x50, 0x15, 0xba, 0x04, 0xd3, 0x49,
+    0x98, 0xa7, 0x11, 0xbf, 0xdb, 0x6c, 0x94, 0xa1, 0x2d, 0x0d, 0x2a, 0x17, 0x6e, 0x00, 0x73, 0x91,
+    0x01, 0xf1, 0x8a, 0x0a, 0x60, 0x3f, 0xa4, 0x67, 0xf9, 0x33, 0x86, 0x7c, 0x92, 0x45, 0x86, 0x98,
+    0xf0, 0x11, 0x19, 0xc0, 0xe3, 0xb9, 0x02, 0x8e, 0xb3, 0x30, 0xdd, 0x46, 0xbf, 0x5f, 0x85, 0x90,
+    0x6d, 0xe4, 0xab, 0x56, 0xe2, 0x98, 0xff, 0x67, 0x11, 0x0a, 0xc5, 0x48, 0x48, 0x75, 0xec, 0xd3,
+    0xf1, 0x51, 0x9a, 0x46, 0x21, 0x2a, 0x27, 0x1e, 0x20, 0x3f, 0xb1, 0x3d, 0x16, 0x87, 0x49, 0x81,
+    0xd2, 0x01, 0xfb, 0x39, 0x97, 0x08, 0x38, 0x1c, 0xee, 0x2f, 0xbc, 0xb9, 0x8b, 0xb2, 0x0a, 0x85,
+    0xc1, 0x22, 0x47, 0xea, 0xbb, 0x63, 0x59, 0x91, 0xb0, 0x94, 0x04, 0xc6, 0xa1, 0xaf, 0x5d, 0xeb,
+    0xb2, 0xaf, 0x92, 0x3c, 0x9e, 0x33, 0x6c, 0xc2, 0x35, 0xb8, 0x8d, 0x98, 0x0c, 0x82, 0x32, 0x61,
+    0x55, 0x71, 0x08, 0xd9, 0x26, 0x08, 0x23, 0xb1, 0x1a, 0x8b, 0x2e, 0xc2, 0xd8, 0xe4, 0xbd, 0x49,
+    0x24, 0x44, 0xba, 0x21, 0x18, 0xe1, 0x79, 0x10, 0x53, 0x2c, 0x22, 0x42, 0x58, 0x8a, 0x7d, 0xde,
+    0x12, 0x86, 0x4a, 0xca, 0x0a, 0xc8, 0xd5, 0xc2, 0xf5, 0x2d, 0xd9, 0xdb, 0xef, 0x90, 0x0f, 0x98,
+    0x7d, 0x74, 0xda, 0x3d, 0x3f, 0x7d, 0x0e, 0x58, 0xfb, 0x07, 0x9a, 0xf2, 0x35, 0xa7, 0xfa, 0xde,
+    0x84, 0x63, 0x75, 0xaf, 0x6f, 0x96, 0xfa, 0xfe, 0x0f, 0x8a, 0xe2, 0x2d, 0xda, 0xde, 0xd7, 0x8a,
+    0xde, 0xaf, 0xe9, 0x58, 0x1f, 0x81, 0x5f, 0x4e, 0x2f, 0xd8, 0x59, 0x10, 0xe4, 0xd8, 0x35, 0x1b,
+    0x2c, 0xe4, 0xe2, 0x35, 0x18, 0x9e, 0x91, 0xd5, 0xcd, 0x95, 0x7a, 0xc3, 0xdb, 0xcc, 0x54, 0x5a,
+    0x9d, 0x43, 0x26, 0xb1, 0xcf, 0x03, 0x56, 0x8a, 0x20, 0x3f, 0xb1, 0x7b, 0xe8, 0xc9, 0x64, 0x12,
+    0xdd, 0x6d, 0x2b, 0x89, 0x9a, 0x19, 0x67, 0xb6, 0x74, 0xb2, 0x16, 0xb5, 0xa6, 0x40, 0x4e, 0x5b,
+    0xa9, 0x62, 0x69, 0x8d, 0xf5, 0xa6, 0x32, 0x72, 0x05, 0x61, 0xc9, 0x3e, 0xd5, 0xd8, 0x82, 0x2a,
+    0x3d, 0x3a, 0xd7, 0x7e, 0x98, 0xf3, 0x29, 0x0e, 0xf6, 0x2b, 0x44, 0xd6, 0x1c, 0x4b, 0xb9, 0x4b,
+    0x09, 0x35, 0xb6, 0xbf, 0x0a, 0x85, 0x86, 0xed, 0xba, 0xc2, 0xf5, 0x6a, 0x2d, 0x76, 0xa6, 0x4f,
+    0x73, 0x62, 0x48, 0xf2, 0x46, 0x09, 0x46, 0x68, 0xfe, 0x07, 0xba, 0x15, 0x53, 0x87, 0x12, 0x68,
+    0xd1, 0x6a, 0x6a, 0x3c, 0x42, 0x25, 0xc7, 0xa5, 0xd0, 0xc9, 0xc8, 0x37, 0xa0, 0xc8, 0x78, 0x32,
+    0x33, 0xe7, 0x42, 0xaf, 0xcf, 0x55, 0x86, 0x02, 0x01, 0x25, 0x0b, 0xcb, 0x51, 0xb2, 0xc1, 0x91,
+    0xa8, 0xf1, 0x50, 0xf4, 0xf8, 0xed, 0x1d, 0x5a, 0xdd, 0x90, 0x20, 0x6f, 0x50, 0x09, 0xc1, 0x5c,
+    0x5e, 0x2d, 0xc9, 0x34, 0xc7, 0xc5, 0x5c, 0x24, 0x86, 0x91, 0x59, 0x3e, 0x13, 0x2a, 0x67, 0xa8,
+    0xe4, 0xaf, 0x5d, 0xf6, 0x45, 0xe8, 0x52, 0x9f, 0x55, 0x4d, 0x28, 0x9b, 0x46, 0x3c, 0xb9, 0x26,
+    0x1e, 0xd7, 0xe4, 0x4e, 0xbd, 0x08, 0x14, 0x3e, 0xf1, 0x79, 0x72, 0xc6, 0x60, 0x62, 0xe3, 0x7c,
+    0x3d, 0xf1, 0x82, 0xe1, 0x3b, 0x51, 0x3a, 0x52, 0x7e, 0x3e, 0x67, 0xc8, 0xd3, 0x28, 0x4f, 0xc1,
+    0x96, 0x6a, 0xd0, 0x93, 0x4f, 0xc7, 0xe7, 0x2e, 0x33, 0xd1, 0x40, 0xeb, 0x4b, 0x62, 0x62, 0x0e,
+    0xc3, 0x4b, 0xb7, 0xb5, 0x59, 0x80, 0x0c, 0xa7, 0x6f, 0x27, 0x28, 0x90, 0xa9, 0x4b, 0xa7, 0xa6,
+    0x8b, 0x60, 0x6b, 0x67, 0x62, 0x2a, 0xd1, 0xa2, 0x00, 0x58, 0x0b, 0x7e, 0x2d, 0x9c, 0xf5, 0x4a,
+    0x35, 0x0f, 0x53, 0xa0, 0xa1, 0x92, 0xbc, 0xb9, 0xaa, 0x59, 0x96, 0xdd, 0x44, 0x5d, 0xed, 0x34,
+    0x5d, 0x36, 0xcb, 0xed, 0xc3, 0x4d, 0x80, 0x9b, 0x21, 0xf4, 0xfe, 0x82, 0x32, 0x73, 0xd1, 0x88,
+    0xd5, 0xdb, 0x78, 0xcf, 0xea, 0x98, 0xad, 0x2f, 0x5f, 0xe4, 0x1d, 0xf3, 0x1c, 0xf9, 0x76, 0x52,
+    0x4c, 0xe1, 0x07, 0x1c, 0x9a, 0x1c, 0x95, 0xaa, 0x2f, 0x02, 0x8e, 0xc2, 0x80, 0xed, 0x1f, 0x1e,
+    0xba, 0xd5, 0x5f, 0xcf, 0x79, 0x51, 0xb2, 0xe6, 0x54, 0xc9, 0x36, 0x5f, 0x5e, 0x94, 0xee, 0x27,
+    0xd8, 0xcf, 0x93, 0xaf, 0x13, 0x74, 0xa4, 0xd9, 0x0d, 0xa0, 0x53, 0xc9, 0xee, 0xb3, 0x99, 0xb1,
+    0xf7, 0x65, 0xb1, 0xc4, 0xa2, 0x92, 0xaa, 0xaf, 0x37, 0x0a, 0xc5, 0xb1, 0x99, 0x08, 0xf4, 0xef,
+    0xe8, 0x3b, 0xd6, 0xa3, 0x30, 0xaa, 0xca, 0x74, 0x61, 0xd8, 0xe9, 0xcb, 0x32, 0xc6, 0x7d, 0x0c,
+    0xb3, 0x78, 0xc1, 0xa9, 0x38, 0x4c, 0x7d, 0xea, 0x37, 0xcf, 0x2b, 0xc0, 0xda, 0x3f, 0xb6, 0x98,
+    0x37, 0xe7, 0x19, 0x47, 0x53, 0x4e, 0xa1, 0xc7, 0x00, 0x98, 0xd0, 0x9b, 0xaf, 0xc2, 0x77, 0xdb,
+    0xe1, 0xaf, 0xa0, 0xdf, 0x90, 0x59, 0xd9, 0x50, 0x7e, 0x69, 0x76, 0x7d, 0x28, 0xbc, 0xa9, 0xa0,
+    0xf0, 0x64, 0x9c, 0x46, 0x68, 0x43, 0xe8, 0x18, 0x2c, 0x3a, 0x35, 0x8b, 0xd2, 0xc0, 0x26, 0x7b,
+    0x33, 0x72, 0xb1, 0xaa, 0x78, 0x3b, 0xd1, 0xe7, 0xa2, 0x6c, 0xf9, 0x2d, 0x7d, 0x70, 0xb4, 0xe7,
+    0x48, 0x4b, 0x6b, 0xf5, 0x0c, 0x19, 0x64, 0x77, 0x69, 0x82, 0x50, 0x0d, 0x12, 0x62, 0x81, 0x54,
+    0x49, 0x71, 0x51, 0x80, 0x23, 0xd7, 0x27, 0x02, 0x05, 0x4e, 0xc4, 0xb3, 0x98, 0x8e, 0xa2, 0x99,
+    0xb4, 0x30, 0x3d, 0xd8, 0x18, 0x59, 0xeb, 0x03, 0x97, 0x1f, 0xc5, 0xc1, 0x01, 0xf7, 0x07, 0x28,
+    0x62, 0xf4, 0x0a, 0xf6, 0x47, 0x1e, 0xa7, 0x03, 0x36, 0xf1, 0xe6, 0xc2, 0x2f, 0x90, 0x2c, 0x87,
+    0x5d, 0xc3, 0x60, 0xfc, 0x0a, 0x99, 0x3e, 0xcf, 0xe7, 0x53, 0xc9, 0x8d, 0xc9, 0x2f, 0x88, 0xdd,
+    0x7b, 0xc7, 0x7b, 0x3f, 0x1e, 0x0e, 0xa8, 0x44, 0x2c, 0x63, 0x42, 0xb1, 0x41, 0x16, 0x70, 0xf0,
+    0x64, 0x8f, 0x37, 0xc7, 0xd7, 0xbf, 0xa6, 0x91, 0xe4, 0x26, 0xea, 0xb9, 0x53, 0x84, 0x8c, 0x3a,
+    0x52, 0x4c, 0x8b, 0x30, 0xc2, 0x46, 0x17, 0x4a, 0xfb, 0x5e, 0x42, 0x5d, 0x0a, 0xc4, 0x3a, 0x88,
+    0xa2, 0xf7, 0x60, 0x93, 0x4f, 0x47, 0x9d, 0xfd, 0xc3, 0x77, 0x65, 0xf4, 0x1d, 0x7a, 0x68, 0x82,
+    0xc7, 0xf9, 0x9c, 0xe3, 0x56, 0x5e, 0xc4, 0x68, 0x7b, 0x8d, 0x68, 0x62, 0x39, 0xec, 0xea, 0x87,
+    0x8e, 0xbb, 0x83, 0xb6, 0xda, 0xc4, 0xa0, 0x45, 0x4d, 0xc0, 0x02, 0xd4, 0x41, 0xb9, 0xe6, 0x88,
+    0x5b, 0xb9, 0xea, 0xe8, 0x68, 0x84, 0xfc, 0x18, 0x74, 0xa8, 0xa9, 0x6c, 0x44, 0xe3, 0x4c, 0xa0,
+    0x99, 0x49, 0xea, 0xf8, 0xe6, 0x95, 0xc5, 0x19, 0x4e, 0x56, 0x0e, 0x17, 0xba, 0xa5, 0x91, 0x39,
+    0xb8, 0x0b, 0x6d, 0xce, 0x4e, 0x2d, 0xa2, 0x30, 0x10, 0xaf, 0x63, 0x32, 0x65, 0x56, 0x3e, 0x95,
+    0x37, 0x26, 0x5b, 0x10, 0x45, 0x26, 0x02, 0x4a, 0x00, 0x88, 0xec, 0xa8, 0x72, 0x1a, 0x32, 0x91,
+    0x18, 0xe0, 0x12, 0xd0, 0x17, 0xa9, 0x6e, 0xf3, 0xcb, 0xe8, 0xd8, 0xc4, 0x23, 0xd5, 0x45, 0x06,
+    0xea, 0xc1, 0x82, 0xf6, 0xd3, 0x43, 0x76, 0x1b, 0x59, 0x64, 0xb7, 0xb5, 0x75, 0x36, 0x11, 0x2c,
+    0xe0, 0x29, 0x8b, 0xa1, 0x3e, 0xf5, 0xc4, 0x5c, 0x46, 0x68, 0xe3, 0x01, 0xe4, 0xca, 0x9f, 0xef,
+    0x0e, 0xd8, 0x5c, 0xdc, 0x36, 0xce, 0xa0, 0xb3, 0x72, 0x62, 0xde, 0x1d, 0x58, 0xcf, 0x1e, 0xb8,
+    0x60, 0x41, 0x47, 0x6c, 0x85, 0xf5, 0xc7, 0x2d, 0x8e, 0x78, 0xe1, 0x24, 0x96, 0x1e, 0x6e, 0x9c,
+    0xc6, 0x9d, 0x0a, 0x9b, 0x46, 0xd0, 0x54, 0x25, 0xd6, 0x76, 0x98, 0xd2, 0x5c, 0xb0, 0x86, 0x57,
+    0xa5, 0x42, 0x8d, 0xd3, 0xea, 0xa0, 0xc2, 0x15, 0x00, 0xb0, 0xd8, 0x78, 0x54, 0x09, 0xc2, 0x32,
+    0x51, 0xd5, 0xc1, 0xa2, 0xf6, 0x30, 0x7f, 0x16, 0xc4, 0x34, 0x34, 0xcb, 0x69, 0x77, 0x53, 0x68,
+    0xa3, 0x01, 0xac, 0x0c, 0x60, 0x0d, 0x3c, 0x95, 0x94, 0x51, 0xde, 0xa5, 0x67, 0xbf, 0x69, 0xb2,
+    0xdc, 0x4d, 0xef, 0x4a, 0x70, 0xba, 0xec, 0x33, 0x30, 0xe1, 0xfb, 0x3a, 0xc6, 0xc5, 0x40, 0x11,
+    0x21, 0x23, 0x13, 0xda, 0x8d, 0xb9, 0x41, 0x93, 0xd6, 0x84, 0xe2, 0x98, 0x4f, 0x98, 0xa0, 0x7e,
+    0x5f, 0x63, 0x84, 0x3a, 0x15, 0x25, 0xda, 0x8c, 0x7a, 0xd1, 0xdc, 0x69, 0x14, 0xdf, 0x35, 0xfc,
+    0x90, 0x61, 0xe9, 0x28, 0x0d, 0xc0, 0xf3, 0x4e, 0x51, 0xa3, 0x85, 0xda, 0x3b, 0xcf, 0xe9, 0xff,
+    0x32, 0xaa, 0x6a, 0x5d, 0x3b, 0x74, 0xfc, 0x64, 0x3d, 0xf1, 0xdb, 0x8c, 0x32, 0x9e, 0xae, 0xa3,
+    0xac, 0xb1, 0x2b, 0x3c, 0xfd, 0x8e, 0x5d, 0x39, 0xd2, 0xce, 0x3a, 0x07, 0xd1, 0xda, 0xbe, 0xf0,
+    0x74, 0xfb, 0xbe, 0x6c, 0x0f, 0x63, 0xa6, 0xdf, 0xfb, 0x8d, 0xc4, 0x56, 0x8d, 0xe8, 0x4b, 0xd1,
+    0x2c, 0xe8, 0x71, 0xff, 0x40, 0x40, 0xa7, 0x0b, 0xbd, 0x96, 0xfd, 0x5c, 0xad, 0xfd, 0x9e, 0xf0,
+    0xa9, 0x8b, 0xca, 0x5a, 0xd8, 0xf8, 0x84, 0x6a, 0xad, 0xb2, 0x2b, 0x79, 0x3d, 0x13, 0x53, 0x09,
+    0xbd, 0x26, 0x00, 0x8b, 0x9f, 0x7a, 0x41, 0x00, 0x95, 0xff, 0x62, 0x6a, 0xa7, 0x13, 0xfd, 0x96,
+    0x63, 0x5d, 0x54, 0xee, 0xa1, 0xa7, 0x53, 0xe3, 0x9d, 0x6e, 0xb7, 0xaa, 0xdc, 0x52, 0x3e, 0x13,
+    0x7d, 0x26, 0x10, 0xb3, 0xee, 0x4c, 0x02, 0xa3, 0x08, 0x83, 0xbd, 0x8d, 0x0c, 0xa8, 0x74, 0xec,
+    0xed, 0xf2, 0x34, 0x04, 0x28, 0xe9, 0x9d, 0x0b, 0xb3, 0xb5, 0xb6, 0x7a, 0x86, 0xa8, 0xa1, 0x97,
+    0xeb, 0x68, 0x45, 0x80, 0xf9, 0xf3, 0xe4, 0xec, 0x2b, 0x8d, 0xeb, 0x72, 0x87, 0xd8, 0x13, 0x5a,
+    0x4d, 0x62, 0xd6, 0x70, 0x3f, 0x3f, 0xba, 0x38, 0xfe, 0xd4, 0x64, 0xd4, 0xa6, 0xc8, 0xe6, 0xcd,
+    0x19, 0xaf, 0x6a, 0x44, 0x8a, 0x70, 0x73, 0xaa, 0x8a, 0x73, 0x16, 0x21, 0x8b, 0xb8, 0x3b, 0x37,
+    0x1c, 0x2d, 0xf3, 0xd1, 0xdf, 0x26, 0xa3, 0x4b, 0x6b, 0x52, 0x58, 0x6d, 0xeb, 0x54, 0xe2, 0xe3,
+    0x82, 0xae, 0x7e, 0x15, 0x74, 0x35, 0xc7, 0xc7, 0xc7, 0x0c, 0x1f, 0x13, 0x6e, 0x5d, 0xb5, 0x4f,
+    0xcf, 0x4e, 0x3e, 0x10, 0x69, 0xd9, 0x64, 0x53, 0xbb, 0x82, 0x47, 0x27, 0x61, 0x4c, 0x9f, 0xb5,
+    0xf3, 0xad, 0xab, 0xc1, 0x4e, 0x50, 0x24, 0xa6, 0xd0, 0x14, 0x91, 0x1d, 0xfa, 0xce, 0x83, 0x89,
+    0xe2, 0xcc, 0x97, 0x5e, 0x11, 0x23, 0xb8, 0xb8, 0xd8, 0x81, 0x0f, 0x91, 0xa0, 0xcb, 0x9f, 0xef,
+    0x3e, 0xfb, 0x44, 0x32, 0x78, 0xd4, 0xca, 0x10, 0x40, 0x85, 0x3f, 0x7a, 0x78, 0x6c, 0xf0, 0x20,
+    0x6f, 0xfc, 0x17, 0xb9, 0x2d, 0xb7, 0x9d, 0x87, 0x1d, 0x46, 0x64, 0xc1, 0x08, 0x8c, 0xf5, 0xcb,
+    0x00, 0xa7, 0xed, 0x69, 0x6a, 0xa2, 0xb2, 0xe9, 0x51, 0x38, 0xea, 0x0d, 0xc2, 0x61, 0xe0, 0x0a,
+    0xc3, 0x3f, 0x77, 0x4d, 0xa8, 0x1b, 0x84, 0xad, 0x16, 0xad, 0xd6, 0xcb, 0xc5, 0x68, 0xf9, 0xfc,
+    0x32, 0xbc, 0x6a, 0xc7, 0xa3, 0xee, 0xdf, 0x53, 0xfb, 0x7f, 0x7d, 0xc7, 0xa7, 0x8f, 0x7f, 0xeb,
+    0xba, 0xe2, 0x56, 0x78, 0x48, 0x71, 0xe4, 0x7c, 0x07, 0xbc, 0x59, 0x18, 0xd8, 0xb1, 0xf3, 0x40,
+    0x4b, 0xaf, 0x11, 0x79, 0xad, 0x56, 0x7c, 0xb9, 0x77, 0xd5, 0xb2, 0xa8, 0x7f, 0xb6, 0x06, 0xde,
+    0xe5, 0xf5, 0xd5, 0xc8, 0xa6, 0xcf, 0x6f, 0xdf, 0x7a, 0xce, 0x37, 0x2c, 0x43, 0x29, 0x40, 0x3d,
+    0xf5, 0xfb, 0xbd, 0xe1, 0x30, 0xbe, 0xdc, 0xbf, 0xea, 0xf7, 0xc8, 0x3a, 0x06, 0x5f, 0xa0, 0x6a,
+    0x07, 0xa7, 0x92, 0xaf, 0x77, 0x69, 0x2e, 0xae, 0x46, 0xc2, 0xd5, 0xa8, 0x80, 0x20, 0x90, 0x95,
+    0xae, 0xf2, 0x06, 0x3b, 0xc6, 0x23, 0x08, 0xd2, 0x16, 0x9c, 0x51, 0x5b, 0xb7, 0x07, 0xeb, 0x46,
+    0x6f, 0x8d, 0x39, 0xf3, 0xd6, 0x68, 0x77, 0x75, 0x0c, 0xea, 0xed, 0xb6, 0xc2, 0xd6, 0xae, 0x35,
+    0xfe, 0x70, 0xab, 0x32, 0xce, 0xbe, 0x48, 0x4f, 0xbf, 0xbe, 0x63, 0xfa, 0x2e, 0xb3, 0xab, 0xe9,
+    0x36, 0xca, 0x7e, 0xba, 0x6c, 0x1f, 0x1f, 0xbf, 0x58, 0x8c, 0xd6, 0x2c, 0xeb, 0x01, 0x69, 0x25,
+    0x82, 0x8a, 0xb4, 0x5d, 0x18, 0x46, 0x3b, 0xa1, 0x27, 0x96, 0x8e, 0x1b, 0xa2, 0xc1, 0xc8, 0x3e,
+    0x5d, 0x9c, 0x7e, 0x19, 0xcd, 0x07, 0xdf, 0xa3, 0xf7, 0x82, 0x5e, 0xf9, 0x94, 0x6c, 0xcb, 0xb6,
+    0x10, 0x2a, 0xdb, 0x61, 0x6b, 0xcf, 0x21, 0xb5, 0x27, 0x93, 0xcf, 0x27, 0x2f, 0x2a, 0xda, 0xe0,
+    0x51, 0x4d, 0x78, 0x1a, 0x77, 0x56, 0x53, 0xde, 0x78, 0x4b, 0x26, 0x2d, 0xd7, 0xd1, 0x8d, 0xf5,
+    0x75, 0xef, 0xde, 0x3e, 0x49, 0xb0, 0xe7, 0x2b, 0xf5, 0x6a, 0xe5, 0x0a, 0xdd, 0xd0, 0x3d, 0xe7,
+    0x8a, 0x14, 0x00, 0x4d, 0x87, 0x6f, 0x07, 0xa9, 0x01, 0xa4, 0xf6, 0x85, 0x79, 0x5f, 0x20, 0xd4,
+    0x78, 0x18, 0x89, 0x99, 0x48, 0xfc, 0xf1, 0xb9, 0x19, 0xbd, 0x90, 0x17, 0x52, 0xed, 0x05, 0x58,
+    0x6f, 0x9e, 0xac, 0x9a, 0x1f, 0x2e, 0x27, 0x74, 0xe9, 0x6e, 0x2b, 0x6d, 0xed, 0xa2, 0x82, 0xa5,
+    0x5a, 0xe9, 0x05, 0x2a, 0x51, 0xe9, 0xbc, 0x3c, 0x37, 0x3e, 0xd4, 0xf2, 0x87, 0xff, 0x3e, 0xf0,
+    0x57, 0x37, 0x68, 0x55, 0x9e, 0x46, 0xf6, 0x54, 0xde, 0xae, 0x72, 0x83, 0x93, 0x7d, 0xda, 0xba,
+    0xdd, 0x16, 0xc5, 0x92, 0x4b, 0xff, 0x4a, 0xab, 0xab, 0x57, 0x33, 0x72, 0x8b, 0xb1, 0x11, 0xf2,
+    0xaa, 0x79, 0x4a, 0x73, 0x71, 0x6c, 0xad, 0xa8, 0x11, 0x43, 0x8d, 0x78, 0xa8, 0x23, 0x4d, 0x75,
+    0x72, 0xe3, 0x5a, 0xa3, 0xd5, 0xa1, 0xcb, 0x6e, 0x2b, 0x36, 0x52, 0x35, 0xf5, 0x65, 0xac, 0xc5,
+    0x96, 0xc3, 0x96, 0xa5, 0xd8, 0x6a, 0xea, 0x82, 0x30, 0xc5, 0x22, 0xc4, 0xe0, 0x88, 0xd9, 0x3f,
+    0x38, 0x7d, 0xb6, 0x71, 0x72, 0xb1, 0x62, 0x14, 0xc2, 0x5a, 0x3d, 0x56, 0x44, 0xa5, 0x98, 0x89,
+    0x7c, 0xce, 0x6e, 0x5f, 0xb1, 0x70, 0x11, 0x50, 0xc6, 0xac, 0x77, 0x74, 0x97, 0x0e, 0x32, 0x01,
+    0xa3, 0x9e, 0xa6, 0xad, 0x82, 0x63, 0x07, 0x5b, 0x8d, 0xca, 0x40, 0xb8, 0x3c, 0x8a, 0xec, 0xcb,
+    0x40, 0x28, 0x6f, 0x6e, 0x5b, 0x3a, 0x88, 0xd3, 0xb6, 0xd1, 0x9c, 0x87, 0x56, 0x40, 0x8b, 0xc4,
+    0xae, 0x22, 0xa2, 0x9d, 0xd5, 0x11, 0x35, 0x73, 0xff, 0x91, 0xe3, 0x06, 0x02, 0x8c, 0xd3, 0x6e,
+    0xae, 0x35, 0x09, 0xe0, 0x77, 0x2c, 0x34, 0x85, 0xd0, 0xeb, 0x16, 0x5e, 0x3d, 0xa5, 0xe2, 0x55,
+    0x7c, 0x56, 0xf7, 0x3a, 0x40, 0xab, 0x7b, 0x1d, 0x9f, 0x39, 0xa2, 0x65, 0xbb, 0x11, 0xb2, 0xb1,
+    0xdd, 0xfc, 0xb2, 0x77, 0xe5, 0x62, 0xcf, 0x3f, 0x70, 0x48, 0xae, 0xd7, 0xdf, 0x9b, 0x18, 0x2b,
+    0x47, 0x75, 0xa2, 0x30, 0xef, 0x45, 0xcb, 0x5c, 0x61, 0x5b, 0x66, 0x77, 0xc1, 0x41, 0x9a, 0x90,
+    0x39, 0x92, 0x2e, 0x45, 0x80, 0xd1, 0xfd, 0x40, 0xdd, 0xbb, 0x28, 0xe4, 0x6c, 0x49, 0x7a, 0x81,
+    0xff, 0x65, 0x63, 0xf4, 0xde, 0x6e, 0xce, 0xc8, 0x37, 0x48, 0xa5, 0x04, 0xc5, 0x11, 0xa7, 0xd7,
+    0x9f, 0xa8, 0xdf, 0xab, 0x8f, 0x1a, 0x98, 0xc4, 0xd7, 0xd0, 0x49, 0xab, 0x45, 0x2e, 0xd0, 0xaf,
+    0xb7, 0x1d, 0x4d, 0x77, 0x5c, 0xfe, 0x6e, 0xc2, 0x73, 0xe9, 0x26, 0x9e, 0x23, 0x3b, 0x78, 0xae,
+    0x9f, 0x2b, 0xc7, 0x78, 0xcf, 0x74, 0xed, 0xab, 0xb4, 0x56, 0x3d, 0xa7, 0x64, 0xf6, 0xc9, 0xe4,
+    0x82, 0x59, 0x2d, 0xbd, 0xa2, 0x65, 0x39, 0x7d, 0xcb, 0x70, 0x78, 0xe3, 0xb9, 0xba, 0xe5, 0xfe,
+    0x0d, 0xf0, 0xd3, 0x8c, 0x1a, 0x13, 0x80, 0x27, 0xbc, 0x5e, 0x39, 0x0f, 0x18, 0xe8, 0xf7, 0xd9,
+    0x60, 0xd7, 0x66, 0xb9, 0xac, 0xc6, 0x4b, 0x65, 0x5f, 0x61, 0x8a, 0x13, 0x19, 0x04, 0x46, 0x7e,
+    0x75, 0x8e, 0xaf, 0xa9, 0xb2, 0xf1, 0x8c, 0xff, 0x56, 0xd2, 0xed, 0xf5, 0xd5, 0x80, 0x72, 0xa0,
+    0x53, 0x26, 0xbd, 0x11, 0x25, 0x4e, 0x3a, 0xac, 0x1b, 0xc3, 0xe3, 0xc6, 0xe0, 0xd4, 0x60, 0x46,
+    0xb9, 0x38, 0x45, 0x22, 0xb6, 0x5a, 0xfe, 0x55, 0x95, 0x76, 0x29, 0x17, 0x57, 0xf7, 0x29, 0x41,
+    0x5f, 0x8d, 0xc7, 0xbe, 0xf3, 0xc7, 0xbd, 0xc1, 0x23, 0x84, 0x94, 0xe5, 0x45, 0xb3, 0xa2, 0xc0,
+    0xf1, 0xc4, 0x5f, 0x8d, 0x4d, 0x17, 0xf5, 0xbc, 0x9e, 0x35, 0x8c, 0x6a, 0x14, 0x88, 0x1b, 0x82,
+    0xb5, 0xb8, 0x71, 0xd3, 0x0c, 0xf1, 0x23, 0x51, 0x27, 0x66, 0xa0, 0x43, 0x4b, 0x19, 0xaa, 0xb0,
+    0xb3, 0x24, 0xba, 0xd3, 0xa5, 0x95, 0x39, 0xf2, 0x4c, 0xf8, 0xf4, 0x22, 0x90, 0x49, 0x1a, 0x16,
+    0xa2, 0xce, 0x33, 0xc5, 0xdf, 0xea, 0x00, 0x53, 0xff, 0x32, 0xc0, 0x54, 0x62, 0x20, 0xa4, 0x08,
+    0x93, 0x33, 0xb4, 0x06, 0x9e, 0xa0, 0x06, 0xc3, 0xe8, 0x68, 0xce, 0x91, 0xb7, 0xa2, 0x6a, 0x9b,
+    0x0a, 0xa3, 0x76, 0x02, 0x5f, 0xac, 0xfb, 0x99, 0x90, 0x03, 0x4f, 0xbe, 0x19, 0x8d, 0xcc, 0x7a,
+    0x5c, 0x3b, 0x0f, 0xf4, 0x69, 0x1c, 0x9c, 0xb4, 0x5a, 0xda, 0x01, 0x04, 0x8f, 0xc4, 0x79, 0xd0,
+    0x38, 0xd4, 0xc3, 0x92, 0x27, 0x80, 0xf8, 0x2a, 0xab, 0x0a, 0xd1, 0xb5, 0x06, 0xe6, 0xc4, 0xeb,
+    0xcd, 0x59, 0x0f, 0x2d, 0xed, 0x07, 0x53, 0x4e, 0xf7, 0x2d, 0x5d, 0x77, 0x5a, 0x6d, 0xfa, 0x01,
+    0x08, 0x0c, 0xe9, 0x3f, 0x58, 0x25, 0xb7, 0xce, 0x05, 0x62, 0xa4, 0xd5, 0xb7, 0x74, 0xf9, 0x69,
+    0x0a, 0x91, 0x2e, 0xc5, 0x0e, 0xeb, 0xb1, 0x4d, 0xbf, 0x12, 0xe9, 0x53, 0x31, 0xeb, 0xe6, 0x2a,
+    0x43, 0x4f, 0x14, 0x06, 0x77, 0xb6, 0xef, 0x3c, 0x3a, 0x3b, 0xec, 0x35, 0x71, 0x67, 0x9d, 0xc6,
+    0x94, 0x68, 0x6f, 0x32, 0x57, 0x64, 0x99, 0xcc, 0x9c, 0x72, 0x9b, 0xbd, 0x81, 0xae, 0xba, 0x36,
+    0x9b, 0x5a, 0xd2, 0xbe, 0xb7, 0x61, 0xb3, 0x32, 0x65, 0x74, 0x1f, 0x87, 0xa9, 0xbc, 0xdd, 0xb2,
+    0x33, 0x57, 0xef, 0xe7, 0x7b, 0x8b, 0xd9, 0x74, 0x57, 0x7f, 0xc1, 0x21, 0x83, 0x3d, 0x96, 0x03,
+    0xa8, 0x4f, 0x74, 0xdd, 0xad, 0x27, 0x09, 0xe6, 0x7d, 0x8c, 0x59, 0xfc, 0xcf, 0x42, 0x14, 0xc2,
+    0x77, 0x69, 0x42, 0x6d, 0x5b, 0x6d, 0xa6, 0x63, 0x1d, 0xe1, 0xeb, 0xd1, 0x40, 0xcc, 0x74, 0xcf,
+    0x04, 0x32, 0x0f, 0x2e, 0xb9, 0x5e, 0x62, 0xac, 0x2e, 0x6c, 0x91, 0x21, 0x46, 0x86, 0x12, 0x64,
+    0x3a, 0x5f, 0x20, 0x52, 0xb6, 0xf3, 0x39, 0x2f, 0xef, 0xd2, 0x08, 0xc1, 0x31, 0x47, 0xc7, 0x85,
+    0xeb, 0x62, 0x1b, 0x56, 0xc9, 0x2f, 0x72, 0x21, 0xb2, 0x63, 0x9e, 0x0b, 0x8d, 0x49, 0xf2, 0x04,
+    0xad, 0xfc, 0xf6, 0xed, 0x4d, 0xf7, 0xef, 0x97, 0xbd, 0xce, 0x4f, 0xbc, 0x13, 0x5c, 0x3d, 0xbc,
+    0x3b, 0x78, 0x44, 0x61, 0x4b, 0xd3, 0x15, 0x1b, 0x3c, 0x1c, 0x83, 0x81, 0xaa, 0x0f, 0x7f, 0x82,
+    0x82, 0xe3, 0xb9, 0x94, 0x39, 0x0d, 0xb4, 0xcd, 0x6c, 0x88, 0x0a, 0x11, 0xb2, 0x54, 0xff, 0x22,
+    0xa2, 0x39, 0x06, 0x5a, 0xc1, 0x08, 0xa9, 0x7f, 0x3b, 0xa2, 0x29, 0xcf, 0x7f, 0x9f, 0x7e, 0xf9,
+    0xa4, 0x54, 0xfa, 0x17, 0x01, 0x6f, 0x40, 0x1c, 0xe1, 0x96, 0x6e, 0xd3, 0xbb, 0xa0, 0x13, 0xae,
+    0xb8, 0x56, 0xd2, 0x77, 0xe1, 0x37, 0xd4, 0x33, 0xd0, 0xa1, 0x8c, 0x41, 0x56, 0x9b, 0x04, 0xe9,
+    0x8f, 0xba, 0xf0, 0xbe, 0x75, 0x0b, 0xdd, 0xb3, 0xc2, 0x61, 0x48, 0x9f, 0x33, 0xe4, 0xe0, 0xbc,
+    0x71, 0x2e, 0x9f, 0xb5, 0xc1, 0x34, 0xbb, 0xd4, 0x6f, 0x5b, 0xad, 0x53, 0x64, 0x71, 0x57, 0x37,
+    0x73, 0x28, 0xbe, 0x0d, 0x38, 0xfe, 0xb4, 0xd7, 0xeb, 0x75, 0xe1, 0x42, 0xc4, 0xc6, 0xc8, 0x69,
+    0x59, 0x3f, 0x58, 0x83, 0x47, 0x2d, 0x4f, 0x26, 0xf4, 0xbc, 0xb9, 0x31, 0xdb, 0x65, 0xdc, 0xba,
+    0xb9, 0x1e, 0xc3, 0x8d, 0x46, 0x07, 0xbd, 0xbd, 0xf7, 0xd6, 0xaf, 0xf4, 0xb2, 0x80, 0x6d, 0x9b,
+    0x3f, 0xb9, 0x56, 0xff, 0xd6, 0x85, 0x01, 0x29, 0x02, 0x8c, 0xb8, 0x00, 0x97, 0x5a, 0xa0, 0x06,
+    0xdc, 0xeb, 0x24, 0x96, 0x56, 0xe9, 0xf1, 0x19, 0xe0, 0x67, 0x37, 0x46, 0xfa, 0x91, 0x44, 0xda,
+    0x70, 0x6b, 0x33, 0xe0, 0x5b, 0xdb, 0x3a, 0x3f, 0x9b, 0x5c, 0x20, 0xfd, 0x75, 0x8d, 0x2a, 0xef,
+    0xcd, 0xa0, 0x6e, 0x64, 0xb5, 0x70, 0xd1, 0x56, 0x59, 0x21, 0xda, 0x96, 0x79, 0x62, 0xb5, 0x8d,
+    0xc8, 0x74, 0x51, 0x61, 0xcb, 0x19, 0xc0, 0x38, 0xda, 0x1e, 0x7f, 0x09, 0x5e, 0x33, 0x64, 0x78,
+    0x0d, 0x78, 0x79, 0xda, 0x00, 0x6f, 0x03, 0x91, 0xc6, 0xb4, 0x6a, 0xc8, 0xb0, 0x05, 0x74, 0x2b,
+    0xd3, 0x1c, 0x9b, 0x10, 0xe8, 0x98, 0x21, 0xe1, 0xbf, 0x04, 0x6d, 0x66, 0x04, 0xf4, 0x7b, 0xb1,
+    0xb6, 0x45, 0xf5, 0x7f, 0x29, 0xd6, 0x36, 0xcb, 0xf8, 0x1e, 0xec, 0x3c, 0xab, 0xe5, 0xf7, 0x62,
+    0xa7, 0x74, 0xd8, 0x53, 0x40, 0xa0, 0xae, 0x2e, 0xe7, 0x1c, 0xc3, 0x6e, 0xf9, 0x9b, 0xbf, 0xae,
+    0xf9, 0x31, 0xe9, 0xff, 0x01, 0x57, 0xf0, 0x0e, 0x99, 0x64, 0x2a, 0x00, 0x00,
+};
+
+// web/dashboard.html: 1616 bytes, 943 gzipped
+static const char DASHBOARD_PAGE_ETAG[] = "\"2785eab2070de0be\"";
+static const size_t DASHBOARD_PAGE_GZ_LEN = 943;
+static const uint8_t DASHBOARD_PAGE_GZ[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x55, 0x5d, 0x6f, 0xeb, 0x36,
+    0x0c, 0x7d, 0xcf, 0xaf, 0xe0, 0x52, 0x0c, 0xb2, 0x71, 0x1d, 0xbb, 0x2d, 0xd6, 0x01, 0x73, 0x62,
+    0x0f, 0x6d, 0xda, 0x02, 0x1d, 0x82, 0xdd, 0xe1, 0xa6, 0x17, 0xc3, 0x30, 0x0c, 0x85, 0x62, 0xd1,
+    0xb1, 0x56, 0xd9, 0x32, 0x24, 0x39, 0x69, 0xe6, 0xf5, 0xbf, 0x8f, 0xb2, 0xdd, 0xed, 0x76, 0xc0,
+    0x1e, 0xf6, 0x12, 0x53, 0xd4, 0xe1, 0x21, 0xc5, 0xaf, 0xac, 0xbe, 0xba, 0xfd, 0xb8, 0x7e, 0xfc,
+    0xe5, 0xa7, 0x3b, 0xa8, 0x5c, 0xad, 0xf2, 0xd9, 0xea, 0xed, 0x83, 0x5c, 0xd0, 0xc7, 0x49, 0xa7,
+    0x30, 0x5f, 0x2b, 0x5d, 0x3c, 0xc3, 0x2d, 0xb7, 0xd5, 0x4e, 0x73, 0x23, 0x56, 0xc9, 0xa8, 0x9e,
+    0xad, 0x6a, 0x74, 0x1c, 0x1a, 0x5e, 0x63, 0x36, 0x3f, 0x48, 0x3c, 0xb6, 0xda, 0xb8, 0x39, 0x14,
+    0xba, 0x71, 0xd8, 0xb8, 0x6c, 0x7e, 0x94, 0xc2, 0x55, 0x99, 0xc0, 0x83, 0x2c, 0x70, 0x31, 0x1c,
+    0x22, 0x90, 0x8d, 0x74, 0x92, 0xab, 0x85, 0x2d, 0xb8, 0xc2, 0xec, 0x62, 0x4e, 0x24, 0xd6, 0x9d,
+    0x3c, 0xd9, 0x4e, 0x8b, 0x53, 0x5f, 0x92, 0xed, 0xa2, 0xe4, 0xb5, 0x54, 0xa7, 0xf4, 0xda, 0x10,
+    0x30, 0xb2, 0xbc, 0xb1, 0x0b, 0x8b, 0x46, 0x96, 0xcb, 0x9a, 0x9b, 0xbd, 0x6c, 0xd2, 0xcb, 0xf3,
+    0xf6, 0x65, 0xf9, 0x3a, 0x73, 0x7c, 0xa7, 0xb0, 0xdf, 0x69, 0x23, 0xd0, 0x2c, 0x0a, 0xad, 0x14,
+    0x6f, 0x2d, 0xa6, 0x6f, 0xc2, 0x72, 0xf0, 0x97, 0x5e, 0x9c, 0x9f, 0x7f, 0xed, 0xb1, 0xa2, 0x6f,
+    0xb9, 0x10, 0xb2, 0xd9, 0xa7, 0xdf, 0x92, 0xf1, 0x64, 0xb4, 0xd3, 0xce, 0xe9, 0x3a, 0xbd, 0x68,
+    0x5f, 0xc0, 0x6a, 0x25, 0x05, 0x9c, 0x09, 0x21, 0x06, 0x74, 0x5a, 0x4a, 0x63, 0xdd, 0xa2, 0xa8,
+    0xa4, 0x12, 0x3d, 0x51, 0x6a, 0x93, 0x9e, 0x5d, 0x5d, 0x5d, 0x4d, 0xa4, 0xdf, 0x0c, 0x9c, 0x67,
+    0xd6, 0x71, 0x87, 0x63, 0xc4, 0x56, 0xfe, 0x81, 0xe9, 0x79, 0xfc, 0x1d, 0xd6, 0xcb, 0x2f, 0xd0,
+    0xaf, 0xb3, 0x55, 0x32, 0x3d, 0x6e, 0x95, 0x4c, 0x09, 0xf5, 0xaf, 0xf4, 0xe9, 0xbd, 0xcc, 0xef,
+    0x95, 0x6c, 0x61, 0xcc, 0xec, 0x46, 0x1e, 0x10, 0xb6, 0x44, 0xd7, 0x59, 0x02, 0x5e, 0xd2, 0x7d,
+    0x0b, 0x52, 0x64, 0x6c, 0xf0, 0xc0, 0xf2, 0xb5, 0x6e, 0x1a, 0x2c, 0x1c, 0x45, 0x1f, 0xc7, 0xf1,
+    0x2a, 0x69, 0x7d, 0x5d, 0xfc, 0xe3, 0x07, 0x8c, 0xd1, 0x47, 0xcb, 0x72, 0x2a, 0x89, 0xd7, 0x78,
+    0xcb, 0x7c, 0xc5, 0xa1, 0x32, 0x58, 0x66, 0x2c, 0xa1, 0x4a, 0x94, 0x72, 0xcf, 0xf2, 0x2d, 0x3a,
+    0x6f, 0x4d, 0xe4, 0x3c, 0x87, 0x3f, 0xe1, 0x1f, 0x00, 0x6f, 0x65, 0x62, 0x07, 0xbf, 0x2c, 0xbf,
+    0xef, 0x94, 0x82, 0xf1, 0x00, 0xc1, 0x0f, 0xdb, 0x8f, 0x3f, 0x86, 0x1e, 0x3e, 0xba, 0xb3, 0x85,
+    0x91, 0xad, 0xcb, 0x67, 0x49, 0x02, 0xf7, 0x86, 0xca, 0x6d, 0xa9, 0xc8, 0x35, 0x42, 0x69, 0x74,
+    0x0d, 0x09, 0x1e, 0xa8, 0xda, 0x64, 0x33, 0x1f, 0x8d, 0xe7, 0x30, 0x2a, 0x22, 0xd0, 0x0d, 0x82,
+    0xad, 0xb8, 0x41, 0x01, 0x9e, 0x8f, 0xe0, 0x64, 0x0a, 0x2d, 0x1a, 0xe8, 0x5a, 0x41, 0x2f, 0x0b,
+    0x67, 0x07, 0x6e, 0x60, 0x73, 0x7d, 0x73, 0xb7, 0xd9, 0x66, 0xbd, 0x4b, 0xd9, 0x98, 0x8d, 0xe0,
+    0xf3, 0xe3, 0x1a, 0xb0, 0xd5, 0x45, 0x15, 0xb2, 0xa8, 0x6b, 0x53, 0xf6, 0xb9, 0x75, 0x92, 0x0c,
+    0x03, 0x4b, 0x67, 0x4a, 0x23, 0x69, 0xee, 0x0d, 0x22, 0x78, 0x11, 0x82, 0xdd, 0xc9, 0xa1, 0xbf,
+    0x30, 0xd6, 0xca, 0x94, 0xfd, 0x2c, 0x17, 0xf7, 0x12, 0x3e, 0x6d, 0xb7, 0x0f, 0x10, 0x88, 0x9b,
+    0x9a, 0xf4, 0x47, 0xe4, 0xae, 0x42, 0x43, 0x57, 0xa3, 0xc0, 0x22, 0x87, 0x35, 0x51, 0x3c, 0xd2,
+    0x2f, 0x1a, 0x0a, 0xd8, 0x20, 0x8b, 0x66, 0xb0, 0x53, 0x29, 0xbb, 0xe1, 0xc5, 0xb3, 0x92, 0xfb,
+    0xca, 0xb1, 0x48, 0x69, 0xdd, 0x3e, 0xf1, 0xc3, 0xfe, 0xa9, 0xb3, 0x29, 0xdb, 0xd0, 0x01, 0x76,
+    0x9d, 0x3d, 0x01, 0x69, 0x20, 0xe8, 0xbc, 0xbb, 0x01, 0x50, 0xf3, 0x97, 0x7f, 0x01, 0x48, 0x33,
+    0x01, 0x9c, 0xee, 0x8a, 0x8a, 0xdc, 0xf8, 0x0f, 0xe5, 0x2b, 0xb0, 0x54, 0x00, 0x85, 0x89, 0xd0,
+    0x1d, 0xd5, 0x29, 0x51, 0xba, 0xd9, 0x27, 0xf6, 0x28, 0x5b, 0x0c, 0xbd, 0x77, 0xc5, 0xad, 0x7b,
+    0x9a, 0x2c, 0x36, 0x24, 0xc3, 0x20, 0x83, 0x3b, 0xb5, 0x14, 0x5c, 0xa1, 0xa4, 0xcf, 0x67, 0xca,
+    0xb6, 0xce, 0x20, 0xaf, 0x61, 0x3a, 0xb3, 0x88, 0xa6, 0x62, 0x70, 0x3f, 0x94, 0x04, 0xfc, 0x8c,
+    0x70, 0x45, 0x8d, 0x38, 0x05, 0x60, 0xb1, 0x11, 0x5f, 0x5c, 0x97, 0xbc, 0x59, 0xe8, 0xce, 0x8d,
+    0x97, 0xaf, 0xcb, 0x21, 0xf5, 0xbe, 0x77, 0x32, 0xa1, 0x8b, 0xae, 0x26, 0xc2, 0x78, 0x8f, 0xee,
+    0x4e, 0xa1, 0x17, 0x6f, 0x4e, 0x0f, 0x22, 0x18, 0x3b, 0x2b, 0x8c, 0x0a, 0x54, 0xca, 0x66, 0x3d,
+    0x99, 0x94, 0xda, 0x04, 0xde, 0xec, 0x99, 0xa6, 0x78, 0x2a, 0x5b, 0xd8, 0x0f, 0x3c, 0x99, 0xc7,
+    0xc6, 0xb2, 0xa1, 0x18, 0xdc, 0x27, 0x7d, 0x0c, 0xc2, 0xa5, 0x99, 0x4e, 0x6b, 0xb2, 0x0e, 0xc2,
+    0xd8, 0xe1, 0x8b, 0x5b, 0x4f, 0x7b, 0x61, 0xb4, 0xfc, 0xf5, 0xf9, 0xb7, 0xe5, 0x40, 0x4d, 0x42,
+    0xf6, 0x1e, 0x4d, 0x83, 0xe3, 0x59, 0xd1, 0x66, 0x0d, 0x1e, 0xe1, 0xce, 0x77, 0xd3, 0x56, 0x77,
+    0xa6, 0xc0, 0x80, 0x4d, 0xcd, 0xc6, 0xc2, 0xe5, 0x0c, 0x6d, 0x4c, 0x23, 0x3d, 0xdc, 0x6e, 0xa4,
+    0x25, 0x66, 0x34, 0x01, 0x9b, 0x9a, 0x39, 0x2a, 0xbb, 0x86, 0x06, 0x46, 0x37, 0x01, 0x86, 0xfd,
+    0x0c, 0x3c, 0x5b, 0x99, 0xf9, 0x1e, 0x8c, 0x5b, 0x6e, 0x2c, 0x06, 0x18, 0x53, 0xff, 0x71, 0x22,
+    0x81, 0x77, 0x6f, 0x2a, 0xc3, 0x5e, 0x96, 0xc1, 0x5b, 0x54, 0xe1, 0x9b, 0xf0, 0x2e, 0xfa, 0x6b,
+    0x63, 0xf8, 0x29, 0x96, 0x76, 0xf8, 0x06, 0xa5, 0xc7, 0x7d, 0xef, 0x7f, 0xe3, 0xdf, 0xb5, 0x6c,
+    0x02, 0x06, 0x09, 0xb0, 0x30, 0xf5, 0x0a, 0x7a, 0x05, 0xfc, 0x67, 0x6e, 0xc7, 0xc9, 0x7e, 0x9f,
+    0x17, 0xe6, 0xd7, 0x40, 0x34, 0x4d, 0x09, 0xfb, 0x80, 0xb1, 0xef, 0x8a, 0xe1, 0x7d, 0x0f, 0xe2,
+    0x03, 0x03, 0xee, 0x48, 0xe9, 0x13, 0x72, 0x4b, 0xa6, 0x3e, 0xa5, 0x7a, 0xa3, 0xfd, 0x12, 0x7d,
+    0xa4, 0xd9, 0xa0, 0xce, 0xa0, 0xf6, 0xa2, 0xcc, 0xcd, 0x5e, 0xc7, 0xcc, 0xd0, 0xe8, 0x19, 0xa3,
+    0x4d, 0xf6, 0x77, 0x1e, 0xc2, 0xfe, 0xff, 0xc5, 0x72, 0x2b, 0x6d, 0x31, 0xae, 0x1d, 0x14, 0x11,
+    0x18, 0x74, 0xe6, 0x34, 0xee, 0x1f, 0xb6, 0xa4, 0x4e, 0xa0, 0xbd, 0x36, 0x6d, 0x84, 0x55, 0x32,
+    0x6d, 0xb4, 0x64, 0xfc, 0xe3, 0xf8, 0x0b, 0x6e, 0xdb, 0x34, 0xb7, 0x50, 0x06, 0x00, 0x00,
+};
+
+// web/setup.html: 3812 bytes, 1664 gzipped
+static const char SETUP_PAGE_ETAG[] = "\"f442bfb01e6449c9\"";
+static const size_t SETUP_PAGE_GZ_LEN = 1664;
+static const uint8_t SETUP_PAGE_GZ[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x57, 0x6d, 0x6f, 0xdb, 0x36,
+    0x10, 0xfe, 0xee, 0x5f, 0xc1, 0xb6, 0x18, 0x28, 0x21, 0xb6, 0xe4, 0x24, 0xed, 0xb0, 0xd9, 0x96,
+    0x8b, 0x34, 0x49, 0xb7, 0x60, 0x7d, 0x09, 0x96, 0x0c, 0xc3, 0x5e, 0x8a, 0x81, 0x96, 0xce, 0x36,
+    0x1b, 0x89, 0x14, 0x48, 0xda, 0x89, 0x93, 0xe6, 0xbf, 0xef, 0x8e, 0xa2, 0x1c, 0xa5, 0x4d, 0xd6,
+    0x62, 0x1f, 0xe2, 0x48, 0xe4, 0xf1, 0x9e, 0xbb, 0xe7, 0xde, 0xa8, 0xc9, 0x93, 0xa3, 0xf7, 0x87,
+    0xe7, 0x7f, 0x9c, 0x1e, 0xb3, 0xa5, 0xab, 0xca, 0x69, 0x6f, 0xd2, 0xfe, 0x03, 0x51, 0xe0, 0x3f,
+    0x27, 0x5d, 0x09, 0xd3, 0xc3, 0x52, 0xe7, 0x17, 0xec, 0x0c, 0xdc, 0xaa, 0x9e, 0xa4, 0xcd, 0x52,
+    0x6f, 0x52, 0x81, 0x13, 0x4c, 0x89, 0x0a, 0xb2, 0xa7, 0x6b, 0x09, 0x97, 0xb5, 0x36, 0xee, 0x29,
+    0xcb, 0xb5, 0x72, 0xa0, 0x5c, 0xf6, 0xf4, 0x52, 0x16, 0x6e, 0x99, 0x15, 0xb0, 0x96, 0x39, 0x0c,
+    0xfc, 0x4b, 0x9f, 0x49, 0x25, 0x9d, 0x14, 0xe5, 0xc0, 0xe6, 0xa2, 0x84, 0x6c, 0xf7, 0x29, 0x2a,
+    0xb1, 0x6e, 0x43, 0xca, 0x66, 0xba, 0xd8, 0xdc, 0xcc, 0xf1, 0xec, 0x60, 0x2e, 0x2a, 0x59, 0x6e,
+    0x46, 0x07, 0x06, 0x05, 0xfb, 0x56, 0x28, 0x3b, 0xb0, 0x60, 0xe4, 0x7c, 0x5c, 0x09, 0xb3, 0x90,
+    0x6a, 0xb4, 0x37, 0xac, 0xaf, 0xc6, 0xb7, 0x3d, 0xa9, 0xea, 0x95, 0xfb, 0xcb, 0x6d, 0x6a, 0xc8,
+    0x1c, 0x5c, 0xb9, 0x0f, 0xfd, 0xce, 0x42, 0x2d, 0xac, 0xbd, 0xd4, 0xa6, 0xf8, 0xd0, 0xb7, 0x50,
+    0x42, 0xee, 0x6e, 0x3c, 0xfa, 0x68, 0x77, 0x38, 0xfc, 0x6e, 0x5c, 0x8b, 0xa2, 0x90, 0x6a, 0x81,
+    0x2f, 0xa8, 0x26, 0xa8, 0xfc, 0xa1, 0xbe, 0x62, 0xc3, 0xf1, 0x4c, 0x5f, 0x0d, 0xac, 0xbc, 0xa6,
+    0xcd, 0x19, 0x1e, 0x06, 0x33, 0xc0, 0x95, 0xfb, 0x48, 0x76, 0x35, 0xab, 0xa4, 0xfb, 0x70, 0x33,
+    0x13, 0xf9, 0xc5, 0xc2, 0xe8, 0x95, 0x2a, 0x06, 0xb9, 0x2e, 0xb5, 0x19, 0x3d, 0x7b, 0x7e, 0x78,
+    0xf0, 0xfa, 0xc5, 0x70, 0xdc, 0xbc, 0x5d, 0x2e, 0xa5, 0x83, 0x3b, 0xa4, 0xe7, 0xa8, 0x7e, 0xef,
+    0x01, 0x38, 0xc2, 0x18, 0x29, 0xad, 0x60, 0x9c, 0xaf, 0x8c, 0xc5, 0x73, 0xb5, 0x96, 0xc8, 0x9d,
+    0x19, 0x77, 0xcc, 0xbd, 0xed, 0x25, 0x4a, 0x3b, 0x68, 0x98, 0x41, 0xeb, 0x60, 0x34, 0x4c, 0x7e,
+    0x84, 0x2a, 0x00, 0x3d, 0x7b, 0xf1, 0xe2, 0x05, 0x8a, 0x4c, 0xd2, 0x40, 0xe2, 0x24, 0x0d, 0x41,
+    0x23, 0x36, 0x29, 0x84, 0x7b, 0xd3, 0xd7, 0xa5, 0xac, 0xd9, 0xbd, 0xe8, 0xe1, 0x62, 0x6f, 0x52,
+    0x33, 0x59, 0x64, 0xdc, 0x3a, 0xe1, 0x80, 0xb3, 0xbc, 0x44, 0xc2, 0x32, 0x4e, 0x40, 0x7c, 0xfa,
+    0x46, 0x0b, 0x32, 0x3b, 0x49, 0x92, 0x49, 0x5a, 0xa3, 0xe4, 0x5c, 0x9b, 0xaa, 0x11, 0xa6, 0xe3,
+    0x9c, 0xb4, 0xee, 0x4f, 0x7f, 0x97, 0x83, 0xd7, 0x12, 0x55, 0xed, 0xe3, 0x6b, 0x29, 0x66, 0x50,
+    0x32, 0x14, 0x43, 0x0d, 0xe0, 0xf8, 0xf4, 0x1d, 0x38, 0x24, 0xff, 0xc2, 0x62, 0xb0, 0x99, 0x11,
+    0x6a, 0x01, 0x2c, 0x9a, 0x08, 0xb6, 0x34, 0x30, 0xcf, 0xf8, 0x33, 0xee, 0x55, 0x19, 0xc0, 0x04,
+    0x50, 0x7c, 0x4a, 0xbf, 0x4c, 0x2c, 0x84, 0x54, 0x93, 0x54, 0x4c, 0xe3, 0xd1, 0x24, 0xf5, 0xca,
+    0x28, 0x2b, 0x7c, 0xe0, 0xbc, 0xb0, 0x57, 0x3a, 0xd1, 0xb5, 0x93, 0x5a, 0xb1, 0xb5, 0x28, 0x57,
+    0x90, 0x71, 0x3e, 0x3d, 0xc3, 0xa3, 0xaa, 0xb5, 0xb3, 0xd9, 0x9c, 0x22, 0x0f, 0xfe, 0xd8, 0x74,
+    0x32, 0x33, 0xf7, 0x0d, 0xb3, 0x56, 0x16, 0x5b, 0xcb, 0xd8, 0x3b, 0x4c, 0x59, 0x16, 0x9d, 0x9d,
+    0x9d, 0x1c, 0x75, 0x21, 0x7d, 0x9c, 0x99, 0x8f, 0x33, 0xa7, 0x94, 0x6a, 0x4c, 0xf5, 0x27, 0x9b,
+    0x24, 0x0f, 0xcf, 0x95, 0xb8, 0x2a, 0x41, 0x2d, 0x30, 0xb7, 0xf9, 0xfe, 0x2e, 0xff, 0x12, 0x8b,
+    0xb2, 0x8f, 0x4f, 0x4f, 0x43, 0x0e, 0x3e, 0x02, 0xd0, 0xa6, 0x68, 0x03, 0xe2, 0x8f, 0x04, 0x90,
+    0xe6, 0xb9, 0x03, 0xf2, 0xfd, 0x7e, 0x0b, 0x42, 0xc4, 0x83, 0x70, 0x4b, 0x30, 0x4c, 0xa8, 0x82,
+    0x9d, 0xcb, 0x0a, 0x42, 0x0c, 0xea, 0xfb, 0x31, 0x7c, 0xef, 0xf9, 0x10, 0xe5, 0x88, 0xcd, 0x4a,
+    0xa1, 0x2e, 0xd8, 0x5c, 0x42, 0x59, 0x58, 0x76, 0x01, 0x50, 0x33, 0x3c, 0x2e, 0x0d, 0xc3, 0x8c,
+    0x33, 0x58, 0xa5, 0x0d, 0x9f, 0x09, 0x3b, 0x5e, 0x83, 0xd9, 0xb8, 0x25, 0xf2, 0xc9, 0xa0, 0xb4,
+    0xc0, 0xa4, 0x65, 0x48, 0x36, 0x8a, 0xb2, 0x6d, 0xe8, 0x52, 0x2c, 0xec, 0xb9, 0x5c, 0x60, 0xd0,
+    0xc0, 0x39, 0x14, 0xb4, 0xac, 0x16, 0x0b, 0xa0, 0xb8, 0x85, 0x44, 0xe9, 0x50, 0x20, 0x6a, 0x79,
+    0x01, 0x1b, 0xb2, 0x03, 0x54, 0xb0, 0xf8, 0xad, 0xa8, 0xd9, 0xc1, 0xe9, 0x09, 0xfb, 0x05, 0x36,
+    0x5f, 0xe5, 0x3c, 0x1c, 0x0f, 0x84, 0xb4, 0x6f, 0x5d, 0xde, 0x7f, 0x7c, 0x80, 0xf7, 0x5c, 0x3a,
+    0x84, 0x3c, 0xc4, 0xdf, 0x10, 0x60, 0x48, 0x16, 0x49, 0x9f, 0xbd, 0xd1, 0xaa, 0xd0, 0xea, 0xeb,
+    0x81, 0xf6, 0xc7, 0x03, 0x64, 0xf3, 0xfc, 0x55, 0x40, 0x6c, 0x00, 0xce, 0x10, 0x66, 0xf3, 0xc0,
+    0x0e, 0x75, 0xb1, 0x85, 0xfd, 0xe9, 0xd5, 0x37, 0x40, 0x06, 0x05, 0x2d, 0x6a, 0xfb, 0xda, 0x05,
+    0x7e, 0xc4, 0xd1, 0x7f, 0x28, 0x9f, 0xbd, 0xaf, 0x27, 0x47, 0x2c, 0x92, 0x73, 0x86, 0x51, 0xe9,
+    0x33, 0x5a, 0x48, 0x5b, 0x6b, 0x84, 0xc1, 0x38, 0x2e, 0x94, 0x36, 0x50, 0x7c, 0x9b, 0xf7, 0xff,
+    0xdc, 0x65, 0xfa, 0xf6, 0xb5, 0x63, 0xca, 0xee, 0x43, 0xc9, 0xee, 0xae, 0xf9, 0x94, 0xf2, 0x90,
+    0xfd, 0x89, 0x7d, 0xec, 0xe1, 0xfa, 0x45, 0x91, 0xa0, 0x95, 0x84, 0xbf, 0x28, 0xe4, 0x68, 0xa5,
+    0xf2, 0x25, 0xb5, 0x89, 0x22, 0xfe, 0x86, 0x42, 0x76, 0x88, 0x35, 0xaf, 0x5c, 0x00, 0x7d, 0x8d,
+    0xbd, 0x49, 0xb8, 0x47, 0x60, 0x83, 0x64, 0x8b, 0xdd, 0x1e, 0xfc, 0x36, 0x03, 0xee, 0x0b, 0x0d,
+    0xf9, 0x74, 0x77, 0x6f, 0xf0, 0xb3, 0x5e, 0x19, 0x16, 0x1d, 0xbc, 0x4d, 0x4f, 0xdf, 0x3e, 0x2a,
+    0x89, 0x1c, 0xed, 0x3d, 0xf7, 0x92, 0x8f, 0x39, 0xd3, 0xe5, 0xbf, 0x99, 0x27, 0xbc, 0x3d, 0x7c,
+    0xa8, 0x95, 0x42, 0x41, 0xea, 0xb1, 0x29, 0xb5, 0x5d, 0x72, 0x28, 0x37, 0xb2, 0x76, 0xd3, 0x5e,
+    0x9a, 0xb2, 0x73, 0xac, 0xc6, 0xdc, 0x37, 0x72, 0xaa, 0x63, 0xcb, 0xcc, 0xca, 0x37, 0x40, 0x86,
+    0xd3, 0xa6, 0x04, 0xac, 0x55, 0xd9, 0x54, 0xa4, 0xaf, 0x5d, 0xac, 0xbb, 0x11, 0x4b, 0xb1, 0x72,
+    0x52, 0x1a, 0xca, 0xa2, 0x64, 0x06, 0xe8, 0xc1, 0x52, 0x49, 0x93, 0xae, 0xbc, 0x41, 0x22, 0xc3,
+    0xfd, 0x0c, 0xf0, 0xfd, 0x84, 0xca, 0x5d, 0x85, 0x16, 0x59, 0x4a, 0xeb, 0xfc, 0x42, 0x83, 0x48,
+    0x8d, 0x5a, 0x41, 0x41, 0x2d, 0x9d, 0x16, 0xef, 0xe6, 0x5f, 0xd2, 0x5b, 0x0b, 0xc3, 0xce, 0xce,
+    0x0f, 0xce, 0x8f, 0xcf, 0xb2, 0x1b, 0x8f, 0xcb, 0x7f, 0x17, 0x92, 0x1a, 0x04, 0x05, 0x8c, 0xf9,
+    0x41, 0xc1, 0x0a, 0xbc, 0x28, 0xc8, 0xd2, 0x26, 0xbc, 0xdf, 0x02, 0xe3, 0x5c, 0x6c, 0xdd, 0x25,
+    0x51, 0xa7, 0xd9, 0x76, 0x0f, 0x8a, 0xed, 0x16, 0x22, 0xfa, 0x1d, 0x3d, 0x9f, 0x8f, 0xb8, 0x1f,
+    0x5f, 0xd8, 0xca, 0x94, 0xb4, 0x4b, 0x28, 0x12, 0x7e, 0x3b, 0xf6, 0xd8, 0x76, 0xa9, 0x2f, 0x15,
+    0xc6, 0x71, 0xdc, 0x9b, 0x63, 0x20, 0xbd, 0x4b, 0x50, 0x46, 0xb2, 0x88, 0x6f, 0x0c, 0x1e, 0x30,
+    0x8a, 0x15, 0x3a, 0x5f, 0x55, 0xd8, 0xeb, 0x92, 0x05, 0xb8, 0xe3, 0x12, 0xe8, 0xf1, 0xd5, 0xe6,
+    0xa4, 0x20, 0x11, 0x9c, 0x9d, 0xdb, 0x43, 0xb5, 0x2e, 0xcb, 0x28, 0xbe, 0xe9, 0xb1, 0x39, 0xb8,
+    0x7c, 0x19, 0xf1, 0x0e, 0x7b, 0x3c, 0x4e, 0xd0, 0x6b, 0x15, 0xb5, 0xb2, 0x91, 0xd9, 0x2a, 0x37,
+    0xc9, 0x47, 0x8b, 0x0b, 0xa8, 0xe9, 0x73, 0x99, 0x9a, 0x74, 0x31, 0x6f, 0x61, 0xd6, 0xf0, 0xf3,
+    0x57, 0x9d, 0x78, 0xb2, 0x3f, 0x7c, 0xfa, 0x14, 0x9e, 0xc6, 0x28, 0x21, 0xe7, 0x51, 0x78, 0xcb,
+    0xa8, 0x05, 0xb4, 0x94, 0xf0, 0xd8, 0xee, 0x64, 0xb8, 0x81, 0x23, 0x67, 0x87, 0xe3, 0x90, 0xe3,
+    0x8f, 0xc9, 0x42, 0x71, 0x5f, 0xb4, 0x93, 0x27, 0x98, 0x09, 0x4a, 0x5f, 0x32, 0xe1, 0xf0, 0x66,
+    0xe7, 0xea, 0x51, 0x9a, 0xf2, 0x9d, 0x3a, 0x91, 0xf5, 0x0e, 0x4f, 0x9b, 0xee, 0x8e, 0x1b, 0x21,
+    0xde, 0x1d, 0xf5, 0x60, 0x8c, 0x36, 0xa4, 0x91, 0xb3, 0x37, 0x02, 0x93, 0x40, 0x38, 0x07, 0x55,
+    0xed, 0x46, 0x8c, 0x0e, 0xfb, 0x4d, 0x04, 0xf1, 0xe2, 0x48, 0x73, 0xb8, 0x41, 0xa0, 0xef, 0xd8,
+    0x49, 0x0e, 0xc3, 0xcd, 0xcf, 0x8e, 0x83, 0xe3, 0x54, 0x79, 0x16, 0x2d, 0x0b, 0x20, 0x36, 0xa9,
+    0x44, 0x7d, 0x47, 0x90, 0xda, 0x92, 0xa8, 0xbc, 0xed, 0x44, 0xe1, 0x47, 0xbc, 0x01, 0x45, 0xfc,
+    0x6f, 0xc5, 0xe3, 0x60, 0x8f, 0x57, 0xf1, 0x24, 0xf3, 0x41, 0xf6, 0x84, 0x86, 0x78, 0xfb, 0x75,
+    0x92, 0x69, 0x80, 0xc0, 0x65, 0x64, 0x0d, 0x5d, 0x15, 0xe2, 0x31, 0xfe, 0x26, 0xa1, 0x69, 0x0d,
+    0xbd, 0x08, 0x2d, 0xe0, 0x65, 0x2c, 0x52, 0x70, 0xc9, 0x9a, 0xd1, 0x18, 0x75, 0x8c, 0x6a, 0x44,
+    0x5f, 0xf2, 0xc3, 0xa5, 0xd6, 0x38, 0xfa, 0x44, 0xcb, 0x09, 0x1f, 0x11, 0xd9, 0xe1, 0x9a, 0xf1,
+    0x92, 0x77, 0x2e, 0x1c, 0x7c, 0xc4, 0xdf, 0xe9, 0x56, 0xcc, 0x62, 0x9e, 0x63, 0x21, 0xf0, 0xb8,
+    0xcf, 0x79, 0xec, 0xcd, 0x66, 0x1d, 0xe5, 0x58, 0x03, 0xc7, 0x02, 0xd3, 0xa9, 0xeb, 0xf5, 0x03,
+    0xe6, 0xa8, 0x10, 0x3d, 0x16, 0xf1, 0x1d, 0x95, 0x18, 0x7c, 0xc1, 0xe7, 0xe2, 0x55, 0xc5, 0x77,
+    0x70, 0x8b, 0xaa, 0xea, 0x25, 0xef, 0xfb, 0xaa, 0x46, 0x68, 0x1e, 0xef, 0xf0, 0x98, 0xf7, 0x9b,
+    0x23, 0x31, 0x65, 0x1e, 0x81, 0xde, 0xf6, 0x18, 0xf2, 0x97, 0x0b, 0xd7, 0x05, 0x8b, 0x6f, 0x1e,
+    0x8b, 0x11, 0x6f, 0xae, 0x84, 0x78, 0x5d, 0xc0, 0xd6, 0x80, 0x06, 0x8a, 0x19, 0xf6, 0x90, 0x48,
+    0x3a, 0x6c, 0xf8, 0x1b, 0xb6, 0x14, 0x6b, 0x60, 0x25, 0xcc, 0x1d, 0xf3, 0x77, 0x3e, 0x56, 0xe1,
+    0x5c, 0x8b, 0x31, 0xe6, 0x84, 0x74, 0xdb, 0xdb, 0x12, 0x9d, 0xe8, 0xd0, 0x38, 0xb3, 0x0e, 0x20,
+    0xc6, 0x8c, 0x5a, 0x51, 0xe2, 0x5b, 0x5a, 0xec, 0xe1, 0xe9, 0xd6, 0x14, 0x37, 0x0b, 0xd9, 0xdd,
+    0xde, 0x18, 0xeb, 0x97, 0xb6, 0xc3, 0x5d, 0xd0, 0x6b, 0x2b, 0x65, 0x7e, 0x71, 0xa7, 0x0c, 0xd6,
+    0x68, 0xff, 0x3a, 0xa9, 0x0d, 0xac, 0xd1, 0xe4, 0x23, 0x98, 0x8b, 0x55, 0xe9, 0xb0, 0xd4, 0xbe,
+    0x2c, 0xd0, 0x97, 0xa4, 0x22, 0xdb, 0x6d, 0xeb, 0x94, 0x4a, 0x39, 0x26, 0xfd, 0x5d, 0x49, 0x1a,
+    0x00, 0xd7, 0x38, 0xa4, 0xec, 0xff, 0xaa, 0xe6, 0x6b, 0x4a, 0xbe, 0xeb, 0x07, 0xc3, 0x49, 0x4e,
+    0xe0, 0x64, 0x8b, 0xbf, 0x88, 0x69, 0x5f, 0x85, 0xe8, 0xd0, 0x9f, 0x67, 0xc2, 0xdf, 0xa0, 0xc9,
+    0xd3, 0xa6, 0xf1, 0xdf, 0x77, 0xb5, 0xc7, 0x1e, 0x72, 0xb6, 0x47, 0x55, 0xf0, 0xe4, 0x73, 0x1e,
+    0xff, 0x2b, 0xb0, 0x4d, 0x1a, 0x63, 0xef, 0xa5, 0x19, 0x73, 0x97, 0xce, 0xbe, 0x1a, 0xb1, 0x7d,
+    0x1a, 0xeb, 0x30, 0x94, 0x8d, 0xc3, 0xd8, 0xff, 0xb6, 0xed, 0xae, 0x31, 0xae, 0x7f, 0x83, 0x1f,
+    0x75, 0x4b, 0x8d, 0x2d, 0xf8, 0xf4, 0xfd, 0xd9, 0x39, 0xef, 0xd3, 0x87, 0xc4, 0x88, 0x9c, 0xfa,
+    0xed, 0xd7, 0x37, 0x67, 0x20, 0x4c, 0xbe, 0x3c, 0x15, 0x46, 0x54, 0xd6, 0x3b, 0x4a, 0xe3, 0xf7,
+    0x48, 0x38, 0x11, 0x75, 0x9c, 0x8b, 0xe3, 0xdb, 0xb8, 0xc7, 0xfe, 0x83, 0x61, 0x32, 0xf6, 0x21,
+    0x86, 0xdd, 0xe3, 0x3e, 0xb9, 0x86, 0xc5, 0x71, 0xaf, 0xe9, 0xd1, 0x63, 0x84, 0x3a, 0xa1, 0x0f,
+    0x25, 0xa4, 0xc2, 0xc7, 0xba, 0xbf, 0x3f, 0x1c, 0x0e, 0x51, 0x02, 0x27, 0x6d, 0x18, 0x97, 0x93,
+    0x34, 0x7c, 0x01, 0xa5, 0xcd, 0xc7, 0xec, 0xbf, 0xd0, 0x4d, 0x6d, 0x04, 0xe4, 0x0e, 0x00, 0x00,
+};
+
+#endif // WEBUIASSETS_H
@@ -0,0 +1,425 @@
+#include "WifiConnect.h"    // Header for this module
+#include "ConfigHandler.h"  // userConfig (networks, static IP) and the shared Preferences object
+#include "config.h"         // WIFI_* timeouts and roaming thresholds
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <time.h>
+
+#define WIFI_CACHE_KEY "wificache"
+
+// --- CONSTANTS ---
+static const uint32_t WIFI_CACHE_MAGIC = 0x57434331; // "WCC1"
+static const uint8_t WIFI_CREDENTIAL_COUNT = 1 + WIFI_EXTRA_NETWORKS; // Primary first
+static const uint8_t WIFI_MAX_CANDIDATES = 6;
+static const char* const PATH_NAMES[] = { "none", "directed", "scan", "plain" };
+
+/**
+ * @brief A known network seen in the last scan: one entry per access point.
+ */
+typedef struct {
+    uint8_t credential;      // Index into the known networks (0 = primary)
+    uint8_t bssid[6];
+    uint8_t channel;
+    int8_t rssi;
+} WifiCandidate;
+
+// --- STATE ---
+// RTC memory: a wake from deep sleep connects without touching NVS
+RTC_DATA_ATTR static WifiCache cache = {};
+static WifiCache stored = {};            // Last copy written to NVS (BSSID and channel only)
+static bool storedLoaded = false;
+static unsigned long leaseMs = 0;        // millis() when the current lease was obtained
+static bool dhcpRestarted = false;       // Left a cached lease for DHCP; the new lease is stored once bound
+static WifiConnectStats stats = {};
+
+// Known networks from the last scan, strongest first
+static WifiCandidate candidates[WIFI_MAX_CANDIDATES];
+static uint8_t candidateCount = 0;
+static unsigned long scanMs = 0;
+static bool scanValid = false;
+static bool scanRunning = false;         // Background scan (roaming)
+
+// Roaming (loop)
+static unsigned long lastRoamCheckMs = 0;
+static unsigned long lostSinceMs = 0;    // 0 = connected
+static bool roamPending = false;
+static unsigned long roamStartMs = 0;
+static int8_t roamCredential = -1;
+
+
+static bool clockValid() {
+    return time(nullptr) > 1600000000;
+}
+
+static const char* credentialSsid(uint8_t index) {
+    return index == 0 ? userConfig.ssid : userConfig.extra_networks[index - 1].ssid;
+}
+
+static const char* credentialPassword(uint8_t index) {
+    return index == 0 ? userConfig.password : userConfig.extra_networks[index - 1].password;
+}
+
+/**
+ * @brief Index of a known network by name, -1 if it is not in the list.
+ */
+static int8_t findCredential(const char* ssid) {
+    if (ssid[0] == '\0') return -1;
+    for (uint8_t i = 0; i < WIFI_CREDENTIAL_COUNT; i++) {
+        if (strncmp(credentialSsid(i), ssid, sizeof(userConfig.ssid)) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief After power-on the RTC copy is gone: fall back to the NVS one.
+ */
+static void loadCache() {
+    if (!storedLoaded) {
+        preferences.begin(PREF_NAMESPACE, true);
+        size_t bytesRead = preferences.getBytes(WIFI_CACHE_KEY, &stored, sizeof(stored));
+        preferences.end();
+        if (bytesRead != sizeof(stored) || stored.magic != WIFI_CACHE_MAGIC) memset(&stored, 0, sizeof(stored));
+        storedLoaded = true;
+    }
+    if (cache.magic != WIFI_CACHE_MAGIC && stored.magic == WIFI_CACHE_MAGIC) {
+        cache = stored; // No lease in the NVS copy
+    }
+}
+
+/**
+ * @brief A cached lease is only reused while the clock can tell it is recent.
+ */
+static bool leaseUsable() {
+    if (cache.ip == 0 || cache.lease_epoch == 0 || !clockValid()) return false;
+    uint32_t age = (uint32_t)time(nullptr) - cache.lease_epoch;
+    return age < WIFI_LEASE_REUSE_S;
+}
+
+/**
+ * @brief Static addresses from the settings (primary network only). An address
+ * without a valid gateway is ignored.
+ */
+static bool staticAddresses(IPAddress& ip, IPAddress& gateway, IPAddress& subnet, IPAddress& dns) {
+    if (userConfig.static_ip[0] == '\0' || !ip.fromString(userConfig.static_ip)) return false;
+    if (!gateway.fromString(userConfig.static_gateway)) {
+        Serial.println("Wi-Fi: static IP set without a valid gateway, using DHCP.");
+        return false;
+    }
+    if (!subnet.fromString(userConfig.static_subnet)) subnet = IPAddress(255, 255, 255, 0);
+    if (!dns.fromString(userConfig.static_dns)) dns = gateway;
+    return true;
+}
+
+/**
+ * @brief Sets the addresses for joining 'credential': static (primary only), the
+ * cached lease when allowed, otherwise DHCP. Records which one in stats.
+ */
+static void prepareAddresses(uint8_t credential, bool allowLease) {
+    IPAddress ip, gateway, subnet, dns;
+    stats.static_ip = credential == 0 && staticAddresses(ip, gateway, subnet, dns);
+    stats.cached_lease = !stats.static_ip && allowLease && leaseUsable();
+    if (stats.static_ip) {
+        WiFi.config(ip, gateway, subnet, dns);
+    } else if (stats.cached_lease) {
+        WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway), IPAddress(cache.subnet), IPAddress(cache.dns));
+    } else {
+        WiFi.config(IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0)); // DHCP
+    }
+}
+
+static bool waitConnected(unsigned long timeoutMs, bool giveUpOnFailure) {
+    unsigned long start = millis();
+    while (millis() - start < timeoutMs) {
+        wl_status_t status = WiFi.status();
+        if (status == WL_CONNECTED) return true;
+        // A directed attempt that cannot find the BSSID says so quickly: move on
+        if (giveUpOnFailure && (status == WL_NO_SSID_AVAIL || status == WL_CONNECT_FAILED)) return false;
+        delay(20);
+    }
+    return WiFi.status() == WL_CONNECTED;
+}
+
+/**
+ * @brief Keeps the known networks of a finished scan, strongest access point first.
+ */
+static void rankScan(int16_t found) {
+    candidateCount = 0;
+    for (int16_t i = 0; i < found; i++) {
+        int8_t credential = findCredential(WiFi.SSID(i).c_str());
+        if (credential < 0) continue;
+        WifiCandidate entry;
+        entry.credential = credential;
+        memcpy(entry.bssid, WiFi.BSSID(i), sizeof(entry.bssid));
+        entry.channel = WiFi.channel(i);
+        entry.rssi = WiFi.RSSI(i);
+        uint8_t slot = candidateCount;
+        if (slot == WIFI_MAX_CANDIDATES) {
+            if (entry.rssi <= candidates[slot - 1].rssi) continue;
+            slot--; // Replaces the weakest
+        } else {
+            candidateCount++;
+        }
+        for (; slot > 0 && candidates[slot - 1].rssi < entry.rssi; slot--) candidates[slot] = candidates[slot - 1];
+        candidates[slot] = entry;
+    }
+    scanMs = millis();
+    scanValid = true;
+    Serial.printf("Wi-Fi: scan saw %d networks, %u known access points:", found, candidateCount);
+    for (uint8_t i = 0; i < candidateCount; i++) {
+        Serial.printf(" '%s' ch %u %d dBm;", credentialSsid(candidates[i].credential), candidates[i].channel, candidates[i].rssi);
+    }
+    Serial.println();
+}
+
+static void noteConnected(WifiConnectPath path, unsigned long start, int8_t rssi) {
+    stats.path = path;
+    stats.connect_ms = millis() - start;
+    stats.rssi = rssi;
+    strncpy(stats.ssid, WiFi.SSID().c_str(), sizeof(stats.ssid) - 1);
+    Serial.printf("Wi-Fi: connected to '%s' (%d dBm, ch %d) in %lu ms: %s path, %u attempt(s), %lu ms scanning, %s.\n",
+                  stats.ssid, rssi, (int)WiFi.channel(), (unsigned long)stats.connect_ms, PATH_NAMES[path], stats.attempts,
+                  (unsigned long)stats.scan_ms, stats.static_ip ? "static IP" : stats.cached_lease ? "cached lease" : "DHCP");
+    wifiCacheStore();
+}
+
+bool wifiConnect() {
+    unsigned long start = millis();
+    uint16_t roams = stats.roams;
+    uint32_t roamMs = stats.roam_ms;
+    memset(&stats, 0, sizeof(stats));
+    stats.roams = roams;
+    stats.roam_ms = roamMs;
+    WiFi.persistent(false); // Credentials live in userConfig: no SDK flash write on every begin()
+    WiFi.mode(WIFI_STA);
+    loadCache();
+
+    // 1. The last good access point, if it is still a known network: no scan
+    int8_t cached = (cache.magic == WIFI_CACHE_MAGIC && cache.channel >= 1 && cache.channel <= 14) ? findCredential(cache.ssid) : -1;
+    if (cached >= 0) {
+        prepareAddresses(cached, true);
+        stats.attempts++;
+        WiFi.begin(credentialSsid(cached), credentialPassword(cached), cache.channel, cache.bssid);
+        if (waitConnected(WIFI_DIRECTED_TIMEOUT_MS, true)) {
+            noteConnected(WIFI_PATH_DIRECTED, start, WiFi.RSSI());
+            return true;
+        }
+        stats.directed_fail_ms = millis() - start;
+        Serial.printf("Wi-Fi: directed connect to '%s' ch %u failed after %lu ms (status %d).\n", cache.ssid,
+                      cache.channel, (unsigned long)stats.directed_fail_ms, (int)WiFi.status());
+        WiFi.disconnect();
+    }
+
+    // 2. One scan (or a recent one), known networks strongest first
+    if (!scanValid || millis() - scanMs >= WIFI_SCAN_CACHE_MS) {
+        unsigned long scanStart = millis();
+        int16_t found = WiFi.scanNetworks();
+        stats.scan_ms = millis() - scanStart;
+        rankScan(found > 0 ? found : 0);
+        WiFi.scanDelete();
+    }
+    for (uint8_t i = 0; i < candidateCount; i++) {
+        const WifiCandidate& candidate = candidates[i];
+        if (cached >= 0 && candidate.channel == cache.channel && memcmp(candidate.bssid, cache.bssid, 6) == 0) {
+            continue; // Just failed above
+        }
+        prepareAddresses(candidate.credential, false);
+        stats.attempts++;
+        WiFi.begin(credentialSsid(candidate.credential), credentialPassword(candidate.credential), candidate.channel, candidate.bssid);
+        if (waitConnected(WIFI_DIRECTED_TIMEOUT_MS, true)) {
+            noteConnected(WIFI_PATH_SCAN, start, candidate.rssi);
+            return true;
+        }
+        Serial.printf("Wi-Fi: '%s' (%d dBm) failed (status %d).\n", credentialSsid(candidate.credential),
+                      candidate.rssi, (int)WiFi.status());
+        WiFi.disconnect();
+    }
+
+    // 3. Nothing known in range, or a hidden network: the primary without a BSSID, as before
+    if (userConfig.ssid[0] != '\0') {
+        prepareAddresses(0, false);
+        stats.attempts++;
+        WiFi.begin(userConfig.ssid, userConfig.password);
+        if (waitConnected(WIFI_SCAN_TIMEOUT_MS, false)) {
+            noteConnected(WIFI_PATH_PLAIN, start, WiFi.RSSI());
+            return true;
+        }
+    }
+    stats.connect_ms = millis() - start;
+    Serial.printf("Wi-Fi: no known network joined after %u attempt(s), %lu ms (status %d).\n", stats.attempts,
+                  (unsigned long)stats.connect_ms, (int)WiFi.status());
+    return false;
+}
+
+/**
+ * @brief Moves to the best candidate: any when disconnected, otherwise only to a
+ * different access point that is clearly stronger than the current one.
+ */
+static void roamToBest() {
+    bool connected = WiFi.status() == WL_CONNECTED;
+    int8_t currentRssi = connected ? WiFi.RSSI() : -128;
+    const uint8_t* currentBssid = connected ? WiFi.BSSID() : nullptr;
+    for (uint8_t i = 0; i < candidateCount; i++) {
+        const WifiCandidate& candidate = candidates[i];
+        if (currentBssid != nullptr && memcmp(candidate.bssid, currentBssid, 6) == 0) continue;
+        if (connected && candidate.rssi < currentRssi + WIFI_ROAM_HYSTERESIS_DB) return; // Sorted: none better
+        Serial.printf("Wi-Fi: roaming from '%s' (%d dBm) to '%s' ch %u (%d dBm).\n", connected ? WiFi.SSID().c_str() : "none",
+                      currentRssi, credentialSsid(candidate.credential), candidate.channel, candidate.rssi);
+        prepareAddresses(candidate.credential, false);
+        WiFi.begin(credentialSsid(candidate.credential), credentialPassword(candidate.credential), candidate.channel, candidate.bssid);
+        roamPending = true;
+        roamStartMs = millis();
+        roamCredential = candidate.credential;
+        return;
+    }
+}
+
+void wifiRoamService() {
+    unsigned long now = millis();
+    bool connected = WiFi.status() == WL_CONNECTED;
+
+    if (roamPending) {
+        if (connected) {
+            roamPending = false;
+            lostSinceMs = 0;
+            stats.roams++;
+            stats.roam_ms = now - roamStartMs;
+            stats.rssi = WiFi.RSSI();
+            strncpy(stats.ssid, WiFi.SSID().c_str(), sizeof(stats.ssid) - 1);
+            Serial.printf("Wi-Fi: roamed to '%s' in %lu ms (%d dBm).\n", stats.ssid, (unsigned long)stats.roam_ms, stats.rssi);
+            wifiCacheStore();
+        } else if (now - roamStartMs >= WIFI_DIRECTED_TIMEOUT_MS * 2) {
+            roamPending = false;
+            Serial.printf("Wi-Fi: roam to '%s' timed out.\n", credentialSsid(roamCredential));
+        }
+        return;
+    }
+    if (scanRunning) {
+        int16_t found = WiFi.scanComplete();
+        if (found == WIFI_SCAN_RUNNING) return;
+        scanRunning = false;
+        rankScan(found > 0 ? found : 0);
+        WiFi.scanDelete();
+        roamToBest();
+        return;
+    }
+
+    if (connected) {
+        lostSinceMs = 0;
+        if (now - lastRoamCheckMs < WIFI_ROAM_CHECK_MS) return;
+        lastRoamCheckMs = now;
+        if (WiFi.RSSI() >= WIFI_ROAM_RSSI_DBM) return;
+    } else {
+        // The radio keeps retrying the same access point by itself; after a while try the others
+        if (lostSinceMs == 0) lostSinceMs = now;
+        if (now - lostSinceMs < WIFI_LOST_RESCAN_MS || now - lastRoamCheckMs < WIFI_ROAM_CHECK_MS) return;
+        lastRoamCheckMs = now;
+    }
+    if (scanValid && now - scanMs < WIFI_SCAN_CACHE_MS) {
+        roamToBest(); // Recent enough: no new scan
+    } else {
+        scanRunning = WiFi.scanNetworks(true) == WIFI_SCAN_RUNNING;
+    }
+}
+
+void wifiRememberNetwork(const char* ssid, const char* password) {
+    wifiCredential_t previous;
+    memset(&previous, 0, sizeof(previous));
+    strncpy(previous.ssid, userConfig.ssid, sizeof(previous.ssid) - 1);
+    strncpy(previous.password, userConfig.password, sizeof(previous.password) - 1);
+
+    memset(userConfig.ssid, 0, sizeof(userConfig.ssid));
+    memset(userConfig.password, 0, sizeof(userConfig.password));
+    strncpy(userConfig.ssid, ssid, sizeof(userConfig.ssid) - 1);
+    strncpy(userConfig.password, password, sizeof(userConfig.password) - 1);
+    if (previous.ssid[0] == '\0' || strcmp(previous.ssid, userConfig.ssid) == 0) return;
+
+    // The old primary goes to the front of the list; the network itself leaves its old slot,
+    // and the last slot drops off when the list is full
+    uint8_t last = WIFI_EXTRA_NETWORKS;
+    for (uint8_t i = 0; i < WIFI_EXTRA_NETWORKS && last == WIFI_EXTRA_NETWORKS; i++) {
+        const char* entry = userConfig.extra_networks[i].ssid;
+        if (strcmp(entry, userConfig.ssid) == 0 || strcmp(entry, previous.ssid) == 0) last = i;
+    }
+    for (uint8_t i = 0; i < WIFI_EXTRA_NETWORKS && last == WIFI_EXTRA_NETWORKS; i++) {
+        if (userConfig.extra_networks[i].ssid[0] == '\0') last = i;
+    }
+    if (last == WIFI_EXTRA_NETWORKS) last = WIFI_EXTRA_NETWORKS - 1;
+    for (uint8_t i = last; i > 0; i--) userConfig.extra_networks[i] = userConfig.extra_networks[i - 1];
+    userConfig.extra_networks[0] = previous;
+    scanValid = false; // Ranking refers to credential indices
+}
+
+void wifiCacheStore() {
+    if (WiFi.status() != WL_CONNECTED) return;
+    loadCache();
+    WifiCache next = cache;
+    next.magic = WIFI_CACHE_MAGIC;
+    memset(next.ssid, 0, sizeof(next.ssid));
+    strncpy(next.ssid, WiFi.SSID().c_str(), sizeof(next.ssid) - 1);
+    memcpy(next.bssid, WiFi.BSSID(), sizeof(next.bssid));
+    next.channel = WiFi.channel();
+    next.reserved = 0;
+    if (stats.static_ip) {
+        next.ip = 0; // Nothing to reuse: the settings supply the addresses
+        next.lease_epoch = 0;
+    } else if (!stats.cached_lease) {
+        // A fresh DHCP lease; a reused one keeps its original age
+        next.ip = WiFi.localIP();
+        next.gateway = WiFi.gatewayIP();
+        next.subnet = WiFi.subnetMask();
+        next.dns = WiFi.dnsIP(0);
+        next.lease_epoch = clockValid() ? (uint32_t)time(nullptr) : 0;
+        leaseMs = millis();
+    }
+    cache = next;
+
+    // NVS only when the access point changed (flash wear): the lease is not kept there
+    if (strncmp(stored.ssid, next.ssid, sizeof(next.ssid)) != 0 || memcmp(stored.bssid, next.bssid, sizeof(next.bssid)) != 0 ||
+        stored.channel != next.channel || stored.magic != WIFI_CACHE_MAGIC) {
+        stored = next;
+        stored.ip = stored.gateway = stored.subnet = stored.dns = stored.lease_epoch = 0;
+        preferences.begin(PREF_NAMESPACE, false);
+        preferences.putBytes(WIFI_CACHE_KEY, &stored, sizeof(stored));
+        preferences.end();
+        Serial.printf("Wi-Fi: cached '%s' ch %u to NVS.\n", stored.ssid, stored.channel);
+    }
+}
+
+void wifiCacheService() {
+    // Reused addresses stop the DHCP client, so nobody renews the lease: hand the
+    // interface back to DHCP before the router can give the address to someone else
+    if (stats.cached_lease && clockValid() && (uint32_t)time(nullptr) - cache.lease_epoch >= WIFI_LEASE_REUSE_S) {
+        Serial.println("Wi-Fi: cached lease is due for renewal, switching to DHCP.");
+        stats.cached_lease = false;
+        dhcpRestarted = true;
+        WiFi.config(IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0)); // Starts the DHCP client
+        return;
+    }
+    if (dhcpRestarted) {
+        if ((uint32_t)WiFi.localIP() == 0) return; // Still negotiating
+        dhcpRestarted = false;
+        wifiCacheStore(); // Not a cached lease any more: records the fresh one
+        return;
+    }
+    if (cache.magic != WIFI_CACHE_MAGIC || cache.ip == 0 || cache.lease_epoch != 0 || !clockValid()) return;
+    cache.lease_epoch = (uint32_t)time(nullptr) - (millis() - leaseMs) / 1000;
+}
+
+void wifiCacheClear() {
+    memset(&cache, 0, sizeof(cache));
+    memset(&stored, 0, sizeof(stored));
+    storedLoaded = true;
+    scanValid = false;
+    preferences.begin(PREF_NAMESPACE, false);
+    preferences.remove(WIFI_CACHE_KEY);
+    preferences.end();
+}
+
+const WifiConnectStats& wifiConnectStats() {
+    return stats;
+}
+
+const char* wifiPathName(WifiConnectPath path) {
+    return PATH_NAMES[path];
+}
@@ -0,0 +1,55 @@
+#ifndef WIFICONNECT_H
+#define WIFICONNECT_H
+
+#include <stdint.h>
+
+/**
+ * @brief Where the last good connection was made. BSSID and channel are kept in
+ * RTC memory and mirrored to NVS (power-on); the DHCP lease only in RTC memory,
+ * since it is only reused while the clock still knows how old it is.
+ */
+typedef struct {
+    uint32_t magic;          // WIFI_CACHE_MAGIC when the entry is valid
+    char ssid[32];           // Network the entry belongs to
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t reserved;
+    uint32_t ip;             // Last DHCP lease (0 = none), IPAddress byte order
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint32_t lease_epoch;    // UTC seconds the lease was obtained, 0 = not known yet
+} WifiCache;
+
+typedef enum : uint8_t {
+    WIFI_PATH_NONE,          // Not connected yet (or every attempt failed)
+    WIFI_PATH_DIRECTED,      // Cached BSSID and channel: no scan
+    WIFI_PATH_SCAN,          // One scan, known networks tried strongest first
+    WIFI_PATH_PLAIN          // None of them seen (hidden network?): plain begin() with the primary
+} WifiConnectPath;
+
+typedef struct {
+    WifiConnectPath path;
+    bool cached_lease;       // Addresses from the cached lease instead of DHCP
+    bool static_ip;          // Addresses from the settings
+    uint8_t attempts;        // Associations tried in the last connect
+    char ssid[32];           // Network chosen
+    int8_t rssi;             // Its signal when chosen (dBm)
+    uint32_t connect_ms;     // Total association time of the last connect, failed attempts included
+    uint32_t scan_ms;        // Part of it spent scanning, 0 = no scan
+    uint32_t directed_fail_ms; // Time lost on a directed attempt that failed, 0 = none
+    uint16_t roams;          // Switches to a stronger access point or another known network
+    uint32_t roam_ms;        // Association time of the last roam
+} WifiConnectStats;
+
+// --- FUNCTION PROTOTYPES ---
+bool wifiConnect();            // Directed connect when cached, then known networks by RSSI; blocks until one succeeds or all fail
+void wifiRoamService();        // loop(), not while the setup portal runs: roams on a weak signal, rejoins when lost
+void wifiRememberNetwork(const char* ssid, const char* password); // Makes it the primary, keeping the old one in the list
+void wifiCacheStore();         // After any successful join (also from the setup portal)
+void wifiCacheService();       // loop() while connected: dates a new lease, hands a reused one back to DHCP when due
+void wifiCacheClear();
+const WifiConnectStats& wifiConnectStats();
+const char* wifiPathName(WifiConnectPath path);
+
+#endif // WIFICONNECT_H
@@ -9,8 +9,19 @@
 
 // --- 2. Time Configuration ---
 static const bool TIME_FORMAT_24H = false;       
-static const bool DST_ACTIVE = true;         
-static const char* ntpServer = "pool.ntp.org"; 
+static const bool DST_ACTIVE = true;         // Only used with the manual GMT offset (no time zone selected)
+// NTP servers in fallback order (the ESP32 SNTP client holds up to 3)
+static const char* const NTP_SERVERS[] = { "pool.ntp.org", "time.google.com", "time.cloudflare.com" };
+static const uint8_t NTP_SERVER_COUNT = sizeof(NTP_SERVERS) / sizeof(NTP_SERVERS[0]);
+
+// SNTP supervision
+static const unsigned long TIME_SYNC_TIMEOUT_MS = 60000UL;   // No sync this long after start: rotate servers
+static const uint32_t TIME_SYNC_DEFAULT_INTERVAL_S = 3600;   // Until the drift is known
+static const uint32_t TIME_SYNC_MIN_INTERVAL_S = 15 * 60;
+static const uint32_t TIME_SYNC_MAX_INTERVAL_S = 24 * 3600;
+static const float TIME_SYNC_TARGET_ERROR_MS = 250.0f;       // Re-sync before the drift reaches this
+static const int32_t TIME_SYNC_MAX_SAMPLE_OFFSET_MS = 30000; // Larger steps (boot, reset) are not drift
+static const uint32_t TIME_SYNC_MIN_SAMPLE_S = 600;          // Shorter intervals are too noisy for a drift sample
 
 // --- 3. XPT2046 TOUCH SCREEN PINS (CYD Default) ---
 #define TS_CS 33   
@@ -27,8 +38,69 @@ static const bool USE_FAHRENHEIT = true;
 // Note: This is now an unsigned long value (in milliseconds)
 static const unsigned long WEATHER_UPDATE_INTERVAL_MS = 60 * 60000UL; 
 
+// --- ADAPTIVE WEATHER REFRESH (see WeatherScheduler.cpp) ---
+static const unsigned long WEATHER_FAST_INTERVAL_MS = 15 * 60000UL;  // While it is raining/snowing
+static const unsigned long WEATHER_BACKOFF_BASE_MS = 30000UL;        // First retry after a transient error, doubles per failure
+static const unsigned long WEATHER_IDLE_THRESHOLD_MS = 30 * 60000UL; // No touch for this long = idle
+static const unsigned long WEATHER_STALE_MAX_MS = 3 * 60 * 60000UL;  // Keep showing old data this long on transient errors
+static const unsigned long WEATHER_SLOW_FACTOR = 3;                  // Interval multiplier while backlight off or idle
+static const long WEATHER_JITTER_PERCENT = 10;                       // +/- random spread on every delay
+static const uint16_t WEATHER_DEFAULT_DAILY_QUOTA = 1000;            // OWM free tier: 1000 calls/day (0 = unlimited)
+
+// Wi-Fi connect (WifiConnect.cpp): cached BSSID/channel first, then known networks by RSSI from one scan
+static const unsigned long WIFI_DIRECTED_TIMEOUT_MS = 3000UL;   // Per directed attempt
+static const unsigned long WIFI_SCAN_TIMEOUT_MS = 10000UL;      // Plain begin() when no known network was seen
+static const unsigned long WIFI_SCAN_CACHE_MS = 60000UL;        // Ranked scan results reused this long
+static const int8_t WIFI_ROAM_RSSI_DBM = -75;                   // Look for a better access point below this
+static const int8_t WIFI_ROAM_HYSTERESIS_DB = 8;                // ...and only move for one at least this much stronger
+static const unsigned long WIFI_ROAM_CHECK_MS = 30000UL;
+static const unsigned long WIFI_LOST_RESCAN_MS = 30000UL;       // Disconnected this long: try the other known networks
+static const uint32_t WIFI_LEASE_REUSE_S = 6 * 3600;   // Cached DHCP lease reused as static addresses this long (half a typical lease), then DHCP again
+
+// Settings menu: loop() pass interval while it is open (press, drag and release are sampled per pass)
+static const unsigned long MENU_POLL_MS = 20UL;
+
+// Quiet hours: idle time before a power-profile window takes effect (a touch restores the display)
+static const unsigned long POWER_IDLE_GRACE_MS = 60000UL;
+
+// Live status stream (/events): changes within the gap share one frame; a heartbeat frame otherwise
+static const unsigned long STATUS_STREAM_MIN_GAP_MS = 250UL;
+static const unsigned long STATUS_STREAM_HEARTBEAT_MS = 5000UL;
+
+// Settings store: saves within the window share one NVS write (capped, so a steady stream still lands)
+static const unsigned long CONFIG_SAVE_COALESCE_MS = 3000UL;
+static const unsigned long CONFIG_SAVE_MAX_DELAY_MS = 15000UL;
+
+// Firmware update trial (OtaUpdate.cpp): a new image must join Wi-Fi within the window and get
+// through setup() within the boot count, or the clock boots the previous image again
+static const unsigned long OTA_VERIFY_TIMEOUT_MS = 3 * 60000UL;
+static const uint8_t OTA_TRIAL_BOOTS = 3;
+
+// Screenshot (/screenshot): panel rows read back per band (band buffer = rows x 320 x 2 bytes)
+static const int SCREENSHOT_BAND_ROWS = 8;
+
+// Forecast refresh interval (the 5-day/3-hour data only changes every 3 hours)
+static const unsigned long FORECAST_UPDATE_INTERVAL_MS = 3 * 60 * 60000UL;
+
+// How often the weather block rotates to the next location (multi-location setups)
+static const unsigned long WEATHER_ROTATE_INTERVAL_MS = 15000UL;
+
+// How often the forecast strip scrolls by one cell (0 disables scrolling)
+static const unsigned long FORECAST_SCROLL_INTERVAL_MS = 10000UL;
+
 // Base URL for the API
-static const char* OPENWEATHER_URL_BASE = "https://api.openweathermap.org/data/2.5/weather?";
+static constexpr char OPENWEATHER_URL_BASE[] = "https://api.openweathermap.org/data/2.5/weather?";
+static constexpr char OPENWEATHER_GROUP_URL_BASE[] = "https://api.openweathermap.org/data/2.5/group?";
+static constexpr char OPENWEATHER_FORECAST_URL_BASE[] = "https://api.openweathermap.org/data/2.5/forecast?";
+static constexpr char OPENMETEO_URL_BASE[] = "https://api.open-meteo.com/v1/forecast?";
+
+// --- MOCK WEATHER PROVIDER (offline testing) ---
+// Empty URL = parse the canned payload from flash; otherwise GET this URL
+// (e.g. "http://192.168.1.10:8000/weather.json" served from a Linux box).
+static constexpr char MOCK_WEATHER_URL[] = "";
+static const unsigned long MOCK_WEATHER_LATENCY_MS = 0; // Artificial delay before each response
+static const int MOCK_WEATHER_HTTP_CODE = 200;           // Non-200 injects that error (canned payload only)
+static const size_t MOCK_WEATHER_PAD_BYTES = 0;          // Whitespace added to grow the canned payload
 
 
 
@@ -0,0 +1,202 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// --- HOST STAND-IN FOR THE ARDUINO CORE ---
+// Just enough of the ESP32 Arduino API for the sketch's pure modules to build
+// and run on a desktop compiler. millis() and esp_random() are driven by the test.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <ctype.h>
+#include <time.h>
+#include <string>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define F(x) x
+#define RTC_DATA_ATTR
+#define IRAM_ATTR
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline bool isDigit(int c) { return isdigit(c) != 0; }
+
+class String {
+public:
+    String() {}
+    String(const char* text) { if (text) s = text; }
+    String(const std::string& text) : s(text) {}
+    String(char c) : s(1, c) {}
+    String(int value) : s(std::to_string(value)) {}
+    String(unsigned value) : s(std::to_string(value)) {}
+    String(long value) : s(std::to_string(value)) {}
+    String(unsigned long value) : s(std::to_string(value)) {}
+    String(double value, int decimals = 2) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        s = buffer;
+    }
+
+    unsigned length() const { return s.size(); }
+    const char* c_str() const { return s.c_str(); }
+    bool isEmpty() const { return s.empty(); }
+    char charAt(unsigned i) const { return i < s.size() ? s[i] : 0; }
+    char operator[](unsigned i) const { return charAt(i); }
+    void setCharAt(unsigned i, char c) { if (i < s.size()) s[i] = c; }
+    void toLowerCase() { for (auto& c : s) c = tolower(c); }
+    void toUpperCase() { for (auto& c : s) c = toupper(c); }
+    void trim() {
+        size_t first = s.find_first_not_of(" \t\r\n");
+        size_t last = s.find_last_not_of(" \t\r\n");
+        s = first == std::string::npos ? "" : s.substr(first, last - first + 1);
+    }
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return atof(s.c_str()); }
+    int indexOf(char c) const { size_t p = s.find(c); return p == std::string::npos ? -1 : (int)p; }
+    int indexOf(const char* text) const { size_t p = s.find(text); return p == std::string::npos ? -1 : (int)p; }
+    String substring(unsigned from) const { return from < s.size() ? s.substr(from) : ""; }
+    String substring(unsigned from, unsigned to) const { return from < s.size() ? s.substr(from, to - from) : ""; }
+    bool startsWith(const char* prefix) const { return s.rfind(prefix, 0) == 0; }
+    bool endsWith(const char* suffix) const {
+        size_t n = strlen(suffix);
+        return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+    }
+    bool equals(const String& other) const { return s == other.s; }
+    bool reserve(unsigned size) { s.reserve(size); return true; }
+    void toCharArray(char* buffer, unsigned size) const {
+        if (size == 0) return;
+        strncpy(buffer, s.c_str(), size - 1);
+        buffer[size - 1] = '\0';
+    }
+
+    String& operator+=(const String& other) { s += other.s; return *this; }
+    String& operator+=(const char* other) { s += other; return *this; }
+    String& operator+=(char other) { s += other; return *this; }
+    String& operator+=(int other) { s += std::to_string(other); return *this; }
+    String& operator+=(unsigned other) { s += std::to_string(other); return *this; }
+    String& operator+=(long other) { s += std::to_string(other); return *this; }
+    String& operator+=(unsigned long other) { s += std::to_string(other); return *this; }
+    bool operator==(const String& other) const { return s == other.s; }
+    bool operator!=(const String& other) const { return s != other.s; }
+    bool operator==(const char* other) const { return s == other; }
+
+    std::string s;
+};
+inline String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+inline String operator+(const String& a, const char* b) { return String(a.s + b); }
+inline String operator+(const char* a, const String& b) { return String(std::string(a) + b.s); }
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        for (size_t i = 0; i < size; i++) write(buffer[i]);
+        return size;
+    }
+    size_t print(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+    size_t print(const String& text) { return print(text.c_str()); }
+    size_t print(int value) { return printf("%d", value); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t println(const char* text = "") { return print(text) + print("\n"); }
+    size_t println(const String& text) { return println(text.c_str()); }
+    size_t println(int value) { return print(value) + print("\n"); }
+    size_t printf(const char* format, ...) {
+        char buffer[256];
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        if (length < 0) return 0;
+        return write((const uint8_t*)buffer, strnlen(buffer, sizeof(buffer)));
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+    size_t readBytes(char* buffer, size_t length) {
+        size_t n = 0;
+        while (n < length && available() > 0) buffer[n++] = (char)read();
+        return n;
+    }
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+    void setTimeout(unsigned long) {}
+    // Reads up to and including the target; false (stream consumed) when not found
+    bool find(const char* target) { return findUntil(target, nullptr); }
+    // Stops after the target (true) or the terminator (false), whichever comes first
+    bool findUntil(const char* target, const char* terminator) {
+        std::string seen;
+        while (available() > 0) {
+            seen += (char)read();
+            if (endsWith(seen, target)) return true;
+            if (terminator && *terminator && endsWith(seen, terminator)) return false;
+        }
+        return false;
+    }
+
+private:
+    static bool endsWith(const std::string& text, const char* suffix) {
+        size_t length = strlen(suffix);
+        return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+    }
+};
+
+// Serial output is dropped unless HOST_VERBOSE is set in the environment
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override;
+    using Print::write;
+};
+extern HardwareSerial Serial;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned us);
+void yield();
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+void analogWrite(int pin, int value);
+long random(long high);
+long random(long low, long high);
+long map(long x, long inLow, long inHigh, long outLow, long outHigh);
+uint32_t esp_random();
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+void configTime(long gmtOffset, int dstOffset, const char* server1, const char* server2 = nullptr, const char* server3 = nullptr);
+void configTzTime(const char* tz, const char* server1, const char* server2 = nullptr, const char* server3 = nullptr);
+
+struct EspClass {
+    void restart() {}
+    uint32_t getFreeHeap() { return 160000; }
+    uint32_t getMinFreeHeap() { return 120000; }
+    uint32_t getMaxAllocHeap() { return 110000; }
+    uint32_t getHeapSize() { return 320000; }
+    uint32_t getSketchSize() { return 1200000; }
+    uint32_t getFreeSketchSpace() { return 1900000; }
+};
+extern EspClass ESP;
+
+// --- TEST CONTROLS ---
+extern unsigned long hostMillis;   // Value millis() returns (micros() follows it)
+extern uint32_t hostRandom;        // Value esp_random() returns
+extern time_t hostNow;             // Wall clock getLocalTime() reports; 0 = not synced
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,77 @@
+#ifndef HOST_HTTPCLIENT_H
+#define HOST_HTTPCLIENT_H
+
+#include "WiFi.h"
+#include <deque>
+#include <vector>
+
+// --- SCRIPTED HTTP ---
+// Each GET takes the next queued reply (a status code and a body) and records
+// the URL it was sent to; with nothing queued the request fails to connect.
+// A chunked reply reaches the socket with HTTP/1.1 chunk framing, as a server
+// may send it; getString() decodes it, getStream() hands over the raw bytes.
+struct HostHttpReply {
+    HostHttpReply(int code, const std::string& body, bool chunked = false) : code(code), body(body), chunked(chunked) {}
+    int code;
+    std::string body;
+    bool chunked;
+};
+struct HostHttp {
+    std::deque<HostHttpReply> replies;
+    std::vector<std::string> requests;
+    bool reuse = false;     // Last setReuse() value
+    bool http10 = false;    // Last useHTTP10() value
+    int connections = 0;    // GETs that had to open a connection
+    void reset() { replies.clear(); requests.clear(); reuse = false; http10 = false; connections = 0; }
+};
+extern HostHttp hostHttp;
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+
+class HTTPClient {
+public:
+    bool begin(WiFiClient& client, const String& url) { _client = &client; _url = url.s; return true; }
+    // Like the ESP32 client: the connection survives end() only with reuse on and HTTP/1.1
+    void end() { if (_client && (!_reuse || _http10)) _client->open = false; }
+    void useHTTP10(bool enable) { _http10 = enable; hostHttp.http10 = enable; if (enable) _reuse = false; }
+    void setReuse(bool enable) { _reuse = enable; hostHttp.reuse = enable; }
+    void setTimeout(uint16_t) {}
+    void setConnectTimeout(int32_t) {}
+    void addHeader(const String&, const String&) {}
+    int GET() {
+        hostHttp.requests.push_back(_url);
+        if (hostHttp.replies.empty()) return HTTPC_ERROR_CONNECTION_REFUSED;
+        if (!_client->open) hostHttp.connections++;
+        _client->open = true;
+        HostHttpReply reply = hostHttp.replies.front();
+        hostHttp.replies.pop_front();
+        _body = reply.body;
+        _client->load(reply.chunked && !_http10 ? chunkFraming(_body) : _body);
+        return reply.code;
+    }
+    int getSize() { return _body.size(); }
+    String getString() { _client->load(""); return _body; }
+    WiFiClient& getStream() { return *_client; }
+    static String errorToString(int code) { return String("error ") + String(code); }
+
+private:
+    // Splits the body into 64-byte chunks: "<hex size>\r\n<data>\r\n" ... "0\r\n\r\n"
+    static std::string chunkFraming(const std::string& body) {
+        std::string framed;
+        for (size_t at = 0; at < body.size(); at += 64) {
+            std::string piece = body.substr(at, 64);
+            char size[12];
+            snprintf(size, sizeof(size), "%zx\r\n", piece.size());
+            framed += size + piece + "\r\n";
+        }
+        return framed + "0\r\n\r\n";
+    }
+
+    WiFiClient* _client = nullptr;
+    bool _reuse = true;     // ESP32 HTTPClient defaults
+    bool _http10 = false;
+    std::string _url;
+    std::string _body;
+};
+
+#endif // HOST_HTTPCLIENT_H
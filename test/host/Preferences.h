@@ -0,0 +1,71 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"
+#include <map>
+#include <vector>
+
+// --- IN-MEMORY NVS ---
+// One flat key space (namespaces are ignored); hostNvs is shared so a test can
+// seed, inspect and count writes.
+struct HostNvs {
+    std::map<std::string, std::vector<uint8_t>> keys;
+    size_t writes = 0;
+    size_t bytes = 0;
+};
+extern HostNvs hostNvs;
+
+class Preferences {
+public:
+    bool begin(const char*, bool = false) { return true; }
+    void end() {}
+    bool clear() { hostNvs.keys.clear(); return true; }
+    bool remove(const char* key) { return hostNvs.keys.erase(key) > 0; }
+    bool isKey(const char* key) { return hostNvs.keys.count(key) > 0; }
+
+    size_t putBytes(const char* key, const void* value, size_t size) {
+        hostNvs.keys[key] = std::vector<uint8_t>((const uint8_t*)value, (const uint8_t*)value + size);
+        hostNvs.writes++;
+        hostNvs.bytes += size;
+        return size;
+    }
+    size_t getBytes(const char* key, void* value, size_t size) {
+        auto it = hostNvs.keys.find(key);
+        if (it == hostNvs.keys.end() || it->second.size() > size) return 0;
+        memcpy(value, it->second.data(), it->second.size());
+        return it->second.size();
+    }
+    size_t getBytesLength(const char* key) {
+        auto it = hostNvs.keys.find(key);
+        return it == hostNvs.keys.end() ? 0 : it->second.size();
+    }
+
+    size_t putBool(const char* key, bool value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putUChar(const char* key, uint8_t value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putUShort(const char* key, uint16_t value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putInt(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putFloat(const char* key, float value) { return putBytes(key, &value, sizeof(value)); }
+    size_t putString(const char* key, const char* value) { return putBytes(key, value, strlen(value) + 1); }
+
+    bool getBool(const char* key, bool fallback = false) { return get(key, fallback); }
+    uint8_t getUChar(const char* key, uint8_t fallback = 0) { return get(key, fallback); }
+    uint16_t getUShort(const char* key, uint16_t fallback = 0) { return get(key, fallback); }
+    int32_t getInt(const char* key, int32_t fallback = 0) { return get(key, fallback); }
+    uint32_t getUInt(const char* key, uint32_t fallback = 0) { return get(key, fallback); }
+    float getFloat(const char* key, float fallback = 0) { return get(key, fallback); }
+    size_t getString(const char* key, char* value, size_t size) { return getBytes(key, value, size); }
+    String getString(const char* key, const String& fallback = String()) {
+        auto it = hostNvs.keys.find(key);
+        return it == hostNvs.keys.end() ? fallback : String((const char*)it->second.data());
+    }
+
+private:
+    template <class T> T get(const char* key, T fallback) {
+        T value = fallback;
+        if (getBytesLength(key) == sizeof(T)) getBytes(key, &value, sizeof(T));
+        return value;
+    }
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,105 @@
+#ifndef HOST_TFT_ESPI_H
+#define HOST_TFT_ESPI_H
+
+#include "Arduino.h"
+
+// --- HOST STAND-IN FOR TFT_eSPI ---
+// Colour constants and a panel that draws nothing; fillRect/fillScreen count
+// pixels so tests can check redraw cost.
+
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_DARKCYAN    0x03EF
+#define TFT_MAROON      0x7800
+#define TFT_PURPLE      0x780F
+#define TFT_OLIVE       0x7BE0
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_DARKGREY    0x7BEF
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_CYAN        0x07FF
+#define TFT_RED         0xF800
+#define TFT_MAGENTA     0xF81F
+#define TFT_YELLOW      0xFFE0
+#define TFT_WHITE       0xFFFF
+#define TFT_ORANGE      0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_PINK        0xFE19
+#define TFT_GOLD        0xFEA0
+#define TFT_SILVER      0xC618
+#define TFT_SKYBLUE     0x867D
+#define TFT_VIOLET      0x915C
+
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define MC_DATUM 4
+#define MR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+
+typedef struct {
+    uint32_t bitmapOffset;
+    uint8_t width, height, xAdvance;
+    int8_t xOffset, yOffset;
+} GFXglyph;
+
+typedef struct {
+    uint8_t* bitmap;
+    GFXglyph* glyph;
+    uint16_t first, last;
+    uint8_t yAdvance;
+} GFXfont;
+
+class TFT_eSPI : public Print {
+public:
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+    void init() {}
+    void setRotation(uint8_t) {}
+    void fillScreen(uint32_t) { pixels += 320 * 240; }
+    void fillRect(int32_t, int32_t, int32_t w, int32_t h, uint32_t) { pixels += w * h; }
+    void drawRect(int32_t, int32_t, int32_t, int32_t, uint32_t) {}
+    void fillRoundRect(int32_t, int32_t, int32_t w, int32_t h, int32_t, uint32_t) { pixels += w * h; }
+    void drawRoundRect(int32_t, int32_t, int32_t, int32_t, int32_t, uint32_t) {}
+    void drawFastHLine(int32_t, int32_t, int32_t, uint32_t) {}
+    void drawFastVLine(int32_t, int32_t, int32_t, uint32_t) {}
+    void drawLine(int32_t, int32_t, int32_t, int32_t, uint32_t) {}
+    void drawPixel(int32_t, int32_t, uint32_t) {}
+    void fillCircle(int32_t, int32_t, int32_t, uint32_t) {}
+    void drawCircle(int32_t, int32_t, int32_t, uint32_t) {}
+    void setTextColor(uint16_t) {}
+    void setTextColor(uint16_t, uint16_t, bool = false) {}
+    void setTextDatum(uint8_t) {}
+    void setFreeFont(const GFXfont*) {}
+    void setTextFont(uint8_t) {}
+    void setTextSize(uint8_t) {}
+    void setTextPadding(uint16_t) {}
+    int16_t drawString(const char* text, int32_t, int32_t) { return textWidth(text); }
+    int16_t drawString(const String& text, int32_t x, int32_t y) { return drawString(text.c_str(), x, y); }
+    int16_t drawString(const char* text, int32_t x, int32_t y, uint8_t) { return drawString(text, x, y); }
+    int16_t drawString(const String& text, int32_t x, int32_t y, uint8_t) { return drawString(text.c_str(), x, y); }
+    int16_t drawChar(uint16_t, int32_t, int32_t) { return 6; }
+    int16_t drawNumber(long, int32_t, int32_t) { return 6; }
+    int16_t textWidth(const char* text) { return 6 * strlen(text); }
+    int16_t textWidth(const String& text) { return textWidth(text.c_str()); }
+    int16_t fontHeight() { return 8; }
+    int16_t fontHeight(int16_t) { return 8; }
+    void readRect(int32_t, int32_t, int32_t, int32_t, uint16_t*) {}
+    uint16_t readPixel(int32_t, int32_t) { return 0; }
+    void pushRect(int32_t, int32_t, int32_t, int32_t, uint16_t*) {}
+    void setSwapBytes(bool) {}
+    bool getSwapBytes() { return false; }
+    int16_t width() { return 320; }
+    int16_t height() { return 240; }
+    uint16_t color565(uint8_t r, uint8_t g, uint8_t b) { return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3); }
+    void startWrite() {}
+    void endWrite() {}
+
+    uint64_t pixels = 0;
+};
+
+#endif // HOST_TFT_ESPI_H
@@ -0,0 +1,41 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+typedef enum { WL_IDLE_STATUS, WL_NO_SSID_AVAIL, WL_SCAN_COMPLETED, WL_CONNECTED,
+               WL_CONNECT_FAILED, WL_CONNECTION_LOST, WL_DISCONNECTED } wl_status_t;
+typedef enum { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+
+// A client fed from a byte string: what the HTTPClient stand-in hands to parsers
+class WiFiClient : public Stream {
+public:
+    void load(const std::string& data) { body = data; position = 0; }
+    int available() override { return body.size() - position; }
+    int read() override { return position < body.size() ? (uint8_t)body[position++] : -1; }
+    int peek() override { return position < body.size() ? (uint8_t)body[position] : -1; }
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+    int connect(const char*, uint16_t) { return 1; }
+    uint8_t connected() { return open; }
+    void stop() { open = false; }
+    void setNoDelay(bool) {}
+
+    bool open = false;      // Set by HTTPClient: a kept-alive connection stays open after end()
+
+private:
+    std::string body;
+    size_t position = 0;
+};
+
+class WiFiClass {
+public:
+    wl_status_t status() { return WL_CONNECTED; }
+    wifi_mode_t getMode() { return WIFI_STA; }
+    IPAddress localIP() { return IPAddress(192, 168, 1, 50); }
+    int8_t RSSI() { return -60; }
+};
+extern WiFiClass WiFi;
+
+#endif // HOST_WIFI_H
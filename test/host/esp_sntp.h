@@ -0,0 +1,38 @@
+#ifndef HOST_ESP_SNTP_H
+#define HOST_ESP_SNTP_H
+
+#include <stdint.h>
+#include <sys/time.h>
+
+// --- RECORDED SNTP CLIENT ---
+// Keeps what the sketch programs (servers, interval, restarts) for the test to inspect.
+#define SNTP_OPMODE_POLL 0
+typedef enum { SNTP_SYNC_STATUS_RESET, SNTP_SYNC_STATUS_COMPLETED, SNTP_SYNC_STATUS_IN_PROGRESS } sntp_sync_status_t;
+
+struct HostSntp {
+    bool enabled = false;
+    int starts = 0;               // sntp_init() calls
+    const char* servers[3] = {};
+    uint32_t interval_ms = 0;
+    sntp_sync_status_t status = SNTP_SYNC_STATUS_RESET;
+};
+extern HostSntp hostSntp;
+
+inline bool sntp_enabled() { return hostSntp.enabled; }
+inline void sntp_stop() { hostSntp.enabled = false; }
+inline void sntp_init() { hostSntp.enabled = true; hostSntp.starts++; }
+inline void sntp_setoperatingmode(uint8_t) {}
+inline void sntp_setservername(uint8_t index, const char* server) { if (index < 3) hostSntp.servers[index] = server; }
+inline void sntp_set_sync_interval(uint32_t ms) { hostSntp.interval_ms = ms; }
+inline void sntp_set_sync_status(sntp_sync_status_t status) { hostSntp.status = status; }
+
+// --- SIMULATED SYSTEM CLOCK ---
+// gettimeofday()/settimeofday() in code that includes this header use hostTimeOfDay,
+// so stepping the clock never touches the host's.
+extern struct timeval hostTimeOfDay;
+inline int hostGettimeofday(struct timeval* tv, void*) { *tv = hostTimeOfDay; return 0; }
+inline int hostSettimeofday(const struct timeval* tv, const void*) { hostTimeOfDay = *tv; return 0; }
+#define gettimeofday hostGettimeofday
+#define settimeofday hostSettimeofday
+
+#endif // HOST_ESP_SNTP_H
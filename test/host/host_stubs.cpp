@@ -0,0 +1,66 @@
+// Definitions behind the host stand-ins in this directory
+#include "Arduino.h"
+#include "Preferences.h"
+#include "WiFi.h"
+#include "HTTPClient.h"
+#include "esp_sntp.h"
+#include "host_test.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+HostNvs hostNvs;
+HostHttp hostHttp;
+HostSntp hostSntp;
+struct timeval hostTimeOfDay = {};
+
+unsigned long hostMillis = 0;
+uint32_t hostRandom = 0;
+time_t hostNow = 0;
+int hostChecks = 0;
+int hostFailures = 0;
+
+size_t HardwareSerial::write(uint8_t c) {
+    static const bool verbose = getenv("HOST_VERBOSE") != nullptr;
+    if (verbose) putchar(c);
+    return 1;
+}
+
+unsigned long millis() { return hostMillis; }
+unsigned long micros() { return hostMillis * 1000UL; }
+void delay(unsigned long ms) { hostMillis += ms; }
+void delayMicroseconds(unsigned) {}
+void yield() {}
+void pinMode(int, int) {}
+void digitalWrite(int, int) {}
+int digitalRead(int) { return HIGH; }
+void analogWrite(int, int) {}
+long random(long high) { return high > 0 ? (long)(hostRandom % high) : 0; }
+long random(long low, long high) { return low + random(high - low); }
+long map(long x, long inLow, long inHigh, long outLow, long outHigh) {
+    return (x - inLow) * (outHigh - outLow) / (inHigh - inLow) + outLow;
+}
+uint32_t esp_random() { return hostRandom; }
+
+bool getLocalTime(struct tm* info, uint32_t) {
+    if (hostNow == 0) return false;
+    localtime_r(&hostNow, info);
+    return true;
+}
+
+// Sets the whole-hour rule the ESP32 core builds: POSIX offsets are west-positive
+void configTime(long gmtOffset, int dstOffset, const char*, const char*, const char*) {
+    char rule[24];
+    snprintf(rule, sizeof(rule), "UTC%ld%s", -gmtOffset / 3600, dstOffset != 0 ? "DST" : "");
+    setenv("TZ", rule, 1);
+    tzset();
+}
+void configTzTime(const char* tz, const char*, const char*, const char*) {
+    setenv("TZ", tz, 1);
+    tzset();
+}
+
+int hostTestResult(const char* name) {
+    printf("%s: %d checks, %d failed\n", name, hostChecks, hostFailures);
+    return hostFailures == 0 ? 0 : 1;
+}
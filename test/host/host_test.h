@@ -0,0 +1,40 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// --- MINIMAL CHECK HELPERS ---
+// Each test_*.cpp includes the module sources it covers, runs its checks from
+// main() and returns hostTestResult(): non-zero when any check failed.
+
+#include <stdio.h>
+#include <string.h>
+
+extern int hostChecks;
+extern int hostFailures;
+
+#define CHECK(cond) do { \
+    hostChecks++; \
+    if (!(cond)) { hostFailures++; printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); } \
+} while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+    hostChecks++; \
+    long long _a = (long long)(actual), _e = (long long)(expected); \
+    if (_a != _e) { hostFailures++; printf("  FAIL %s:%d: %s == %lld, expected %lld\n", __FILE__, __LINE__, #actual, _a, _e); } \
+} while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance) do { \
+    hostChecks++; \
+    double _a = (double)(actual), _e = (double)(expected); \
+    if (_a < _e - (tolerance) || _a > _e + (tolerance)) { \
+        hostFailures++; printf("  FAIL %s:%d: %s == %g, expected %g +/- %g\n", __FILE__, __LINE__, #actual, _a, _e, (double)(tolerance)); } \
+} while (0)
+
+#define CHECK_STR(actual, expected) do { \
+    hostChecks++; \
+    const char* _a = (actual); const char* _e = (expected); \
+    if (strcmp(_a, _e) != 0) { hostFailures++; printf("  FAIL %s:%d: %s == \"%s\", expected \"%s\"\n", __FILE__, __LINE__, #actual, _a, _e); } \
+} while (0)
+
+int hostTestResult(const char* name);
+
+#endif // HOST_TEST_H
@@ -0,0 +1,518 @@
+#ifndef HOST_ARDUINOJSON_H
+#define HOST_ARDUINOJSON_H
+
+// --- HOST STAND-IN FOR ARDUINOJSON 6 ---
+// The part of the library the sketch's stream parsers use: StaticJsonDocument,
+// filtered deserializeJson() from a Stream, operator[], "| default", as<T>(),
+// is<T>() and isNull(). Like the library, reading stops right after the value
+// (so a parser can step through a "list" one element at a time), and a document
+// is charged the way it is on the ESP32: 16 bytes per member or element plus
+// each distinct copied string, so an undersized document fails with NoMemory.
+// It is a model, not the library: run_tests.sh uses the real one instead when
+// ARDUINOJSON_DIR has it, and only falls back to this file when it does not.
+
+#include "Arduino.h"
+#include <errno.h>
+#include <limits>
+#include <set>
+#include <vector>
+#include <type_traits>
+
+static const size_t JSON_SLOT_SIZE = 16;       // sizeof(VariantSlot) on a 32-bit target
+static const uint8_t JSON_NESTING_LIMIT = 10;  // ARDUINOJSON_DEFAULT_NESTING_LIMIT
+
+struct JsonNode {
+    enum Type { NUL, BOOL, INT, FLOAT, STRING, ARRAY, OBJECT };
+    Type type = NUL;
+    bool boolean = false;
+    long long integer = 0;
+    double real = 0;
+    std::string text;
+    std::vector<std::string> keys;   // OBJECT: one per child
+    std::vector<JsonNode> children;  // OBJECT members or ARRAY elements
+
+    JsonNode* member(const std::string& key) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (keys[i] == key) return &children[i];
+        }
+        return nullptr;
+    }
+    void reset() { *this = JsonNode(); }
+};
+
+// A path from the document root; resolved on every access, created on assignment
+class JsonVariant {
+public:
+    JsonVariant() : root(nullptr) {}
+    explicit JsonVariant(JsonNode* node) : root(node) {}
+
+    JsonVariant operator[](const char* key) const { return child(Step{ false, key, 0 }); }
+    JsonVariant operator[](const String& key) const { return child(Step{ false, key.c_str(), 0 }); }
+    JsonVariant operator[](int index) const { return child(Step{ true, "", (size_t)index }); }
+
+    bool isNull() const {
+        const JsonNode* node = resolve();
+        return node == nullptr || node->type == JsonNode::NUL;
+    }
+    size_t size() const {
+        const JsonNode* node = resolve();
+        return node ? node->children.size() : 0;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value, T>::type as() const {
+        const JsonNode* node = resolve();
+        if (node == nullptr) return 0;
+        switch (node->type) {
+            case JsonNode::BOOL:  return (T)node->boolean;
+            case JsonNode::INT:   return (T)node->integer;
+            case JsonNode::FLOAT: return (T)node->real;
+            default:              return 0;
+        }
+    }
+    template <typename T>
+    typename std::enable_if<std::is_same<T, const char*>::value, T>::type as() const {
+        const JsonNode* node = resolve();
+        return node && node->type == JsonNode::STRING ? node->text.c_str() : nullptr;
+    }
+    template <typename T>
+    typename std::enable_if<std::is_same<T, String>::value, T>::type as() const {
+        return String(as<const char*>());
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_same<T, bool>::value, bool>::type is() const {
+        return hasType(JsonNode::BOOL);
+    }
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, bool>::type is() const {
+        const JsonNode* node = resolve();
+        return node && node->type == JsonNode::INT &&
+               node->integer >= (long long)std::numeric_limits<T>::min() &&
+               (node->integer <= 0 || (unsigned long long)node->integer <= (unsigned long long)std::numeric_limits<T>::max());
+    }
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, bool>::type is() const {
+        return hasType(JsonNode::INT) || hasType(JsonNode::FLOAT);
+    }
+    template <typename T>
+    typename std::enable_if<std::is_same<T, const char*>::value, bool>::type is() const {
+        return hasType(JsonNode::STRING);
+    }
+
+    template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value ||
+                                                             std::is_same<T, const char*>::value ||
+                                                             std::is_same<T, String>::value>::type>
+    operator T() const { return as<T>(); }
+
+    const char* operator|(const char* fallback) const {
+        const char* text = as<const char*>();
+        return text ? text : fallback;
+    }
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value, T>::type operator|(T fallback) const {
+        return is<T>() ? as<T>() : fallback;
+    }
+
+    JsonVariant& operator=(bool value) {
+        JsonNode& node = create();
+        node.reset();
+        node.type = JsonNode::BOOL;
+        node.boolean = value;
+        return *this;
+    }
+
+protected:
+    struct Step {
+        bool isIndex;
+        std::string key;
+        size_t index;
+    };
+
+    JsonNode* root;
+    std::vector<Step> path;
+
+    JsonVariant child(const Step& step) const {
+        JsonVariant result(*this);
+        result.path.push_back(step);
+        return result;
+    }
+    bool hasType(JsonNode::Type type) const {
+        const JsonNode* node = resolve();
+        return node && node->type == type;
+    }
+    JsonNode* resolve() const {
+        JsonNode* node = root;
+        for (const Step& step : path) {
+            if (node == nullptr) return nullptr;
+            if (step.isIndex) {
+                if (node->type != JsonNode::ARRAY || step.index >= node->children.size()) return nullptr;
+                node = &node->children[step.index];
+            } else {
+                if (node->type != JsonNode::OBJECT) return nullptr;
+                node = node->member(step.key);
+            }
+        }
+        return node;
+    }
+    JsonNode& create() {
+        JsonNode* node = root;
+        for (const Step& step : path) {
+            if (step.isIndex) {
+                if (node->type != JsonNode::ARRAY) { node->reset(); node->type = JsonNode::ARRAY; }
+                while (node->children.size() <= step.index) node->children.push_back(JsonNode());
+                node = &node->children[step.index];
+            } else {
+                if (node->type != JsonNode::OBJECT) { node->reset(); node->type = JsonNode::OBJECT; }
+                JsonNode* existing = node->member(step.key);
+                if (existing == nullptr) {
+                    node->keys.push_back(step.key);
+                    node->children.push_back(JsonNode());
+                    existing = &node->children.back();
+                }
+                node = existing;
+            }
+        }
+        return *node;
+    }
+};
+
+// Null unless the variant it was taken from holds an object
+class JsonObject : public JsonVariant {
+public:
+    JsonObject() {}
+    JsonObject(const JsonVariant& variant) : JsonVariant(variant) {
+        const JsonNode* node = resolve();
+        if (node == nullptr || node->type != JsonNode::OBJECT) root = nullptr;
+    }
+};
+
+class JsonDocument {
+public:
+    explicit JsonDocument(size_t capacity) : _capacity(capacity), _used(0) {}
+
+    JsonVariant operator[](const char* key) { return JsonVariant(&_root)[key]; }
+    JsonVariant operator[](int index) { return JsonVariant(&_root)[index]; }
+    operator JsonVariant() { return JsonVariant(&_root); }
+    template <typename T>
+    T as() { return JsonVariant(&_root).as<T>(); }
+    bool isNull() const { return _root.type == JsonNode::NUL; }
+    size_t capacity() const { return _capacity; }
+    size_t memoryUsage() const { return _used; }
+    void clear() {
+        _root.reset();
+        _strings.clear();
+        _used = 0;
+    }
+
+    // --- Used by deserializeJson() ---
+    JsonNode& root() { return _root; }
+    const JsonNode& root() const { return _root; }
+    bool charge(size_t bytes) {
+        if (_used + bytes > _capacity) return false;
+        _used += bytes;
+        return true;
+    }
+    bool chargeString(const std::string& text) {
+        if (_strings.count(text)) return true; // Deduplicated, like the library
+        if (!charge(text.size() + 1)) return false;
+        _strings.insert(text);
+        return true;
+    }
+
+private:
+    JsonNode _root;
+    std::set<std::string> _strings;
+    size_t _capacity;
+    size_t _used;
+};
+
+template <size_t N>
+class StaticJsonDocument : public JsonDocument {
+public:
+    StaticJsonDocument() : JsonDocument(N) {}
+};
+
+class DeserializationError {
+public:
+    enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+    DeserializationError(Code code = Ok) : _code(code) {}
+    explicit operator bool() const { return _code != Ok; }
+    bool operator==(Code code) const { return _code == code; }
+    bool operator!=(Code code) const { return _code != code; }
+    Code code() const { return _code; }
+    const char* c_str() const {
+        static const char* const NAMES[] = { "Ok", "EmptyInput", "IncompleteInput", "InvalidInput", "NoMemory", "TooDeep" };
+        return NAMES[_code];
+    }
+    const char* f_str() const { return c_str(); }
+
+private:
+    Code _code;
+};
+
+namespace DeserializationOption {
+class Filter {
+public:
+    explicit Filter(const JsonDocument& document) : node(&document.root()) {}
+    const JsonNode* node;
+};
+}
+
+// --- PARSER ---
+// Reads one character at a time and never past the end of the value.
+class HostJsonParser {
+public:
+    HostJsonParser(JsonDocument& document, Stream& input) : _doc(document), _input(input), _current(-2) {}
+
+    DeserializationError parse(const JsonNode* filter) {
+        _doc.clear();
+        skipSpace();
+        if (peek() < 0) return DeserializationError::EmptyInput;
+        return value(_doc.root(), filter, 0);
+    }
+
+private:
+    JsonDocument& _doc;
+    Stream& _input;
+    int _current; // Look-ahead character, -2 = none read yet
+
+    static bool keepsAll(const JsonNode* filter) { return filter && filter->type == JsonNode::BOOL && filter->boolean; }
+    static bool allows(const JsonNode* filter, JsonNode::Type type) {
+        return keepsAll(filter) || (filter && filter->type == type);
+    }
+    static const JsonNode* memberFilter(const JsonNode* filter, const std::string& key) {
+        if (keepsAll(filter)) return filter;
+        if (filter == nullptr || filter->type != JsonNode::OBJECT) return nullptr;
+        JsonNode* member = const_cast<JsonNode*>(filter)->member(key);
+        if (member == nullptr) member = const_cast<JsonNode*>(filter)->member("*");
+        return member && !(member->type == JsonNode::BOOL && !member->boolean) ? member : nullptr;
+    }
+    static const JsonNode* elementFilter(const JsonNode* filter) {
+        if (keepsAll(filter)) return filter;
+        if (filter == nullptr || filter->type != JsonNode::ARRAY || filter->children.empty()) return nullptr;
+        return &filter->children[0];
+    }
+
+    int peek() {
+        if (_current == -2) _current = _input.read();
+        return _current;
+    }
+    int next() {
+        int c = peek();
+        _current = -2;
+        return c;
+    }
+    void skipSpace() {
+        while (peek() == ' ' || peek() == '\t' || peek() == '\r' || peek() == '\n') next();
+    }
+
+    // Parses a value into node, or skips it when filter is nullptr (node may then be nullptr)
+    DeserializationError value(JsonNode& node, const JsonNode* filter, uint8_t depth) {
+        skipSpace();
+        int c = peek();
+        if (c < 0) return DeserializationError::IncompleteInput;
+        if (c == '{') return object(node, allows(filter, JsonNode::OBJECT) ? filter : nullptr, depth);
+        if (c == '[') return array(node, allows(filter, JsonNode::ARRAY) ? filter : nullptr, depth);
+        bool keep = keepsAll(filter);
+        if (c == '"' || c == '\'') {
+            std::string text;
+            DeserializationError error = string(text);
+            if (error) return error;
+            if (keep) {
+                if (!_doc.chargeString(text)) return DeserializationError::NoMemory;
+                node.type = JsonNode::STRING;
+                node.text = text;
+            }
+            return DeserializationError::Ok;
+        }
+        std::string token;
+        while (peek() >= 0 && (isalnum(peek()) || peek() == '-' || peek() == '+' || peek() == '.')) token += (char)next();
+        if (token.empty()) return c < 0 ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+        JsonNode parsed;
+        if (token == "true" || token == "false") {
+            parsed.type = JsonNode::BOOL;
+            parsed.boolean = token == "true";
+        } else if (token == "null") {
+            parsed.type = JsonNode::NUL;
+        } else if (!number(token, parsed)) {
+            return DeserializationError::InvalidInput;
+        }
+        if (keep) node = parsed;
+        return DeserializationError::Ok;
+    }
+
+    static bool number(const std::string& token, JsonNode& node) {
+        const char* start = token.c_str();
+        char* end = nullptr;
+        bool integral = token.find_first_of(".eE") == std::string::npos;
+        if (integral) {
+            errno = 0;
+            long long integer = strtoll(start, &end, 10);
+            if (*end == '\0' && end != start && errno == 0) {
+                node.type = JsonNode::INT;
+                node.integer = integer;
+                return true;
+            }
+        }
+        double real = strtod(start, &end);
+        if (*end != '\0' || end == start) return false;
+        node.type = JsonNode::FLOAT;
+        node.real = real;
+        return true;
+    }
+
+    DeserializationError string(std::string& text) {
+        int quote = next();
+        for (;;) {
+            int c = next();
+            if (c < 0) return DeserializationError::IncompleteInput;
+            if (c == quote) return DeserializationError::Ok;
+            if (c != '\\') {
+                text += (char)c;
+                continue;
+            }
+            c = next();
+            switch (c) {
+                case -1: return DeserializationError::IncompleteInput;
+                case 'b': text += '\b'; break;
+                case 'f': text += '\f'; break;
+                case 'n': text += '\n'; break;
+                case 'r': text += '\r'; break;
+                case 't': text += '\t'; break;
+                case 'u': {
+                    uint32_t code = 0;
+                    DeserializationError error = hex4(code);
+                    if (error) return error;
+                    if (code >= 0xD800 && code < 0xDC00) { // High surrogate: the low one follows
+                        uint32_t low = 0;
+                        if (next() != '\\' || next() != 'u') return DeserializationError::InvalidInput;
+                        error = hex4(low);
+                        if (error) return error;
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    utf8(code, text);
+                    break;
+                }
+                default: text += (char)c; break; // \" \\ \/
+            }
+        }
+    }
+
+    DeserializationError hex4(uint32_t& code) {
+        for (int i = 0; i < 4; i++) {
+            int c = next();
+            if (c < 0) return DeserializationError::IncompleteInput;
+            if (!isxdigit(c)) return DeserializationError::InvalidInput;
+            code = code * 16 + (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+        }
+        return DeserializationError::Ok;
+    }
+
+    static void utf8(uint32_t code, std::string& text) {
+        if (code < 0x80) {
+            text += (char)code;
+        } else if (code < 0x800) {
+            text += (char)(0xC0 | (code >> 6));
+            text += (char)(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            text += (char)(0xE0 | (code >> 12));
+            text += (char)(0x80 | ((code >> 6) & 0x3F));
+            text += (char)(0x80 | (code & 0x3F));
+        } else {
+            text += (char)(0xF0 | (code >> 18));
+            text += (char)(0x80 | ((code >> 12) & 0x3F));
+            text += (char)(0x80 | ((code >> 6) & 0x3F));
+            text += (char)(0x80 | (code & 0x3F));
+        }
+    }
+
+    DeserializationError object(JsonNode& node, const JsonNode* filter, uint8_t depth) {
+        if (depth >= JSON_NESTING_LIMIT) return DeserializationError::TooDeep;
+        next(); // '{'
+        if (filter) {
+            node.reset();
+            node.type = JsonNode::OBJECT;
+        }
+        skipSpace();
+        if (peek() == '}') {
+            next();
+            return DeserializationError::Ok;
+        }
+        for (;;) {
+            skipSpace();
+            if (peek() < 0) return DeserializationError::IncompleteInput;
+            if (peek() != '"' && peek() != '\'') return DeserializationError::InvalidInput;
+            std::string key;
+            DeserializationError error = string(key);
+            if (error) return error;
+            skipSpace();
+            int c = next();
+            if (c < 0) return DeserializationError::IncompleteInput;
+            if (c != ':') return DeserializationError::InvalidInput;
+
+            const JsonNode* keyFilter = filter ? memberFilter(filter, key) : nullptr;
+            JsonNode ignored;
+            JsonNode* target = &ignored;
+            if (keyFilter) {
+                target = node.member(key);
+                if (target == nullptr) {
+                    if (!_doc.charge(JSON_SLOT_SIZE) || !_doc.chargeString(key)) return DeserializationError::NoMemory;
+                    node.keys.push_back(key);
+                    node.children.push_back(JsonNode());
+                    target = &node.children.back();
+                }
+            }
+            error = value(*target, keyFilter, depth + 1);
+            if (error) return error;
+
+            skipSpace();
+            c = next();
+            if (c < 0) return DeserializationError::IncompleteInput;
+            if (c == '}') return DeserializationError::Ok;
+            if (c != ',') return DeserializationError::InvalidInput;
+        }
+    }
+
+    DeserializationError array(JsonNode& node, const JsonNode* filter, uint8_t depth) {
+        if (depth >= JSON_NESTING_LIMIT) return DeserializationError::TooDeep;
+        next(); // '['
+        if (filter) {
+            node.reset();
+            node.type = JsonNode::ARRAY;
+        }
+        const JsonNode* itemFilter = filter ? elementFilter(filter) : nullptr;
+        skipSpace();
+        if (peek() == ']') {
+            next();
+            return DeserializationError::Ok;
+        }
+        for (;;) {
+            JsonNode item;
+            DeserializationError error = value(item, itemFilter, depth + 1);
+            if (error) return error;
+            if (itemFilter) {
+                if (!_doc.charge(JSON_SLOT_SIZE)) return DeserializationError::NoMemory;
+                node.children.push_back(item);
+            }
+            skipSpace();
+            int c = next();
+            if (c < 0) return DeserializationError::IncompleteInput;
+            if (c == ']') return DeserializationError::Ok;
+            if (c != ',') return DeserializationError::InvalidInput;
+        }
+    }
+};
+
+inline DeserializationError deserializeJson(JsonDocument& document, Stream& input, DeserializationOption::Filter filter) {
+    return HostJsonParser(document, input).parse(filter.node);
+}
+
+inline DeserializationError deserializeJson(JsonDocument& document, Stream& input) {
+    static JsonNode keepAll;
+    keepAll.type = JsonNode::BOOL;
+    keepAll.boolean = true;
+    return HostJsonParser(document, input).parse(&keepAll);
+}
+
+#endif // HOST_ARDUINOJSON_H
@@ -0,0 +1,47 @@
+#!/bin/sh
+# Builds and runs the host tests: each test/test_*.cpp includes the sketch
+# modules it covers and links against the stand-ins in test/host.
+#
+#   test/run_tests.sh [name...]     e.g. test/run_tests.sh config_store
+#
+# Tests whose first line reads "// requires: ArduinoJson" build against the real
+# library when ARDUINOJSON_DIR points at its src/ directory (default: the Arduino
+# IDE library folder). Without it they fall back to the stand-in in
+# test/host/json, and say so: that checks the parsers' logic and document sizes
+# against a model of ArduinoJson 6, not against the library itself.
+
+cd "$(dirname "$0")/.." || exit 1
+CXX=${CXX:-g++}
+BUILD=${BUILD:-test/build}
+ARDUINOJSON_DIR=${ARDUINOJSON_DIR:-$HOME/Arduino/libraries/ArduinoJson/src}
+mkdir -p "$BUILD"
+
+if [ $# -gt 0 ]; then
+    tests=""
+    for name in "$@"; do tests="$tests test/test_$name.cpp"; done
+else
+    tests=$(ls test/test_*.cpp)
+fi
+
+failed=0
+for source in $tests; do
+    name=$(basename "$source" .cpp)
+    flags=""
+    if head -n 1 "$source" | grep -q "requires: ArduinoJson"; then
+        if [ -f "$ARDUINOJSON_DIR/ArduinoJson.h" ]; then
+            flags="-I$ARDUINOJSON_DIR"
+        else
+            echo "$name: ArduinoJson not found in $ARDUINOJSON_DIR, using the stand-in in test/host/json"
+            flags="-Itest/host/json"
+        fi
+    fi
+    if ! $CXX -std=gnu++11 -Wall -Wno-sign-compare -g -Itest/host $flags -I. \
+            "$source" test/host/host_stubs.cpp -o "$BUILD/$name"; then
+        echo "$name: BUILD FAILED"
+        failed=$((failed + 1))
+        continue
+    fi
+    "$BUILD/$name" || failed=$((failed + 1))
+done
+
+[ $failed -eq 0 ] || { echo "$failed test(s) failed"; exit 1; }
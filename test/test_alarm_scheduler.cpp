@@ -0,0 +1,205 @@
+// Alarm scheduling: next fire times across DST changes and month/year ends,
+// the fire-time heap, and snoozes (including one-shots and deep sleep).
+#include "host_test.h"
+#include "../AlarmScheduler.cpp"
+#include "../AlarmHandler.cpp"
+
+TFT_eSPI tft;
+const int DISPLAY_WIDTH = 320;
+const int DISPLAY_HEIGHT = 240;
+bool backlight_state = true;
+unsigned long lastActivityTime = 0;
+Preferences preferences;
+void toggleBacklight() { backlight_state = !backlight_state; }
+void applyTheme(bool) {}
+
+static const char* BERLIN = "CET-1CEST,M3.5.0,M10.5.0/3";
+static const char* NEW_YORK = "EST5EDT,M3.2.0,M11.1.0";
+
+static void useZone(const char* rule) {
+    setenv("TZ", rule, 1);
+    tzset();
+}
+
+static time_t utc(int year, int month, int day, int hour, int minute) {
+    struct tm t = {};
+    t.tm_year = year - 1900;
+    t.tm_mon = month - 1;
+    t.tm_mday = day;
+    t.tm_hour = hour;
+    t.tm_min = minute;
+    return timegm(&t);
+}
+
+static AlarmEntry makeEntry(uint8_t weekdays, uint8_t hour, uint8_t minute) {
+    AlarmEntry entry = {};
+    entry.flags = ALARM_FLAG_ENABLED;
+    entry.weekdays = weekdays;
+    entry.hour = hour;
+    entry.minute = minute;
+    entry.action = ALARM_ACTION_ALERT;
+    entry.snooze_min = 9;
+    return entry;
+}
+
+static const uint8_t EVERY_DAY = 0x7F;
+
+static void testDaylightSavingChanges() {
+    useZone(BERLIN);
+    // 07:00 local is 06:00 UTC before the spring change and 05:00 UTC after it
+    AlarmEntry seven = makeEntry(EVERY_DAY, 7, 0);
+    CHECK_EQ(alarmNextFire(seven, utc(2026, 3, 28, 0, 0), false), utc(2026, 3, 28, 6, 0));
+    CHECK_EQ(alarmNextFire(seven, utc(2026, 3, 28, 6, 0), true), utc(2026, 3, 29, 5, 0));
+
+    // 02:30 does not exist on 29 March: it moves forward by the gap (03:30 CEST)
+    AlarmEntry skipped = makeEntry(EVERY_DAY, 2, 30);
+    CHECK_EQ(alarmNextFire(skipped, utc(2026, 3, 28, 12, 0), false), utc(2026, 3, 29, 1, 30));
+    CHECK_EQ(alarmNextFire(skipped, utc(2026, 3, 29, 1, 30), true), utc(2026, 3, 30, 0, 30));
+
+    // 02:30 happens twice on 25 October: it fires once, then on the next day
+    AlarmEntry repeated = makeEntry(EVERY_DAY, 2, 30);
+    time_t first = alarmNextFire(repeated, utc(2026, 10, 24, 12, 0), false);
+    CHECK(first == utc(2026, 10, 25, 0, 30) || first == utc(2026, 10, 25, 1, 30));
+    CHECK_EQ(alarmNextFire(repeated, first, true), utc(2026, 10, 26, 1, 30));
+
+    useZone(NEW_YORK);
+    // US change on 8 March 2026: 06:30 EST (11:30 UTC) becomes 06:30 EDT (10:30 UTC)
+    AlarmEntry early = makeEntry(EVERY_DAY, 6, 30);
+    CHECK_EQ(alarmNextFire(early, utc(2026, 3, 7, 11, 30), true), utc(2026, 3, 8, 10, 30));
+    // And back on 1 November
+    CHECK_EQ(alarmNextFire(early, utc(2026, 10, 31, 10, 30), true), utc(2026, 11, 1, 11, 30));
+}
+
+static void testMonthAndYearEnds() {
+    useZone(BERLIN);
+    AlarmEntry six = makeEntry(EVERY_DAY, 6, 0);
+    CHECK_EQ(alarmNextFire(six, utc(2026, 1, 31, 22, 0), false), utc(2026, 2, 1, 5, 0));
+    CHECK_EQ(alarmNextFire(six, utc(2027, 2, 28, 5, 0), true), utc(2027, 3, 1, 5, 0));   // Not a leap year
+    CHECK_EQ(alarmNextFire(six, utc(2028, 2, 28, 5, 0), true), utc(2028, 2, 29, 5, 0));  // Leap year
+    CHECK_EQ(alarmNextFire(six, utc(2026, 4, 30, 4, 0), true), utc(2026, 5, 1, 4, 0));
+    CHECK_EQ(alarmNextFire(six, utc(2026, 12, 31, 5, 0), true), utc(2027, 1, 1, 5, 0));
+
+    // Weekday masks: Monday only (bit 1), asked on Friday 30 October 2026
+    AlarmEntry monday = makeEntry(0x02, 8, 15);
+    CHECK_EQ(alarmNextFire(monday, utc(2026, 10, 30, 12, 0), false), utc(2026, 11, 2, 7, 15));
+    // Sunday only (bit 0) across the year end: Sunday 3 January 2027
+    AlarmEntry sunday = makeEntry(0x01, 9, 0);
+    CHECK_EQ(alarmNextFire(sunday, utc(2026, 12, 28, 12, 0), false), utc(2027, 1, 3, 8, 0));
+
+    // One-shot: next occurrence of the time, today or tomorrow; disabled entries never fire
+    AlarmEntry once = makeEntry(0, 21, 0);
+    CHECK_EQ(alarmNextFire(once, utc(2026, 6, 10, 12, 0), false), utc(2026, 6, 10, 19, 0));
+    CHECK_EQ(alarmNextFire(once, utc(2026, 6, 10, 20, 0), false), utc(2026, 6, 11, 19, 0));
+    once.flags = 0;
+    CHECK_EQ(alarmNextFire(once, utc(2026, 6, 10, 12, 0), false), 0);
+}
+
+static void testHeapOrder() {
+    AlarmHeap heap;
+    alarmHeapClear(heap);
+    const time_t fires[] = { 500, 100, 900, 300, 700, 200, 800, 600, 400 };
+    for (uint8_t i = 0; i < sizeof(fires) / sizeof(fires[0]); i++) {
+        CHECK(alarmHeapPush(heap, fires[i], i, false));
+    }
+    time_t previous = 0;
+    while (heap.count > 0) {
+        CHECK(heap.nodes[0].fire >= previous);
+        previous = heap.nodes[0].fire;
+        alarmHeapPop(heap);
+    }
+    CHECK_EQ(previous, 900);
+
+    for (uint8_t i = 0; i < ALARM_HEAP_CAPACITY; i++) CHECK(alarmHeapPush(heap, 1000 + i, 0, false));
+    CHECK(!alarmHeapPush(heap, 1, 0, false));
+}
+
+// Snoozes are taken from the system clock: these tests schedule slot 0 for the
+// next whole minute and drive serviceAlarms() from there
+static time_t nextMinute(AlarmEntry& entry, uint8_t weekdays) {
+    time_t fire = (time(nullptr) / 60 + 1) * 60;
+    struct tm local;
+    localtime_r(&fire, &local);
+    entry = makeEntry(weekdays, local.tm_hour, local.tm_min);
+    return fire;
+}
+
+// Fires slot 0 at its time and snoozes it from the alert
+static time_t fireAndSnooze(time_t fire) {
+    serviceAlarms(fire);
+    CHECK(alarmAlertActive());
+    CHECK(alarmHandleTouch(1, 160, ALARM_SNOOZE_ZONE_Y + 20));
+    CHECK(!alarmAlertActive());
+    CHECK(snoozeFire[0] > fire);
+    return snoozeFire[0];
+}
+
+static void testSnoozedOneShotRingsAgain() {
+    useZone(BERLIN);
+    hostNvs.keys.clear();
+    loadAlarms();
+    time_t fire = nextMinute(alarmEntries[0], 0);
+    saveAlarms();
+
+    serviceAlarms(fire - 30);
+    time_t snooze = fireAndSnooze(fire);
+    CHECK_EQ(alarmEntries[0].flags & ALARM_FLAG_ENABLED, 0); // The one-shot itself is done
+    CHECK_EQ(alarmSecondsUntilNext(snooze - 60), 60);
+
+    serviceAlarms(snooze - 60);
+    CHECK(!alarmAlertActive());
+    serviceAlarms(snooze);
+    CHECK(alarmAlertActive());
+    CHECK_EQ(snoozeFire[0], 0);
+    alarmHandleTouch(1, 160, 20); // Dismiss
+    CHECK_EQ(alarmSecondsUntilNext(snooze), 0);
+}
+
+// The heap is rebuilt from scratch after deep sleep; the snooze comes back from RTC memory
+static void testSnoozeSurvivesDeepSleep() {
+    hostNvs.keys.clear();
+    loadAlarms();
+    time_t fire = nextMinute(alarmEntries[0], EVERY_DAY);
+    saveAlarms();
+    time_t tomorrow = alarmNextFire(alarmEntries[0], fire, true);
+
+    serviceAlarms(fire - 30);
+    time_t snooze = fireAndSnooze(fire);
+
+    // Wake: RAM state is gone, RTC memory (snoozeFire) is kept
+    alarmHeapClear(alarmHeap);
+    loadAlarms();
+    serviceAlarms(snooze - 120);
+    CHECK_EQ(alarmSecondsUntilNext(snooze - 120), 120);
+    serviceAlarms(snooze);
+    CHECK(alarmAlertActive());
+    alarmHandleTouch(1, 160, 20);
+    // The repeating entry keeps its own next occurrence
+    CHECK_EQ(alarmSecondsUntilNext(snooze), tomorrow - snooze);
+
+}
+
+static void testEditDropsSnooze() {
+    hostNvs.keys.clear();
+    loadAlarms();
+    time_t fire = nextMinute(alarmEntries[0], 0);
+    saveAlarms();
+    serviceAlarms(fire - 30);
+    time_t snooze = fireAndSnooze(fire);
+
+    saveAlarms();
+    CHECK_EQ(snoozeFire[0], 0);
+    serviceAlarms(fire + 60);
+    CHECK_EQ(alarmSecondsUntilNext(fire + 60), 0);
+    serviceAlarms(snooze);
+    CHECK(!alarmAlertActive());
+}
+
+int main() {
+    testDaylightSavingChanges();
+    testMonthAndYearEnds();
+    testHeapOrder();
+    testSnoozedOneShotRingsAgain();
+    testSnoozeSurvivesDeepSleep();
+    testEditDropsSnooze();
+    return hostTestResult("test_alarm_scheduler");
+}
@@ -0,0 +1,313 @@
+// Settings store: blob migration from every historical layout, per-field keys,
+// and save coalescing.
+#include "host_test.h"
+#include "../ConfigStore.cpp"
+
+userConfig_t userConfig;
+Preferences preferences;
+
+// Current settings with a distinct value in every field
+static userConfig_t sampleConfig() {
+    userConfig_t config;
+    configSetDefaults(config);
+    strcpy(config.ssid, "home-net");
+    strcpy(config.password, "hunter22");
+    strcpy(config.weather_api_key, "0123456789abcdef");
+    config.gmt_offset_hr = 2;
+    config.sleep_timeout_min = 9;
+    config.time_format_24h = true;
+    config.use_fahrenheit = false;
+    config.use_city_id_mode = true;
+    strcpy(config.weather_city, "Paris");
+    strcpy(config.weather_country_code, "FR");
+    strcpy(config.weather_city_id, "2988507");
+    config.use_multi_color_icons = false;
+    config.weather_view = 2;
+    config.weather_provider = WEATHER_PROVIDER_OPENMETEO;
+    config.latitude = 48.85f;
+    config.longitude = 2.35f;
+    config.weather_daily_quota = 77;
+    strcpy(config.extra_locations[1].city, "Oslo");
+    strcpy(config.extra_locations[1].country_code, "NO");
+    config.auto_theme = true;
+    strcpy(config.tz_name, "Europe/Paris");
+    config.power_profiles[2].weekdays = 0x41;
+    config.power_profiles[2].start_hour = 22;
+    strcpy(config.update_password, "swordfish9");
+    return config;
+}
+
+static void storeBlob(const void* blob, size_t size) {
+    hostNvs.keys.clear();
+    preferences.putBytes(LEGACY_BLOB_KEY, blob, size);
+}
+
+// --- RELEASE FIXTURES ---
+// userConfig_t exactly as each release before per-field keys declared it (and
+// wrote it with putBytes). Each release appended fields to the previous one.
+#define RELEASE_BASELINE_FIELDS \
+    char ssid[32]; char password[64]; char weather_api_key[40]; \
+    int gmt_offset_hr; int sleep_timeout_min; \
+    bool time_format_24h; bool use_fahrenheit; bool use_city_id_mode; \
+    char weather_city[40]; char weather_country_code[4]; char weather_city_id[12]; \
+    bool use_multi_color_icons;
+#define RELEASE_FORECAST_FIELDS  RELEASE_BASELINE_FIELDS uint8_t weather_view;
+#define RELEASE_PROVIDER_FIELDS  RELEASE_FORECAST_FIELDS uint8_t weather_provider; float latitude; float longitude;
+#define RELEASE_QUOTA_FIELDS     RELEASE_PROVIDER_FIELDS uint16_t weather_daily_quota;
+#define RELEASE_LOCATIONS_FIELDS RELEASE_QUOTA_FIELDS weatherLocation_t extra_locations[3];
+#define RELEASE_SOLAR_FIELDS     RELEASE_LOCATIONS_FIELDS bool auto_theme;
+#define RELEASE_ZONE_FIELDS      RELEASE_SOLAR_FIELDS char tz_name[40];
+#define RELEASE_QUIET_FIELDS     RELEASE_ZONE_FIELDS powerProfile_t power_profiles[3];
+#define RELEASE_UPDATE_FIELDS    RELEASE_QUIET_FIELDS char update_password[32];
+
+struct ReleaseBaseline  { RELEASE_BASELINE_FIELDS };
+struct ReleaseForecast  { RELEASE_FORECAST_FIELDS };   // Weather view
+struct ReleaseProvider  { RELEASE_PROVIDER_FIELDS };   // Provider and coordinates
+struct ReleaseQuota     { RELEASE_QUOTA_FIELDS };      // Daily quota
+struct ReleaseLocations { RELEASE_LOCATIONS_FIELDS };  // Extra locations
+struct ReleaseSolar     { RELEASE_SOLAR_FIELDS };      // Automatic theme
+struct ReleaseZone      { RELEASE_ZONE_FIELDS };       // Time zone name
+struct ReleaseQuiet     { RELEASE_QUIET_FIELDS };      // Quiet hours
+struct ReleaseUpdate    { RELEASE_UPDATE_FIELDS };     // Update password (last blob release)
+
+// fillX() sets the fields added up to release X, with values unlike the defaults
+template <class Release> static void fillBaseline(Release& r) {
+    memset(&r, 0, sizeof(r));
+    strcpy(r.ssid, "attic");
+    strcpy(r.password, "correct horse");
+    strcpy(r.weather_api_key, "feedfacecafebeef");
+    r.gmt_offset_hr = -3;
+    r.sleep_timeout_min = 42;
+    r.time_format_24h = false;
+    r.use_fahrenheit = true;
+    r.use_city_id_mode = false;
+    strcpy(r.weather_city, "Sao Paulo");
+    strcpy(r.weather_country_code, "BR");
+    strcpy(r.weather_city_id, "3448439");
+    r.use_multi_color_icons = false;
+}
+template <class Release> static void fillForecast(Release& r) { r.weather_view = 1; }
+template <class Release> static void fillProvider(Release& r) {
+    fillForecast(r);
+    r.weather_provider = WEATHER_PROVIDER_OPENMETEO;
+    r.latitude = -23.55f;
+    r.longitude = -46.63f;
+}
+template <class Release> static void fillQuota(Release& r) { fillProvider(r); r.weather_daily_quota = 500; }
+template <class Release> static void fillLocations(Release& r) {
+    fillQuota(r);
+    strcpy(r.extra_locations[0].city_id, "3451190");
+    strcpy(r.extra_locations[2].city, "Lisbon");
+    strcpy(r.extra_locations[2].country_code, "PT");
+}
+template <class Release> static void fillSolar(Release& r) { fillLocations(r); r.auto_theme = true; }
+template <class Release> static void fillZone(Release& r) { fillSolar(r); strcpy(r.tz_name, "America/Sao_Paulo"); }
+template <class Release> static void fillQuiet(Release& r) {
+    fillZone(r);
+    r.power_profiles[0] = { 0x3E, 22, 30, 6, 45, POWER_MODE_DIM, 15, 4 };
+}
+template <class Release> static void fillUpdate(Release& r) { fillQuiet(r); strcpy(r.update_password, "open sesame"); }
+
+// Stores the release's blob at its own sizeof, loads it and checks that every
+// field it held came through unchanged
+template <class Release> static void checkRelease(const char* name, const Release& release, int fields) {
+    storeBlob(&release, sizeof(release));
+    configStoreLoad();
+    printf("  %s release: %u-byte blob\n", name, (unsigned)sizeof(release));
+    CHECK(!preferences.isKey(LEGACY_BLOB_KEY));
+
+    userConfig_t defaults;
+    configSetDefaults(defaults);
+    CHECK_STR(userConfig.ssid, "attic");
+    CHECK_STR(userConfig.password, "correct horse");
+    CHECK_STR(userConfig.weather_api_key, "feedfacecafebeef");
+    CHECK_EQ(userConfig.gmt_offset_hr, -3);
+    CHECK_EQ(userConfig.sleep_timeout_min, 42);
+    CHECK_EQ(userConfig.time_format_24h, false);
+    CHECK_EQ(userConfig.use_fahrenheit, true);
+    CHECK_EQ(userConfig.use_city_id_mode, false);
+    CHECK_STR(userConfig.weather_city, "Sao Paulo");
+    CHECK_STR(userConfig.weather_country_code, "BR");
+    CHECK_STR(userConfig.weather_city_id, "3448439");
+    CHECK_EQ(userConfig.use_multi_color_icons, false);
+    CHECK_EQ(userConfig.weather_view, fields >= 1 ? 1 : defaults.weather_view);
+    CHECK_EQ(userConfig.weather_provider, fields >= 2 ? WEATHER_PROVIDER_OPENMETEO : defaults.weather_provider);
+    CHECK_NEAR(userConfig.latitude, fields >= 2 ? -23.55f : defaults.latitude, 1e-4);
+    CHECK_NEAR(userConfig.longitude, fields >= 2 ? -46.63f : defaults.longitude, 1e-4);
+    CHECK_EQ(userConfig.weather_daily_quota, fields >= 3 ? 500 : defaults.weather_daily_quota);
+    CHECK_STR(userConfig.extra_locations[0].city_id, fields >= 4 ? "3451190" : "");
+    CHECK_STR(userConfig.extra_locations[2].city, fields >= 4 ? "Lisbon" : "");
+    CHECK_EQ(userConfig.auto_theme, fields >= 5);
+    CHECK_STR(userConfig.tz_name, fields >= 6 ? "America/Sao_Paulo" : "");
+    CHECK_EQ(userConfig.power_profiles[0].weekdays, fields >= 7 ? 0x3E : 0);
+    CHECK_EQ(userConfig.power_profiles[0].end_minute, fields >= 7 ? 45 : 0);
+    CHECK_EQ(userConfig.power_profiles[0].weather_factor, fields >= 7 ? 4 : 3);
+    CHECK_STR(userConfig.update_password, fields >= 8 ? "open sesame" : "");
+    // Fields added after the last blob release start from their defaults
+    CHECK_STR(userConfig.theme_dark, defaults.theme_dark);
+    CHECK_EQ(userConfig.static_ip[0], '\0');
+    CHECK_EQ(userConfig.extra_networks[0].ssid[0], '\0');
+}
+
+// Every release that stored a blob upgrades with its settings intact
+static void testReleaseUpgrades() {
+    ReleaseBaseline baseline; fillBaseline(baseline);
+    checkRelease("baseline", baseline, 0);
+    ReleaseForecast forecast; fillBaseline(forecast); fillForecast(forecast);
+    checkRelease("forecast", forecast, 1);
+    ReleaseProvider provider; fillBaseline(provider); fillProvider(provider);
+    checkRelease("provider", provider, 2);
+    ReleaseQuota quota; fillBaseline(quota); fillQuota(quota);
+    checkRelease("quota", quota, 3);
+    ReleaseLocations locations; fillBaseline(locations); fillLocations(locations);
+    checkRelease("locations", locations, 4);
+    ReleaseSolar solar; fillBaseline(solar); fillSolar(solar);
+    checkRelease("solar", solar, 5);
+    ReleaseZone zone; fillBaseline(zone); fillZone(zone);
+    checkRelease("zone", zone, 6);
+    ReleaseQuiet quiet; fillBaseline(quiet); fillQuiet(quiet);
+    checkRelease("quiet hours", quiet, 7);
+    ReleaseUpdate update; fillBaseline(update); fillUpdate(update);
+    checkRelease("update password", update, 8);
+}
+
+// A blob truncated to each historical layout keeps what that release stored
+// and gets defaults for the rest
+static void testEveryLayout() {
+    const userConfig_t full = sampleConfig();
+    userConfig_t defaults;
+    configSetDefaults(defaults);
+    const size_t align = alignof(userConfig_t);
+
+    for (uint8_t i = 0; i < LEGACY_LAYOUT_COUNT; i++) {
+        size_t valid = LEGACY_LAYOUTS[i];
+        size_t size = (valid + align - 1) / align * align;
+        uint8_t blob[sizeof(userConfig_t)];
+        memset(blob, 0, sizeof(blob));
+        memcpy(blob, &full, valid);
+        storeBlob(blob, size);
+        configStoreLoad();
+        printf("  layout %u: %u bytes\n", i, (unsigned)size);
+
+        CHECK(!preferences.isKey(LEGACY_BLOB_KEY));
+        CHECK_EQ(preferences.getUChar(SCHEMA_KEY, 0), CONFIG_SCHEMA_VERSION);
+        CHECK_STR(userConfig.ssid, "home-net");
+        CHECK_STR(userConfig.password, "hunter22");
+        CHECK_STR(userConfig.weather_api_key, "0123456789abcdef");
+        CHECK_EQ(userConfig.gmt_offset_hr, 2);
+        CHECK_EQ(userConfig.sleep_timeout_min, 9);
+        CHECK_STR(userConfig.weather_city_id, "2988507");
+        CHECK_EQ(userConfig.use_multi_color_icons, false);
+
+        bool hasView = valid > offsetof(userConfig_t, weather_view);
+        bool hasProvider = valid > offsetof(userConfig_t, weather_provider);
+        bool hasQuota = valid > offsetof(userConfig_t, weather_daily_quota);
+        bool hasLocations = valid > offsetof(userConfig_t, extra_locations);
+        bool hasZone = valid > offsetof(userConfig_t, tz_name);
+        bool hasProfiles = valid > offsetof(userConfig_t, power_profiles);
+        bool hasPassword = valid > offsetof(userConfig_t, update_password);
+        CHECK_EQ(userConfig.weather_view, hasView ? 2 : defaults.weather_view);
+        CHECK_EQ(userConfig.weather_provider, hasProvider ? WEATHER_PROVIDER_OPENMETEO : defaults.weather_provider);
+        CHECK_NEAR(userConfig.latitude, hasProvider ? 48.85f : defaults.latitude, 1e-4);
+        CHECK_EQ(userConfig.weather_daily_quota, hasQuota ? 77 : defaults.weather_daily_quota);
+        CHECK_STR(userConfig.extra_locations[1].city, hasLocations ? "Oslo" : "");
+        CHECK_EQ(userConfig.power_profiles[2].weekdays, hasProfiles ? 0x41 : 0);
+        CHECK_EQ(userConfig.power_profiles[1].end_hour, 6);
+        CHECK_STR(userConfig.update_password, hasPassword ? "swordfish9" : "");
+        CHECK_STR(userConfig.theme_dark, THEME_DEFAULT_DARK);
+        // No zone name stored: the manual offset stays in charge, not the default zone
+        CHECK_STR(userConfig.tz_name, hasZone ? "Europe/Paris" : "");
+
+        // Reloading from the per-field keys gives the same settings
+        userConfig_t migrated = userConfig;
+        configStoreLoad();
+        for (uint8_t f = 0; f < configFieldCount(); f++) {
+            CHECK(!configFieldDiffers(configFieldAt(f), migrated, userConfig));
+        }
+    }
+}
+
+// Releases that had no zone name kept the clock on gmt_offset_hr; they must not
+// switch to the default zone (America/New_York) after the upgrade
+static void testPreZoneBlobKeepsManualOffset() {
+    userConfig_t full = sampleConfig();
+    full.gmt_offset_hr = 9;
+    storeBlob(&full, (offsetof(userConfig_t, tz_name) + alignof(userConfig_t) - 1) / alignof(userConfig_t) * alignof(userConfig_t));
+    configStoreLoad();
+    CHECK_EQ(userConfig.tz_name[0], '\0');
+    CHECK_EQ(userConfig.gmt_offset_hr, 9);
+    CHECK_EQ(userConfig.auto_theme, true);
+
+    // A fresh install still starts on the default zone
+    hostNvs.keys.clear();
+    configStoreLoad();
+    CHECK_STR(userConfig.tz_name, "America/New_York");
+}
+
+static void testUnknownBlobStartsFromDefaults() {
+    userConfig_t full = sampleConfig();
+    storeBlob(&full, 300);
+    configStoreLoad();
+    CHECK_EQ(userConfig.ssid[0], '\0');
+    CHECK(!preferences.isKey(LEGACY_BLOB_KEY));
+    CHECK_EQ(preferences.getUChar(SCHEMA_KEY, 0), CONFIG_SCHEMA_VERSION);
+}
+
+// A field added after the device last saved keeps its default; the others stay
+static void testMissingKeyKeepsDefault() {
+    hostNvs.keys.clear();
+    configStoreLoad();
+    userConfig.weather_daily_quota = 12;
+    strcpy(userConfig.weather_city, "Rome");
+    configStoreRequestSave();
+    configStoreFlush();
+    hostNvs.keys.erase("quota");
+    configStoreLoad();
+    CHECK_EQ(userConfig.weather_daily_quota, WEATHER_DEFAULT_DAILY_QUOTA);
+    CHECK_STR(userConfig.weather_city, "Rome");
+}
+
+// Requests inside the coalescing window end up as one write per changed field
+static void testSaveCoalescing() {
+    hostNvs.keys.clear();
+    hostMillis = 0;
+    configStoreLoad();
+    size_t before = hostNvs.writes;
+
+    userConfig.gmt_offset_hr = 3;
+    configStoreRequestSave();
+    hostMillis = 1000;
+    strcpy(userConfig.weather_city, "Rome");
+    configStoreRequestSave();
+    hostMillis = 3500;
+    serviceConfigStore();
+    CHECK_EQ(hostNvs.writes - before, 0);
+    hostMillis = 4001;
+    serviceConfigStore();
+    CHECK_EQ(hostNvs.writes - before, 2);
+
+    // Nothing changed: nothing written
+    configStoreRequestSave();
+    hostMillis = 10000;
+    serviceConfigStore();
+    CHECK_EQ(hostNvs.writes - before, 2);
+
+    // A steady stream of requests is still written within the maximum delay
+    size_t streamStart = hostNvs.writes;
+    for (hostMillis = 20000; hostMillis < 20000 + CONFIG_SAVE_MAX_DELAY_MS + 1000; hostMillis += 1000) {
+        userConfig.sleep_timeout_min++;
+        configStoreRequestSave();
+        serviceConfigStore();
+    }
+    CHECK(hostNvs.writes > streamStart);
+}
+
+int main() {
+    testReleaseUpgrades();
+    testEveryLayout();
+    testPreZoneBlobKeepsManualOffset();
+    testUnknownBlobStartsFromDefaults();
+    testMissingKeyKeepsDefault();
+    testSaveCoalescing();
+    return hostTestResult("test_config_store");
+}
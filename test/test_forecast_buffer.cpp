@@ -0,0 +1,98 @@
+// Forecast ring buffer: slot packing, overwrite-oldest on overflow and
+// expiry of past slots, including across the wrap point.
+#include "host_test.h"
+#include "../ForecastBuffer.cpp"
+
+static const uint32_t SLOT = 3 * 3600; // OWM forecast step
+static const uint32_t START = 1792000000;
+
+static ForecastEntry slot(uint32_t index) {
+    return forecastPack(START + index * SLOT, 10.0f + index, 800, 0.0f, "d");
+}
+
+static void testPacking() {
+    CHECK_EQ(sizeof(ForecastEntry), 12);
+
+    ForecastEntry entry = forecastPack(START, 21.46f, 501, 0.37f, "n");
+    CHECK_EQ(entry.time, START);
+    CHECK_EQ(entry.temp_x10, 215);
+    CHECK_EQ(entry.condition_id, 501);
+    CHECK_EQ(entry.pop, 37);
+    CHECK_EQ(entry.flags, FORECAST_FLAG_NIGHT);
+
+    CHECK_EQ(forecastPack(START, -3.25f, 600, 0.0f, "d").temp_x10, -33); // Rounds away from zero
+    CHECK_EQ(forecastPack(START, -0.04f, 600, 0.0f, "d").temp_x10, 0);
+    CHECK_EQ(forecastPack(START, 5000.0f, 800, 0.0f, "d").temp_x10, INT16_MAX);
+    CHECK_EQ(forecastPack(START, -5000.0f, 800, 0.0f, "d").temp_x10, INT16_MIN);
+    CHECK_EQ(forecastPack(START, 0.0f, 800, 1.0f, "d").pop, 100);
+    CHECK_EQ(forecastPack(START, 0.0f, 800, 1.2f, "d").pop, 100);
+    CHECK_EQ(forecastPack(START, 0.0f, 800, -0.1f, "d").pop, 0);
+    CHECK_EQ(forecastPack(START, 0.0f, 800, 0.0f, "d").flags, 0);
+    CHECK_EQ(forecastPack(START, 0.0f, 800, 0.0f, nullptr).flags, 0);
+}
+
+static void testPushAndOverflow() {
+    ForecastRing ring;
+    forecastRingClear(ring);
+    CHECK_EQ(ring.size, 0);
+    CHECK(forecastRingAt(ring, 0) == nullptr);
+
+    for (uint32_t i = 0; i < 10; i++) forecastRingPush(ring, slot(i));
+    CHECK_EQ(ring.size, 10);
+    for (uint8_t i = 0; i < 10; i++) CHECK_EQ(forecastRingAt(ring, i)->time, START + i * SLOT);
+    CHECK(forecastRingAt(ring, 10) == nullptr);
+
+    // Five past capacity: the five oldest are overwritten, order is kept
+    forecastRingClear(ring);
+    for (uint32_t i = 0; i < FORECAST_CAPACITY + 5; i++) forecastRingPush(ring, slot(i));
+    CHECK_EQ(ring.size, FORECAST_CAPACITY);
+    CHECK_EQ(ring.head, 5);
+    CHECK_EQ(forecastRingAt(ring, 0)->time, START + 5 * SLOT);
+    CHECK_EQ(forecastRingAt(ring, FORECAST_CAPACITY - 1)->time, START + (FORECAST_CAPACITY + 4) * SLOT);
+    CHECK_EQ(forecastRingAt(ring, FORECAST_CAPACITY - 1)->temp_x10, (10 + FORECAST_CAPACITY + 4) * 10);
+    CHECK(forecastRingAt(ring, FORECAST_CAPACITY) == nullptr);
+}
+
+static void testDropPast() {
+    ForecastRing ring;
+    forecastRingClear(ring);
+    for (uint32_t i = 0; i < 8; i++) forecastRingPush(ring, slot(i));
+
+    // Before the first slot starts: nothing to drop
+    forecastRingDropPast(ring, START - 60);
+    CHECK_EQ(ring.size, 8);
+
+    // Inside slot 2: slots 0 and 1 have ended, slot 2 is in progress and stays
+    forecastRingDropPast(ring, START + 2 * SLOT + 600);
+    CHECK_EQ(ring.size, 6);
+    CHECK_EQ(forecastRingAt(ring, 0)->time, START + 2 * SLOT);
+
+    // Exactly at the start of slot 3
+    forecastRingDropPast(ring, START + 3 * SLOT);
+    CHECK_EQ(forecastRingAt(ring, 0)->time, START + 3 * SLOT);
+
+    // Long after the last slot: the last one is kept rather than leaving the strip empty
+    forecastRingDropPast(ring, START + 100 * SLOT);
+    CHECK_EQ(ring.size, 1);
+    CHECK_EQ(forecastRingAt(ring, 0)->time, START + 7 * SLOT);
+
+    // Across the wrap point of a full ring
+    forecastRingClear(ring);
+    for (uint32_t i = 0; i < FORECAST_CAPACITY + 3; i++) forecastRingPush(ring, slot(i));
+    forecastRingDropPast(ring, START + (FORECAST_CAPACITY + 1) * SLOT + 1);
+    CHECK_EQ(ring.size, 2);
+    CHECK_EQ(forecastRingAt(ring, 0)->time, START + (FORECAST_CAPACITY + 1) * SLOT);
+    CHECK_EQ(forecastRingAt(ring, 1)->time, START + (FORECAST_CAPACITY + 2) * SLOT);
+
+    // Pushing after a drop appends behind the newest slot
+    forecastRingPush(ring, slot(FORECAST_CAPACITY + 3));
+    CHECK_EQ(ring.size, 3);
+    CHECK_EQ(forecastRingAt(ring, 2)->time, START + (FORECAST_CAPACITY + 3) * SLOT);
+}
+
+int main() {
+    testPacking();
+    testPushAndOverflow();
+    testDropPast();
+    return hostTestResult("test_forecast_buffer");
+}
@@ -0,0 +1,201 @@
+// Solar times: published sunrise/sunset times, a double-precision NOAA reference
+// over a latitude/longitude/date grid, polar day and night, and the date line.
+#include "host_test.h"
+#include "../SolarCalculator.cpp"
+
+userConfig_t userConfig;
+
+static const double PI_D = 3.14159265358979323846;
+static double rad(double deg) { return deg * PI_D / 180.0; }
+static double deg(double r) { return r * 180.0 / PI_D; }
+
+static time_t utc(int year, int month, int day, int hour, int minute) {
+    struct tm t = {};
+    t.tm_year = year - 1900;
+    t.tm_mon = month - 1;
+    t.tm_mday = day;
+    t.tm_hour = hour;
+    t.tm_min = minute;
+    return timegm(&t);
+}
+
+// Solar times for the local day around a UTC instant, the way the clock computes them
+static SolarTimes timesAt(time_t when, float latitude, float longitude) {
+    SolarTimes times;
+    solarCompute(solarDayFor(when, longitude), latitude, longitude, times);
+    return times;
+}
+
+/**
+ * NOAA "General Solar Position Calculations" (equation of time, apparent
+ * longitude, obliquity with nutation) in double precision, evaluated at local
+ * mean noon. Independent of the single-precision sunrise equation under test.
+ * @return Hour angle in degrees (-1 = never rises, 181 = never sets); noon in UTC seconds.
+ */
+static double noaaHourAngle(uint32_t day, double latitude, double longitude, double altitude, double& noon) {
+    double jd = 2440587.5 + day + 0.5 - longitude / 360.0;
+    double t = (jd - 2451545.0) / 36525.0;
+    double l0 = fmod(280.46646 + t * (36000.76983 + t * 0.0003032), 360.0);
+    double m = 357.52911 + t * (35999.05029 - 0.0001537 * t);
+    double e = 0.016708634 - t * (0.000042037 + 0.0000001267 * t);
+    double c = sin(rad(m)) * (1.914602 - t * (0.004817 + 0.000014 * t)) + sin(rad(2 * m)) * (0.019993 - 0.000101 * t) +
+               sin(rad(3 * m)) * 0.000289;
+    double omega = 125.04 - 1934.136 * t;
+    double lambda = l0 + c - 0.00569 - 0.00478 * sin(rad(omega));
+    double eps0 = 23.0 + (26.0 + (21.448 - t * (46.815 + t * (0.00059 - t * 0.001813))) / 60.0) / 60.0;
+    double eps = eps0 + 0.00256 * cos(rad(omega));
+    double dec = asin(sin(rad(eps)) * sin(rad(lambda)));
+    double y = tan(rad(eps / 2)) * tan(rad(eps / 2));
+    double eot = 4.0 * deg(y * sin(2 * rad(l0)) - 2 * e * sin(rad(m)) + 4 * e * y * sin(rad(m)) * cos(2 * rad(l0)) -
+                           0.5 * y * y * sin(4 * rad(l0)) - 1.25 * e * e * sin(2 * rad(m)));
+    noon = day * 86400.0 + (720.0 - 4.0 * longitude - eot) * 60.0;
+
+    double cosH = (sin(rad(altitude)) - sin(rad(latitude)) * sin(dec)) / (cos(rad(latitude)) * cos(dec));
+    if (cosH > 1.0) return -1.0;
+    if (cosH < -1.0) return 181.0;
+    return deg(acos(cosH));
+}
+
+static void checkPublished(const char* place, time_t when, float latitude, float longitude,
+                           time_t sunrise, time_t sunset) {
+    SolarTimes times = timesAt(when, latitude, longitude);
+    if (fabs((double)times.sunrise - sunrise) > 180 || fabs((double)times.sunset - sunset) > 180) {
+        printf("  %s\n", place);
+    }
+    CHECK_NEAR(times.sunrise, sunrise, 180);
+    CHECK_NEAR(times.sunset, sunset, 180);
+    CHECK_EQ(times.flags, 0);
+    CHECK(times.dawn < times.sunrise && times.sunrise < times.noon);
+    CHECK(times.noon < times.sunset && times.sunset < times.dusk);
+}
+
+// Almanac times (UTC, to the minute) for the solstices of 2024
+static void testPublishedTimes() {
+    checkPublished("London, June", utc(2024, 6, 21, 12, 0), 51.5074f, -0.1278f,
+                   utc(2024, 6, 21, 3, 43), utc(2024, 6, 21, 20, 21));
+    checkPublished("London, December", utc(2024, 12, 21, 12, 0), 51.5074f, -0.1278f,
+                   utc(2024, 12, 21, 8, 3), utc(2024, 12, 21, 15, 53));
+    // New York: sunset falls on the next UTC date
+    checkPublished("New York, June", utc(2024, 6, 20, 17, 0), 40.7128f, -74.0060f,
+                   utc(2024, 6, 20, 9, 25), utc(2024, 6, 21, 0, 31));
+    // Sydney: sunrise falls on the previous UTC date
+    checkPublished("Sydney, December", utc(2024, 12, 21, 2, 0), -33.8688f, 151.2093f,
+                   utc(2024, 12, 20, 18, 41), utc(2024, 12, 21, 9, 5));
+}
+
+// Sunrise, sunset and civil twilight within two minutes of the reference, 60S-60N
+static void testAgainstReference() {
+    double worst = 0;
+    for (uint32_t day = 19723; day < 19723 + 366; day += 5) { // 2024
+        for (int lat = -60; lat <= 60; lat += 15) {
+            for (int lon = -180; lon <= 180; lon += 30) {
+                SolarTimes times;
+                solarCompute(day, (float)lat, (float)lon, times);
+
+                double noon;
+                double sun = noaaHourAngle(day, lat, lon, -0.833, noon);
+                double civil = noaaHourAngle(day, lat, lon, -6.0, noon);
+                double errors[] = {
+                    times.noon - noon,
+                    times.sunrise - (noon - sun * 240.0),
+                    times.sunset - (noon + sun * 240.0),
+                    times.dawn - (noon - civil * 240.0),
+                    times.dusk - (noon + civil * 240.0),
+                };
+                for (double error : errors) {
+                    if (fabs(error) > worst) worst = fabs(error);
+                }
+            }
+        }
+    }
+    if (worst > 120) printf("  worst error against NOAA: %.0f s\n", worst);
+    CHECK(worst <= 120);
+}
+
+static void testPolarDayAndNight() {
+    // Tromso: midnight sun in June, polar night in December with a civil twilight at noon
+    SolarTimes june = timesAt(utc(2024, 6, 21, 12, 0), 69.6492f, 18.9553f);
+    CHECK_EQ(june.flags, SOLAR_FLAG_POLAR_DAY);
+    CHECK_EQ(solarPhaseAt(june, utc(2024, 6, 20, 23, 0)), SOLAR_PHASE_DAY);
+    CHECK_EQ(solarPhaseAt(june, june.noon), SOLAR_PHASE_DAY);
+
+    SolarTimes december = timesAt(utc(2024, 12, 21, 12, 0), 69.6492f, 18.9553f);
+    CHECK_EQ(december.flags, SOLAR_FLAG_POLAR_NIGHT);
+    CHECK_EQ(december.sunrise, december.noon);
+    CHECK_EQ(december.sunset, december.noon);
+    CHECK(december.dawn < december.noon && december.dusk > december.noon);
+    CHECK_EQ(solarPhaseAt(december, december.noon), SOLAR_PHASE_TWILIGHT);
+    CHECK_EQ(solarPhaseAt(december, december.noon - 4 * 3600), SOLAR_PHASE_NIGHT);
+
+    // Longyearbyen in December: too far below the horizon even for twilight
+    SolarTimes svalbard = timesAt(utc(2024, 12, 21, 12, 0), 78.2232f, 15.6267f);
+    CHECK_EQ(svalbard.flags, SOLAR_FLAG_POLAR_NIGHT);
+    CHECK_EQ(svalbard.dawn, svalbard.noon);
+    CHECK_EQ(svalbard.dusk, svalbard.noon);
+    CHECK_EQ(solarPhaseAt(svalbard, svalbard.noon), SOLAR_PHASE_NIGHT);
+
+    // Antarctica (McMurdo) the other way round
+    SolarTimes mcmurdo = timesAt(utc(2024, 12, 21, 0, 0), -77.8460f, 166.6760f);
+    CHECK_EQ(mcmurdo.flags, SOLAR_FLAG_POLAR_DAY);
+    CHECK_EQ(mcmurdo.sunset - mcmurdo.sunrise, 86400);
+    SolarTimes mcmurdoJune = timesAt(utc(2024, 6, 21, 0, 0), -77.8460f, 166.6760f);
+    CHECK_EQ(mcmurdoJune.flags, SOLAR_FLAG_POLAR_NIGHT);
+
+    // First and last polar day of the season in Tromso (reference: about 20 May to 22 July)
+    CHECK_EQ(timesAt(utc(2024, 5, 10, 12, 0), 69.6492f, 18.9553f).flags, 0);
+    CHECK_EQ(timesAt(utc(2024, 5, 25, 12, 0), 69.6492f, 18.9553f).flags, SOLAR_FLAG_POLAR_DAY);
+    CHECK_EQ(timesAt(utc(2024, 7, 18, 12, 0), 69.6492f, 18.9553f).flags, SOLAR_FLAG_POLAR_DAY);
+    CHECK_EQ(timesAt(utc(2024, 8, 1, 12, 0), 69.6492f, 18.9553f).flags, 0);
+}
+
+// The solar day follows the longitude, not the civil date: both sides of the
+// date line see the same sun at the same instant
+static void testDateLine() {
+    const float latitude = -15.0f;
+    for (int hour = 0; hour < 24; hour += 3) {
+        time_t when = utc(2024, 1, 15, hour, 10);
+        SolarTimes east = timesAt(when, latitude, 179.99f);
+        SolarTimes west = timesAt(when, latitude, -179.99f);
+        CHECK_EQ(solarDayFor(when, 179.99f) - solarDayFor(when, -179.99f), 1);
+        CHECK_NEAR((double)east.sunrise, (double)west.sunrise, 60);
+        CHECK_NEAR((double)east.sunset, (double)west.sunset, 60);
+        CHECK_EQ(solarPhaseAt(east, when), solarPhaseAt(west, when));
+    }
+
+    // Auckland (UTC+13 in January) and Apia (UTC+13, but west of the line): each
+    // instant of the day is matched with the sunrise and sunset around it
+    const float places[][2] = { { -36.8485f, 174.7633f }, { -13.8333f, -171.7667f } };
+    for (const auto& place : places) {
+        for (int minute = 0; minute < 24 * 60; minute += 20) {
+            time_t when = utc(2024, 1, 15, 0, 0) + minute * 60;
+            SolarTimes times = timesAt(when, place[0], place[1]);
+            CHECK(when >= (time_t)times.noon - 43200 && when < (time_t)times.noon + 43200);
+        }
+        SolarTimes times = timesAt(utc(2024, 1, 15, 0, 0), place[0], place[1]);
+        CHECK_EQ(solarPhaseAt(times, times.noon), SOLAR_PHASE_DAY);
+        CHECK_EQ(solarPhaseAt(times, times.noon + 43199), SOLAR_PHASE_NIGHT);
+    }
+}
+
+static void testCachedToday() {
+    userConfig.latitude = 51.5074f;
+    userConfig.longitude = -0.1278f;
+    const SolarTimes& first = solarTimesToday();
+    uint32_t day = first.day;
+    CHECK_EQ(day, solarDayFor(time(nullptr), userConfig.longitude));
+    CHECK_EQ(solarTimesToday().sunrise, first.sunrise);
+
+    // New coordinates are picked up without waiting for the next day
+    userConfig.latitude = -33.8688f;
+    userConfig.longitude = 151.2093f;
+    CHECK_NEAR(solarTimesToday().longitude, 151.2093, 0.0001);
+}
+
+int main() {
+    testPublishedTimes();
+    testAgainstReference();
+    testPolarDayAndNight();
+    testDateLine();
+    testCachedToday();
+    return hostTestResult("test_solar_calculator");
+}
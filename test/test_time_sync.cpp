@@ -0,0 +1,254 @@
+// SNTP supervision: the drift estimator (running mean, then exponential average),
+// the adaptive poll interval, drift corrections across deep sleep, and server
+// fallback, against a simulated clock and a recorded SNTP client.
+#include "host_test.h"
+#include "../TimeSync.cpp"
+
+static const uint32_t T0 = 1790000000; // A synced clock
+
+// Offset a clock running 'ppm' slow builds up over 'seconds' (ms, rounded like a real sample)
+static int32_t offsetAfter(float ppm, uint32_t seconds) {
+    return (int32_t)lroundf(ppm * seconds / 1000.0f);
+}
+
+static void testEstimator() {
+    TimeSyncState state = {};
+
+    // The first sync only sets the reference
+    timeSyncRecord(state, T0, 12000);
+    CHECK_EQ(state.drift_samples, 0);
+    CHECK_EQ(state.last_sync_epoch, T0);
+    CHECK_EQ(state.last_offset_ms, 12000);
+    CHECK_EQ(state.sync_count, 1);
+
+    // +36 ms over an hour: the local clock runs 10 ppm slow
+    timeSyncRecord(state, T0 + 3600, 36);
+    CHECK_EQ(state.drift_samples, 1);
+    CHECK_NEAR(state.drift_ppm, 10.0, 0.001);
+
+    // Running mean over the first four samples
+    timeSyncRecord(state, T0 + 7200, 72);     // 20 ppm
+    CHECK_NEAR(state.drift_ppm, 15.0, 0.001);
+    timeSyncRecord(state, T0 + 10800, -54);   // -15 ppm
+    CHECK_NEAR(state.drift_ppm, 5.0, 0.001);
+    timeSyncRecord(state, T0 + 14400, 18);    // 5 ppm
+    CHECK_NEAR(state.drift_ppm, 5.0, 0.001);
+    CHECK_EQ(state.drift_samples, 4);
+
+    // Then an exponential average with weight 1/4
+    timeSyncRecord(state, T0 + 18000, 90);    // 25 ppm
+    CHECK_NEAR(state.drift_ppm, 10.0, 0.001);
+
+    // Steps too large to be drift (boot, manual clock change) and samples too
+    // close together are not folded in, but still reset the reference
+    timeSyncRecord(state, T0 + 21600, TIME_SYNC_MAX_SAMPLE_OFFSET_MS + 1);
+    timeSyncRecord(state, T0 + 25200, -TIME_SYNC_MAX_SAMPLE_OFFSET_MS - 1);
+    timeSyncRecord(state, T0 + 25200 + TIME_SYNC_MIN_SAMPLE_S - 1, 900);
+    CHECK_NEAR(state.drift_ppm, 10.0, 0.001);
+    CHECK_EQ(state.drift_samples, 5);
+    CHECK_EQ(state.last_sync_epoch, T0 + 25200 + TIME_SYNC_MIN_SAMPLE_S - 1);
+    CHECK_EQ(state.sync_count, 9);
+
+    // Exactly at the limits is accepted
+    timeSyncRecord(state, state.last_sync_epoch + TIME_SYNC_MIN_SAMPLE_S, 6); // 10 ppm
+    CHECK_EQ(state.drift_samples, 6);
+    CHECK_NEAR(state.drift_ppm, 10.0, 0.001);
+
+    // Counters saturate
+    state.drift_samples = 255;
+    state.sync_count = 65535;
+    timeSyncRecord(state, state.last_sync_epoch + 3600, 36);
+    CHECK_EQ(state.drift_samples, 255);
+    CHECK_EQ(state.sync_count, 65535);
+}
+
+static void testInterval() {
+    TimeSyncState state = {};
+    CHECK_EQ(timeSyncIntervalFor(state), TIME_SYNC_DEFAULT_INTERVAL_S);
+    state.drift_samples = 1;
+    state.drift_ppm = 50.0f;
+    CHECK_EQ(timeSyncIntervalFor(state), TIME_SYNC_DEFAULT_INTERVAL_S); // One sample is not enough
+
+    // Re-sync when the expected error reaches the target: 250 ms at 25 ppm = 10000 s
+    state.drift_samples = 2;
+    state.drift_ppm = 25.0f;
+    CHECK_EQ(timeSyncIntervalFor(state), 10000);
+    state.drift_ppm = -25.0f; // Fast clocks the same
+    CHECK_EQ(timeSyncIntervalFor(state), 10000);
+
+    state.drift_ppm = 500.0f;
+    CHECK_EQ(timeSyncIntervalFor(state), TIME_SYNC_MIN_INTERVAL_S);
+    state.drift_ppm = 1.0f;
+    CHECK_EQ(timeSyncIntervalFor(state), TIME_SYNC_MAX_INTERVAL_S);
+    state.drift_ppm = 0.0f; // A perfect crystal still gets the daily sync
+    CHECK_EQ(timeSyncIntervalFor(state), TIME_SYNC_MAX_INTERVAL_S);
+}
+
+static void testCorrection() {
+    TimeSyncState state = {};
+    CHECK_EQ(timeSyncCorrectionFor(state, T0), 0); // No estimate yet
+
+    state.drift_samples = 3;
+    state.drift_ppm = 20.0f;
+    state.last_correction_epoch = T0;
+    CHECK_EQ(timeSyncCorrectionFor(state, T0 + 10000), 200);
+    CHECK_EQ(timeSyncCorrectionFor(state, T0), 0);
+    CHECK_EQ(timeSyncCorrectionFor(state, T0 - 100), 0); // Clock behind the last correction
+    state.drift_ppm = -12.5f;
+    CHECK_EQ(timeSyncCorrectionFor(state, T0 + 4000), -50);
+}
+
+// A clock with a fixed error: the estimate converges, the interval follows it and
+// every sync finds the clock within the target error
+static void testConvergence() {
+    TimeSyncState state = {};
+    const float truePpm = 23.0f;
+    uint32_t now = T0;
+    timeSyncRecord(state, now, 5000);
+
+    for (int i = 0; i < 12; i++) {
+        uint32_t interval = timeSyncIntervalFor(state);
+        now += interval;
+        int32_t offset = offsetAfter(truePpm, interval);
+        if (i >= 3) CHECK(abs(offset) <= TIME_SYNC_TARGET_ERROR_MS + 1);
+        timeSyncRecord(state, now, offset);
+    }
+    CHECK_NEAR(state.drift_ppm, truePpm, 0.1);
+    CHECK_NEAR(timeSyncIntervalFor(state), 250.0 * 1000.0 / truePpm, 50); // Offsets are whole ms
+
+    // Temperature change: the clock now runs 8 ppm fast; the 1/4 weight halves the gap every ~2.4 syncs
+    for (int i = 0; i < 16; i++) {
+        uint32_t interval = timeSyncIntervalFor(state);
+        now += interval;
+        timeSyncRecord(state, now, offsetAfter(-8.0f, interval));
+    }
+    CHECK_NEAR(state.drift_ppm, -8.0, 0.5);
+}
+
+// Corrections applied during deep sleep count towards the next sample
+static void testCorrectionsAcrossSleep() {
+    TimeSyncState state = {};
+    const float truePpm = 40.0f;
+    timeSyncRecord(state, T0, 0);
+    timeSyncRecord(state, T0 + 3600, offsetAfter(truePpm, 3600));
+    timeSyncRecord(state, T0 + 7200, offsetAfter(truePpm, 3600));
+    CHECK_NEAR(state.drift_ppm, truePpm, 0.01);
+
+    // Two wakes, each pulling the clock forward by the estimated drift
+    hostTimeOfDay.tv_sec = T0 + 7200 + 2000;
+    hostTimeOfDay.tv_usec = 500000;
+    timeSyncState = state;
+    timeSyncApplyDrift();
+    CHECK_EQ(timeSyncState.correction_ms, 80);
+    CHECK_EQ(hostTimeOfDay.tv_sec, T0 + 7200 + 2000);
+    CHECK_EQ(hostTimeOfDay.tv_usec, 580000);
+    CHECK_EQ(timeSyncState.last_correction_epoch, T0 + 7200 + 2000);
+
+    hostTimeOfDay.tv_sec = T0 + 7200 + 3000;
+    hostTimeOfDay.tv_usec = 0;
+    timeSyncApplyDrift();
+    CHECK_EQ(timeSyncState.correction_ms, 120);
+    CHECK_EQ(hostTimeOfDay.tv_sec, T0 + 7200 + 3000);
+    CHECK_EQ(hostTimeOfDay.tv_usec, 40000);
+
+    // The next sync finds only the remainder; the sample still measures the full drift
+    int32_t remainder = offsetAfter(truePpm, 3600) - 120;
+    timeSyncRecord(timeSyncState, T0 + 10800, remainder);
+    CHECK_NEAR(timeSyncState.drift_ppm, truePpm, 0.01);
+    CHECK_EQ(timeSyncState.correction_ms, 0);
+
+    // Never before the clock is set
+    hostTimeOfDay.tv_sec = 1000;
+    timeSyncApplyDrift();
+    CHECK_EQ(hostTimeOfDay.tv_sec, 1000);
+}
+
+static void testSyncNotification() {
+    timeSyncState = {};
+    hostMillis = 0;
+    timeSyncBegin();
+
+    // The SNTP task reports a time 250 ms ahead of the local clock
+    hostTimeOfDay.tv_sec = T0;
+    hostTimeOfDay.tv_usec = 100000;
+    struct timeval server = { (time_t)T0, 350000 };
+    sntp_sync_time(&server);
+    CHECK_EQ(hostTimeOfDay.tv_usec, 350000);
+    CHECK_EQ(hostSntp.status, SNTP_SYNC_STATUS_COMPLETED);
+    CHECK_EQ(timeSyncState.sync_count, 0); // Handed over, not yet recorded
+
+    timeSyncService();
+    CHECK_EQ(timeSyncState.sync_count, 1);
+    CHECK_EQ(timeSyncState.last_offset_ms, 250);
+    CHECK_EQ(timeSyncState.last_sync_epoch, T0);
+
+    // Once the estimate moves the interval by more than 25 %, SNTP is re-programmed
+    CHECK_EQ(hostSntp.interval_ms, TIME_SYNC_DEFAULT_INTERVAL_S * 1000UL);
+    for (uint32_t i = 1; i <= 2; i++) {
+        hostTimeOfDay.tv_sec = T0 + i * 3600;
+        hostTimeOfDay.tv_usec = 0;
+        struct timeval next = { (time_t)(T0 + i * 3600), 180000 }; // 50 ppm
+        sntp_sync_time(&next);
+        timeSyncService();
+    }
+    CHECK_NEAR(timeSyncState.drift_ppm, 50.0, 0.01);
+    CHECK_EQ(timeSyncActiveInterval(), 5000);
+    CHECK_EQ(hostSntp.interval_ms, 5000000UL);
+}
+
+static void testServerFallback() {
+    timeSyncState = {};
+    hostMillis = 1000;
+    timeSyncBegin();
+    int starts = hostSntp.starts;
+    CHECK_STR(hostSntp.servers[0], NTP_SERVERS[0]);
+    CHECK_STR(hostSntp.servers[1], NTP_SERVERS[1]);
+
+    // No answer within the timeout: the next server leads, the others follow in order
+    hostMillis += TIME_SYNC_TIMEOUT_MS;
+    timeSyncService();
+    CHECK_EQ(hostSntp.starts, starts);
+    hostMillis += 1;
+    timeSyncService();
+    CHECK_EQ(hostSntp.starts, starts + 1);
+    CHECK_EQ(timeSyncState.server_index, 1);
+    CHECK_STR(hostSntp.servers[0], NTP_SERVERS[1]);
+    CHECK_STR(hostSntp.servers[NTP_SERVER_COUNT - 1], NTP_SERVERS[0]);
+
+    // Around the list and back to the first
+    for (uint8_t i = 1; i < NTP_SERVER_COUNT; i++) {
+        hostMillis += TIME_SYNC_TIMEOUT_MS + 1;
+        timeSyncService();
+    }
+    CHECK_EQ(timeSyncState.server_index, 0);
+    CHECK_STR(hostSntp.servers[0], NTP_SERVERS[0]);
+
+    // After a sync, only a long-overdue next sync rotates (the age uses the real clock)
+    uint32_t now = (uint32_t)time(nullptr);
+    hostTimeOfDay.tv_sec = now;
+    struct timeval server = { (time_t)now, 0 };
+    sntp_sync_time(&server);
+    timeSyncService();
+    starts = hostSntp.starts;
+    hostMillis += 10 * TIME_SYNC_TIMEOUT_MS;
+    timeSyncService();
+    CHECK_EQ(hostSntp.starts, starts);
+    timeSyncState.last_sync_epoch = now - 3 * timeSyncActiveInterval() - TIME_SYNC_TIMEOUT_MS / 1000 - 5;
+    timeSyncService();
+    CHECK_EQ(hostSntp.starts, starts + 1);
+    CHECK_EQ(timeSyncState.server_index, 1);
+
+    timeSyncState.last_sync_epoch = 0;
+    CHECK_EQ(timeSyncAgeSeconds(), UINT32_MAX);
+}
+
+int main() {
+    testEstimator();
+    testInterval();
+    testCorrection();
+    testConvergence();
+    testCorrectionsAcrossSleep();
+    testSyncNotification();
+    testServerFallback();
+    return hostTestResult("test_time_sync");
+}
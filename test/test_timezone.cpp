@@ -0,0 +1,207 @@
+// Time zones: the IANA -> POSIX rule table (lookup, and every rule against the
+// host's tzdata), applyTimezone() and the DST transitions of the current year.
+#include "host_test.h"
+#include "../TimezoneHandler.cpp"
+
+#include <sys/stat.h>
+
+userConfig_t userConfig;
+
+static const char* ZONEINFO = "/usr/share/zoneinfo/";
+
+// POSIX cannot express these zones' rules; the table keeps their usual offset
+static const char* const TZDATA_EXCEPTIONS[] = {
+    "Africa/Casablanca", // Switches to +00 for Ramadan every year
+};
+
+static void useRule(const char* rule) {
+    setenv("TZ", rule, 1);
+    tzset();
+}
+
+static time_t utc(int year, int month, int day, int hour, int minute) {
+    struct tm t = {};
+    t.tm_year = year - 1900;
+    t.tm_mon = month - 1;
+    t.tm_mday = day;
+    t.tm_hour = hour;
+    t.tm_min = minute;
+    return timegm(&t);
+}
+
+static long offsetAt(time_t when) {
+    struct tm local;
+    localtime_r(&when, &local);
+    return local.tm_gmtoff;
+}
+
+static int thisYear() {
+    time_t now = time(nullptr);
+    struct tm t;
+    gmtime_r(&now, &t);
+    return t.tm_year + 1900;
+}
+
+// Last (or first) Sunday of a month, as a UTC date at the given hour
+static time_t sundayOf(int year, int month, bool last, int hour) {
+    if (last) {
+        time_t t = utc(year, month + 1, 0, hour, 0); // Day 0 = last day of 'month'
+        struct tm day;
+        gmtime_r(&t, &day);
+        return t - day.tm_wday * 86400;
+    }
+    time_t t = utc(year, month, 1, hour, 0);
+    struct tm day;
+    gmtime_r(&t, &day);
+    return t + ((7 - day.tm_wday) % 7) * 86400;
+}
+
+static void testLookup() {
+    CHECK(timezoneCount() > 50);
+    for (size_t i = 0; i < timezoneCount(); i++) {
+        const TimezoneEntry& entry = timezoneAt(i);
+        CHECK(findTimezone(entry.name) == &entry);
+        CHECK(strlen(entry.posix) > 0);
+        if (i > 0) CHECK(strcmp(timezoneAt(i - 1).name, entry.name) < 0);
+    }
+    CHECK_STR(findTimezone("Europe/London")->posix, "GMT0BST,M3.5.0/1,M10.5.0");
+    CHECK(findTimezone("europe/london") == nullptr); // Case-sensitive, like the IANA names
+    CHECK(findTimezone("Europe/Londo") == nullptr);
+    CHECK(findTimezone("Europe/London ") == nullptr);
+    CHECK(findTimezone("") == nullptr);
+    CHECK(findTimezone(nullptr) == nullptr);
+    CHECK(findTimezone("A") == nullptr);  // Before the first entry
+    CHECK(findTimezone("Zulu") == nullptr); // After the last entry
+}
+
+/**
+ * Every rule gives the same UTC offset as the IANA zone, hour by hour, this year
+ * and the next two. Needs the host's tzdata; zones it lacks are skipped.
+ */
+static void testRulesMatchTzdata() {
+    const int firstYear = thisYear();
+    const time_t from = utc(firstYear, 1, 1, 0, 30);
+    const time_t to = utc(firstYear + 3, 1, 1, 0, 30);
+    const int hours = (int)((to - from) / 3600);
+    static long expected[3 * 366 * 24];
+
+    size_t compared = 0;
+    for (size_t i = 0; i < timezoneCount(); i++) {
+        const TimezoneEntry& entry = timezoneAt(i);
+        bool exception = false;
+        for (const char* name : TZDATA_EXCEPTIONS) exception = exception || strcmp(name, entry.name) == 0;
+        std::string path = std::string(ZONEINFO) + entry.name;
+        struct stat info;
+        if (exception || stat(path.c_str(), &info) != 0) continue;
+
+        useRule((":" + std::string(entry.name)).c_str());
+        for (int h = 0; h < hours; h++) expected[h] = offsetAt(from + h * 3600L);
+
+        useRule(entry.posix);
+        int mismatches = 0;
+        for (int h = 0; h < hours; h++) {
+            long actual = offsetAt(from + h * 3600L);
+            if (actual != expected[h] && mismatches++ == 0) {
+                time_t when = from + h * 3600L;
+                printf("  %s: %s gives %+ld s at %s", entry.name, entry.posix, actual, asctime(gmtime(&when)));
+                printf("    tzdata gives %+ld s\n", expected[h]);
+            }
+        }
+        CHECK_EQ(mismatches, 0);
+        compared++;
+    }
+    if (compared == 0) printf("  no tzdata in %s: rule comparison skipped\n", ZONEINFO);
+    else CHECK(compared + 5 >= timezoneCount()); // A host without most zones would hide regressions
+}
+
+// Known offsets, independent of the host's tzdata
+static void testKnownOffsets() {
+    const struct {
+        const char* name;
+        long january;   // Seconds east of UTC on 15 January
+        long july;      // And on 15 July
+    } zones[] = {
+        { "UTC", 0, 0 },
+        { "Europe/London", 0, 3600 },
+        { "Europe/Dublin", 0, 3600 },           // Negative DST: winter is the "daylight" rule
+        { "Europe/Berlin", 3600, 7200 },
+        { "America/New_York", -5 * 3600, -4 * 3600 },
+        { "America/Phoenix", -7 * 3600, -7 * 3600 },
+        { "America/St_Johns", -(3 * 3600 + 1800), -(2 * 3600 + 1800) },
+        { "America/Santiago", -3 * 3600, -4 * 3600 },
+        { "Asia/Kolkata", 5 * 3600 + 1800, 5 * 3600 + 1800 },
+        { "Asia/Kathmandu", 5 * 3600 + 2700, 5 * 3600 + 2700 },
+        { "Australia/Sydney", 11 * 3600, 10 * 3600 },
+        { "Australia/Lord_Howe", 11 * 3600, 10 * 3600 + 1800 }, // Half-hour DST
+        { "Pacific/Chatham", 13 * 3600 + 2700, 12 * 3600 + 2700 },
+        { "Pacific/Kiritimati", 14 * 3600, 14 * 3600 },
+        { "Pacific/Pago_Pago", -11 * 3600, -11 * 3600 },
+    };
+    const int year = thisYear();
+    for (const auto& zone : zones) {
+        useRule(findTimezone(zone.name)->posix);
+        CHECK_EQ(offsetAt(utc(year, 1, 15, 12, 0)), zone.january);
+        CHECK_EQ(offsetAt(utc(year, 7, 15, 12, 0)), zone.july);
+    }
+}
+
+static void testApplyTimezone() {
+    strcpy(userConfig.tz_name, "America/Chicago");
+    applyTimezone();
+    CHECK_STR(getenv("TZ"), "CST6CDT,M3.2.0,M11.1.0");
+
+    // No zone (or an unknown one): the manual offset, POSIX sign inverted
+    userConfig.tz_name[0] = '\0';
+    userConfig.gmt_offset_hr = 2;
+    applyTimezone();
+    CHECK_STR(getenv("TZ"), DST_ACTIVE ? "UTC-2DST" : "UTC-2");
+    strcpy(userConfig.tz_name, "Mars/Olympus_Mons");
+    userConfig.gmt_offset_hr = -7;
+    applyTimezone();
+    CHECK_STR(getenv("TZ"), DST_ACTIVE ? "UTC7DST" : "UTC7");
+}
+
+static void checkTransitions(const char* zone, time_t start, time_t end) {
+    strcpy(userConfig.tz_name, zone);
+    applyTimezone();
+    const TimezoneTransitions& transitions = timezoneTransitions();
+    CHECK_EQ(transitions.year, thisYear());
+    CHECK_EQ(transitions.dst_start, start);
+    CHECK_EQ(transitions.dst_end, end);
+    if (start != 0) {
+        // The exact second: standard time just before, daylight time from then on
+        CHECK(offsetAt(start) != offsetAt(start - 1));
+        CHECK(offsetAt(end) != offsetAt(end - 1));
+    }
+}
+
+static void testTransitions() {
+    const int year = thisYear();
+    // EU: last Sunday of March / October at 01:00 UTC
+    checkTransitions("Europe/Berlin", sundayOf(year, 3, true, 1), sundayOf(year, 10, true, 1));
+    checkTransitions("Europe/London", sundayOf(year, 3, true, 1), sundayOf(year, 10, true, 1));
+    // US: second Sunday of March 02:00 EST / first Sunday of November 02:00 EDT
+    checkTransitions("America/New_York", sundayOf(year, 3, false, 7) + 7 * 86400, sundayOf(year, 11, false, 6));
+    // Southern hemisphere: DST ends in April and starts in October (02:00 AEST = 16:00 UTC the day before)
+    checkTransitions("Australia/Sydney", sundayOf(year, 10, false, 16) - 86400, sundayOf(year, 4, false, 16) - 86400);
+    // No DST at all
+    checkTransitions("Asia/Tokyo", 0, 0);
+
+    // Cached per year and dropped when the rules change
+    strcpy(userConfig.tz_name, "America/New_York");
+    applyTimezone();
+    time_t first = timezoneTransitions().dst_start;
+    CHECK(&timezoneTransitions() == &cachedTransitions);
+    strcpy(userConfig.tz_name, "Europe/Paris");
+    applyTimezone();
+    CHECK(timezoneTransitions().dst_start != first);
+}
+
+int main() {
+    testLookup();
+    testRulesMatchTzdata();
+    testKnownOffsets();
+    testApplyTimezone();
+    testTransitions();
+    return hostTestResult("test_timezone");
+}
@@ -0,0 +1,400 @@
+// requires: ArduinoJson
+// Weather providers against recorded payloads: what each parser extracts, the
+// requests each provider sends, error classification, and quota charging for
+// single, group and fallback requests; the full 40-slot forecast body, timed.
+#include "host_test.h"
+#include "../WeatherProvider.cpp"
+#include "../OpenWeatherProvider.cpp"
+#include "../OpenMeteoProvider.cpp"
+#include "../MockWeatherProvider.cpp"
+#include "../WeatherUtilities.cpp"
+#include "../ForecastBuffer.cpp"
+
+#include <chrono>
+
+userConfig_t userConfig;
+static Theme testTheme = {};
+const Theme* currentTheme = &testTheme;
+
+// --- QUOTA (WeatherHandler.cpp on the device) ---
+static int quotaLeft = 0;
+static int quotaCharged = 0;
+bool weatherQuotaTake() {
+    if (quotaLeft <= 0) return false;
+    quotaLeft--;
+    quotaCharged++;
+    return true;
+}
+
+// --- FIXTURES (trimmed copies of real responses) ---
+static const char OWM_LONDON[] = R"json({"coord":{"lon":-0.1257,"lat":51.5085},"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04d"}],"base":"stations","main":{"temp":14.62,"feels_like":14.02,"temp_min":13.33,"temp_max":15.6,"pressure":1014,"humidity":72},"visibility":10000,"wind":{"speed":4.63,"deg":240},"clouds":{"all":75},"dt":1760860800,"sys":{"type":2,"id":2075535,"country":"GB","sunrise":1760855421,"sunset":1760893456},"timezone":3600,"id":2643743,"name":"London","cod":200})json";
+
+static const char OWM_OSLO_NIGHT[] = R"json({"coord":{"lon":10.7461,"lat":59.9127},"weather":[{"id":600,"main":"Snow","description":"light snow","icon":"13n"}],"main":{"temp":-3.4,"humidity":93},"dt":1760914800,"sys":{"country":"NO"},"id":3143244,"name":"Oslo","cod":200})json";
+
+static const char OWM_GROUP[] = R"json({"cnt":3,"list":[{"coord":{"lon":-0.1257,"lat":51.5085},"sys":{"country":"GB","timezone":3600},"weather":[{"id":803,"main":"Clouds","description":"broken clouds","icon":"04d"}],"main":{"temp":14.62,"humidity":72},"dt":1760860800,"id":2643743,"name":"London"},{"coord":{"lon":2.3488,"lat":48.8534},"sys":{"country":"FR","timezone":7200},"weather":[{"id":500,"main":"Rain","description":"light rain","icon":"10d"}],"main":{"temp":16.1,"humidity":81},"dt":1760860800,"id":2988507,"name":"Paris"},{"coord":{"lon":139.6917,"lat":35.6895},"sys":{"country":"JP","timezone":32400},"weather":[{"id":800,"main":"Clear","description":"clear sky","icon":"01n"}],"main":{"temp":19.8,"humidity":60},"dt":1760860800,"id":1850147,"name":"Tokyo"}]})json";
+
+static const char OPENMETEO_BERLIN[] = R"json({"latitude":52.52,"longitude":13.419998,"generationtime_ms":0.03,"utc_offset_seconds":0,"timezone":"GMT","timezone_abbreviation":"GMT","elevation":38.0,"current_units":{"time":"iso8601","interval":"seconds","temperature_2m":"°C","weather_code":"wmo code","is_day":""},"current":{"time":"2026-10-19T08:00","interval":900,"temperature_2m":9.7,"weather_code":61,"is_day":0}})json";
+
+static const char OWM_UNAUTHORIZED[] = R"json({"cod":401,"message":"Invalid API key. Please see https://openweathermap.org/faq#error401 for more info."})json";
+
+// Full /data/2.5/forecast body (5 days in 3-hour steps): every field OWM sends,
+// London-like values, including the integer temp and pop OWM emits for whole numbers
+static const char FORECAST_FIXTURE[] = "test/fixtures/owm_forecast_london.json";
+
+static String readFixture(const char* path) {
+    String text;
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) return text;
+    char buffer[1024];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) text.s.append(buffer, n);
+    fclose(file);
+    return text;
+}
+
+static WeatherLocation cityId(const char* id) {
+    WeatherLocation location = { "", "", id };
+    return location;
+}
+
+static void resetNetwork(int quota) {
+    hostHttp.reset();
+    quotaLeft = quota;
+    quotaCharged = 0;
+}
+
+static void setUp() {
+    strcpy(userConfig.weather_api_key, "0123456789abcdef0123456789abcdef");
+    userConfig.latitude = 52.52f;
+    userConfig.longitude = 13.42f;
+}
+
+static void testOpenWeatherCurrent() {
+    OpenWeatherProvider provider;
+    WeatherRecord record = {};
+    WeatherFetchStats stats;
+
+    resetNetwork(10);
+    hostHttp.replies.push_back({ 200, OWM_LONDON });
+    WeatherLocation byName = { "New York", "US", "" };
+    CHECK_EQ(provider.fetch(byName, record, stats), WEATHER_RESULT_OK);
+    CHECK_EQ(hostHttp.requests.size(), 1);
+    CHECK_STR(hostHttp.requests[0].c_str(),
+              "https://api.openweathermap.org/data/2.5/weather?q=New+York,US&units=metric&appid=0123456789abcdef0123456789abcdef");
+    CHECK(hostHttp.http10);
+    CHECK_EQ(quotaCharged, 1);
+
+    CHECK_NEAR(record.temperature, 14.62, 0.001);
+    CHECK_EQ(record.condition_id, 803);
+    CHECK(record.is_day);
+    CHECK_NEAR(record.latitude, 51.5085, 0.0001);
+    CHECK_NEAR(record.longitude, -0.1257, 0.0001);
+    CHECK_STR(record.description, "broken clouds");
+    CHECK_STR(record.name, "London");
+    CHECK_EQ(stats.http_code, 200);
+    CHECK_EQ(stats.request_bytes, hostHttp.requests[0].size());
+    CHECK_EQ(stats.response_bytes, strlen(OWM_LONDON));
+
+    // City ID mode, imperial units, night icon
+    resetNetwork(10);
+    userConfig.use_fahrenheit = true;
+    hostHttp.replies.push_back({ 200, OWM_OSLO_NIGHT });
+    CHECK_EQ(provider.fetch(cityId("3143244"), record, stats), WEATHER_RESULT_OK);
+    CHECK_STR(hostHttp.requests[0].c_str(),
+              "https://api.openweathermap.org/data/2.5/weather?id=3143244&units=imperial&appid=0123456789abcdef0123456789abcdef");
+    CHECK_NEAR(record.temperature, -3.4, 0.001);
+    CHECK_EQ(record.condition_id, 600);
+    CHECK(!record.is_day);
+    CHECK_STR(record.name, "Oslo");
+    userConfig.use_fahrenheit = false;
+
+    // Configuration checks happen before any traffic
+    WeatherLocation empty = { "", "", "" };
+    CHECK_EQ(provider.checkConfig(empty), WEATHER_RESULT_NO_LOCATION);
+    WeatherLocation noCountry = { "Paris", "", "" };
+    CHECK_EQ(provider.checkConfig(noCountry), WEATHER_RESULT_NO_LOCATION);
+    CHECK_EQ(provider.checkConfig(cityId("2988507")), WEATHER_RESULT_OK);
+    userConfig.weather_api_key[0] = '\0';
+    CHECK_EQ(provider.checkConfig(cityId("2988507")), WEATHER_RESULT_NO_KEY);
+    strcpy(userConfig.weather_api_key, "0123456789abcdef0123456789abcdef");
+}
+
+static void testErrors() {
+    OpenWeatherProvider provider;
+    WeatherRecord record = {};
+    WeatherFetchStats stats;
+    const struct {
+        int code;
+        const char* body;
+        WeatherResult expected;
+    } cases[] = {
+        { 401, OWM_UNAUTHORIZED, WEATHER_RESULT_AUTH },
+        { 404, R"json({"cod":"404","message":"city not found"})json", WEATHER_RESULT_NOT_FOUND },
+        { 429, R"json({"cod":429})json", WEATHER_RESULT_RATE_LIMITED },
+        { 500, "Internal Server Error", WEATHER_RESULT_HTTP },
+        { 200, R"json({"coord":{"lon":1,"lat":2},"weather":[{"id":800)json", WEATHER_RESULT_PARSE },   // Truncated
+        { 200, R"json({"weather":[{"id":800,"icon":"01d"}],"name":"X"})json", WEATHER_RESULT_PARSE },  // No temperature
+        { 200, "<html>captive portal</html>", WEATHER_RESULT_PARSE },
+    };
+    for (const auto& c : cases) {
+        resetNetwork(10);
+        hostHttp.replies.push_back({ c.code, c.body });
+        CHECK_EQ(provider.fetch(cityId("2643743"), record, stats), c.expected);
+        CHECK_EQ(stats.http_code, c.code);
+    }
+
+    // Nothing queued: the connection fails
+    resetNetwork(10);
+    CHECK_EQ(provider.fetch(cityId("2643743"), record, stats), WEATHER_RESULT_NETWORK);
+    CHECK_EQ(quotaCharged, 1); // It was sent
+
+    // Quota used up: nothing is sent
+    resetNetwork(0);
+    hostHttp.replies.push_back({ 200, OWM_LONDON });
+    CHECK_EQ(provider.fetch(cityId("2643743"), record, stats), WEATHER_RESULT_QUOTA);
+    CHECK_EQ(hostHttp.requests.size(), 0);
+}
+
+static void testOpenWeatherGroup() {
+    OpenWeatherProvider provider;
+    WeatherLocation locations[3] = { cityId("2643743"), cityId("2988507"), cityId("1850147") };
+    WeatherRecord records[3] = {};
+    WeatherResult results[3];
+    WeatherFetchStats stats;
+
+    // Every location has an ID: one /group request, charged once
+    resetNetwork(10);
+    hostHttp.replies.push_back({ 200, OWM_GROUP });
+    provider.fetchBatch(locations, 3, records, results, stats);
+    CHECK_EQ(hostHttp.requests.size(), 1);
+    CHECK_STR(hostHttp.requests[0].c_str(),
+              "https://api.openweathermap.org/data/2.5/group?id=2643743,2988507,1850147&units=metric&appid=0123456789abcdef0123456789abcdef");
+    CHECK_EQ(quotaCharged, 1);
+    const char* names[] = { "London", "Paris", "Tokyo" };
+    const uint16_t ids[] = { 803, 500, 800 };
+    const bool days[] = { true, true, false };
+    for (int i = 0; i < 3; i++) {
+        CHECK_EQ(results[i], WEATHER_RESULT_OK);
+        CHECK_STR(records[i].name, names[i]);
+        CHECK_EQ(records[i].condition_id, ids[i]);
+        CHECK_EQ(records[i].is_day, days[i]);
+    }
+    CHECK_NEAR(records[1].temperature, 16.1, 0.001);
+    CHECK_STR(records[2].description, "clear sky");
+
+    // Group endpoint refused: one request per location, each charged
+    resetNetwork(10);
+    hostHttp.replies.push_back({ 400, R"json({"cod":"400","message":"not allowed"})json" });
+    hostHttp.replies.push_back({ 200, OWM_LONDON });
+    hostHttp.replies.push_back({ 200, OWM_OSLO_NIGHT });
+    hostHttp.replies.push_back({ 200, OWM_LONDON });
+    provider.fetchBatch(locations, 3, records, results, stats);
+    CHECK_EQ(hostHttp.requests.size(), 4);
+    CHECK_EQ(quotaCharged, 4);
+    CHECK(!hostHttp.http10);
+    CHECK(hostHttp.reuse);
+    CHECK_EQ(hostHttp.connections, 2);   // The group request, then one kept-alive connection
+    CHECK_EQ(stats.connections, 2);
+    for (int i = 0; i < 3; i++) CHECK_EQ(results[i], WEATHER_RESULT_OK);
+    CHECK_STR(records[1].name, "Oslo");
+    CHECK(strstr(hostHttp.requests[3].c_str(), "id=1850147&") != nullptr);
+
+    // The fallback stops when the quota runs out
+    resetNetwork(2);
+    hostHttp.replies.push_back({ 400, "{}" });
+    hostHttp.replies.push_back({ 200, OWM_LONDON });
+    hostHttp.replies.push_back({ 200, OWM_LONDON });
+    provider.fetchBatch(locations, 3, records, results, stats);
+    CHECK_EQ(hostHttp.requests.size(), 2);
+    CHECK_EQ(results[0], WEATHER_RESULT_OK);
+    CHECK_EQ(results[1], WEATHER_RESULT_QUOTA);
+    CHECK_EQ(results[2], WEATHER_RESULT_QUOTA);
+
+    // Auth and rate-limit errors apply to every location without a fallback
+    resetNetwork(10);
+    hostHttp.replies.push_back({ 401, OWM_UNAUTHORIZED });
+    provider.fetchBatch(locations, 3, records, results, stats);
+    CHECK_EQ(hostHttp.requests.size(), 1);
+    for (int i = 0; i < 3; i++) CHECK_EQ(results[i], WEATHER_RESULT_AUTH);
+
+    // No quota for the group request itself
+    resetNetwork(0);
+    provider.fetchBatch(locations, 3, records, results, stats);
+    CHECK_EQ(hostHttp.requests.size(), 0);
+    for (int i = 0; i < 3; i++) CHECK_EQ(results[i], WEATHER_RESULT_QUOTA);
+
+    // A location without an ID: sequential requests from the start, over one
+    // HTTP/1.1 connection whose bodies arrive chunked
+    WeatherLocation mixed[2] = { cityId("2643743"), { "Oslo", "NO", "" } };
+    resetNetwork(10);
+    hostHttp.replies.push_back({ 200, OWM_LONDON, true });
+    hostHttp.replies.push_back({ 200, OWM_OSLO_NIGHT, true });
+    provider.fetchBatch(mixed, 2, records, results, stats);
+    CHECK_EQ(hostHttp.requests.size(), 2);
+    CHECK(strstr(hostHttp.requests[1].c_str(), "q=Oslo,NO&") != nullptr);
+    CHECK_EQ(results[0], WEATHER_RESULT_OK);
+    CHECK_EQ(results[1], WEATHER_RESULT_OK);
+    CHECK_STR(records[0].name, "London");
+    CHECK_STR(records[1].name, "Oslo");
+    CHECK_NEAR(records[1].temperature, -3.4, 0.001);
+    CHECK_EQ(stats.response_bytes, strlen(OWM_LONDON) + strlen(OWM_OSLO_NIGHT));
+    CHECK_EQ(hostHttp.connections, 1);
+    CHECK_EQ(stats.connections, 1);
+
+    // An error reply is drained, so the next location still reuses the connection
+    resetNetwork(10);
+    hostHttp.replies.push_back({ 404, R"json({"cod":"404","message":"city not found"})json", true });
+    hostHttp.replies.push_back({ 200, OWM_OSLO_NIGHT, true });
+    provider.fetchBatch(mixed, 2, records, results, stats);
+    CHECK_EQ(results[0], WEATHER_RESULT_NOT_FOUND);
+    CHECK_EQ(results[1], WEATHER_RESULT_OK);
+    CHECK_EQ(hostHttp.connections, 1);
+
+    // Single fetches stay on HTTP/1.0 (no chunking) and parse straight off the socket
+    resetNetwork(10);
+    hostHttp.replies.push_back({ 200, OWM_LONDON, true });
+    CHECK_EQ(provider.fetch(mixed[1], records[0], stats), WEATHER_RESULT_OK);
+    CHECK(hostHttp.http10);
+    CHECK_EQ(stats.connections, 1);
+}
+
+static void testOpenMeteo() {
+    OpenMeteoProvider provider;
+    WeatherRecord record = {};
+    WeatherFetchStats stats;
+    WeatherLocation unused = { "", "", "" };
+
+    resetNetwork(10);
+    hostHttp.replies.push_back({ 200, OPENMETEO_BERLIN });
+    CHECK_EQ(provider.fetch(unused, record, stats), WEATHER_RESULT_OK);
+    CHECK_STR(hostHttp.requests[0].c_str(),
+              "https://api.open-meteo.com/v1/forecast?latitude=52.5200&longitude=13.4200"
+              "&current=temperature_2m,weather_code,is_day&temperature_unit=celsius");
+    CHECK_EQ(quotaCharged, 1);
+    CHECK_NEAR(record.temperature, 9.7, 0.001);
+    CHECK_EQ(record.condition_id, 500);   // WMO 61: slight rain
+    CHECK(!record.is_day);
+    CHECK_STR(record.description, "Rain");
+    CHECK_STR(record.name, "");
+    CHECK_NEAR(record.latitude, 52.52, 0.0001);
+
+    resetNetwork(10);
+    hostHttp.replies.push_back({ 200, R"json({"latitude":1,"longitude":2,"current":{"weather_code":3}})json" });
+    CHECK_EQ(provider.fetch(unused, record, stats), WEATHER_RESULT_PARSE);
+
+    userConfig.latitude = 0.0f;
+    userConfig.longitude = 0.0f;
+    CHECK_EQ(provider.checkConfig(unused), WEATHER_RESULT_NO_LOCATION);
+    CHECK(!provider.supportsLocations());
+    userConfig.latitude = 52.52f;
+    userConfig.longitude = 13.42f;
+}
+
+static void testMock() {
+    MockWeatherProvider provider;
+    WeatherRecord record = {};
+    WeatherFetchStats stats;
+    WeatherLocation unused = { "", "", "" };
+
+    // The canned payload is parsed without any request or quota
+    resetNetwork(0);
+    CHECK_EQ(provider.checkConfig(unused), WEATHER_RESULT_OK);
+    CHECK_EQ(provider.fetch(unused, record, stats), WEATHER_RESULT_OK);
+    CHECK_EQ(hostHttp.requests.size(), 0);
+    CHECK_STR(record.name, "New York");
+    CHECK_EQ(record.condition_id, 500);
+    CHECK_NEAR(record.temperature, 54.3, 0.001);
+    CHECK(record.is_day);
+    CHECK_EQ(stats.http_code, MOCK_WEATHER_HTTP_CODE);
+
+    WeatherLocation locations[2] = { unused, unused };
+    WeatherRecord records[2] = {};
+    WeatherResult results[2];
+    provider.fetchBatch(locations, 2, records, results, stats);
+    CHECK_EQ(results[0], WEATHER_RESULT_OK);
+    CHECK_EQ(results[1], WEATHER_RESULT_OK);
+    CHECK_EQ(stats.response_bytes, 2 * (MOCK_WEATHER_PAD_BYTES + strlen(MOCK_WEATHER_PAYLOAD)));
+}
+
+static void testOpenWeatherForecast() {
+    OpenWeatherProvider provider;
+    ForecastRing ring = {};
+    String body = readFixture(FORECAST_FIXTURE);
+    CHECK(body.length() > 15000);
+
+    BodyStream stream(body);
+    CHECK_EQ(provider.parseForecast(stream, ring), WEATHER_RESULT_OK);
+    CHECK_EQ(ring.size, 40);
+    CHECK_EQ(ring.head, 0);
+    for (uint8_t i = 0; i < ring.size; i++) {
+        const ForecastEntry* e = forecastRingAt(ring, i);
+        CHECK_EQ(e->time, 1760918400 + i * 10800); // Oldest first, 3-hour steps
+        uint8_t hour = (i % 8) * 3;
+        CHECK_EQ(e->flags, hour >= 6 && hour < 18 ? 0 : FORECAST_FLAG_NIGHT);
+    }
+
+    // First and last slots, a rainy one, and whole numbers sent as JSON integers
+    const ForecastEntry* first = forecastRingAt(ring, 0);
+    CHECK_EQ(first->temp_x10, 78);
+    CHECK_EQ(first->condition_id, 800);
+    CHECK_EQ(first->pop, 0);
+    const ForecastEntry* rain = forecastRingAt(ring, 4);
+    CHECK_EQ(rain->temp_x10, 142);
+    CHECK_EQ(rain->condition_id, 501);
+    CHECK_EQ(rain->pop, 68);
+    CHECK_EQ(rain->flags, 0);
+    const ForecastEntry* whole = forecastRingAt(ring, 5);
+    CHECK_EQ(whole->temp_x10, 90);
+    CHECK_EQ(forecastRingAt(ring, 3)->pop, 100);
+    const ForecastEntry* last = forecastRingAt(ring, 39);
+    CHECK_EQ(last->time, 1761339600);
+    CHECK_EQ(last->temp_x10, 96);
+    CHECK_EQ(last->condition_id, 500);
+    CHECK_EQ(last->pop, 20);
+    CHECK_EQ(last->flags, FORECAST_FLAG_NIGHT);
+
+    // Parse time on this host (the device logs its own in ForecastHandler.cpp)
+    const int runs = 200;
+    auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < runs; run++) {
+        BodyStream again(body);
+        provider.parseForecast(again, ring);
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+    printf("  forecast: %u slots from %u bytes in %.0f us per parse (host, mean of %d)\n", ring.size, body.length(), us, runs);
+    CHECK_EQ(ring.size, 40);
+
+    // A body cut off mid-list fails, keeping nothing the caller would use
+    String truncated = body.substring(0, body.length() / 2);
+    BodyStream cut(truncated);
+    CHECK_EQ(provider.parseForecast(cut, ring), WEATHER_RESULT_PARSE);
+
+    // An error body without "list"
+    String error = OWM_UNAUTHORIZED;
+    BodyStream noList(error);
+    CHECK_EQ(provider.parseForecast(noList, ring), WEATHER_RESULT_PARSE);
+    CHECK_EQ(ring.size, 0);
+}
+
+static void testProviderSelection() {
+    userConfig.weather_provider = WEATHER_PROVIDER_OPENWEATHER;
+    CHECK_STR(activeWeatherProvider().name(), "OpenWeatherMap");
+    userConfig.weather_provider = WEATHER_PROVIDER_OPENMETEO;
+    CHECK_STR(activeWeatherProvider().name(), "Open-Meteo");
+    userConfig.weather_provider = WEATHER_PROVIDER_MOCK;
+    CHECK_STR(activeWeatherProvider().name(), "Mock");
+    userConfig.weather_provider = 42;
+    CHECK_STR(activeWeatherProvider().name(), "OpenWeatherMap");
+}
+
+int main() {
+    setUp();
+    testOpenWeatherCurrent();
+    testErrors();
+    testOpenWeatherGroup();
+    testOpenMeteo();
+    testMock();
+    testOpenWeatherForecast();
+    testProviderSelection();
+    return hostTestResult("test_weather_providers");
+}
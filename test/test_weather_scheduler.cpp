@@ -0,0 +1,194 @@
+// Weather refresh scheduler: daily quota, exponential backoff, the precipitation /
+// idle / quiet-hours intervals and the jitter bounds, driven by a simulated clock.
+#include "host_test.h"
+#include "../WeatherScheduler.cpp"
+
+static const unsigned long MINUTE = 60000UL;
+
+static WeatherScheduleContext awake() {
+    WeatherScheduleContext context = {};
+    context.backlight_on = true;
+    context.power_factor = 1;
+    return context;
+}
+
+// The random value that lands exactly on the unjittered delay
+static uint32_t centre(unsigned long delayMs) {
+    return (uint32_t)((delayMs / 100) * WEATHER_JITTER_PERCENT);
+}
+
+static unsigned long delayFor(uint8_t failures, ScheduleOutcome outcome, const WeatherScheduleContext& context,
+                              unsigned long expected) {
+    return scheduleComputeDelay(failures, outcome, context, centre(expected));
+}
+
+static void testQuota() {
+    WeatherSchedule schedule = {};
+    const uint32_t day = 20500;
+
+    CHECK(scheduleQuotaAvailable(schedule, day, 3));
+    CHECK(scheduleTakeQuota(schedule, day, 3));
+    CHECK(scheduleTakeQuota(schedule, day, 3));
+    CHECK(scheduleQuotaAvailable(schedule, day, 3));
+    CHECK_EQ(schedule.calls_today, 2);
+    CHECK(scheduleTakeQuota(schedule, day, 3));
+    CHECK(!scheduleQuotaAvailable(schedule, day, 3));
+    CHECK(!scheduleTakeQuota(schedule, day, 3));
+    CHECK_EQ(schedule.calls_today, 3); // Refused calls are not counted
+
+    // Checking never counts
+    for (int i = 0; i < 5; i++) scheduleQuotaAvailable(schedule, day, 3);
+    CHECK_EQ(schedule.calls_today, 3);
+
+    // A raised quota applies at once; 0 means unlimited
+    CHECK(scheduleTakeQuota(schedule, day, 4));
+    CHECK(scheduleQuotaAvailable(schedule, day, 0));
+    for (int i = 0; i < 2000; i++) CHECK(scheduleTakeQuota(schedule, day, 0));
+    CHECK_EQ(schedule.calls_today, 2004);
+
+    // The next UTC day starts from zero
+    CHECK(scheduleQuotaAvailable(schedule, day + 1, 3));
+    CHECK_EQ(schedule.calls_today, 2004);
+    CHECK(scheduleTakeQuota(schedule, day + 1, 3));
+    CHECK_EQ(schedule.quota_day, day + 1);
+    CHECK_EQ(schedule.calls_today, 1);
+
+    // Clock not synced yet (day 0) is a day of its own, and so is the return to the real date
+    CHECK(scheduleTakeQuota(schedule, 0, 3));
+    CHECK_EQ(schedule.calls_today, 1);
+    CHECK(scheduleTakeQuota(schedule, day + 1, 3));
+    CHECK_EQ(schedule.calls_today, 1);
+
+    // Resetting the timer keeps the counter
+    scheduleReset(schedule);
+    CHECK_EQ(schedule.calls_today, 1);
+    CHECK_EQ(schedule.quota_day, day + 1);
+}
+
+static void testBackoff() {
+    WeatherScheduleContext context = awake();
+    // 30 s, doubling per failure, capped at the normal interval
+    CHECK_EQ(delayFor(1, SCHEDULE_TRANSIENT_FAILURE, context, 30000), 30000);
+    CHECK_EQ(delayFor(2, SCHEDULE_TRANSIENT_FAILURE, context, 60000), 60000);
+    CHECK_EQ(delayFor(3, SCHEDULE_TRANSIENT_FAILURE, context, 120000), 120000);
+    CHECK_EQ(delayFor(5, SCHEDULE_TRANSIENT_FAILURE, context, 480000), 480000);
+    CHECK_EQ(delayFor(7, SCHEDULE_TRANSIENT_FAILURE, context, 1920000), 1920000);
+    CHECK_EQ(delayFor(8, SCHEDULE_TRANSIENT_FAILURE, context, WEATHER_UPDATE_INTERVAL_MS), WEATHER_UPDATE_INTERVAL_MS);
+    CHECK_EQ(delayFor(255, SCHEDULE_TRANSIENT_FAILURE, context, WEATHER_UPDATE_INTERVAL_MS), WEATHER_UPDATE_INTERVAL_MS);
+
+    // Retries are not stretched when nobody is looking or in quiet hours
+    WeatherScheduleContext sleepy = awake();
+    sleepy.backlight_on = false;
+    sleepy.idle = true;
+    sleepy.power_factor = 4;
+    CHECK_EQ(delayFor(2, SCHEDULE_TRANSIENT_FAILURE, sleepy, 60000), 60000);
+
+    // scheduleRecord counts consecutive transient failures; anything else clears them
+    WeatherSchedule schedule = {};
+    scheduleRecord(schedule, 1000, SCHEDULE_TRANSIENT_FAILURE, context, centre(30000));
+    scheduleRecord(schedule, 2000, SCHEDULE_TRANSIENT_FAILURE, context, centre(60000));
+    CHECK_EQ(schedule.failures, 2);
+    CHECK_EQ(schedule.next_delay_ms, 60000);
+    scheduleRecord(schedule, 3000, SCHEDULE_RATE_LIMITED, context, centre(WEATHER_UPDATE_INTERVAL_MS));
+    CHECK_EQ(schedule.failures, 0);
+    scheduleRecord(schedule, 4000, SCHEDULE_TRANSIENT_FAILURE, context, centre(30000));
+    CHECK_EQ(schedule.next_delay_ms, 30000);
+    scheduleRecord(schedule, 5000, SCHEDULE_SUCCESS, context, 0);
+    CHECK_EQ(schedule.failures, 0);
+
+    schedule.failures = 254;
+    scheduleRecord(schedule, 6000, SCHEDULE_TRANSIENT_FAILURE, context, 0);
+    scheduleRecord(schedule, 7000, SCHEDULE_TRANSIENT_FAILURE, context, 0);
+    CHECK_EQ(schedule.failures, 255);
+}
+
+static void testIntervals() {
+    WeatherScheduleContext context = awake();
+    CHECK_EQ(delayFor(0, SCHEDULE_SUCCESS, context, WEATHER_UPDATE_INTERVAL_MS), 60 * MINUTE);
+    CHECK_EQ(delayFor(0, SCHEDULE_RATE_LIMITED, context, WEATHER_UPDATE_INTERVAL_MS), 60 * MINUTE);
+    CHECK_EQ(delayFor(0, SCHEDULE_CONFIG_FAILURE, context, WEATHER_UPDATE_INTERVAL_MS), 60 * MINUTE);
+
+    // Rain or snow: the fast interval, but only after a success
+    context.precipitation = true;
+    CHECK_EQ(delayFor(0, SCHEDULE_SUCCESS, context, WEATHER_FAST_INTERVAL_MS), 15 * MINUTE);
+    CHECK_EQ(delayFor(0, SCHEDULE_RATE_LIMITED, context, WEATHER_UPDATE_INTERVAL_MS), 60 * MINUTE);
+
+    // Backlight off or idle: x3
+    context.backlight_on = false;
+    CHECK_EQ(delayFor(0, SCHEDULE_SUCCESS, context, 45 * MINUTE), 45 * MINUTE);
+    context.backlight_on = true;
+    context.idle = true;
+    context.precipitation = false;
+    CHECK_EQ(delayFor(0, SCHEDULE_SUCCESS, context, 180 * MINUTE), 180 * MINUTE);
+
+    // Quiet hours multiply on top
+    context.power_factor = 2;
+    CHECK_EQ(delayFor(0, SCHEDULE_RATE_LIMITED, context, 360 * MINUTE), 360 * MINUTE);
+    context.idle = false;
+    CHECK_EQ(delayFor(0, SCHEDULE_CONFIG_FAILURE, context, 120 * MINUTE), 120 * MINUTE);
+    context.power_factor = 0; // Treated like 1
+    CHECK_EQ(delayFor(0, SCHEDULE_SUCCESS, context, 60 * MINUTE), 60 * MINUTE);
+}
+
+static void testJitter() {
+    WeatherScheduleContext context = awake();
+    const unsigned long base = WEATHER_UPDATE_INTERVAL_MS;
+    const unsigned long span = base / 100 * WEATHER_JITTER_PERCENT;
+
+    CHECK_EQ(scheduleComputeDelay(0, SCHEDULE_SUCCESS, context, 0), base - span);
+    CHECK_EQ(scheduleComputeDelay(0, SCHEDULE_SUCCESS, context, 2 * span), base + span);
+    CHECK_EQ(scheduleComputeDelay(0, SCHEDULE_SUCCESS, context, 2 * span + 1), base - span); // Wraps
+
+    // Any 32-bit value stays within +/- WEATHER_JITTER_PERCENT, and the spread is used
+    unsigned long lowest = base;
+    unsigned long highest = base;
+    uint32_t value = 12345;
+    for (int i = 0; i < 5000; i++) {
+        value = value * 1664525u + 1013904223u;
+        unsigned long delayMs = scheduleComputeDelay(0, SCHEDULE_SUCCESS, context, value);
+        if (delayMs < lowest) lowest = delayMs;
+        if (delayMs > highest) highest = delayMs;
+    }
+    CHECK(lowest >= base - span);
+    CHECK(highest <= base + span);
+    CHECK(lowest < base - span / 2);
+    CHECK(highest > base + span / 2);
+    CHECK(scheduleComputeDelay(0, SCHEDULE_SUCCESS, context, 0xFFFFFFFFu) >= base - span);
+    CHECK(scheduleComputeDelay(0, SCHEDULE_SUCCESS, context, 0xFFFFFFFFu) <= base + span);
+
+    // The first retry is jittered too, never below zero
+    CHECK_EQ(scheduleComputeDelay(1, SCHEDULE_TRANSIENT_FAILURE, context, 0), 27000);
+    CHECK_EQ(scheduleComputeDelay(1, SCHEDULE_TRANSIENT_FAILURE, context, 6000), 33000);
+}
+
+static void testDueAcrossMillisWrap() {
+    WeatherSchedule schedule = {};
+    CHECK(scheduleIsDue(schedule, 0)); // Never attempted: due at once
+    CHECK(scheduleIsDue(schedule, 123456));
+
+    WeatherScheduleContext context = awake();
+    scheduleRecord(schedule, 1000, SCHEDULE_SUCCESS, context, centre(WEATHER_UPDATE_INTERVAL_MS));
+    CHECK(!scheduleIsDue(schedule, 1000));
+    CHECK(!scheduleIsDue(schedule, 1000 + WEATHER_UPDATE_INTERVAL_MS - 1));
+    CHECK(scheduleIsDue(schedule, 1000 + WEATHER_UPDATE_INTERVAL_MS));
+
+    // millis() wraps (after ~49.7 days on the device): elapsed time is computed modulo the type
+    const unsigned long start = (unsigned long)-1 - 10 * MINUTE;
+    scheduleRecord(schedule, start, SCHEDULE_SUCCESS, context, centre(WEATHER_UPDATE_INTERVAL_MS));
+    CHECK(!scheduleIsDue(schedule, start + 20 * MINUTE));
+    CHECK(!scheduleIsDue(schedule, start + WEATHER_UPDATE_INTERVAL_MS - 1));
+    CHECK(scheduleIsDue(schedule, start + WEATHER_UPDATE_INTERVAL_MS));
+
+    scheduleReset(schedule);
+    CHECK(scheduleIsDue(schedule, 5));
+    CHECK_EQ(schedule.failures, 0);
+}
+
+int main() {
+    testQuota();
+    testBackoff();
+    testIntervals();
+    testJitter();
+    testDueAcrossMillisWrap();
+    return hostTestResult("test_weather_scheduler");
+}
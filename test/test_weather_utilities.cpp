@@ -0,0 +1,118 @@
+// OWM condition codes: every code in the OpenWeatherMap condition list maps to
+// the intended class, glyph, icon colour and label; unlisted codes are "unknown".
+#include "host_test.h"
+#include "../WeatherUtilities.cpp"
+
+// A palette with a distinct value per entry, so the colour lookup can be checked
+static Theme makeTheme() {
+    Theme theme = {};
+    for (uint8_t i = 0; i < THEME_ICON_COLOR_COUNT; i++) theme.icon_colors[i] = 0x1000 + i;
+    return theme;
+}
+static Theme testTheme = makeTheme();
+const Theme* currentTheme = &testTheme;
+
+typedef struct {
+    uint16_t id;
+    WeatherClass expected;
+} CodeCase;
+
+// https://openweathermap.org/weather-conditions
+static const CodeCase OWM_CODES[] = {
+    // Group 2xx: thunderstorm
+    { 200, WX_CLASS_THUNDER }, { 201, WX_CLASS_THUNDER }, { 202, WX_CLASS_THUNDER },
+    { 210, WX_CLASS_THUNDER }, { 211, WX_CLASS_THUNDER }, { 212, WX_CLASS_THUNDER },
+    { 221, WX_CLASS_THUNDER }, { 230, WX_CLASS_THUNDER }, { 231, WX_CLASS_THUNDER },
+    { 232, WX_CLASS_THUNDER },
+    // Group 3xx: drizzle
+    { 300, WX_CLASS_DRIZZLE }, { 301, WX_CLASS_DRIZZLE }, { 302, WX_CLASS_DRIZZLE },
+    { 310, WX_CLASS_DRIZZLE }, { 311, WX_CLASS_DRIZZLE }, { 312, WX_CLASS_DRIZZLE },
+    { 313, WX_CLASS_DRIZZLE }, { 314, WX_CLASS_DRIZZLE }, { 321, WX_CLASS_DRIZZLE },
+    // Group 5xx: rain (511 freezing rain shows as sleet)
+    { 500, WX_CLASS_RAIN }, { 501, WX_CLASS_RAIN }, { 502, WX_CLASS_RAIN },
+    { 503, WX_CLASS_RAIN }, { 504, WX_CLASS_RAIN }, { 511, WX_CLASS_SLEET },
+    { 520, WX_CLASS_RAIN }, { 521, WX_CLASS_RAIN }, { 522, WX_CLASS_RAIN },
+    { 531, WX_CLASS_RAIN },
+    // Group 6xx: snow (sleet and rain-and-snow show as sleet)
+    { 600, WX_CLASS_SNOW }, { 601, WX_CLASS_SNOW }, { 602, WX_CLASS_SNOW },
+    { 611, WX_CLASS_SLEET }, { 612, WX_CLASS_SLEET }, { 613, WX_CLASS_SLEET },
+    { 615, WX_CLASS_SLEET }, { 616, WX_CLASS_SLEET },
+    { 620, WX_CLASS_SNOW }, { 621, WX_CLASS_SNOW }, { 622, WX_CLASS_SNOW },
+    // Group 7xx: atmosphere
+    { 701, WX_CLASS_ATMOSPHERE }, { 711, WX_CLASS_ATMOSPHERE }, { 721, WX_CLASS_ATMOSPHERE },
+    { 731, WX_CLASS_ATMOSPHERE }, { 741, WX_CLASS_ATMOSPHERE }, { 751, WX_CLASS_ATMOSPHERE },
+    { 761, WX_CLASS_ATMOSPHERE }, { 762, WX_CLASS_ATMOSPHERE }, { 771, WX_CLASS_ATMOSPHERE },
+    { 781, WX_CLASS_ATMOSPHERE },
+    // Group 800: clear
+    { 800, WX_CLASS_CLEAR },
+    // Group 80x: clouds
+    { 801, WX_CLASS_FEW_CLOUDS }, { 802, WX_CLASS_FEW_CLOUDS },
+    { 803, WX_CLASS_BROKEN_CLOUDS }, { 804, WX_CLASS_OVERCAST },
+};
+
+// Codes outside the list: no data (0), gaps between groups and past the end
+static const uint16_t UNLISTED_CODES[] = { 0, 1, 199, 400, 450, 499, 805, 899, 900, 962, 65535 };
+
+static void testEveryListedCode() {
+    for (size_t i = 0; i < sizeof(OWM_CODES) / sizeof(OWM_CODES[0]); i++) {
+        const CodeCase& c = OWM_CODES[i];
+        if (weatherClassForId(c.id) != c.expected) printf("  code %u\n", c.id);
+        CHECK_EQ(weatherClassForId(c.id), c.expected);
+        CHECK(getWeatherIcon(c.id, true) != WEATHER_CLASS_TABLE[WX_CLASS_UNKNOWN].glyph_day);
+        CHECK(strcmp(getWeatherLabel(c.id), "Unknown") != 0);
+        // Precipitation: the 2xx/3xx/5xx/6xx groups, nothing else
+        CHECK_EQ(weatherIdIsPrecipitation(c.id), c.id < 700);
+    }
+    for (size_t i = 0; i < sizeof(UNLISTED_CODES) / sizeof(UNLISTED_CODES[0]); i++) {
+        uint16_t id = UNLISTED_CODES[i];
+        CHECK_EQ(weatherClassForId(id), WX_CLASS_UNKNOWN);
+        CHECK_STR(getWeatherLabel(id), "Unknown");
+        CHECK_EQ(getWeatherIcon(id, true), ')');
+        CHECK(!weatherIdIsPrecipitation(id));
+    }
+}
+
+static void testGlyphsColorsAndLabels() {
+    // Clear is the only class with a separate night glyph and colour
+    CHECK_EQ(getWeatherIcon(800, true), 'B');
+    CHECK_EQ(getWeatherIcon(800, false), 'C');
+    CHECK_EQ(getWeatherColor(800, true), 0x1000 + THEME_ICON_SUN);
+    CHECK_EQ(getWeatherColor(800, false), 0x1000 + THEME_ICON_MOON);
+    CHECK_EQ(getWeatherIcon(801, true), 'H');
+    CHECK_EQ(getWeatherIcon(801, false), 'I');
+
+    CHECK_EQ(getWeatherIcon(211, true), 'P');
+    CHECK_EQ(getWeatherColor(211, false), 0x1000 + THEME_ICON_THUNDER);
+    CHECK_EQ(getWeatherIcon(511, false), 'X');
+    CHECK_EQ(getWeatherColor(511, true), 0x1000 + THEME_ICON_SNOW);
+    CHECK_EQ(getWeatherColor(741, true), 0x1000 + THEME_ICON_FOG);
+    CHECK_EQ(getWeatherColor(804, true), 0x1000 + THEME_ICON_CLOUDS);
+    CHECK_EQ(getWeatherColor(0, true), 0x1000 + THEME_ICON_UNKNOWN);
+
+    CHECK_STR(getWeatherLabel(313), "Drizzle");
+    CHECK_STR(getWeatherLabel(616), "Sleet");
+    CHECK_STR(getWeatherLabel(622), "Snow");
+    CHECK_STR(getWeatherLabel(781), "Fog");
+    CHECK_STR(getWeatherLabel(802), "Partly Cloudy");
+    CHECK_STR(getWeatherLabel(803), "Cloudy");
+    CHECK_STR(getWeatherLabel(804), "Overcast");
+}
+
+static void checkTitleCase(const char* text, const char* expected) {
+    String result = toTitleCase(text);
+    CHECK_STR(result.c_str(), expected);
+}
+
+static void testTitleCase() {
+    checkTitleCase("light rain", "Light Rain");
+    checkTitleCase("OVERCAST CLOUDS", "Overcast Clouds");
+    checkTitleCase("thunderstorm  with rain", "Thunderstorm  With Rain");
+    checkTitleCase("", "");
+}
+
+int main() {
+    testEveryListedCode();
+    testGlyphsColorsAndLabels();
+    testTitleCase();
+    return hostTestResult("test_weather_utilities");
+}
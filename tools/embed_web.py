@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""Gzips the pages in web/ into WebUiAssets.h (flash-resident arrays with strong ETags).
+
+Run from the repository root after editing anything in web/:
+    python3 tools/embed_web.py
+"""
+import gzip
+import hashlib
+import os
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+ASSETS = [
+    # (source file, C identifier)
+    ("web/config.html", "CONFIG_PAGE"),
+    ("web/dashboard.html", "DASHBOARD_PAGE"),
+    ("web/setup.html", "SETUP_PAGE"),
+]
+
+
+def main():
+    out = [
+        "#ifndef WEBUIASSETS_H",
+        "#define WEBUIASSETS_H",
+        "",
+        "// GENERATED by tools/embed_web.py from web/ -- do not edit by hand.",
+        "// Gzip-compressed pages served with Content-Encoding: gzip; the ETag is a",
+        "// hash of the compressed bytes, so it changes whenever the page does.",
+        "",
+        "#include <stdint.h>",
+        "#include <stddef.h>",
+        "",
+    ]
+    for source, name in ASSETS:
+        with open(os.path.join(ROOT, source), "rb") as f:
+            raw = f.read()
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = hashlib.sha256(packed).hexdigest()[:16]
+        out.append("// %s: %d bytes, %d gzipped" % (source, len(raw), len(packed)))
+        out.append('static const char %s_ETAG[] = "\\"%s\\"";' % (name, etag))
+        out.append("static const size_t %s_GZ_LEN = %d;" % (name, len(packed)))
+        out.append("static const uint8_t %s_GZ[] = {" % name)
+        for i in range(0, len(packed), 16):
+            out.append("    " + ", ".join("0x%02x" % b for b in packed[i:i + 16]) + ",")
+        out.append("};")
+        out.append("")
+        print("%s: %d -> %d bytes, ETag %s" % (source, len(raw), len(packed), etag))
+    out.append("#endif // WEBUIASSETS_H")
+    with open(os.path.join(ROOT, "WebUiAssets.h"), "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()
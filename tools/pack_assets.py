@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Builds an asset pack for the "assets" flash partition (see AssetPack.h).
+
+Each argument is name=file. Adafruit GFX font headers (*.h, as made by
+fontconvert) become FONT entries in TFT_eSPI's glyph layout, theme records
+(*.json, format in ThemeHandler.h) become THEME entries, and anything else is
+stored as a RAW blob. Themes look fonts up by name, clock, date and icons by
+default; theme names appear in the theme selects on the device.
+
+    python3 tools/pack_assets.py -o assets.bin icons=meteocons10pt7b.h clock=FreeSansBold24pt7b.h Ocean=ocean.json
+
+Upload the result from the settings page (Fonts & Icons), or flash it directly:
+    parttool.py write_partition --partition-name assets --input assets.bin
+"""
+import argparse
+import json
+import re
+import struct
+import sys
+import zlib
+
+MAGIC = 0x50414346  # "FCAP"
+VERSION = 1
+NAME_LEN = 16
+TYPE_RAW = 0
+TYPE_FONT = 1
+TYPE_THEME = 2
+THEME_KEYS = {"background", "digit", "card", "colon", "icon", "text", "radius", "icons", "palette", "fonts"}
+PARTITION_SIZE = 0x160000  # partitions.csv
+
+HEADER = struct.Struct("<IHHII")        # AssetPackHeader
+TOC_ENTRY = struct.Struct("<16sB3xII")  # AssetTocEntry
+FONT_HEADER = struct.Struct("<HHBBHIII")  # AssetFontHeader
+GLYPH = struct.Struct("<IBBBbb3x")      # TFT_eSPI GFXglyph (12 bytes with padding)
+
+
+def align4(n):
+    return (n + 3) & ~3
+
+
+def parse_gfx_font(text, path):
+    """Returns (bitmap bytes, glyph tuples, first, last, yAdvance) from a fontconvert header."""
+    text = re.sub(r"//[^\n]*|/\*.*?\*/", "", text, flags=re.S)
+    bitmaps = re.search(r"Bitmaps\[\]\s*(?:PROGMEM)?\s*=\s*\{(.*?)\};", text, re.S)
+    glyphs = re.search(r"Glyphs\[\]\s*(?:PROGMEM)?\s*=\s*\{(.*?)\};", text, re.S)
+    font = re.search(r"GFXfont\s+\w+\s*(?:PROGMEM)?\s*=\s*\{(.*?)\};", text, re.S)
+    if not (bitmaps and glyphs and font):
+        sys.exit("%s: not an Adafruit GFX font header" % path)
+    bitmap = bytes(int(v, 0) for v in re.findall(r"0x[0-9A-Fa-f]+|\d+", bitmaps.group(1)))
+    table = [tuple(int(v, 0) for v in re.findall(r"-?0x[0-9A-Fa-f]+|-?\d+", g))
+             for g in re.findall(r"\{([^{}]*)\}", glyphs.group(1))]
+    fields = [f.strip() for f in font.group(1).split(",") if f.strip()]
+    first, last, y_advance = (int(v, 0) for v in fields[-3:])
+    if len(table) != last - first + 1 or any(len(g) != 6 for g in table):
+        sys.exit("%s: glyph table does not match the range 0x%X-0x%X" % (path, first, last))
+    return bitmap, table, first, last, y_advance
+
+
+def font_blob(path):
+    with open(path, encoding="utf-8", errors="replace") as f:
+        bitmap, table, first, last, y_advance = parse_gfx_font(f.read(), path)
+    glyph_offset = align4(FONT_HEADER.size)
+    bitmap_offset = glyph_offset + len(table) * GLYPH.size
+    blob = bytearray(FONT_HEADER.pack(first, last, y_advance, GLYPH.size, 0,
+                                      glyph_offset, bitmap_offset, len(bitmap)))
+    blob += bytes(glyph_offset - len(blob))
+    for offset, width, height, x_advance, x_offset, y_offset in table:
+        blob += GLYPH.pack(offset, width, height, x_advance, x_offset, y_offset)
+    return bytes(blob + bitmap)
+
+
+def theme_blob(name, path):
+    """Checks a theme record the way the firmware will, and stores it minified."""
+    if not re.fullmatch(r"[A-Za-z0-9 _.-]{1,15}", name):
+        sys.exit("%s: theme names are 1-15 letters, digits, spaces or _.-" % name)
+    with open(path, encoding="utf-8") as f:
+        record = json.load(f)
+    if not isinstance(record, dict) or not {"background", "digit", "card"} <= record.keys():
+        sys.exit("%s: a theme needs background, digit and card" % path)
+    unknown = record.keys() - THEME_KEYS
+    if unknown:
+        sys.exit("%s: unknown keys %s" % (path, ", ".join(sorted(unknown))))
+    return json.dumps(record, separators=(",", ":")).encode()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output", required=True, help="pack file to write")
+    parser.add_argument("entries", nargs="+", metavar="name=file")
+    args = parser.parse_args()
+
+    entries = []
+    for spec in args.entries:
+        name, sep, path = spec.partition("=")
+        if not sep or not name or len(name.encode()) > NAME_LEN:
+            sys.exit("%s: expected name=file with a name of 1-%d characters" % (spec, NAME_LEN))
+        if path.endswith(".h"):
+            entries.append((name, TYPE_FONT, font_blob(path)))
+        elif path.endswith(".json"):
+            entries.append((name, TYPE_THEME, theme_blob(name, path)))
+        else:
+            with open(path, "rb") as f:
+                entries.append((name, TYPE_RAW, f.read()))
+
+    offset = align4(HEADER.size + len(entries) * TOC_ENTRY.size)
+    toc = bytearray()
+    data = bytearray()
+    for name, kind, blob in entries:
+        toc += TOC_ENTRY.pack(name.encode(), kind, offset, len(blob))
+        padded = blob + bytes(align4(len(blob)) - len(blob))
+        data += padded
+        offset += len(padded)
+    toc += bytes(align4(HEADER.size + len(toc)) - HEADER.size - len(toc))
+    body = bytes(toc + data)
+    total = HEADER.size + len(body)
+    if total > PARTITION_SIZE:
+        sys.exit("pack is %d bytes, the assets partition holds %d" % (total, PARTITION_SIZE))
+
+    with open(args.output, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, len(entries), total, zlib.crc32(body)))
+        f.write(body)
+    for name, kind, blob in entries:
+        print("%-16s %-5s %6d bytes" % (name, ("raw", "font", "theme")[kind], len(blob)))
+    print("%s: %d entries, %d bytes" % (args.output, len(entries), total))
+
+
+if __name__ == "__main__":
+    main()